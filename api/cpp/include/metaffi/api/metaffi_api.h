@@ -1,7 +1,10 @@
 #pragma once
 
+#include <metaffi/api/metaffi_worker_pool.h>
 #include <cdts_serializer/cpp/cdts_cpp_serializer.h>
 #include <runtime/cdt.h>
+#include <runtime/cdts_arena.h>
+#include <runtime/cdts_cache.h>
 #include <runtime/metaffi_primitives.h>
 #include <runtime/xcall.h>
 #include <runtime/xllr_capi_loader.h>
@@ -9,15 +12,29 @@
 #include <utils/entity_path_parser.h>
 
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <stdexcept>
 #include <string>
 #include <tuple>
+#include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#define METAFFI_API_COROUTINES 1
+#endif
+
 namespace metaffi::api
 {
 
@@ -26,6 +43,52 @@ using MetaFFITypes = metaffi_types;
 
 class MetaFFIModule;
 class MetaFFIEntity;
+class MetaFFICallFrame;
+template<typename Signature> class TypedEntity;
+
+#ifdef METAFFI_API_COROUTINES
+/**
+ * @brief Awaitable of an asynchronous entity call (MetaFFIEntity::call_awaitable).
+ *
+ * The call starts when awaited, and the coroutine resumes on the worker thread that ran it.
+ */
+template<typename... Ret>
+class MetaFFICallAwaitable
+{
+public:
+	using on_complete_t = std::function<void(std::tuple<Ret...>&&, std::exception_ptr)>;
+
+	explicit MetaFFICallAwaitable(std::function<void(on_complete_t)> start) : _start(std::move(start)) {}
+
+	[[nodiscard]] bool await_ready() const noexcept { return false; }
+
+	void await_suspend(std::coroutine_handle<> awaiting)
+	{
+		// the coroutine (and this awaitable) may be resumed and gone before start returns
+		std::function<void(on_complete_t)> start = std::move(_start);
+		start([this, awaiting](std::tuple<Ret...>&& result, std::exception_ptr error)
+		{
+			_result = std::move(result);
+			_error = error;
+			awaiting.resume();
+		});
+	}
+
+	std::tuple<Ret...> await_resume()
+	{
+		if(_error)
+		{
+			std::rethrow_exception(_error);
+		}
+		return std::move(_result);
+	}
+
+private:
+	std::function<void(on_complete_t)> _start;
+	std::tuple<Ret...> _result{};
+	std::exception_ptr _error;
+};
+#endif
 
 /**
  * @brief MetaFFI runtime handle. Loads/unloads a runtime plugin and creates modules.
@@ -87,9 +150,45 @@ public:
 										const std::vector<MetaFFITypeInfo>& params_types,
 										const std::vector<MetaFFITypeInfo>& retvals_types) const;
 
+	/**
+	 * @brief Load entity without calling into the runtime plugin - the entity is loaded by its first call.
+	 *
+	 * Errors loading the entity are thrown by the first call (which is retried by the next call).
+	 */
+	MetaFFIEntity load_entity_lazy(const std::string& entity_path,
+									const std::vector<MetaFFITypeInfo>& params_types,
+									const std::vector<MetaFFITypeInfo>& retvals_types) const;
+
+	/**
+	 * @brief Cached load_entity_with_info: the entity of (entity path, params types, retvals types)
+	 * is loaded once and shared. Thread-safe.
+	 *
+	 * The cache is shared by copies of the module. Cached entities are shared - do not reconfigure them
+	 * (use_call_arena, use_worker_pool) while other threads call them.
+	 */
+	std::shared_ptr<MetaFFIEntity> get_entity(const std::string& entity_path,
+												const std::vector<MetaFFITypeInfo>& params_types = {},
+												const std::vector<MetaFFITypeInfo>& retvals_types = {}) const;
+
+	/// @brief If true, get_entity loads new entities lazily (see load_entity_lazy). Disabled by default.
+	void set_lazy_loading(bool lazy);
+	/// @brief True if get_entity loads new entities lazily.
+	[[nodiscard]] bool is_lazy_loading() const;
+
+	/// @brief Drop the cached entities. Entities still referenced elsewhere stay alive.
+	void clear_entities_cache();
+
 private:
+	struct entities_cache
+	{
+		std::shared_mutex lock;
+		std::unordered_map<std::string, std::shared_ptr<MetaFFIEntity>> entities;
+		std::atomic<bool> lazy_loading{false};
+	};
+
 	std::string _runtime_plugin;
 	std::string _module_path;
+	std::shared_ptr<entities_cache> _entities_cache;
 };
 
 /**
@@ -148,15 +247,18 @@ public:
 	{
 		ensure_params_count(sizeof...(Args));
 
-		cdts params(static_cast<metaffi_size>(sizeof...(Args)));
-		metaffi::utils::cdts_cpp_serializer serializer(params);
-		if constexpr (sizeof...(Args) > 0)
+		// return values are handed to the caller - keep them off the thread cache
+		metaffi::runtime::cdts_frame frame(static_cast<metaffi_size>(sizeof...(Args)),
+		                                   static_cast<metaffi_size>(_retvals_types.size()),
+		                                   false);
+		call_with_frame(frame, std::forward<Args>(args)...);
+
+		if(_retvals_types.empty())
 		{
-			(serializer << ... << std::forward<Args>(args));
+			return cdts();
 		}
 
-		validate_params(params);
-		return call_with_cdts(std::move(params));
+		return frame.detach_retvals();
 	}
 
 	/**
@@ -168,13 +270,18 @@ public:
 	std::tuple<Ret...> call(Args&&... args)
 	{
 		ensure_retvals_count(sizeof...(Ret));
+		ensure_params_count(sizeof...(Args));
+
+		// parameters and return values do not outlive the call - use the thread cache when they fit
+		metaffi::runtime::cdts_frame frame(static_cast<metaffi_size>(sizeof...(Args)),
+		                                   static_cast<metaffi_size>(sizeof...(Ret)));
+		call_with_frame(frame, std::forward<Args>(args)...);
 
-		cdts retvals = call_cdts(std::forward<Args>(args)...);
 		std::tuple<Ret...> result{};
 
 		if constexpr (sizeof...(Ret) > 0)
 		{
-			metaffi::utils::cdts_cpp_serializer serializer(retvals);
+			metaffi::utils::cdts_cpp_serializer serializer(frame.retvals());
 			std::apply(
 				[&serializer](auto&... items)
 				{
@@ -195,24 +302,386 @@ public:
 		return call<Ret...>(std::forward<Args>(args)...);
 	}
 
+	/**
+	 * @brief Call entity on a worker thread (see use_worker_pool) and get the return values through a future.
+	 *
+	 * Arguments are copied (or moved) into the call. The entity must outlive the call.
+	 * @tparam Ret Return types in order (count must match retvals_types).
+	 * @return Future of the return values, holding the exception if the call fails.
+	 * @throws std::invalid_argument on param/retval count mismatch.
+	 */
+	template<typename... Ret, typename... Args>
+	std::future<std::tuple<Ret...>> call_async(Args&&... args)
+	{
+		auto promise = std::make_shared<std::promise<std::tuple<Ret...>>>();
+		std::future<std::tuple<Ret...>> result = promise->get_future();
+
+		call_async_then<Ret...>(
+			[promise](std::tuple<Ret...>&& values, std::exception_ptr error)
+			{
+				if(error)
+				{
+					promise->set_exception(error);
+				}
+				else
+				{
+					promise->set_value(std::move(values));
+				}
+			},
+			std::forward<Args>(args)...);
+
+		return result;
+	}
+
+	/**
+	 * @brief Call entity on a worker thread (see use_worker_pool) and pass the result to on_complete.
+	 *
+	 * on_complete(std::tuple<Ret...>&& values, std::exception_ptr error) runs on the worker thread.
+	 * error is set (and values value-initialized) if the call fails.
+	 * on_complete must not throw - an exception escaping it is logged and dropped.
+	 * Arguments are copied (or moved) into the call. The entity must outlive the call.
+	 * @throws std::invalid_argument on param/retval count mismatch.
+	 */
+	template<typename... Ret, typename OnComplete, typename... Args>
+	void call_async_then(OnComplete&& on_complete, Args&&... args)
+	{
+		ensure_retvals_count(sizeof...(Ret));
+		ensure_params_count(sizeof...(Args));
+
+		// std::function needs a copyable task - share the (possibly move-only) callback and arguments
+		auto state = std::make_shared<std::tuple<std::decay_t<OnComplete>, std::decay_t<Args>...>>(
+			std::forward<OnComplete>(on_complete), std::forward<Args>(args)...);
+
+		worker_pool().submit(
+			[this, state]()
+			{
+				std::apply(
+					[this](auto& complete, auto&... items)
+					{
+						std::tuple<Ret...> values{};
+						std::exception_ptr error;
+						try
+						{
+							values = call<Ret...>(items...);
+						}
+						catch(...)
+						{
+							error = std::current_exception();
+						}
+
+						complete(std::move(values), error);
+					},
+					*state);
+			});
+	}
+
+#ifdef METAFFI_API_COROUTINES
+	/**
+	 * @brief co_await-able asynchronous call - the call runs on a worker thread (see use_worker_pool).
+	 *
+	 * The coroutine resumes on the worker thread. co_await rethrows the call's exception.
+	 * Arguments are copied (or moved) into the call. The entity must outlive the call.
+	 * @throws std::invalid_argument on param/retval count mismatch.
+	 */
+	template<typename... Ret, typename... Args>
+	MetaFFICallAwaitable<Ret...> call_awaitable(Args&&... args)
+	{
+		ensure_retvals_count(sizeof...(Ret));
+		ensure_params_count(sizeof...(Args));
+
+		auto call_args = std::make_shared<std::tuple<std::decay_t<Args>...>>(std::forward<Args>(args)...);
+		return MetaFFICallAwaitable<Ret...>(
+			[this, call_args](typename MetaFFICallAwaitable<Ret...>::on_complete_t on_complete)
+			{
+				std::apply(
+					[this, &on_complete](auto&... items)
+					{
+						call_async_then<Ret...>(std::move(on_complete), items...);
+					},
+					*call_args);
+			});
+	}
+#endif
+
+	/**
+	 * @brief Worker pool of call_async, call_async_then and call_awaitable.
+	 *
+	 * nullptr (the default) uses the runtime plugin's pool (MetaFFIWorkerPool::of_runtime).
+	 * The pool must outlive the asynchronous calls.
+	 */
+	void use_worker_pool(MetaFFIWorkerPool* pool);
+
 	/**
 	 * @brief Call entity with pre-built CDTS parameters.
 	 * @throws std::invalid_argument on param count/type mismatch.
 	 */
 	cdts call_raw(cdts&& params);
 
+	/**
+	 * @brief Call entity in place on a parameters/return values frame (e.g. from xllr_alloc_cdts_buffer).
+	 *
+	 * params_ret[1] is reused if its length matches the return values count, otherwise it is replaced.
+	 * params_ret[0] is left untouched.
+	 * @throws std::invalid_argument on param count/type mismatch.
+	 */
+	void call_in_frame(cdts params_ret[2]);
+
+	/**
+	 * @brief Call entity once per arguments tuple, crossing into the runtime plugin once for the whole batch.
+	 *
+	 * Runtime plugins that implement xcall_batch pay their per-call setup (GIL, JNI environment, ...) once.
+	 * @tparam Ret Return types in order (count must match retvals_types).
+	 * @return Return values of each call, in the order of args.
+	 * @throws std::invalid_argument on param/retval count/type mismatch.
+	 * @throws std::runtime_error if a call fails - the calls after it are not made.
+	 */
+	template<typename... Ret, typename... Args>
+	std::vector<std::tuple<Ret...>> call_batch(const std::vector<std::tuple<Args...>>& args)
+	{
+		ensure_retvals_count(sizeof...(Ret));
+		ensure_params_count(sizeof...(Args));
+
+		std::vector<std::tuple<Ret...>> results(args.size());
+		if(args.empty())
+		{
+			return results;
+		}
+
+		// parameters/return values pair of each call - reserved up front, frames must not move once serialized
+		std::vector<cdts> frames;
+		frames.reserve(args.size() * 2);
+		for(const std::tuple<Args...>& call_args : args)
+		{
+			cdts& params = frames.emplace_back(static_cast<metaffi_size>(sizeof...(Args)));
+			frames.emplace_back(static_cast<metaffi_size>(sizeof...(Ret)));
+
+			std::apply(
+				[this, &params](const Args&... items)
+				{
+					serialize_params(params, nullptr, items...);
+				},
+				call_args);
+		}
+
+		invoke_batch(frames.data(), static_cast<metaffi_size>(args.size()));
+
+		if constexpr (sizeof...(Ret) > 0)
+		{
+			for(std::size_t i = 0; i < results.size(); i++)
+			{
+				metaffi::utils::cdts_cpp_serializer serializer(frames[2 * i + 1]);
+				std::apply(
+					[&serializer](auto&... items)
+					{
+						(serializer >> ... >> items);
+					},
+					results[i]);
+			}
+		}
+
+		return results;
+	}
+
+	/**
+	 * @brief Call entity count times in place, crossing into the runtime plugin once for the whole batch.
+	 *
+	 * frames holds count parameters/return values pairs - frames[2*i] and frames[2*i+1].
+	 * Return values are prepared as in call_in_frame.
+	 * @throws std::invalid_argument on param count/type mismatch.
+	 * @throws std::runtime_error if a call fails - the calls after it are not made.
+	 */
+	void call_batch(cdts* frames, metaffi_size count);
+
+	/**
+	 * @brief Create a reusable call frame of this entity (see MetaFFICallFrame).
+	 * The entity must outlive the frame.
+	 */
+	[[nodiscard]] MetaFFICallFrame make_call_frame();
+
+	/**
+	 * @brief Build call parameters in a per-thread arena instead of the heap.
+	 *
+	 * The parameters frame (cdt array, strings, nested and packed arrays) is then
+	 * released in one operation when the call completes. Disabled by default.
+	 */
+	void use_call_arena(bool enable);
+	/// @brief True if call parameters are built in a per-thread arena.
+	[[nodiscard]] bool is_using_call_arena() const;
+
 private:
+	template<typename... Args>
+	void call_with_frame(metaffi::runtime::cdts_frame& frame, Args&&... args)
+	{
+		if(_use_call_arena)
+		{
+			// parameters do not outlive the call - build them in the thread's arena
+			metaffi::runtime::cdts_arena_scope scope(metaffi::runtime::cdts_arena::thread_local_instance());
+			serialize_params(frame.params(), &scope.get(), std::forward<Args>(args)...);
+			invoke(frame.get());
+			return;
+		}
+
+		serialize_params(frame.params(), nullptr, std::forward<Args>(args)...);
+		invoke(frame.get());
+	}
+
+	template<typename... Args>
+	void serialize_params(cdts& params, metaffi::runtime::cdts_arena* arena, Args&&... args)
+	{
+		metaffi::utils::cdts_cpp_serializer serializer(params, arena);
+		serializer.set_borrow_packed_arrays(true); // arguments outlive the call - pass numeric vectors without copying
+		if constexpr (sizeof...(Args) > 0)
+		{
+			(serializer << ... << std::forward<Args>(args));
+		}
+
+		validate_params(params);
+	}
+
+	template<typename Signature> friend class TypedEntity;
+	friend class MetaFFICallFrame;
+	friend class MetaFFIModule;
+
+	/// @brief Deferred xllr_load_entity of a lazily loaded entity (MetaFFIModule::load_entity_lazy).
+	struct lazy_load
+	{
+		std::string module_path;
+		std::string entity_path;
+		std::once_flag loaded;
+		xcall* pxcall = nullptr;
+		std::string runtime_plugin;
+
+		~lazy_load();
+	};
+
+	MetaFFIEntity(std::string runtime_plugin,
+				std::unique_ptr<lazy_load> lazy,
+				std::vector<MetaFFITypeInfo> params_types,
+				std::vector<MetaFFITypeInfo> retvals_types);
+
+	/// @brief The entity's xcall - loads lazily loaded entities on first use.
+	xcall* resolved_xcall()
+	{
+		if(_pxcall != nullptr || !_lazy)
+		{
+			return _pxcall;
+		}
+
+		return load_lazy();
+	}
+
+	xcall* load_lazy();
+
+	MetaFFIWorkerPool& worker_pool()
+	{
+		return _worker_pool ? *_worker_pool : MetaFFIWorkerPool::of_runtime(_runtime_plugin);
+	}
+
 	void ensure_params_count(std::size_t count) const;
 	void ensure_retvals_count(std::size_t count) const;
 	void validate_params(const cdts& params) const;
 	void validate_retvals(const cdts& retvals) const;
 	cdts call_with_cdts(cdts&& params);
+	void prepare_retvals(cdts& retvals) const;
+	void invoke(cdts* params_ret);
+	void invoke_batch(cdts* frames, metaffi_size count);
 
 	std::string _runtime_plugin;
 	xcall* _pxcall;
 	std::vector<MetaFFITypeInfo> _params_types;
 	std::vector<MetaFFITypeInfo> _retvals_types;
 	bool _owns_xcall = true;
+	bool _use_call_arena = false;
+	MetaFFIWorkerPool* _worker_pool = nullptr;
+	std::unique_ptr<lazy_load> _lazy;
+};
+
+/**
+ * @brief Parameters and return values of an entity, allocated once and reused by every call.
+ *
+ * Between calls only the CDTs that own memory (strings, arrays, handles, callables) are freed,
+ * so calls of scalar entities do not allocate in steady state.
+ * Not thread-safe - use a frame per thread. Obtained by MetaFFIEntity::make_call_frame().
+ */
+class MetaFFICallFrame
+{
+public:
+	explicit MetaFFICallFrame(MetaFFIEntity& entity);
+
+	MetaFFICallFrame(const MetaFFICallFrame&) = delete;
+	MetaFFICallFrame& operator=(const MetaFFICallFrame&) = delete;
+	MetaFFICallFrame(MetaFFICallFrame&& other) noexcept = default;
+	MetaFFICallFrame& operator=(MetaFFICallFrame&& other) noexcept = default;
+	~MetaFFICallFrame() = default;
+
+	/// @brief Parameters of the next call, for populating in place (see reset_params and invoke).
+	[[nodiscard]] cdts& params() { return _params_ret[0]; }
+	/// @brief Return values of the last call.
+	[[nodiscard]] cdts& retvals() { return _params_ret[1]; }
+
+	/**
+	 * @brief Serialize args into the frame, call the entity and deserialize the return values.
+	 * Packed arrays borrow the arguments' buffers, so params() is reset when call() returns.
+	 * @tparam Ret Return types in order (count must match retvals_types).
+	 * @throws std::invalid_argument on param/retval count or type mismatch.
+	 */
+	template<typename... Ret, typename... Args>
+	std::tuple<Ret...> call(Args&&... args)
+	{
+		_entity->ensure_retvals_count(sizeof...(Ret));
+		_entity->ensure_params_count(sizeof...(Args));
+
+		reset_params();
+		try
+		{
+			metaffi::utils::cdts_cpp_serializer serializer(params());
+			serializer.set_borrow_packed_arrays(true); // arguments outlive the call
+			if constexpr (sizeof...(Args) > 0)
+			{
+				(serializer << ... << std::forward<Args>(args));
+			}
+
+			invoke();
+		}
+		catch(...)
+		{
+			reset_params();
+			throw;
+		}
+
+		// borrowed packed arrays point into args - do not leave them for a later invoke()
+		reset_params();
+
+		std::tuple<Ret...> result{};
+		if constexpr (sizeof...(Ret) > 0)
+		{
+			metaffi::utils::cdts_cpp_serializer deserializer(retvals());
+			std::apply(
+				[&deserializer](auto&... items)
+				{
+					(deserializer >> ... >> items);
+				},
+				result);
+		}
+
+		return result;
+	}
+
+	/**
+	 * @brief Call the entity with the parameters populated in params().
+	 * The return values of the previous call are freed first.
+	 * @throws std::invalid_argument on param type mismatch.
+	 */
+	void invoke();
+
+	/// @brief Free the parameters that own memory and reset all parameters to null, before re-populating params().
+	void reset_params();
+
+private:
+	static void reset(cdts& values);
+
+	MetaFFIEntity* _entity;
+	std::array<cdts, 2> _params_ret;
 };
 
 /**
@@ -220,6 +689,7 @@ private:
  *
  * This class owns only the callable metadata (types arrays + struct) and does not
  * own the underlying xcall pointer.
+ * The entity view is built once, on construction, and calls may run concurrently.
  */
 class MetaFFICallable
 {
@@ -243,8 +713,8 @@ public:
 	template<typename... Ret, typename... Args>
 	std::tuple<Ret...> call(Args&&... args) const
 	{
-		MetaFFIEntity entity = as_entity();
-		return entity.call<Ret...>(std::forward<Args>(args)...);
+		ensure_not_null();
+		return _entity.call<Ret...>(std::forward<Args>(args)...);
 	}
 
 	/**
@@ -259,9 +729,11 @@ public:
 private:
 	/// @brief Create a non-owning entity view over the callable's xcall.
 	[[nodiscard]] MetaFFIEntity as_entity() const;
+	void ensure_not_null() const;
 
 	cdt_metaffi_callable* _callable = nullptr;
 	std::string _runtime_plugin;
+	mutable MetaFFIEntity _entity; // calls do not modify the entity - safe to share between threads
 };
 
 } // namespace metaffi::api
@@ -65,6 +65,8 @@ metaffi_entity_h metaffi_entity_load(metaffi_module_h module,
  *   params_ret[1] = output retvals    (filled by this function on success)
  *
  * On return, params_ret[0] is consumed and params_ret[1] holds the results.
+ * If params_ret[1] already holds an array of the expected length (e.g. from
+ * xllr_alloc_cdts_buffer), the results are written into it in place.
  */
 void metaffi_entity_call(metaffi_entity_h h, struct cdts params_ret[2], char** out_err);
 
@@ -0,0 +1,419 @@
+#pragma once
+
+#include <metaffi/api/metaffi_api.h>
+
+#include <array>
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace metaffi::api
+{
+
+namespace detail_typed
+{
+
+/**
+ * @brief MetaFFI type of a C++ type, derived at compile time.
+ *
+ * Scalars and strings are written to the CDT directly (is_direct), and scalars are read from it directly (is_scalar).
+ * The other types (characters, vectors, handles, callables, metaffi_variant) go through cdts_cpp_serializer.
+ */
+template<typename T, typename Enable = void>
+struct typed_cdt
+{
+	static constexpr bool is_supported = false;
+};
+
+template<typename T, metaffi_types Type>
+struct typed_scalar_cdt
+{
+	static constexpr bool is_supported = true;
+	static constexpr bool is_direct = true;
+	static constexpr bool is_scalar = true;
+	static constexpr metaffi_type type = Type;
+	static constexpr metaffi_int64 fixed_dimensions = 0;
+	using cdt_value = T;
+};
+
+template<> struct typed_cdt<metaffi_int8> : typed_scalar_cdt<metaffi_int8, metaffi_int8_type> {};
+template<> struct typed_cdt<metaffi_int16> : typed_scalar_cdt<metaffi_int16, metaffi_int16_type> {};
+template<> struct typed_cdt<metaffi_int32> : typed_scalar_cdt<metaffi_int32, metaffi_int32_type> {};
+template<> struct typed_cdt<metaffi_int64> : typed_scalar_cdt<metaffi_int64, metaffi_int64_type> {};
+template<> struct typed_cdt<metaffi_uint8> : typed_scalar_cdt<metaffi_uint8, metaffi_uint8_type> {};
+template<> struct typed_cdt<metaffi_uint16> : typed_scalar_cdt<metaffi_uint16, metaffi_uint16_type> {};
+template<> struct typed_cdt<metaffi_uint32> : typed_scalar_cdt<metaffi_uint32, metaffi_uint32_type> {};
+template<> struct typed_cdt<metaffi_uint64> : typed_scalar_cdt<metaffi_uint64, metaffi_uint64_type> {};
+template<> struct typed_cdt<metaffi_float32> : typed_scalar_cdt<metaffi_float32, metaffi_float32_type> {};
+template<> struct typed_cdt<metaffi_float64> : typed_scalar_cdt<metaffi_float64, metaffi_float64_type> {};
+template<> struct typed_cdt<bool> : typed_scalar_cdt<bool, metaffi_bool_type> {};
+#if defined(__linux__)
+// int64_t/uint64_t are long/unsigned long on Linux
+template<> struct typed_cdt<long long> : typed_scalar_cdt<metaffi_int64, metaffi_int64_type> {};
+template<> struct typed_cdt<unsigned long long> : typed_scalar_cdt<metaffi_uint64, metaffi_uint64_type> {};
+#endif
+
+template<typename String, typename Char, metaffi_types Type>
+struct typed_string_cdt
+{
+	static constexpr bool is_supported = true;
+	static constexpr bool is_direct = true;
+	static constexpr bool is_scalar = false;
+	static constexpr metaffi_type type = Type;
+	static constexpr metaffi_int64 fixed_dimensions = 0;
+	using char_type = Char;
+};
+
+template<> struct typed_cdt<std::string> : typed_string_cdt<std::string, char8_t, metaffi_string8_type> {};
+template<> struct typed_cdt<std::u16string> : typed_string_cdt<std::u16string, char16_t, metaffi_string16_type> {};
+template<> struct typed_cdt<std::u32string> : typed_string_cdt<std::u32string, char32_t, metaffi_string32_type> {};
+
+template<typename T, metaffi_types Type, metaffi_int64 Dimensions = 0>
+struct typed_serialized_cdt
+{
+	static constexpr bool is_supported = true;
+	static constexpr bool is_direct = false;
+	static constexpr bool is_scalar = false;
+	static constexpr metaffi_type type = Type;
+	static constexpr metaffi_int64 fixed_dimensions = Dimensions;
+};
+
+template<> struct typed_cdt<metaffi_char8> : typed_serialized_cdt<metaffi_char8, metaffi_char8_type> {};
+template<> struct typed_cdt<metaffi_char16> : typed_serialized_cdt<metaffi_char16, metaffi_char16_type> {};
+template<> struct typed_cdt<metaffi_char32> : typed_serialized_cdt<metaffi_char32, metaffi_char32_type> {};
+template<> struct typed_cdt<cdt_metaffi_handle> : typed_serialized_cdt<cdt_metaffi_handle, metaffi_handle_type> {};
+template<> struct typed_cdt<cdt_metaffi_callable> : typed_serialized_cdt<cdt_metaffi_callable, metaffi_callable_type> {};
+template<> struct typed_cdt<metaffi_variant> : typed_serialized_cdt<metaffi_variant, metaffi_any_type> {};
+
+// Nested vectors of scalars/strings - arrays of the element type with a dimension per nesting level
+template<typename T>
+struct typed_cdt<std::vector<T>, std::enable_if_t<typed_cdt<T>::is_supported>>
+	: typed_serialized_cdt<std::vector<T>,
+	                       static_cast<metaffi_types>(typed_cdt<T>::type | metaffi_array_type),
+	                       typed_cdt<T>::fixed_dimensions + 1>
+{
+};
+
+template<typename T>
+inline constexpr bool is_typed_cdt_v = typed_cdt<std::decay_t<T>>::is_supported;
+
+template<typename Tuple>
+struct is_typed_tuple;
+
+template<typename... T>
+struct is_typed_tuple<std::tuple<T...>> : std::bool_constant<(is_typed_cdt_v<T> && ...)> {};
+
+/**
+ * @brief Write value to params[index]. params[index] must be an empty (null) CDT.
+ */
+template<typename T>
+void write_cdt(cdts& params, metaffi_size index, metaffi::utils::cdts_cpp_serializer& serializer, const T& value)
+{
+	using traits = typed_cdt<T>;
+
+	if constexpr (traits::is_scalar)
+	{
+		params.arr[index] = static_cast<typename traits::cdt_value>(value);
+	}
+	else if constexpr (traits::is_direct)
+	{
+		params.arr[index].set_string(reinterpret_cast<const typename traits::char_type*>(value.data()),
+		                             static_cast<metaffi_size>(value.size()),
+		                             true);
+	}
+	else
+	{
+		serializer.set_index(index);
+		serializer << value;
+	}
+}
+
+template<typename V>
+V read_scalar(const cdt& c)
+{
+	if constexpr (std::is_same_v<V, metaffi_int8>) return c.cdt_val.int8_val;
+	else if constexpr (std::is_same_v<V, metaffi_int16>) return c.cdt_val.int16_val;
+	else if constexpr (std::is_same_v<V, metaffi_int32>) return c.cdt_val.int32_val;
+	else if constexpr (std::is_same_v<V, metaffi_int64>) return c.cdt_val.int64_val;
+	else if constexpr (std::is_same_v<V, metaffi_uint8>) return c.cdt_val.uint8_val;
+	else if constexpr (std::is_same_v<V, metaffi_uint16>) return c.cdt_val.uint16_val;
+	else if constexpr (std::is_same_v<V, metaffi_uint32>) return c.cdt_val.uint32_val;
+	else if constexpr (std::is_same_v<V, metaffi_uint64>) return c.cdt_val.uint64_val;
+	else if constexpr (std::is_same_v<V, metaffi_float32>) return c.cdt_val.float32_val;
+	else if constexpr (std::is_same_v<V, metaffi_float64>) return c.cdt_val.float64_val;
+	else return c.cdt_val.bool_val != 0;
+}
+
+/**
+ * @brief Read retvals[index] as T. Scalars are read straight from the CDT after a single type compare
+ * (the guest may still return null, or a metaffi_any_type entity another type); the other types are checked by cdts_cpp_serializer.
+ * @throws std::runtime_error on type mismatch.
+ */
+template<typename T>
+T read_cdt(cdts& retvals, metaffi_size index, metaffi::utils::cdts_cpp_serializer& serializer)
+{
+	using traits = typed_cdt<T>;
+
+	if constexpr (traits::is_scalar)
+	{
+		const cdt& item = retvals.arr[index];
+		if(item.type != traits::type)
+		{
+			std::ostringstream ss;
+			ss << "Return value type mismatch at index " << index << ": expected type "
+			   << static_cast<unsigned long long>(traits::type) << ", got " << static_cast<unsigned long long>(item.type);
+			throw std::runtime_error(ss.str());
+		}
+
+		return static_cast<T>(read_scalar<typename traits::cdt_value>(item));
+	}
+	else
+	{
+		T value{};
+		serializer.set_index(index);
+		serializer >> value;
+		return value;
+	}
+}
+
+template<typename R>
+struct typed_return
+{
+	using types = std::tuple<R>;
+};
+
+template<>
+struct typed_return<void>
+{
+	using types = std::tuple<>;
+};
+
+template<typename... R>
+struct typed_return<std::tuple<R...>>
+{
+	using types = std::tuple<R...>;
+};
+
+template<typename Tuple>
+struct typed_types_info;
+
+template<typename... T>
+struct typed_types_info<std::tuple<T...>>
+{
+	static constexpr std::array<metaffi_type, sizeof...(T)> types = {typed_cdt<T>::type...};
+	static constexpr std::array<metaffi_int64, sizeof...(T)> fixed_dimensions = {typed_cdt<T>::fixed_dimensions...};
+
+	static std::vector<MetaFFITypeInfo> to_type_infos()
+	{
+		std::vector<MetaFFITypeInfo> infos;
+		infos.reserve(sizeof...(T));
+		for(std::size_t i = 0; i < sizeof...(T); i++)
+		{
+			infos.emplace_back(types[i], nullptr, false, fixed_dimensions[i] == 0 ? MIXED_OR_UNKNOWN_DIMENSIONS : fixed_dimensions[i]);
+		}
+		return infos;
+	}
+};
+
+/**
+ * @brief Check that the types an entity was loaded with match the C++ signature.
+ * @throws std::invalid_argument on mismatch.
+ */
+template<std::size_t N>
+void check_signature(const std::vector<MetaFFITypeInfo>& loaded,
+                     const std::array<metaffi_type, N>& types,
+                     const std::array<metaffi_int64, N>& fixed_dimensions,
+                     const char* what)
+{
+	if(loaded.size() != N)
+	{
+		std::ostringstream ss;
+		ss << what << " count mismatch. expected=" << N << ", actual=" << loaded.size();
+		throw std::invalid_argument(ss.str());
+	}
+
+	for(std::size_t i = 0; i < N; i++)
+	{
+		const MetaFFITypeInfo& info = loaded[i];
+		const metaffi_type element_type = info.type & ~metaffi_packed_type;
+
+		bool matches = element_type == types[i] || info.type == metaffi_any_type;
+		if(matches && fixed_dimensions[i] > 0 && info.fixed_dimensions != MIXED_OR_UNKNOWN_DIMENSIONS)
+		{
+			matches = info.fixed_dimensions == fixed_dimensions[i];
+		}
+
+		if(!matches)
+		{
+			std::ostringstream ss;
+			ss << what << " type mismatch at index " << i << ". expected type=" << static_cast<unsigned long long>(types[i])
+			   << ", loaded type=" << static_cast<unsigned long long>(info.type);
+			throw std::invalid_argument(ss.str());
+		}
+	}
+}
+
+} // namespace detail_typed
+
+/**
+ * @brief Statically typed entity handle, e.g. TypedEntity<metaffi_int64(metaffi_int64, metaffi_int64)>.
+ *
+ * R is void, a single type or std::tuple of the return types.
+ * The MetaFFI types are derived from the C++ types at compile time, and the signature is checked
+ * once when the entity is loaded. Calls write the arguments straight into the CDTs of a cached
+ * frame and read the return values straight out of it, without per-call type validation.
+ */
+template<typename Signature>
+class TypedEntity;
+
+template<typename R, typename... Args>
+class TypedEntity<R(Args...)>
+{
+	static_assert((detail_typed::is_typed_cdt_v<Args> && ...), "TypedEntity parameter type is not a MetaFFI type");
+	static_assert(sizeof...(Args) <= 127, "TypedEntity supports up to 127 parameters");
+	static_assert(!std::is_same_v<R, std::tuple<>>, "use void for entities without return values");
+
+	using params_tuple = std::tuple<std::decay_t<Args>...>;
+	using retvals_tuple = typename detail_typed::typed_return<R>::types;
+	static_assert(detail_typed::is_typed_tuple<retvals_tuple>::value, "TypedEntity return type is not a MetaFFI type");
+	static_assert(std::tuple_size_v<retvals_tuple> <= 127, "TypedEntity supports up to 127 return values");
+	using params_info = detail_typed::typed_types_info<params_tuple>;
+	using retvals_info = detail_typed::typed_types_info<retvals_tuple>;
+
+	static constexpr metaffi_size params_count = sizeof...(Args);
+	static constexpr metaffi_size retvals_count = std::tuple_size_v<retvals_tuple>;
+
+public:
+	/// @brief MetaFFI types of the parameters.
+	static constexpr const std::array<metaffi_type, sizeof...(Args)>& parameters_types() { return params_info::types; }
+	/// @brief MetaFFI types of the return values.
+	static constexpr const std::array<metaffi_type, std::tuple_size_v<retvals_tuple>>& retval_types() { return retvals_info::types; }
+
+	/// @brief Empty, unbound entity (for use as static).
+	TypedEntity() = default;
+
+	/**
+	 * @brief Load entity_path from module with the types of the signature.
+	 */
+	TypedEntity(const MetaFFIModule& module, const std::string& entity_path)
+		: _entity(module.load_entity_with_info(entity_path, params_info::to_type_infos(), retvals_info::to_type_infos()))
+	{
+	}
+
+	/**
+	 * @brief Take an already loaded entity.
+	 * @throws std::invalid_argument if the entity's types do not match the signature.
+	 */
+	explicit TypedEntity(MetaFFIEntity&& entity)
+	{
+		detail_typed::check_signature(entity.parameters_types(), params_info::types, params_info::fixed_dimensions, "Parameter");
+		detail_typed::check_signature(entity.retval_types(), retvals_info::types, retvals_info::fixed_dimensions, "Return value");
+		_entity = std::move(entity);
+	}
+
+	/// @brief The underlying (dynamically typed) entity.
+	[[nodiscard]] MetaFFIEntity& entity() { return _entity; }
+
+	/**
+	 * @brief Call the entity.
+	 * @throws std::runtime_error if the entity is unbound or the call fails.
+	 */
+	R call(const std::decay_t<Args>&... args)
+	{
+		xcall* pxcall = _entity.resolved_xcall();
+		if(pxcall == nullptr)
+		{
+			throw std::runtime_error("xcall is null");
+		}
+
+		char* err = nullptr;
+
+		if constexpr (params_count == 0 && retvals_count == 0)
+		{
+			xllr_xcall_no_params_no_ret(pxcall, &err);
+			throw_if_call_err(err);
+		}
+		else
+		{
+			metaffi::runtime::cdts_frame frame(params_count, retvals_count);
+
+			if constexpr (params_count > 0)
+			{
+				metaffi::utils::cdts_cpp_serializer serializer(frame.params());
+				serializer.set_borrow_packed_arrays(true); // arguments outlive the call
+				write_params(frame.params(), serializer, std::index_sequence_for<Args...>{}, args...);
+			}
+
+			if constexpr (params_count > 0 && retvals_count > 0)
+			{
+				xllr_xcall_params_ret(pxcall, frame.get(), &err);
+			}
+			else if constexpr (params_count > 0)
+			{
+				xllr_xcall_params_no_ret(pxcall, frame.get(), &err);
+			}
+			else
+			{
+				xllr_xcall_no_params_ret(pxcall, frame.get(), &err);
+			}
+			throw_if_call_err(err);
+
+			if constexpr (retvals_count > 0)
+			{
+				return read_retvals(frame.retvals(), std::make_index_sequence<retvals_count>{});
+			}
+		}
+	}
+
+	/**
+	 * @brief Call the entity via operator() (same as call()).
+	 */
+	R operator()(const std::decay_t<Args>&... args)
+	{
+		return call(args...);
+	}
+
+private:
+	template<std::size_t... I>
+	static void write_params(cdts& params, metaffi::utils::cdts_cpp_serializer& serializer, std::index_sequence<I...>, const std::decay_t<Args>&... args)
+	{
+		(detail_typed::write_cdt(params, static_cast<metaffi_size>(I), serializer, args), ...);
+	}
+
+	template<std::size_t... I>
+	static R read_retvals(cdts& retvals, std::index_sequence<I...>)
+	{
+		metaffi::utils::cdts_cpp_serializer serializer(retvals);
+		if constexpr (std::is_same_v<R, retvals_tuple>)
+		{
+			// braced initialization reads the return values in order
+			return R{detail_typed::read_cdt<std::tuple_element_t<I, retvals_tuple>>(retvals, static_cast<metaffi_size>(I), serializer)...};
+		}
+		else
+		{
+			return detail_typed::read_cdt<R>(retvals, 0, serializer);
+		}
+	}
+
+	static void throw_if_call_err(char* err)
+	{
+		if(err == nullptr)
+		{
+			return;
+		}
+
+		std::string msg = "xcall invocation failed: ";
+		msg += err;
+		xllr_free_string(err);
+		throw std::runtime_error(msg);
+	}
+
+	MetaFFIEntity _entity;
+};
+
+} // namespace metaffi::api
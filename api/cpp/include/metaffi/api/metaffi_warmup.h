@@ -0,0 +1,298 @@
+#pragma once
+
+#include <metaffi/api/metaffi_api.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace metaffi::api
+{
+
+/// @brief Timings of the warm-up of one runtime plugin.
+struct MetaFFIWarmupTimings
+{
+	std::string runtime_plugin;
+	std::chrono::nanoseconds load_runtime{0};  ///< load_runtime_plugin
+	std::chrono::nanoseconds load_entities{0}; ///< loading all the entities of the runtime
+	std::size_t entities_count = 0;
+};
+
+/**
+ * @brief Result of MetaFFIWarmup::run - the loaded entities (by manifest index) and the timings.
+ */
+class MetaFFIWarmupReport
+{
+public:
+	/// @brief Number of entities in the manifest.
+	[[nodiscard]] std::size_t entities_count() const
+	{
+		return _entities.size();
+	}
+
+	/**
+	 * @brief The entity of a manifest index (returned by MetaFFIWarmup::add).
+	 * @throws std::out_of_range if the index is invalid or the entity was taken.
+	 */
+	[[nodiscard]] MetaFFIEntity& entity(std::size_t index) const
+	{
+		return *checked(index);
+	}
+
+	/**
+	 * @brief Move the entity of a manifest index out of the report.
+	 * @throws std::out_of_range if the index is invalid or the entity was already taken.
+	 */
+	std::unique_ptr<MetaFFIEntity> take_entity(std::size_t index)
+	{
+		checked(index);
+		return std::move(_entities[index]);
+	}
+
+	/// @brief Timings per runtime plugin, in the order the runtimes first appear in the manifest.
+	[[nodiscard]] const std::vector<MetaFFIWarmupTimings>& runtimes() const
+	{
+		return _runtimes;
+	}
+
+	/// @brief Wall-clock time of the whole warm-up.
+	[[nodiscard]] std::chrono::nanoseconds total() const
+	{
+		return _total;
+	}
+
+private:
+	friend class MetaFFIWarmup;
+
+	const std::unique_ptr<MetaFFIEntity>& checked(std::size_t index) const
+	{
+		if(index >= _entities.size() || !_entities[index])
+		{
+			throw std::out_of_range("warm-up entity " + std::to_string(index) + " does not exist or was already taken");
+		}
+		return _entities[index];
+	}
+
+	std::vector<std::unique_ptr<MetaFFIEntity>> _entities;
+	std::vector<MetaFFIWarmupTimings> _runtimes;
+	std::chrono::nanoseconds _total{0};
+};
+
+/**
+ * @brief Loads a manifest of runtimes and entities concurrently, instead of the serial
+ * load_runtime_plugin -> load_module -> load_entity sequence.
+ *
+ * Each runtime plugin is loaded on its own thread, so independent runtimes (e.g. JVM and Python)
+ * initialize at the same time. Once its runtime is loaded, the entities of that runtime are loaded
+ * by entity_threads threads - except Python runtimes, which load their entities on one thread
+ * (the plugin holds the GIL while loading an entity, so more threads only contend for it).
+ *
+ * @code
+ * MetaFFIWarmup warmup;
+ * size_t add = warmup.add("python3", "math.py", "callable=add", {metaffi_int64_type, metaffi_int64_type}, {metaffi_int64_type});
+ * size_t now = warmup.add("jvm", "time.jar", "class=Clock,callable=now", {}, {metaffi_int64_type});
+ * MetaFFIWarmupReport report = warmup.run();
+ * MetaFFIEntity& add_entity = report.entity(add);
+ * @endcode
+ */
+class MetaFFIWarmup
+{
+public:
+	/**
+	 * @brief Add an entity to the manifest.
+	 * @param runtime_plugin Runtime name (e.g., "python3" or "xllr.python3").
+	 * @return Index of the entity in MetaFFIWarmupReport.
+	 */
+	std::size_t add(const std::string& runtime_plugin,
+					const std::string& module_path,
+					const std::string& entity_path,
+					const std::vector<MetaFFITypeInfo>& params_types = {},
+					const std::vector<MetaFFITypeInfo>& retvals_types = {})
+	{
+		_manifest.push_back({MetaFFIRuntime(runtime_plugin).runtime_plugin(), module_path, entity_path, params_types, retvals_types});
+		return _manifest.size() - 1;
+	}
+
+	/// @brief Number of entities in the manifest.
+	[[nodiscard]] std::size_t size() const
+	{
+		return _manifest.size();
+	}
+
+	/// @brief Threads loading the entities of each (non-Python) runtime. Defaults to 4.
+	void set_entity_threads(std::size_t threads_count)
+	{
+		_entity_threads = (std::max)(threads_count, std::size_t(1));
+	}
+
+	/// @brief If true, entities are not loaded by run() - each is loaded by its first call (see MetaFFIModule::load_entity_lazy).
+	void set_lazy_entities(bool lazy)
+	{
+		_lazy_entities = lazy;
+	}
+
+	/**
+	 * @brief Load all the runtimes and entities of the manifest.
+	 *
+	 * Waits for all the runtimes to finish, even if some of them fail.
+	 * @throws The first error (in manifest order of the runtimes) loading a runtime or an entity.
+	 */
+	[[nodiscard]] MetaFFIWarmupReport run() const
+	{
+		using clock = std::chrono::steady_clock;
+		const clock::time_point start = clock::now();
+
+		// group the manifest by runtime, keeping the order the runtimes appear in
+		std::vector<std::string> runtimes;
+		std::map<std::string, std::vector<std::size_t>> runtime_entries;
+		for(std::size_t i = 0; i < _manifest.size(); i++)
+		{
+			std::vector<std::size_t>& entries = runtime_entries[_manifest[i].runtime_plugin];
+			if(entries.empty())
+			{
+				runtimes.push_back(_manifest[i].runtime_plugin);
+			}
+			entries.push_back(i);
+		}
+
+		MetaFFIWarmupReport report;
+		report._entities.resize(_manifest.size());
+		report._runtimes.resize(runtimes.size());
+
+		std::vector<std::exception_ptr> errors(runtimes.size());
+		std::vector<std::thread> threads;
+		threads.reserve(runtimes.size());
+
+		for(std::size_t r = 0; r < runtimes.size(); r++)
+		{
+			threads.emplace_back([this, &report, &errors, &runtimes, &runtime_entries, r]()
+			{
+				try
+				{
+					MetaFFIWarmupTimings& timings = report._runtimes[r];
+					timings.runtime_plugin = runtimes[r];
+					timings.entities_count = runtime_entries.at(runtimes[r]).size();
+
+					clock::time_point phase_start = clock::now();
+					MetaFFIRuntime(runtimes[r]).load_runtime_plugin();
+					timings.load_runtime = clock::now() - phase_start;
+
+					phase_start = clock::now();
+					load_entities(runtime_entries.at(runtimes[r]), report._entities);
+					timings.load_entities = clock::now() - phase_start;
+				}
+				catch(...)
+				{
+					errors[r] = std::current_exception();
+				}
+			});
+		}
+
+		for(std::thread& t : threads)
+		{
+			t.join();
+		}
+
+		for(const std::exception_ptr& err : errors)
+		{
+			if(err)
+			{
+				std::rethrow_exception(err);
+			}
+		}
+
+		report._total = clock::now() - start;
+		return report;
+	}
+
+private:
+	struct manifest_entry
+	{
+		std::string runtime_plugin; // normalized
+		std::string module_path;
+		std::string entity_path;
+		std::vector<MetaFFITypeInfo> params_types;
+		std::vector<MetaFFITypeInfo> retvals_types;
+	};
+
+	std::unique_ptr<MetaFFIEntity> load_entity(const manifest_entry& entry) const
+	{
+		MetaFFIModule module(entry.runtime_plugin, entry.module_path);
+		return std::make_unique<MetaFFIEntity>(_lazy_entities ?
+			module.load_entity_lazy(entry.entity_path, entry.params_types, entry.retvals_types) :
+			module.load_entity_with_info(entry.entity_path, entry.params_types, entry.retvals_types));
+	}
+
+	// loads the entities of one runtime, in parallel if the runtime allows it
+	void load_entities(const std::vector<std::size_t>& entries, std::vector<std::unique_ptr<MetaFFIEntity>>& out) const
+	{
+		if(entries.empty())
+		{
+			return;
+		}
+
+		std::size_t threads_count = _entity_threads;
+		if(_lazy_entities || _manifest[entries.front()].runtime_plugin.rfind("xllr.python", 0) == 0)
+		{
+			threads_count = 1;
+		}
+		threads_count = (std::min)(threads_count, entries.size());
+
+		if(threads_count == 1)
+		{
+			for(std::size_t i : entries)
+			{
+				out[i] = load_entity(_manifest[i]);
+			}
+			return;
+		}
+
+		// each thread loads every threads_count-th entry (entries are disjoint, so the writes to out do not race)
+		std::vector<std::exception_ptr> errors(threads_count);
+		std::vector<std::thread> threads;
+		threads.reserve(threads_count);
+		for(std::size_t t = 0; t < threads_count; t++)
+		{
+			threads.emplace_back([this, &entries, &out, &errors, threads_count, t]()
+			{
+				try
+				{
+					for(std::size_t e = t; e < entries.size(); e += threads_count)
+					{
+						out[entries[e]] = load_entity(_manifest[entries[e]]);
+					}
+				}
+				catch(...)
+				{
+					errors[t] = std::current_exception();
+				}
+			});
+		}
+
+		for(std::thread& t : threads)
+		{
+			t.join();
+		}
+
+		for(const std::exception_ptr& err : errors)
+		{
+			if(err)
+			{
+				std::rethrow_exception(err);
+			}
+		}
+	}
+
+	std::vector<manifest_entry> _manifest;
+	std::size_t _entity_threads = 4;
+	bool _lazy_entities = false;
+};
+
+} // namespace metaffi::api
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <utils/logger.hpp>
+
+namespace metaffi::api
+{
+
+/**
+ * @brief Fixed-size pool of worker threads running MetaFFI calls (used by MetaFFIEntity::call_async).
+ *
+ * Each runtime plugin gets its own pool (of_runtime), so the threads calling into a runtime are
+ * long-lived and dedicated to it: JVM calls stay on threads the plugin already attached,
+ * and Python calls are queued to a single worker instead of contending for the GIL.
+ */
+class MetaFFIWorkerPool
+{
+public:
+	/**
+	 * @param threads_count Number of worker threads (at least 1).
+	 */
+	explicit MetaFFIWorkerPool(std::size_t threads_count)
+	{
+		threads_count = (std::max)(threads_count, std::size_t(1));
+		_threads.reserve(threads_count);
+		for(std::size_t i = 0; i < threads_count; i++)
+		{
+			_threads.emplace_back([this]() { worker_loop(); });
+		}
+	}
+
+	MetaFFIWorkerPool(const MetaFFIWorkerPool&) = delete;
+	MetaFFIWorkerPool& operator=(const MetaFFIWorkerPool&) = delete;
+
+	/// @brief Runs the queued tasks, then joins the worker threads.
+	~MetaFFIWorkerPool()
+	{
+		{
+			std::lock_guard<std::mutex> guard(_lock);
+			_stopping = true;
+		}
+		_tasks_cv.notify_all();
+
+		for(std::thread& t : _threads)
+		{
+			t.join();
+		}
+	}
+
+	/**
+	 * @brief Queue a task. Tasks report their own errors - exceptions escaping a task are logged and dropped.
+	 * @throws std::runtime_error if the pool is shutting down.
+	 */
+	void submit(std::function<void()> task)
+	{
+		{
+			std::lock_guard<std::mutex> guard(_lock);
+			if(_stopping)
+			{
+				throw std::runtime_error("MetaFFIWorkerPool is shutting down");
+			}
+			_tasks.push_back(std::move(task));
+		}
+		_tasks_cv.notify_one();
+	}
+
+	/// @brief Number of worker threads.
+	[[nodiscard]] std::size_t threads_count() const
+	{
+		return _threads.size();
+	}
+
+	/**
+	 * @brief The pool of a runtime plugin, created on first use.
+	 * @param runtime_plugin Normalized runtime plugin name (e.g. "xllr.python3").
+	 */
+	static MetaFFIWorkerPool& of_runtime(const std::string& runtime_plugin)
+	{
+		pools_registry& reg = registry();
+		std::lock_guard<std::mutex> guard(reg.lock);
+
+		auto it = reg.pools.find(runtime_plugin);
+		if(it == reg.pools.end())
+		{
+			auto configured = reg.threads_counts.find(runtime_plugin);
+			std::size_t threads_count = configured != reg.threads_counts.end() ? configured->second : default_threads_count(runtime_plugin);
+			it = reg.pools.emplace(runtime_plugin, std::make_unique<MetaFFIWorkerPool>(threads_count)).first;
+		}
+
+		return *it->second;
+	}
+
+	/**
+	 * @brief Set the number of threads of a runtime plugin's pool. Call before the pool's first use.
+	 *
+	 * Defaults: 1 for Python runtimes (the GIL runs one call at a time), hardware concurrency otherwise.
+	 * @throws std::logic_error if the runtime's pool already exists.
+	 */
+	static void set_runtime_threads(const std::string& runtime_plugin, std::size_t threads_count)
+	{
+		pools_registry& reg = registry();
+		std::lock_guard<std::mutex> guard(reg.lock);
+
+		if(reg.pools.find(runtime_plugin) != reg.pools.end())
+		{
+			throw std::logic_error("worker pool of " + runtime_plugin + " is already running");
+		}
+
+		reg.threads_counts[runtime_plugin] = threads_count;
+	}
+
+private:
+	static void log_task_error(const char* error)
+	{
+		static auto* LOG = metaffi::get_logger("cpp.api");
+		METAFFI_ERROR(LOG, "Exception escaped a worker pool task (e.g. a call_async_then callback): {}", error);
+	}
+
+	struct pools_registry
+	{
+		std::mutex lock;
+		std::map<std::string, std::size_t> threads_counts;
+		std::map<std::string, std::unique_ptr<MetaFFIWorkerPool>> pools;
+	};
+
+	static pools_registry& registry()
+	{
+		static pools_registry instance;
+		return instance;
+	}
+
+	static std::size_t default_threads_count(const std::string& runtime_plugin)
+	{
+		if(runtime_plugin.rfind("xllr.python", 0) == 0)
+		{
+			return 1;
+		}
+
+		return (std::max)(std::thread::hardware_concurrency(), 1u);
+	}
+
+	void worker_loop()
+	{
+		while(true)
+		{
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> guard(_lock);
+				_tasks_cv.wait(guard, [this]() { return _stopping || !_tasks.empty(); });
+
+				if(_tasks.empty()) // stopping
+				{
+					return;
+				}
+
+				task = std::move(_tasks.front());
+				_tasks.pop_front();
+			}
+
+			// tasks report their errors through their future/callback - anything escaping is a bug in the task
+			try
+			{
+				task();
+			}
+			catch(const std::exception& e)
+			{
+				log_task_error(e.what());
+			}
+			catch(...)
+			{
+				log_task_error("unknown exception");
+			}
+		}
+	}
+
+	std::mutex _lock;
+	std::condition_variable _tasks_cv;
+	std::deque<std::function<void()>> _tasks;
+	std::vector<std::thread> _threads;
+	bool _stopping = false;
+};
+
+} // namespace metaffi::api
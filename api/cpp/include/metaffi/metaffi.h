@@ -25,6 +25,8 @@
 // These provide struct/class declarations and type definitions.
 // Our header adds inline implementations below.
 #include <metaffi/api/metaffi_api.h>
+#include <metaffi/api/metaffi_typed_entity.h>
+#include <metaffi/api/metaffi_warmup.h>
 // metaffi_api.h transitively includes:
 //   runtime/metaffi_primitives.h, runtime/cdt.h, runtime/xcall.h,
 //   runtime/xllr_capi_loader.h, utils/env_utils.h, utils/expand_env.h,
@@ -81,10 +83,16 @@ inline void cdts::set(metaffi_size index, cdt&& val) const
 {
 	arr[index].type = val.type;
 	arr[index].free_required = val.free_required;
+	arr[index].has_length = val.has_length;
+	arr[index].is_small_string = val.is_small_string;
+	arr[index].small_string_length = val.small_string_length;
 	arr[index].cdt_val = val.cdt_val;
 
 	val.type = metaffi_null_type;
 	val.free_required = 0;
+	val.has_length = 0;
+	val.is_small_string = 0;
+	val.small_string_length = 0;
 	std::memset(&val.cdt_val, 0, sizeof(val.cdt_val));
 }
 
@@ -117,6 +125,241 @@ inline cdts::~cdts()
 	free();
 }
 
+// --- cdts_arena (replaces cdts_arena.cpp) ---
+
+namespace metaffi::runtime
+{
+
+inline cdts_arena::cdts_arena() : first{nullptr, inline_storage, inline_block_size}, current(&first), current_used(0), nested_head(nullptr)
+{
+}
+
+inline cdts_arena::~cdts_arena()
+{
+	reset();
+
+	block* b = first.next;
+	while(b)
+	{
+		block* next = b->next;
+		xllr_free_memory(b);
+		b = next;
+	}
+	first.next = nullptr;
+}
+
+inline cdts_arena& cdts_arena::thread_local_instance()
+{
+	thread_local cdts_arena arena;
+	return arena;
+}
+
+inline cdts* cdts_arena::alloc_cdts(metaffi_size length, metaffi_int64 fixed_dimensions)
+{
+	auto* node = static_cast<nested_cdts*>(alloc(sizeof(nested_cdts), alignof(nested_cdts)));
+	node->prev = nested_head;
+	new (&node->value) cdts(alloc_cdt_array(length), length, fixed_dimensions, 1);
+	nested_head = node;
+
+	return &node->value;
+}
+
+inline void cdts_arena::rewind(const marker& m)
+{
+	while(nested_head != m.nested)
+	{
+		nested_head->value.free();
+		nested_head = nested_head->prev;
+	}
+
+	current = m.blk;
+	current_used = m.used;
+}
+
+inline void cdts_arena::reset()
+{
+	rewind(marker{&first, 0, nullptr});
+}
+
+inline size_t cdts_arena::heap_blocks_count() const
+{
+	size_t count = 0;
+	for(block* b = first.next; b; b = b->next)
+	{
+		count++;
+	}
+	return count;
+}
+
+inline void* cdts_arena::alloc_slow(size_t size, size_t alignment)
+{
+	size_t required = size + alignment;
+
+	if(!current->next || current->next->capacity < required)
+	{
+		size_t capacity = required > default_block_size ? required : default_block_size;
+		void* mem = xllr_alloc_memory(sizeof(block) + alignof(std::max_align_t) + capacity);
+		if(!mem)
+		{
+			throw std::bad_alloc();
+		}
+
+		auto* b = static_cast<block*>(mem);
+		uintptr_t data_start = reinterpret_cast<uintptr_t>(b + 1);
+		data_start = (data_start + alignof(std::max_align_t) - 1) & ~(uintptr_t)(alignof(std::max_align_t) - 1);
+
+		b->data = reinterpret_cast<unsigned char*>(data_start);
+		b->capacity = capacity;
+		b->next = current->next;
+		current->next = b;
+	}
+
+	current = current->next;
+	current_used = 0;
+
+	return alloc(size, alignment);
+}
+
+// --- cdts_cache (replaces cdts_cache.cpp) ---
+
+inline cdts_cache::cdts_cache() : slots(reinterpret_cast<cdt*>(slots_storage)), slots_used(0), frames_used(0)
+{
+}
+
+inline cdts_cache::~cdts_cache()
+{
+	for(auto& frame : frames)
+	{
+		frame[0].free();
+		frame[1].free();
+	}
+}
+
+inline cdts_cache& cdts_cache::thread_local_instance()
+{
+	thread_local cdts_cache cache;
+	return cache;
+}
+
+inline cdt* cdts_cache::acquire_cdt_array(metaffi_size length)
+{
+	if(length == 0 || length > cdt_cache_size - slots_used)
+	{
+		return nullptr;
+	}
+
+	cdt* arr = slots + slots_used;
+	for(metaffi_size i = 0; i < length; i++)
+	{
+		new (&arr[i]) cdt();
+	}
+
+	slots_used += length;
+	return arr;
+}
+
+inline void cdts_cache::release_cdt_array(cdt* arr)
+{
+	if(!is_cached(arr))
+	{
+		return;
+	}
+
+	slots_used = static_cast<metaffi_size>(arr - slots);
+}
+
+inline cdts* cdts_cache::acquire_frame()
+{
+	if(frames_used == cdts_cache_size)
+	{
+		return nullptr;
+	}
+
+	return frames[frames_used++];
+}
+
+inline void cdts_cache::release_frame(cdts* frame)
+{
+	if(!is_cached(frame))
+	{
+		return;
+	}
+
+	frames_used = static_cast<metaffi_size>((frame - &frames[0][0]) / 2);
+}
+
+inline cdts_frame::cdts_frame(metaffi_size params_count, metaffi_size retvals_count, bool cache_retvals)
+	: params_ret(nullptr), cached_params(nullptr), cached_retvals(nullptr), cached_frame(false)
+{
+	cdts_cache& cache = cdts_cache::thread_local_instance();
+
+	params_ret = cache.acquire_frame();
+	cached_frame = params_ret != nullptr;
+	if(!cached_frame)
+	{
+		params_ret = new cdts[2];
+	}
+
+	cached_params = cache.acquire_cdt_array(params_count);
+	if(cached_params)
+	{
+		params_ret[0] = cdts(cached_params, params_count, MIXED_OR_UNKNOWN_DIMENSIONS, 1);
+	}
+	else
+	{
+		params_ret[0] = cdts(params_count);
+	}
+
+	cached_retvals = cache_retvals ? cache.acquire_cdt_array(retvals_count) : nullptr;
+	if(cached_retvals)
+	{
+		params_ret[1] = cdts(cached_retvals, retvals_count, MIXED_OR_UNKNOWN_DIMENSIONS, 1);
+	}
+	else
+	{
+		params_ret[1] = cdts(retvals_count);
+	}
+}
+
+inline cdts_frame::~cdts_frame()
+{
+	params_ret[0].free();
+	params_ret[1].free();
+
+	cdts_cache& cache = cdts_cache::thread_local_instance();
+
+	if(cached_retvals)
+	{
+		cache.release_cdt_array(cached_retvals);
+	}
+
+	if(cached_params)
+	{
+		cache.release_cdt_array(cached_params);
+	}
+
+	if(cached_frame)
+	{
+		cache.release_frame(params_ret);
+	}
+	else
+	{
+		delete[] params_ret;
+	}
+}
+
+inline cdts cdts_frame::detach_retvals()
+{
+	if(cached_retvals)
+	{
+		throw std::logic_error("Cannot detach return values allocated on the thread cache");
+	}
+
+	return std::move(params_ret[1]);
+}
+
+} // namespace metaffi::runtime
+
 
 // ============================================================================
 // Section 1: Inline XLLR Loader
@@ -219,6 +462,7 @@ struct xllr_api
 	void (*p_xcall_no_params_ret)(struct xcall*, struct cdts[2], char**) = nullptr;
 	void (*p_xcall_params_no_ret)(struct xcall*, struct cdts[2], char**) = nullptr;
 	void (*p_xcall_no_params_no_ret)(struct xcall*, char**) = nullptr;
+	void (*p_xcall_batch)(struct xcall*, struct cdts*, metaffi_size, char**) = nullptr; // optional
 
 	// Entity loading
 	struct xcall* (*p_load_entity)(const char*, const char*, const char*,
@@ -352,6 +596,10 @@ struct xllr_api
 			std::string ignored_err;
 			p_load_callable = reinterpret_cast<decltype(p_load_callable)>(
 				platform_load_symbol(lib_handle, "load_callable", ignored_err));
+
+			// xcall_batch is optional - xllr_xcall_batch loops over the xcall if missing
+			p_xcall_batch = reinterpret_cast<decltype(p_xcall_batch)>(
+				platform_load_symbol(lib_handle, "xcall_batch", ignored_err));
 		});
 	}
 };
@@ -396,6 +644,33 @@ inline void xllr_xcall_no_params_no_ret(struct xcall* pxcall, char** out_err)
 	metaffi::detail::g_xllr.p_xcall_no_params_no_ret(pxcall, out_err);
 }
 
+inline void xllr_xcall_batch(struct xcall* pxcall, struct cdts* frames, metaffi_size count, char** out_err)
+{
+	metaffi::detail::g_xllr.ensure_loaded();
+	if(metaffi::detail::g_xllr.p_xcall_batch)
+	{
+		metaffi::detail::g_xllr.p_xcall_batch(pxcall, frames, count, out_err);
+		return;
+	}
+
+	for(metaffi_size i = 0; i < count; i++)
+	{
+		if(frames)
+		{
+			(*pxcall)(&frames[2 * i], out_err);
+		}
+		else
+		{
+			(*pxcall)(out_err);
+		}
+
+		if(*out_err)
+		{
+			return;
+		}
+	}
+}
+
 inline struct xcall* xllr_load_entity(const char* runtime_plugin,
                                       const char* module_path,
                                       const char* entity_path,
@@ -844,12 +1119,86 @@ namespace metaffi::utils
 // --- Constructor ---
 
 inline cdts_cpp_serializer::cdts_cpp_serializer(cdts& pcdts)
-	: data(pcdts), current_index(0)
+	: data(pcdts), current_index(0), arena(nullptr), borrow_packed_arrays(false), pack_tensors(false)
+{
+}
+
+inline cdts_cpp_serializer::cdts_cpp_serializer(cdts& pcdts, metaffi::runtime::cdts_arena* arena)
+	: data(pcdts), current_index(0), arena(arena), borrow_packed_arrays(false), pack_tensors(false)
 {
 }
 
 // --- Helper ---
 
+inline cdts& cdts_cpp_serializer::set_new_array_at(cdts& target, metaffi_size index, metaffi_size length, metaffi_int64 fixed_dimensions, metaffi_types common_type)
+{
+	if(arena)
+	{
+		target[index].set_array(arena->alloc_cdts(length, fixed_dimensions), common_type);
+		target[index].free_required = false;
+	}
+	else
+	{
+		target[index].set_new_array(length, fixed_dimensions, common_type);
+	}
+
+	return static_cast<cdts&>(target[index]);
+}
+
+inline cdt_packed_array* cdts_cpp_serializer::alloc_packed_array(metaffi_size length, size_t element_size, size_t element_alignment)
+{
+	if(arena)
+	{
+		return arena->alloc_packed_array(length, element_size, element_alignment);
+	}
+
+	cdt_packed_array* packed = static_cast<cdt_packed_array*>(xllr_alloc_memory(sizeof(cdt_packed_array)));
+	if(!packed)
+	{
+		throw std::runtime_error("Failed to allocate packed array");
+	}
+
+	packed->length = length;
+	packed->is_borrowed = 0;
+	packed->is_string_blob = 0;
+	packed->rank = 0;
+	packed->shape = nullptr;
+	packed->strides = nullptr;
+	packed->data = nullptr;
+	if(length > 0)
+	{
+		packed->data = xllr_alloc_memory(length * element_size);
+		if(!packed->data)
+		{
+			xllr_free_memory(packed);
+			throw std::runtime_error("Failed to allocate packed array buffer");
+		}
+	}
+
+	return packed;
+}
+
+inline void cdts_cpp_serializer::set_packed_array_at(metaffi_size index, cdt_packed_array* packed, metaffi_types element_type)
+{
+	data[index].set_packed_array(packed, element_type);
+	if(arena)
+	{
+		data[index].free_required = false;
+	}
+}
+
+inline void cdts_cpp_serializer::set_packed_shape_of(cdt_packed_array* packed, metaffi_size rank, const metaffi_size* shape, const metaffi_int64* strides)
+{
+	if(!arena)
+	{
+		metaffi::runtime::alloc_packed_shape(packed, rank, shape, strides);
+		return;
+	}
+
+	void* shape_buffer = rank > 1 ? arena->alloc(metaffi_packed_shape_size(rank, strides != nullptr), alignof(metaffi_size)) : nullptr;
+	metaffi::runtime::set_packed_shape(packed, shape_buffer, rank, shape, strides);
+}
+
 inline void cdts_cpp_serializer::check_bounds(metaffi_size index) const
 {
 	if(index >= data.length)
@@ -967,7 +1316,7 @@ inline cdts_cpp_serializer& cdts_cpp_serializer::operator<<(unsigned long long v
 inline cdts_cpp_serializer& cdts_cpp_serializer::operator<<(const std::string& val)
 {
 	check_bounds(current_index);
-	data[current_index].set_string((const char8_t*)val.c_str(), true);
+	set_string_at(current_index, reinterpret_cast<const char8_t*>(val.c_str()), val.length());
 	current_index++;
 	return *this;
 }
@@ -975,7 +1324,7 @@ inline cdts_cpp_serializer& cdts_cpp_serializer::operator<<(const std::string& v
 inline cdts_cpp_serializer& cdts_cpp_serializer::operator<<(const std::u16string& val)
 {
 	check_bounds(current_index);
-	data[current_index].set_string(val.c_str(), true);
+	set_string_at(current_index, val.c_str(), val.length());
 	current_index++;
 	return *this;
 }
@@ -983,7 +1332,7 @@ inline cdts_cpp_serializer& cdts_cpp_serializer::operator<<(const std::u16string
 inline cdts_cpp_serializer& cdts_cpp_serializer::operator<<(const std::u32string& val)
 {
 	check_bounds(current_index);
-	data[current_index].set_string(val.c_str(), true);
+	set_string_at(current_index, val.c_str(), val.length());
 	current_index++;
 	return *this;
 }
@@ -991,7 +1340,7 @@ inline cdts_cpp_serializer& cdts_cpp_serializer::operator<<(const std::u32string
 inline cdts_cpp_serializer& cdts_cpp_serializer::operator<<(const char* val)
 {
 	check_bounds(current_index);
-	data[current_index].set_string((const char8_t*)val, true);
+	set_string_at(current_index, reinterpret_cast<const char8_t*>(val), std::strlen(val));
 	current_index++;
 	return *this;
 }
@@ -1216,7 +1565,8 @@ inline cdts_cpp_serializer& cdts_cpp_serializer::operator>>(unsigned long long&
 inline cdts_cpp_serializer& cdts_cpp_serializer::operator>>(std::string& val)
 {
 	validate_type_at<std::string>(current_index);
-	val = std::string((const char*)data[current_index].cdt_val.string8_val);
+	std::u8string_view view = data[current_index].get_string8_view();
+	val.assign(reinterpret_cast<const char*>(view.data()), view.size());
 	current_index++;
 	return *this;
 }
@@ -1224,7 +1574,7 @@ inline cdts_cpp_serializer& cdts_cpp_serializer::operator>>(std::string& val)
 inline cdts_cpp_serializer& cdts_cpp_serializer::operator>>(std::u16string& val)
 {
 	validate_type_at<std::u16string>(current_index);
-	val = std::u16string(data[current_index].cdt_val.string16_val);
+	val = data[current_index].get_string16_view();
 	current_index++;
 	return *this;
 }
@@ -1232,7 +1582,42 @@ inline cdts_cpp_serializer& cdts_cpp_serializer::operator>>(std::u16string& val)
 inline cdts_cpp_serializer& cdts_cpp_serializer::operator>>(std::u32string& val)
 {
 	validate_type_at<std::u32string>(current_index);
-	val = std::u32string(data[current_index].cdt_val.string32_val);
+	val = data[current_index].get_string32_view();
+	current_index++;
+	return *this;
+}
+
+// String views
+
+inline cdts_cpp_serializer& cdts_cpp_serializer::operator>>(std::string_view& val)
+{
+	validate_type_at<std::string>(current_index);
+	std::u8string_view view = data[current_index].get_string8_view();
+	val = std::string_view(reinterpret_cast<const char*>(view.data()), view.size());
+	current_index++;
+	return *this;
+}
+
+inline cdts_cpp_serializer& cdts_cpp_serializer::operator>>(std::u8string_view& val)
+{
+	validate_type_at<std::string>(current_index);
+	val = data[current_index].get_string8_view();
+	current_index++;
+	return *this;
+}
+
+inline cdts_cpp_serializer& cdts_cpp_serializer::operator>>(std::u16string_view& val)
+{
+	validate_type_at<std::u16string>(current_index);
+	val = data[current_index].get_string16_view();
+	current_index++;
+	return *this;
+}
+
+inline cdts_cpp_serializer& cdts_cpp_serializer::operator>>(std::u32string_view& val)
+{
+	validate_type_at<std::u32string>(current_index);
+	val = data[current_index].get_string32_view();
 	current_index++;
 	return *this;
 }
@@ -1400,7 +1785,10 @@ inline cdts_cpp_serializer::cdts_any_variant cdts_cpp_serializer::extract_any()
 		case metaffi_string8_type:
 		{
 			cdt& source = data[current_index];
-			metaffi_string8 v = source.cdt_val.string8_val;
+			// the caller owns the returned string - inline small strings are copied out of the CDT
+			metaffi_string8 v = source.is_small_string ?
+				xllr_alloc_string8(source.cdt_val.small_string_val.string8, source.small_string_length) :
+				source.cdt_val.string8_val;
 			source.free_required = false;
 			current_index++;
 			return v;
@@ -1408,7 +1796,10 @@ inline cdts_cpp_serializer::cdts_any_variant cdts_cpp_serializer::extract_any()
 		case metaffi_string16_type:
 		{
 			cdt& source = data[current_index];
-			metaffi_string16 v = source.cdt_val.string16_val;
+			// the caller owns the returned string - inline small strings are copied out of the CDT
+			metaffi_string16 v = source.is_small_string ?
+				xllr_alloc_string16(source.cdt_val.small_string_val.string16, source.small_string_length) :
+				source.cdt_val.string16_val;
 			source.free_required = false;
 			current_index++;
 			return v;
@@ -1416,7 +1807,10 @@ inline cdts_cpp_serializer::cdts_any_variant cdts_cpp_serializer::extract_any()
 		case metaffi_string32_type:
 		{
 			cdt& source = data[current_index];
-			metaffi_string32 v = source.cdt_val.string32_val;
+			// the caller owns the returned string - inline small strings are copied out of the CDT
+			metaffi_string32 v = source.is_small_string ?
+				xllr_alloc_string32(source.cdt_val.small_string_val.string32, source.small_string_length) :
+				source.cdt_val.string32_val;
 			source.free_required = false;
 			current_index++;
 			return v;
@@ -1443,6 +1837,22 @@ inline cdts_cpp_serializer::cdts_any_variant cdts_cpp_serializer::extract_any()
 }
 
 inline metaffi_type cdts_cpp_serializer::peek_type() const  { check_bounds(current_index); return data[current_index].type; }
+inline std::vector<metaffi_size> cdts_cpp_serializer::peek_packed_shape() const
+{
+	check_bounds(current_index);
+	if(!metaffi_is_packed_array(data[current_index].type) || !data[current_index].cdt_val.packed_array_val)
+	{
+		throw std::runtime_error("peek_packed_shape: element is not a packed array");
+	}
+
+	const cdt_packed_array* packed = data[current_index].cdt_val.packed_array_val;
+	std::vector<metaffi_size> shape(metaffi::runtime::packed_rank(packed));
+	for(metaffi_size dim = 0; dim < shape.size(); dim++)
+	{
+		shape[dim] = metaffi::runtime::packed_extent(packed, dim);
+	}
+	return shape;
+}
 inline bool cdts_cpp_serializer::is_null() const            { check_bounds(current_index); return data[current_index].type == metaffi_null_type; }
 inline void cdts_cpp_serializer::reset()                    { current_index = 0; }
 inline metaffi_size cdts_cpp_serializer::get_index() const  { return current_index; }
@@ -1491,6 +1901,48 @@ inline void ensure_count_fits_int8(std::size_t count, const char* label)
 	}
 }
 
+inline void validate_entity_request(const std::string& entity_path,
+							 const std::vector<MetaFFITypeInfo>& params_types,
+							 const std::vector<MetaFFITypeInfo>& retvals_types)
+{
+	if(entity_path.empty())
+	{
+		throw std::invalid_argument("entity_path must not be empty");
+	}
+
+	// Validate entity path format early (fail-fast)
+	metaffi::utils::entity_path_parser parser(entity_path);
+	(void)parser;
+
+	ensure_count_fits_int8(params_types.size(), "params_types");
+	ensure_count_fits_int8(retvals_types.size(), "retvals_types");
+}
+
+// Key of an entity in MetaFFIModule's entities cache
+inline std::string entity_cache_key(const std::string& entity_path,
+							 const std::vector<MetaFFITypeInfo>& params_types,
+							 const std::vector<MetaFFITypeInfo>& retvals_types)
+{
+	std::string key = entity_path;
+	for(const std::vector<MetaFFITypeInfo>* types : {&params_types, &retvals_types})
+	{
+		key += '|';
+		for(const MetaFFITypeInfo& t : *types)
+		{
+			key += std::to_string(static_cast<unsigned long long>(t.type));
+			key += ':';
+			key += std::to_string(static_cast<long long>(t.fixed_dimensions));
+			if(t.alias)
+			{
+				key += ':';
+				key += t.alias;
+			}
+			key += ',';
+		}
+	}
+	return key;
+}
+
 inline void throw_if_err(char* err, const char* context)
 {
 	if(err == nullptr) return;
@@ -1634,7 +2086,8 @@ inline MetaFFIModule MetaFFIRuntime::load_module(std::string module_path) const
 
 inline MetaFFIModule::MetaFFIModule(std::string runtime_plugin, std::string module_path)
 	: _runtime_plugin(detail_api::normalize_runtime_plugin(std::move(runtime_plugin))),
-	  _module_path(std::move(module_path))
+	  _module_path(std::move(module_path)),
+	  _entities_cache(std::make_shared<entities_cache>())
 {
 }
 
@@ -1660,17 +2113,7 @@ inline MetaFFIEntity MetaFFIModule::load_entity_with_info(const std::string& ent
                                                           const std::vector<MetaFFITypeInfo>& params_types,
                                                           const std::vector<MetaFFITypeInfo>& retvals_types) const
 {
-	if(entity_path.empty())
-	{
-		throw std::invalid_argument("entity_path must not be empty");
-	}
-
-	// Validate entity path format early (fail-fast)
-	metaffi::utils::entity_path_parser parser(entity_path);
-	(void)parser;
-
-	detail_api::ensure_count_fits_int8(params_types.size(), "params_types");
-	detail_api::ensure_count_fits_int8(retvals_types.size(), "retvals_types");
+	detail_api::validate_entity_request(entity_path, params_types, retvals_types);
 
 	std::vector<MetaFFITypeInfo> params_copy = params_types;
 	std::vector<MetaFFITypeInfo> retvals_copy = retvals_types;
@@ -1696,6 +2139,61 @@ inline MetaFFIEntity MetaFFIModule::load_entity_with_info(const std::string& ent
 	return MetaFFIEntity(_runtime_plugin, pxcall, std::move(params_copy), std::move(retvals_copy));
 }
 
+inline MetaFFIEntity MetaFFIModule::load_entity_lazy(const std::string& entity_path,
+									const std::vector<MetaFFITypeInfo>& params_types,
+									const std::vector<MetaFFITypeInfo>& retvals_types) const
+{
+	detail_api::validate_entity_request(entity_path, params_types, retvals_types);
+
+	auto lazy = std::make_unique<MetaFFIEntity::lazy_load>();
+	lazy->module_path = _module_path;
+	lazy->entity_path = entity_path;
+	lazy->runtime_plugin = _runtime_plugin;
+
+	return MetaFFIEntity(_runtime_plugin, std::move(lazy), params_types, retvals_types);
+}
+
+inline std::shared_ptr<MetaFFIEntity> MetaFFIModule::get_entity(const std::string& entity_path,
+												const std::vector<MetaFFITypeInfo>& params_types,
+												const std::vector<MetaFFITypeInfo>& retvals_types) const
+{
+	const std::string key = detail_api::entity_cache_key(entity_path, params_types, retvals_types);
+
+	{
+		std::shared_lock<std::shared_mutex> guard(_entities_cache->lock);
+		auto it = _entities_cache->entities.find(key);
+		if(it != _entities_cache->entities.end())
+		{
+			return it->second;
+		}
+	}
+
+	// load outside the lock - loading calls into the runtime plugin
+	auto entity = std::make_shared<MetaFFIEntity>(_entities_cache->lazy_loading ?
+	                                              load_entity_lazy(entity_path, params_types, retvals_types) :
+	                                              load_entity_with_info(entity_path, params_types, retvals_types));
+
+	std::unique_lock<std::shared_mutex> guard(_entities_cache->lock);
+	// if another thread loaded the entity meanwhile, keep the cached one
+	return _entities_cache->entities.emplace(key, std::move(entity)).first->second;
+}
+
+inline void MetaFFIModule::set_lazy_loading(bool lazy)
+{
+	_entities_cache->lazy_loading = lazy;
+}
+
+inline bool MetaFFIModule::is_lazy_loading() const
+{
+	return _entities_cache->lazy_loading;
+}
+
+inline void MetaFFIModule::clear_entities_cache()
+{
+	std::unique_lock<std::shared_mutex> guard(_entities_cache->lock);
+	_entities_cache->entities.clear();
+}
+
 // --- MetaFFIEntity ---
 
 inline MetaFFIEntity::MetaFFIEntity(std::string runtime_plugin,
@@ -1724,6 +2222,62 @@ inline MetaFFIEntity::MetaFFIEntity(std::string runtime_plugin,
 	}
 }
 
+inline MetaFFIEntity::MetaFFIEntity(std::string runtime_plugin,
+				std::unique_ptr<lazy_load> lazy,
+				std::vector<MetaFFITypeInfo> params_types,
+				std::vector<MetaFFITypeInfo> retvals_types)
+	: _runtime_plugin(detail_api::normalize_runtime_plugin(std::move(runtime_plugin))),
+	  _pxcall(nullptr),
+	  _params_types(std::move(params_types)),
+	  _retvals_types(std::move(retvals_types)),
+	  _owns_xcall(false),
+	  _lazy(std::move(lazy))
+{
+}
+
+inline MetaFFIEntity::lazy_load::~lazy_load()
+{
+	if(pxcall != nullptr)
+	{
+		char* err = nullptr;
+		xllr_free_xcall(runtime_plugin.c_str(), pxcall, &err);
+		if(err)
+		{
+			std::cerr << "MetaFFI: Failed to free lazily loaded xcall: " << err << std::endl;
+			xllr_free_string(err);
+		}
+	}
+}
+
+inline xcall* MetaFFIEntity::load_lazy()
+{
+	// a failed load leaves the flag unset - the next call retries
+	std::call_once(_lazy->loaded, [this]()
+	{
+		char* err = nullptr;
+		xcall* pxcall = xllr_load_entity(
+			_runtime_plugin.c_str(),
+			_lazy->module_path.c_str(),
+			_lazy->entity_path.c_str(),
+			_params_types.empty() ? nullptr : _params_types.data(),
+			static_cast<int8_t>(_params_types.size()),
+			_retvals_types.empty() ? nullptr : _retvals_types.data(),
+			static_cast<int8_t>(_retvals_types.size()),
+			&err);
+
+		detail_api::throw_if_err(err, "Failed to load entity");
+
+		if(pxcall == nullptr)
+		{
+			throw std::runtime_error("xllr_load_entity returned null xcall");
+		}
+
+		_lazy->pxcall = pxcall;
+	});
+
+	return _lazy->pxcall;
+}
+
 inline MetaFFIEntity::MetaFFIEntity() noexcept
 	: _pxcall(nullptr), _owns_xcall(false)
 {
@@ -1734,7 +2288,10 @@ inline MetaFFIEntity::MetaFFIEntity(MetaFFIEntity&& other) noexcept
 	  _pxcall(other._pxcall),
 	  _params_types(std::move(other._params_types)),
 	  _retvals_types(std::move(other._retvals_types)),
-	  _owns_xcall(other._owns_xcall)
+	  _owns_xcall(other._owns_xcall),
+	  _use_call_arena(other._use_call_arena),
+	  _worker_pool(other._worker_pool),
+	  _lazy(std::move(other._lazy))
 {
 	other._pxcall = nullptr;
 	other._owns_xcall = false;
@@ -1760,6 +2317,9 @@ inline MetaFFIEntity& MetaFFIEntity::operator=(MetaFFIEntity&& other) noexcept
 		_params_types = std::move(other._params_types);
 		_retvals_types = std::move(other._retvals_types);
 		_owns_xcall = other._owns_xcall;
+		_use_call_arena = other._use_call_arena;
+		_worker_pool = other._worker_pool;
+		_lazy = std::move(other._lazy);
 		other._pxcall = nullptr;
 		other._owns_xcall = false;
 	}
@@ -1817,60 +2377,90 @@ inline void MetaFFIEntity::validate_retvals(const cdts& retvals) const
 
 inline cdts MetaFFIEntity::call_with_cdts(cdts&& params)
 {
-	if(_pxcall == nullptr)
+	const metaffi_size retvals_count = static_cast<metaffi_size>(_retvals_types.size());
+
+	std::array<cdts, 2> params_ret{};
+	params_ret[0] = std::move(params);
+	params_ret[1] = cdts(retvals_count);
+
+	invoke(params_ret.data());
+
+	if(retvals_count == 0)
+	{
+		return cdts();
+	}
+
+	return std::move(params_ret[1]);
+}
+
+inline void MetaFFIEntity::invoke(cdts* params_ret)
+{
+	xcall* pxcall = resolved_xcall();
+	if(pxcall == nullptr)
 	{
 		throw std::runtime_error("xcall is null");
 	}
 
-	const metaffi_size params_count = params.length;
+	const metaffi_size params_count = params_ret[0].length;
 	const metaffi_size retvals_count = static_cast<metaffi_size>(_retvals_types.size());
-	cdts retvals(retvals_count);
 
 	char* err = nullptr;
 
 	if(params_count == 0 && retvals_count == 0)
 	{
-		xllr_xcall_no_params_no_ret(_pxcall, &err);
+		xllr_xcall_no_params_no_ret(pxcall, &err);
 		detail_api::throw_if_err(err, "xcall invocation failed");
-		return cdts();
+		return;
 	}
 
 	if(params_count > 0 && retvals_count > 0)
 	{
-		std::array<cdts, 2> params_ret{};
-		params_ret[0] = std::move(params);
-		params_ret[1] = std::move(retvals);
+		xllr_xcall_params_ret(pxcall, params_ret, &err);
+	}
+	else if(params_count > 0)
+	{
+		xllr_xcall_params_no_ret(pxcall, params_ret, &err);
+	}
+	else
+	{
+		xllr_xcall_no_params_ret(pxcall, params_ret, &err);
+	}
 
-		xllr_xcall_params_ret(_pxcall, params_ret.data(), &err);
-		detail_api::throw_if_err(err, "xcall invocation failed");
+	detail_api::throw_if_err(err, "xcall invocation failed");
 
-		retvals = std::move(params_ret[1]);
-		validate_retvals(retvals);
-		return retvals;
+	if(retvals_count > 0)
+	{
+		validate_retvals(params_ret[1]);
 	}
+}
 
-	if(params_count > 0)
+inline void MetaFFIEntity::invoke_batch(cdts* frames, metaffi_size count)
+{
+	xcall* pxcall = resolved_xcall();
+	if(pxcall == nullptr)
 	{
-		std::array<cdts, 2> params_ret{};
-		params_ret[0] = std::move(params);
-		params_ret[1] = cdts(0);
+		throw std::runtime_error("xcall is null");
+	}
 
-		xllr_xcall_params_no_ret(_pxcall, params_ret.data(), &err);
-		detail_api::throw_if_err(err, "xcall invocation failed");
-		return cdts();
+	if(count == 0)
+	{
+		return;
 	}
 
-	// Only retvals
-	std::array<cdts, 2> params_ret{};
-	params_ret[0] = cdts(0);
-	params_ret[1] = std::move(retvals);
+	// entities without parameters and return values take no frames
+	const bool has_frames = !_params_types.empty() || !_retvals_types.empty();
 
-	xllr_xcall_no_params_ret(_pxcall, params_ret.data(), &err);
-	detail_api::throw_if_err(err, "xcall invocation failed");
+	char* err = nullptr;
+	xllr_xcall_batch(pxcall, has_frames ? frames : nullptr, count, &err);
+	detail_api::throw_if_err(err, "xcall batch invocation failed");
 
-	retvals = std::move(params_ret[1]);
-	validate_retvals(retvals);
-	return retvals;
+	if(!_retvals_types.empty())
+	{
+		for(metaffi_size i = 0; i < count; i++)
+		{
+			validate_retvals(frames[2 * i + 1]);
+		}
+	}
 }
 
 inline cdts MetaFFIEntity::call_raw(cdts&& params)
@@ -1880,17 +2470,119 @@ inline cdts MetaFFIEntity::call_raw(cdts&& params)
 	return call_with_cdts(std::move(params));
 }
 
+inline void MetaFFIEntity::call_in_frame(cdts params_ret[2])
+{
+	ensure_params_count(params_ret[0].length);
+	validate_params(params_ret[0]);
+	prepare_retvals(params_ret[1]);
+
+	invoke(params_ret);
+}
+
+inline void MetaFFIEntity::call_batch(cdts* frames, metaffi_size count)
+{
+	for(metaffi_size i = 0; i < count; i++)
+	{
+		ensure_params_count(frames[2 * i].length);
+		validate_params(frames[2 * i]);
+		prepare_retvals(frames[2 * i + 1]);
+	}
+
+	invoke_batch(frames, count);
+}
+
+inline void MetaFFIEntity::prepare_retvals(cdts& retvals) const
+{
+	const metaffi_size retvals_count = static_cast<metaffi_size>(_retvals_types.size());
+	if(retvals.length == retvals_count && (retvals_count == 0 || retvals.arr != nullptr))
+	{
+		// reuse the caller's return values buffer - only reset its elements
+		for(metaffi_size i = 0; i < retvals_count; i++)
+		{
+			retvals.arr[i].~cdt();
+			new (&retvals.arr[i]) cdt();
+		}
+	}
+	else
+	{
+		retvals.free();
+		retvals = cdts(retvals_count);
+	}
+}
+
+inline void MetaFFIEntity::use_call_arena(bool enable)
+{
+	_use_call_arena = enable;
+}
+
+inline bool MetaFFIEntity::is_using_call_arena() const
+{
+	return _use_call_arena;
+}
+
+inline void MetaFFIEntity::use_worker_pool(MetaFFIWorkerPool* pool)
+{
+	_worker_pool = pool;
+}
+
+// --- MetaFFICallFrame ---
+
+inline MetaFFICallFrame MetaFFIEntity::make_call_frame()
+{
+	return MetaFFICallFrame(*this);
+}
+
+inline MetaFFICallFrame::MetaFFICallFrame(MetaFFIEntity& entity)
+	: _entity(&entity),
+	  _params_ret{cdts(static_cast<metaffi_size>(entity._params_types.size())),
+	              cdts(static_cast<metaffi_size>(entity._retvals_types.size()))}
+{
+}
+
+inline void MetaFFICallFrame::invoke()
+{
+	_entity->validate_params(_params_ret[0]);
+	reset(_params_ret[1]);
+
+	_entity->invoke(_params_ret.data());
+}
+
+inline void MetaFFICallFrame::reset_params()
+{
+	reset(_params_ret[0]);
+}
+
+inline void MetaFFICallFrame::reset(cdts& values)
+{
+	// keep the buffer - reset the used elements (freeing the ones owning memory)
+	for(metaffi_size i = 0; i < values.length; i++)
+	{
+		if(values.arr[i].type == metaffi_null_type)
+		{
+			continue;
+		}
+
+		values.arr[i].~cdt();
+		new (&values.arr[i]) cdt();
+	}
+}
+
 // --- MetaFFICallable ---
 
 inline MetaFFICallable::MetaFFICallable(cdt_metaffi_callable* callable, std::string runtime_plugin)
 	: _callable(callable),
 	  _runtime_plugin(detail_api::normalize_runtime_plugin(std::move(runtime_plugin)))
 {
+	if(!is_null())
+	{
+		_entity = as_entity();
+	}
 }
 
 inline MetaFFICallable::MetaFFICallable(MetaFFICallable&& other) noexcept
 	: _callable(other._callable),
-	  _runtime_plugin(std::move(other._runtime_plugin))
+	  _runtime_plugin(std::move(other._runtime_plugin)),
+	  _entity(std::move(other._entity))
 {
 	other._callable = nullptr;
 }
@@ -1908,6 +2600,7 @@ inline MetaFFICallable& MetaFFICallable::operator=(MetaFFICallable&& other) noex
 
 		_callable = other._callable;
 		_runtime_plugin = std::move(other._runtime_plugin);
+		_entity = std::move(other._entity);
 		other._callable = nullptr;
 	}
 	return *this;
@@ -1931,9 +2624,18 @@ inline cdt_metaffi_callable* MetaFFICallable::release()
 {
 	cdt_metaffi_callable* released = _callable;
 	_callable = nullptr;
+	_entity = MetaFFIEntity();
 	return released;
 }
 
+inline void MetaFFICallable::ensure_not_null() const
+{
+	if(is_null())
+	{
+		throw std::invalid_argument("callable must not be null");
+	}
+}
+
 inline MetaFFIEntity MetaFFICallable::as_entity() const
 {
 	if(!_callable || !_callable->val)
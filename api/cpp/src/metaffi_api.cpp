@@ -37,6 +37,48 @@ void ensure_count_fits_int8(std::size_t count, const char* label)
 	}
 }
 
+void validate_entity_request(const std::string& entity_path,
+							 const std::vector<MetaFFITypeInfo>& params_types,
+							 const std::vector<MetaFFITypeInfo>& retvals_types)
+{
+	if(entity_path.empty())
+	{
+		throw std::invalid_argument("entity_path must not be empty");
+	}
+
+	// Validate entity path format early (fail-fast)
+	metaffi::utils::entity_path_parser parser(entity_path);
+	(void)parser;
+
+	ensure_count_fits_int8(params_types.size(), "params_types");
+	ensure_count_fits_int8(retvals_types.size(), "retvals_types");
+}
+
+// Key of an entity in MetaFFIModule's entities cache
+std::string entity_cache_key(const std::string& entity_path,
+							 const std::vector<MetaFFITypeInfo>& params_types,
+							 const std::vector<MetaFFITypeInfo>& retvals_types)
+{
+	std::string key = entity_path;
+	for(const std::vector<MetaFFITypeInfo>* types : {&params_types, &retvals_types})
+	{
+		key += '|';
+		for(const MetaFFITypeInfo& t : *types)
+		{
+			key += std::to_string(static_cast<unsigned long long>(t.type));
+			key += ':';
+			key += std::to_string(static_cast<long long>(t.fixed_dimensions));
+			if(t.alias)
+			{
+				key += ':';
+				key += t.alias;
+			}
+			key += ',';
+		}
+	}
+	return key;
+}
+
 void throw_if_err(char* err, const char* context)
 {
 	if(err == nullptr)
@@ -233,7 +275,8 @@ MetaFFIModule MetaFFIRuntime::load_module(std::string module_path) const
 
 MetaFFIModule::MetaFFIModule(std::string runtime_plugin, std::string module_path)
 	: _runtime_plugin(normalize_runtime_plugin(std::move(runtime_plugin))),
-	  _module_path(std::move(module_path))
+	  _module_path(std::move(module_path)),
+	  _entities_cache(std::make_shared<entities_cache>())
 {
 }
 
@@ -272,17 +315,7 @@ MetaFFIEntity MetaFFIModule::load_entity_with_info(const std::string& entity_pat
 									const std::vector<MetaFFITypeInfo>& params_types,
 									const std::vector<MetaFFITypeInfo>& retvals_types) const
 {
-	if(entity_path.empty())
-	{
-		throw std::invalid_argument("entity_path must not be empty");
-	}
-
-	// Validate entity path format early (fail-fast)
-	metaffi::utils::entity_path_parser parser(entity_path);
-	(void)parser;
-
-	ensure_count_fits_int8(params_types.size(), "params_types");
-	ensure_count_fits_int8(retvals_types.size(), "retvals_types");
+	validate_entity_request(entity_path, params_types, retvals_types);
 
 	std::vector<MetaFFITypeInfo> params_copy = params_types;
 	std::vector<MetaFFITypeInfo> retvals_copy = retvals_types;
@@ -308,6 +341,61 @@ MetaFFIEntity MetaFFIModule::load_entity_with_info(const std::string& entity_pat
 	return MetaFFIEntity(_runtime_plugin, pxcall, std::move(params_copy), std::move(retvals_copy));
 }
 
+MetaFFIEntity MetaFFIModule::load_entity_lazy(const std::string& entity_path,
+									const std::vector<MetaFFITypeInfo>& params_types,
+									const std::vector<MetaFFITypeInfo>& retvals_types) const
+{
+	validate_entity_request(entity_path, params_types, retvals_types);
+
+	auto lazy = std::make_unique<MetaFFIEntity::lazy_load>();
+	lazy->module_path = _module_path;
+	lazy->entity_path = entity_path;
+	lazy->runtime_plugin = _runtime_plugin;
+
+	return MetaFFIEntity(_runtime_plugin, std::move(lazy), params_types, retvals_types);
+}
+
+std::shared_ptr<MetaFFIEntity> MetaFFIModule::get_entity(const std::string& entity_path,
+												const std::vector<MetaFFITypeInfo>& params_types,
+												const std::vector<MetaFFITypeInfo>& retvals_types) const
+{
+	const std::string key = entity_cache_key(entity_path, params_types, retvals_types);
+
+	{
+		std::shared_lock<std::shared_mutex> guard(_entities_cache->lock);
+		auto it = _entities_cache->entities.find(key);
+		if(it != _entities_cache->entities.end())
+		{
+			return it->second;
+		}
+	}
+
+	// load outside the lock - loading calls into the runtime plugin
+	auto entity = std::make_shared<MetaFFIEntity>(_entities_cache->lazy_loading ?
+	                                              load_entity_lazy(entity_path, params_types, retvals_types) :
+	                                              load_entity_with_info(entity_path, params_types, retvals_types));
+
+	std::unique_lock<std::shared_mutex> guard(_entities_cache->lock);
+	// if another thread loaded the entity meanwhile, keep the cached one
+	return _entities_cache->entities.emplace(key, std::move(entity)).first->second;
+}
+
+void MetaFFIModule::set_lazy_loading(bool lazy)
+{
+	_entities_cache->lazy_loading = lazy;
+}
+
+bool MetaFFIModule::is_lazy_loading() const
+{
+	return _entities_cache->lazy_loading;
+}
+
+void MetaFFIModule::clear_entities_cache()
+{
+	std::unique_lock<std::shared_mutex> guard(_entities_cache->lock);
+	_entities_cache->entities.clear();
+}
+
 MetaFFIEntity::MetaFFIEntity(std::string runtime_plugin,
 				xcall* pxcall,
 				std::vector<MetaFFITypeInfo> params_types,
@@ -337,6 +425,62 @@ MetaFFIEntity::MetaFFIEntity(std::string runtime_plugin,
 	}
 }
 
+MetaFFIEntity::MetaFFIEntity(std::string runtime_plugin,
+				std::unique_ptr<lazy_load> lazy,
+				std::vector<MetaFFITypeInfo> params_types,
+				std::vector<MetaFFITypeInfo> retvals_types)
+	: _runtime_plugin(normalize_runtime_plugin(std::move(runtime_plugin))),
+	  _pxcall(nullptr),
+	  _params_types(std::move(params_types)),
+	  _retvals_types(std::move(retvals_types)),
+	  _owns_xcall(false),
+	  _lazy(std::move(lazy))
+{
+}
+
+MetaFFIEntity::lazy_load::~lazy_load()
+{
+	if(pxcall != nullptr)
+	{
+		char* err = nullptr;
+		xllr_free_xcall(runtime_plugin.c_str(), pxcall, &err);
+		if(err)
+		{
+			METAFFI_ERROR(LOG, "Failed to free lazily loaded xcall: {}", err);
+			xllr_free_string(err);
+		}
+	}
+}
+
+xcall* MetaFFIEntity::load_lazy()
+{
+	// a failed load leaves the flag unset - the next call retries
+	std::call_once(_lazy->loaded, [this]()
+	{
+		char* err = nullptr;
+		xcall* pxcall = xllr_load_entity(
+			_runtime_plugin.c_str(),
+			_lazy->module_path.c_str(),
+			_lazy->entity_path.c_str(),
+			_params_types.empty() ? nullptr : _params_types.data(),
+			static_cast<int8_t>(_params_types.size()),
+			_retvals_types.empty() ? nullptr : _retvals_types.data(),
+			static_cast<int8_t>(_retvals_types.size()),
+			&err);
+
+		throw_if_err(err, "Failed to load entity");
+
+		if(pxcall == nullptr)
+		{
+			throw std::runtime_error("xllr_load_entity returned null xcall");
+		}
+
+		_lazy->pxcall = pxcall;
+	});
+
+	return _lazy->pxcall;
+}
+
 MetaFFIEntity::MetaFFIEntity() noexcept
 	: _pxcall(nullptr)
 	, _owns_xcall(false)
@@ -348,7 +492,10 @@ MetaFFIEntity::MetaFFIEntity(MetaFFIEntity&& other) noexcept
 	  _pxcall(other._pxcall),
 	  _params_types(std::move(other._params_types)),
 	  _retvals_types(std::move(other._retvals_types)),
-	  _owns_xcall(other._owns_xcall)
+	  _owns_xcall(other._owns_xcall),
+	  _use_call_arena(other._use_call_arena),
+	  _worker_pool(other._worker_pool),
+	  _lazy(std::move(other._lazy))
 {
 	other._pxcall = nullptr;
 	other._owns_xcall = false;
@@ -374,6 +521,9 @@ MetaFFIEntity& MetaFFIEntity::operator=(MetaFFIEntity&& other) noexcept
 		_params_types = std::move(other._params_types);
 		_retvals_types = std::move(other._retvals_types);
 		_owns_xcall = other._owns_xcall;
+		_use_call_arena = other._use_call_arena;
+		_worker_pool = other._worker_pool;
+		_lazy = std::move(other._lazy);
 		other._pxcall = nullptr;
 		other._owns_xcall = false;
 	}
@@ -444,59 +594,90 @@ void MetaFFIEntity::validate_retvals(const cdts& retvals) const
 
 cdts MetaFFIEntity::call_with_cdts(cdts&& params)
 {
-	if(_pxcall == nullptr)
+	const metaffi_size retvals_count = static_cast<metaffi_size>(_retvals_types.size());
+
+	std::array<cdts, 2> params_ret{};
+	params_ret[0] = std::move(params);
+	params_ret[1] = cdts(retvals_count);
+
+	invoke(params_ret.data());
+
+	if(retvals_count == 0)
+	{
+		return cdts();
+	}
+
+	return std::move(params_ret[1]);
+}
+
+void MetaFFIEntity::invoke(cdts* params_ret)
+{
+	xcall* pxcall = resolved_xcall();
+	if(pxcall == nullptr)
 	{
 		throw std::runtime_error("xcall is null");
 	}
 
-	const metaffi_size params_count = params.length;
+	const metaffi_size params_count = params_ret[0].length;
 	const metaffi_size retvals_count = static_cast<metaffi_size>(_retvals_types.size());
-	cdts retvals(retvals_count);
 
 	char* err = nullptr;
 
 	if(params_count == 0 && retvals_count == 0)
 	{
-		xllr_xcall_no_params_no_ret(_pxcall, &err);
+		xllr_xcall_no_params_no_ret(pxcall, &err);
 		throw_if_err(err, "xcall invocation failed");
-		return cdts();
+		return;
 	}
 
 	if(params_count > 0 && retvals_count > 0)
 	{
-		std::array<cdts, 2> params_ret{};
-		params_ret[0] = std::move(params);
-		params_ret[1] = std::move(retvals);
+		xllr_xcall_params_ret(pxcall, params_ret, &err);
+	}
+	else if(params_count > 0)
+	{
+		xllr_xcall_params_no_ret(pxcall, params_ret, &err);
+	}
+	else
+	{
+		xllr_xcall_no_params_ret(pxcall, params_ret, &err);
+	}
 
-		xllr_xcall_params_ret(_pxcall, params_ret.data(), &err);
-		throw_if_err(err, "xcall invocation failed");
+	throw_if_err(err, "xcall invocation failed");
 
-		retvals = std::move(params_ret[1]);
-		validate_retvals(retvals);
-		return retvals;
+	if(retvals_count > 0)
+	{
+		validate_retvals(params_ret[1]);
 	}
+}
 
-	if(params_count > 0)
+void MetaFFIEntity::invoke_batch(cdts* frames, metaffi_size count)
+{
+	xcall* pxcall = resolved_xcall();
+	if(pxcall == nullptr)
 	{
-		std::array<cdts, 2> params_ret{};
-		params_ret[0] = std::move(params);
-		params_ret[1] = cdts(0);  // [1] = retvals slot (unused)
+		throw std::runtime_error("xcall is null");
+	}
 
-		xllr_xcall_params_no_ret(_pxcall, params_ret.data(), &err);
-		throw_if_err(err, "xcall invocation failed");
-		return cdts();
+	if(count == 0)
+	{
+		return;
 	}
 
-	std::array<cdts, 2> params_ret{};
-	params_ret[0] = cdts(0);  // [0] = params slot (empty)
-	params_ret[1] = std::move(retvals);
+	// entities without parameters and return values take no frames
+	const bool has_frames = !_params_types.empty() || !_retvals_types.empty();
 
-	xllr_xcall_no_params_ret(_pxcall, params_ret.data(), &err);
-	throw_if_err(err, "xcall invocation failed");
+	char* err = nullptr;
+	xllr_xcall_batch(pxcall, has_frames ? frames : nullptr, count, &err);
+	throw_if_err(err, "xcall batch invocation failed");
 
-	retvals = std::move(params_ret[1]);
-	validate_retvals(retvals);
-	return retvals;
+	if(!_retvals_types.empty())
+	{
+		for(metaffi_size i = 0; i < count; i++)
+		{
+			validate_retvals(frames[2 * i + 1]);
+		}
+	}
 }
 
 cdts MetaFFIEntity::call_raw(cdts&& params)
@@ -506,15 +687,115 @@ cdts MetaFFIEntity::call_raw(cdts&& params)
 	return call_with_cdts(std::move(params));
 }
 
+void MetaFFIEntity::call_in_frame(cdts params_ret[2])
+{
+	ensure_params_count(params_ret[0].length);
+	validate_params(params_ret[0]);
+	prepare_retvals(params_ret[1]);
+
+	invoke(params_ret);
+}
+
+void MetaFFIEntity::call_batch(cdts* frames, metaffi_size count)
+{
+	for(metaffi_size i = 0; i < count; i++)
+	{
+		ensure_params_count(frames[2 * i].length);
+		validate_params(frames[2 * i]);
+		prepare_retvals(frames[2 * i + 1]);
+	}
+
+	invoke_batch(frames, count);
+}
+
+void MetaFFIEntity::prepare_retvals(cdts& retvals) const
+{
+	const metaffi_size retvals_count = static_cast<metaffi_size>(_retvals_types.size());
+	if(retvals.length == retvals_count && (retvals_count == 0 || retvals.arr != nullptr))
+	{
+		// reuse the caller's return values buffer - only reset its elements
+		for(metaffi_size i = 0; i < retvals_count; i++)
+		{
+			retvals.arr[i].~cdt();
+			new (&retvals.arr[i]) cdt();
+		}
+	}
+	else
+	{
+		retvals.free();
+		retvals = cdts(retvals_count);
+	}
+}
+
+void MetaFFIEntity::use_call_arena(bool enable)
+{
+	_use_call_arena = enable;
+}
+
+bool MetaFFIEntity::is_using_call_arena() const
+{
+	return _use_call_arena;
+}
+
+void MetaFFIEntity::use_worker_pool(MetaFFIWorkerPool* pool)
+{
+	_worker_pool = pool;
+}
+
+MetaFFICallFrame MetaFFIEntity::make_call_frame()
+{
+	return MetaFFICallFrame(*this);
+}
+
+MetaFFICallFrame::MetaFFICallFrame(MetaFFIEntity& entity)
+	: _entity(&entity),
+	  _params_ret{cdts(static_cast<metaffi_size>(entity._params_types.size())),
+	              cdts(static_cast<metaffi_size>(entity._retvals_types.size()))}
+{
+}
+
+void MetaFFICallFrame::invoke()
+{
+	_entity->validate_params(_params_ret[0]);
+	reset(_params_ret[1]);
+
+	_entity->invoke(_params_ret.data());
+}
+
+void MetaFFICallFrame::reset_params()
+{
+	reset(_params_ret[0]);
+}
+
+void MetaFFICallFrame::reset(cdts& values)
+{
+	// keep the buffer - reset the used elements (freeing the ones owning memory)
+	for(metaffi_size i = 0; i < values.length; i++)
+	{
+		if(values.arr[i].type == metaffi_null_type)
+		{
+			continue;
+		}
+
+		values.arr[i].~cdt();
+		new (&values.arr[i]) cdt();
+	}
+}
+
 MetaFFICallable::MetaFFICallable(cdt_metaffi_callable* callable, std::string runtime_plugin)
 	: _callable(callable),
 	  _runtime_plugin(normalize_runtime_plugin(std::move(runtime_plugin)))
 {
+	if(!is_null())
+	{
+		_entity = as_entity();
+	}
 }
 
 MetaFFICallable::MetaFFICallable(MetaFFICallable&& other) noexcept
 	: _callable(other._callable),
-	  _runtime_plugin(std::move(other._runtime_plugin))
+	  _runtime_plugin(std::move(other._runtime_plugin)),
+	  _entity(std::move(other._entity))
 {
 	other._callable = nullptr;
 }
@@ -538,6 +819,7 @@ MetaFFICallable& MetaFFICallable::operator=(MetaFFICallable&& other) noexcept
 
 		_callable = other._callable;
 		_runtime_plugin = std::move(other._runtime_plugin);
+		_entity = std::move(other._entity);
 		other._callable = nullptr;
 	}
 	return *this;
@@ -574,9 +856,18 @@ cdt_metaffi_callable* MetaFFICallable::release()
 {
 	cdt_metaffi_callable* released = _callable;
 	_callable = nullptr;
+	_entity = MetaFFIEntity();
 	return released;
 }
 
+void MetaFFICallable::ensure_not_null() const
+{
+	if(is_null())
+	{
+		throw std::invalid_argument("callable must not be null");
+	}
+}
+
 MetaFFIEntity MetaFFICallable::as_entity() const
 {
 	if(!_callable || !_callable->val)
@@ -139,22 +139,18 @@ void metaffi_entity_call(metaffi_entity_h h, struct cdts params_ret[2], char** o
 	{
 		auto* entity = reinterpret_cast<MetaFFIEntity*>(h);
 
-		// Move the caller's params out of slot [0]
-		cdts params = std::move(params_ret[0]);
-
-		// Call entity (validates params count & types, dispatches to right xcall variant)
-		cdts retvals = entity->call_raw(std::move(params));
-
-		// Free any pre-existing content in slot [1] (e.g. from xllr_alloc_cdts_buffer)
-		params_ret[1].free();
-
-		// Move results into slot [1] for the caller to read
-		params_ret[1] = std::move(retvals);
+		// Call entity in place (validates params count & types, dispatches to right xcall variant).
+		// Slot [1] is reused if it already has room for the results (e.g. from xllr_alloc_cdts_buffer),
+		// so no frame is allocated per call.
+		entity->call_in_frame(params_ret);
 	}
 	catch(const std::exception& e)
 	{
 		if(out_err) *out_err = capture_err(e);
 	}
+
+	// The caller's params in slot [0] are consumed
+	params_ret[0].free();
 }
 
 void metaffi_entity_free(metaffi_entity_h h, char** /*out_err*/)
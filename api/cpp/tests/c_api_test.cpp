@@ -47,7 +47,7 @@ static void c_adder_fn(void* /*ctx*/, cdts* d, char** /*err*/)
 
 static void c_echo_string_fn(void* /*ctx*/, cdts* d, char** /*err*/)
 {
-	metaffi_string8 s = d[0].arr[0].cdt_val.string8_val;
+	metaffi_string8 s = metaffi_cdt_string8(&d[0].arr[0]);
 	d[1].arr[0].set_string(s, /*is_copy=*/false);
 }
 
@@ -339,8 +339,8 @@ TEST_SUITE("C Suite 2 - Return primitives")
 		char* err = nullptr;
 		metaffi_entity_call(e, pr, &err);
 		CHECK_NO_ERR(err);
-		REQUIRE(pr[1].arr[0].cdt_val.string8_val != nullptr);
-		CHECK(std::string(reinterpret_cast<const char*>(pr[1].arr[0].cdt_val.string8_val))
+		REQUIRE(metaffi_cdt_string8(&pr[1].arr[0]) != nullptr);
+		CHECK(std::string(reinterpret_cast<const char*>(metaffi_cdt_string8(&pr[1].arr[0])))
 		      == "Hello from test plugin");
 		metaffi_entity_free(e, nullptr);
 	}
@@ -505,7 +505,7 @@ TEST_SUITE("C Suite 4 - Echo")
 		char* err = nullptr;
 		metaffi_entity_call(e, pr, &err);
 		CHECK_NO_ERR(err);
-		CHECK(std::string(reinterpret_cast<const char*>(pr[1].arr[0].cdt_val.string8_val)) == "hello");
+		CHECK(std::string(reinterpret_cast<const char*>(metaffi_cdt_string8(&pr[1].arr[0]))) == "hello");
 		metaffi_entity_free(e, nullptr);
 	}
 
@@ -571,7 +571,7 @@ TEST_SUITE("C Suite 5 - Arithmetic")
 		char* err = nullptr;
 		metaffi_entity_call(e, pr, &err);
 		CHECK_NO_ERR(err);
-		CHECK(std::string(reinterpret_cast<const char*>(pr[1].arr[0].cdt_val.string8_val)) == "helloworld");
+		CHECK(std::string(reinterpret_cast<const char*>(metaffi_cdt_string8(&pr[1].arr[0]))) == "helloworld");
 		metaffi_entity_free(e, nullptr);
 	}
 }
@@ -648,7 +648,7 @@ TEST_SUITE("C Suite 6 - Arrays")
 		char* err = nullptr;
 		metaffi_entity_call(e, pr, &err);
 		CHECK_NO_ERR(err);
-		CHECK(std::string(reinterpret_cast<const char*>(pr[1].arr[0].cdt_val.string8_val))
+		CHECK(std::string(reinterpret_cast<const char*>(metaffi_cdt_string8(&pr[1].arr[0])))
 		      == "one, two, three");
 		metaffi_entity_free(e, nullptr);
 	}
@@ -689,7 +689,7 @@ TEST_SUITE("C Suite 7 - Handles")
 			pr[0].arr[0].set_handle(&handle);
 			metaffi_entity_call(get_e, pr, &err);
 			CHECK_NO_ERR(err);
-			CHECK(std::string(reinterpret_cast<const char*>(pr[1].arr[0].cdt_val.string8_val))
+			CHECK(std::string(reinterpret_cast<const char*>(metaffi_cdt_string8(&pr[1].arr[0])))
 			      == "test_data");
 		}
 
@@ -708,7 +708,7 @@ TEST_SUITE("C Suite 7 - Handles")
 			pr[0].arr[0].set_handle(&handle);
 			metaffi_entity_call(get_e, pr, &err);
 			CHECK_NO_ERR(err);
-			CHECK(std::string(reinterpret_cast<const char*>(pr[1].arr[0].cdt_val.string8_val))
+			CHECK(std::string(reinterpret_cast<const char*>(metaffi_cdt_string8(&pr[1].arr[0])))
 			      == "new_data");
 		}
 
@@ -796,7 +796,7 @@ TEST_SUITE("C Suite 8 - Callables")
 		char* err = nullptr;
 		metaffi_entity_call(e, pr, &err);
 		CHECK_NO_ERR(err);
-		CHECK(std::string(reinterpret_cast<const char*>(pr[1].arr[0].cdt_val.string8_val)) == "test");
+		CHECK(std::string(reinterpret_cast<const char*>(metaffi_cdt_string8(&pr[1].arr[0]))) == "test");
 		metaffi_entity_free(e, nullptr);
 	}
 
@@ -924,7 +924,7 @@ TEST_SUITE("C Suite 11 - Multiple returns")
 		CHECK_NO_ERR(err);
 		REQUIRE(pr[1].length == 2);
 		CHECK(pr[1].arr[0].cdt_val.int64_val == 42);
-		CHECK(std::string(reinterpret_cast<const char*>(pr[1].arr[1].cdt_val.string8_val)) == "answer");
+		CHECK(std::string(reinterpret_cast<const char*>(metaffi_cdt_string8(&pr[1].arr[1]))) == "answer");
 		metaffi_entity_free(e, nullptr);
 	}
 
@@ -959,7 +959,7 @@ TEST_SUITE("C Suite 11 - Multiple returns")
 		metaffi_entity_call(e, pr, &err);
 		CHECK_NO_ERR(err);
 		REQUIRE(pr[1].length == 2);
-		CHECK(std::string(reinterpret_cast<const char*>(pr[1].arr[0].cdt_val.string8_val)) == "hello");
+		CHECK(std::string(reinterpret_cast<const char*>(metaffi_cdt_string8(&pr[1].arr[0]))) == "hello");
 		CHECK(pr[1].arr[1].cdt_val.int64_val == 42);
 		metaffi_entity_free(e, nullptr);
 	}
@@ -983,7 +983,7 @@ TEST_SUITE("C Suite 12 - Globals")
 		cdts pr_get[2] = {cdts(), cdts()};
 		metaffi_entity_call(get_e, pr_get, &err);
 		CHECK_NO_ERR(err);
-		std::string orig(reinterpret_cast<const char*>(pr_get[1].arr[0].cdt_val.string8_val));
+		std::string orig(reinterpret_cast<const char*>(metaffi_cdt_string8(&pr_get[1].arr[0])));
 
 		// Set new value
 		{
@@ -998,7 +998,7 @@ TEST_SUITE("C Suite 12 - Globals")
 			cdts pr_v[2] = {cdts(), cdts()};
 			metaffi_entity_call(get_e, pr_v, &err);
 			CHECK_NO_ERR(err);
-			CHECK(std::string(reinterpret_cast<const char*>(pr_v[1].arr[0].cdt_val.string8_val))
+			CHECK(std::string(reinterpret_cast<const char*>(metaffi_cdt_string8(&pr_v[1].arr[0])))
 			      == "c_api_test_value");
 		}
 
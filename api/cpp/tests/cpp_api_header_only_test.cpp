@@ -0,0 +1,65 @@
+/**
+ * cpp_api_header_only_test.cpp — builds the C++ API from <metaffi/metaffi.h> alone
+ *
+ * Compiled without metaffi_api.cpp, so everything the header-only API uses
+ * (including the worker pool behind call_async) must be defined inline.
+ *
+ * Runtime: "test" (normalised to "xllr.test")
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT
+#define DOCTEST_CONFIG_NO_WINDOWS_SEH
+#include <doctest/doctest.h>
+
+#include <metaffi/metaffi.h>
+
+#include <future>
+#include <tuple>
+
+using namespace metaffi::api;
+
+static MetaFFIRuntime* g_runtime = nullptr;
+static MetaFFIModule*  g_module  = nullptr;
+
+int main(int argc, char** argv)
+{
+	g_runtime = new MetaFFIRuntime("test");
+	g_runtime->load_runtime_plugin();
+
+	auto m   = g_runtime->load_module("");
+	g_module = new MetaFFIModule(std::move(m));
+
+	doctest::Context ctx(argc, argv);
+	int res = ctx.run();
+
+	delete g_module;
+	g_module = nullptr;
+
+	g_runtime->release_runtime_plugin();
+	delete g_runtime;
+	g_runtime = nullptr;
+
+	return res;
+}
+
+TEST_SUITE("Header-only API")
+{
+	TEST_CASE("add_int64 async")
+	{
+		auto e = g_module->load_entity("test::add_int64",
+		                               {metaffi_int64_type, metaffi_int64_type},
+		                               {metaffi_int64_type});
+
+		auto [v] = e.call_async<metaffi_int64>(metaffi_int64(3), metaffi_int64(4)).get();
+		CHECK(v == 7);
+
+		std::promise<metaffi_int64> completed;
+		e.call_async_then<metaffi_int64>(
+			[&completed](std::tuple<metaffi_int64>&& values, std::exception_ptr error)
+			{
+				completed.set_value(error ? -1 : std::get<0>(values));
+			},
+			metaffi_int64(5), metaffi_int64(6));
+		CHECK(completed.get_future().get() == 11);
+	}
+}
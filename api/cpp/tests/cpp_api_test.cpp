@@ -14,14 +14,21 @@
 #include <doctest/doctest.h>
 
 #include <metaffi/api/metaffi_api.h>
+#include <metaffi/api/metaffi_typed_entity.h>
+#include <metaffi/api/metaffi_warmup.h>
 #include <cdts_serializer/cpp/cdts_cpp_serializer.h>
 #include <runtime/xllr_capi_loader.h>
 #include <runtime/xcall.h>
 
+#include <array>
 #include <cmath>
 #include <cstring>
+#include <future>
 #include <limits>
+#include <span>
 #include <string>
+#include <thread>
+#include <tuple>
 #include <vector>
 
 using namespace metaffi::api;
@@ -34,6 +41,39 @@ using namespace metaffi::utils;
 static MetaFFIRuntime* g_runtime = nullptr;
 static MetaFFIModule*  g_module  = nullptr;
 
+// ---------------------------------------------------------------------------
+// xllr_alloc_memory hook - counts the allocations made through xllr by this process
+// (used to verify allocation-free call paths)
+// ---------------------------------------------------------------------------
+
+extern "C" void* (*pxllr_alloc_memory)(uint64_t);
+static void* (*s_xllr_alloc_memory)(uint64_t) = nullptr;
+static size_t s_xllr_allocations = 0;
+
+static void* counting_xllr_alloc_memory(uint64_t size)
+{
+	s_xllr_allocations++;
+	return s_xllr_alloc_memory(size);
+}
+
+/** Count xllr allocations from construction to destruction. */
+struct xllr_allocations_counter
+{
+	xllr_allocations_counter()
+	{
+		s_xllr_allocations = 0;
+		s_xllr_alloc_memory = pxllr_alloc_memory;
+		pxllr_alloc_memory = &counting_xllr_alloc_memory;
+	}
+
+	~xllr_allocations_counter()
+	{
+		pxllr_alloc_memory = s_xllr_alloc_memory;
+	}
+
+	[[nodiscard]] size_t count() const { return s_xllr_allocations; }
+};
+
 // ---------------------------------------------------------------------------
 // Callable helpers (static lifetime — alive for the full test process)
 // ---------------------------------------------------------------------------
@@ -50,7 +90,7 @@ static void cpp_adder_fn(void* /*ctx*/, cdts* d, char** /*err*/)
 static void cpp_echo_string_fn(void* /*ctx*/, cdts* d, char** /*err*/)
 {
 	// Borrow the input pointer — the plugin reads the return immediately.
-	metaffi_string8 s = d[0].arr[0].cdt_val.string8_val;
+	metaffi_string8 s = metaffi_cdt_string8(&d[0].arr[0]);
 	d[1].arr[0].set_string(s, /*is_copy=*/false);
 }
 
@@ -365,6 +405,234 @@ TEST_SUITE("Suite 5 - Arithmetic")
 		auto [v] = e.call<std::string>(std::string("hello"), std::string("world"));
 		CHECK(v == "helloworld");
 	}
+
+	TEST_CASE("add_int64 batch")
+	{
+		auto e = g_module->load_entity("test::add_int64",
+		                               {metaffi_int64_type, metaffi_int64_type},
+		                               {metaffi_int64_type});
+
+		std::vector<std::tuple<metaffi_int64, metaffi_int64>> args;
+		for(metaffi_int64 i = 0; i < 100; i++)
+		{
+			args.emplace_back(i, i * 2);
+		}
+
+		auto results = e.call_batch<metaffi_int64>(args);
+		REQUIRE(results.size() == args.size());
+		for(std::size_t i = 0; i < results.size(); i++)
+		{
+			CHECK(std::get<0>(results[i]) == static_cast<metaffi_int64>(i * 3));
+		}
+
+		CHECK(e.call_batch<metaffi_int64>(std::vector<std::tuple<metaffi_int64, metaffi_int64>>{}).empty());
+	}
+
+	TEST_CASE("add_int64 batch in frames")
+	{
+		auto e = g_module->load_entity("test::add_int64",
+		                               {metaffi_int64_type, metaffi_int64_type},
+		                               {metaffi_int64_type});
+
+		// two calls: parameters/return values pairs
+		cdts frames[4];
+		for(int i = 0; i < 2; i++)
+		{
+			frames[2 * i] = cdts(2);
+			frames[2 * i].arr[0] = metaffi_int64(i + 1);
+			frames[2 * i].arr[1] = metaffi_int64(10);
+		}
+
+		e.call_batch(frames, 2);
+		CHECK(frames[1].arr[0].cdt_val.int64_val == 11);
+		CHECK(frames[3].arr[0].cdt_val.int64_val == 12);
+	}
+
+	TEST_CASE("add_int64 in a reusable call frame")
+	{
+		auto e = g_module->load_entity("test::add_int64",
+		                               {metaffi_int64_type, metaffi_int64_type},
+		                               {metaffi_int64_type});
+		MetaFFICallFrame frame = e.make_call_frame();
+		auto [first] = frame.call<metaffi_int64>(metaffi_int64(1), metaffi_int64(2));
+		CHECK(first == 3);
+
+		cdt* params_buffer = frame.params().arr;
+		metaffi_int64 sum = 0;
+		{
+			// steady state - no allocations per call
+			xllr_allocations_counter counter;
+			for(metaffi_int64 i = 0; i < 1000; i++)
+			{
+				auto [v] = frame.call<metaffi_int64>(i, metaffi_int64(1));
+				sum += v;
+			}
+			CHECK(counter.count() == 0);
+		}
+		CHECK(sum == 500500);
+		CHECK(frame.params().arr == params_buffer);
+
+		// populate the parameters in place
+		frame.reset_params();
+		frame.params().arr[0] = metaffi_int64(40);
+		frame.params().arr[1] = metaffi_int64(2);
+		frame.invoke();
+		CHECK(frame.retvals().arr[0].cdt_val.int64_val == 42);
+	}
+
+	TEST_CASE("concat_strings in a reusable call frame")
+	{
+		auto e = g_module->load_entity("test::concat_strings",
+		                               {metaffi_string8_type, metaffi_string8_type},
+		                               {metaffi_string8_type});
+		MetaFFICallFrame frame = e.make_call_frame();
+		for(int i = 0; i < 3; i++)
+		{
+			auto [v] = frame.call<std::string>(std::string("a string longer than the inline capacity "), std::to_string(i));
+			CHECK(v == "a string longer than the inline capacity " + std::to_string(i));
+		}
+	}
+
+	TEST_CASE("add_int64 from the entities cache")
+	{
+		auto first = g_module->get_entity("test::add_int64",
+		                                  {metaffi_int64_type, metaffi_int64_type},
+		                                  {metaffi_int64_type});
+
+		std::vector<std::shared_ptr<MetaFFIEntity>> entities(4);
+		std::vector<std::thread> threads;
+		for(std::size_t t = 0; t < entities.size(); t++)
+		{
+			threads.emplace_back([&entities, t]()
+			{
+				entities[t] = g_module->get_entity("test::add_int64",
+				                                   {metaffi_int64_type, metaffi_int64_type},
+				                                   {metaffi_int64_type});
+			});
+		}
+
+		for(std::thread& th : threads)
+		{
+			th.join();
+		}
+
+		for(const auto& e : entities)
+		{
+			CHECK(e == first);
+		}
+
+		auto [v] = first->call<metaffi_int64>(metaffi_int64(10), metaffi_int64(20));
+		CHECK(v == 30);
+
+		// different types - a different entity
+		auto float_add = g_module->get_entity("test::add_float64",
+		                                      {metaffi_float64_type, metaffi_float64_type},
+		                                      {metaffi_float64_type});
+		CHECK(float_add != first);
+	}
+
+	TEST_CASE("add_int64 lazily loaded")
+	{
+		auto e = g_module->load_entity_lazy("test::add_int64",
+		                                    {metaffi_int64_type, metaffi_int64_type},
+		                                    {metaffi_int64_type});
+		auto [v] = e.call<metaffi_int64>(metaffi_int64(1), metaffi_int64(2));
+		CHECK(v == 3);
+
+		MetaFFIModule lazy_module(g_module->runtime_plugin(), g_module->module_path());
+		lazy_module.set_lazy_loading(true);
+		auto cached = lazy_module.get_entity("test::add_int64",
+		                                     {metaffi_int64_type, metaffi_int64_type},
+		                                     {metaffi_int64_type});
+		auto [w] = cached->call<metaffi_int64>(metaffi_int64(5), metaffi_int64(6));
+		CHECK(w == 11);
+	}
+
+	TEST_CASE("add_int64 and add_float64 warmed up")
+	{
+		MetaFFIWarmup warmup;
+		warmup.set_entity_threads(2);
+		size_t add_int = warmup.add(g_module->runtime_plugin(), g_module->module_path(), "test::add_int64",
+		                            {ti(metaffi_int64_type), ti(metaffi_int64_type)}, {ti(metaffi_int64_type)});
+		size_t add_float = warmup.add(g_module->runtime_plugin(), g_module->module_path(), "test::add_float64",
+		                              {ti(metaffi_float64_type), ti(metaffi_float64_type)}, {ti(metaffi_float64_type)});
+
+		MetaFFIWarmupReport report = warmup.run();
+		REQUIRE(report.entities_count() == 2);
+		REQUIRE(report.runtimes().size() == 1);
+		CHECK(report.runtimes()[0].runtime_plugin == g_module->runtime_plugin());
+		CHECK(report.runtimes()[0].entities_count == 2);
+		CHECK(report.total() >= report.runtimes()[0].load_runtime + report.runtimes()[0].load_entities);
+
+		auto [i] = report.entity(add_int).call<metaffi_int64>(metaffi_int64(3), metaffi_int64(4));
+		CHECK(i == 7);
+
+		std::unique_ptr<MetaFFIEntity> float_add = report.take_entity(add_float);
+		auto [f] = float_add->call<metaffi_float64>(metaffi_float64(1.5), metaffi_float64(2.5));
+		CHECK(std::fabs(f - 4.0) < 1e-10);
+		CHECK_THROWS_AS(report.take_entity(add_float), std::out_of_range);
+
+		MetaFFIWarmup failing;
+		failing.add(g_module->runtime_plugin(), g_module->module_path(), "test::no_such_entity");
+		CHECK_THROWS_AS((void)failing.run(), std::runtime_error);
+	}
+
+	TEST_CASE("add_int64 typed")
+	{
+		TypedEntity<metaffi_int64(metaffi_int64, metaffi_int64)> add_int64(*g_module, "test::add_int64");
+		CHECK(add_int64(10, 20) == 30);
+		CHECK(add_int64.call(-5, 5) == 0);
+	}
+
+	TEST_CASE("concat_strings typed")
+	{
+		TypedEntity<std::string(std::string, std::string)> concat(*g_module, "test::concat_strings");
+		CHECK(concat("hello", "world") == "helloworld");
+	}
+
+	TEST_CASE("typed entity rejects a mismatching signature")
+	{
+		auto e = g_module->load_entity("test::add_float64",
+		                               {metaffi_float64_type, metaffi_float64_type},
+		                               {metaffi_float64_type});
+		using add_int64_t = TypedEntity<metaffi_int64(metaffi_int64, metaffi_int64)>;
+		CHECK_THROWS_AS(add_int64_t(std::move(e)), std::invalid_argument);
+	}
+
+	TEST_CASE("typed entity rejects a null scalar return value")
+	{
+		auto e = g_module->load_entity("test::return_null", {}, {metaffi_any_type});
+		TypedEntity<metaffi_int64()> return_null(std::move(e));
+		CHECK_THROWS_AS(return_null(), std::runtime_error);
+	}
+
+	TEST_CASE("add_int64 async")
+	{
+		auto e = g_module->load_entity("test::add_int64",
+		                               {metaffi_int64_type, metaffi_int64_type},
+		                               {metaffi_int64_type});
+
+		std::vector<std::future<std::tuple<metaffi_int64>>> results;
+		for(metaffi_int64 i = 0; i < 10; i++)
+		{
+			results.push_back(e.call_async<metaffi_int64>(i, metaffi_int64(100)));
+		}
+
+		for(std::size_t i = 0; i < results.size(); i++)
+		{
+			auto [v] = results[i].get();
+			CHECK(v == static_cast<metaffi_int64>(i + 100));
+		}
+
+		std::promise<metaffi_int64> completed;
+		e.call_async_then<metaffi_int64>(
+			[&completed](std::tuple<metaffi_int64>&& values, std::exception_ptr error)
+			{
+				completed.set_value(error ? -1 : std::get<0>(values));
+			},
+			metaffi_int64(3), metaffi_int64(4));
+		CHECK(completed.get_future().get() == 7);
+	}
 }
 
 // ===========================================================================
@@ -473,6 +741,34 @@ TEST_SUITE("Suite 6 - Arrays")
 		CHECK(v == 15);
 	}
 
+	TEST_CASE("sum_int64_array in a call frame does not keep borrowed arguments")
+	{
+		auto e = g_module->load_entity_with_info("test::sum_int64_array",
+		                                          {ti_arr(metaffi_int64_array_type, 1)},
+		                                          {ti(metaffi_int64_type)});
+		MetaFFICallFrame frame = e.make_call_frame();
+		auto [v] = frame.call<metaffi_int64>(std::vector<metaffi_int64>{1, 2, 3, 4, 5});
+		CHECK(v == 15);
+
+		// the vector is gone - params() must not point into it
+		CHECK(frame.params().arr[0].type == metaffi_null_type);
+		CHECK_THROWS_AS(frame.invoke(), std::invalid_argument);
+	}
+
+	TEST_CASE("sum_int64_array from std::array and std::span")
+	{
+		auto e = g_module->load_entity_with_info("test::sum_int64_array",
+		                                          {ti_arr(metaffi_int64_array_type, 1)},
+		                                          {ti(metaffi_int64_type)});
+
+		std::array<metaffi_int64, 5> input{1, 2, 3, 4, 5};
+		auto [v] = e.call<metaffi_int64>(input);
+		CHECK(v == 15);
+
+		auto [w] = e.call<metaffi_int64>(std::span<const metaffi_int64>(input.data(), 3));
+		CHECK(w == 6);
+	}
+
 	TEST_CASE("echo_int64_array")
 	{
 		// echo([10,20,30]) → [10,20,30]
@@ -658,6 +954,39 @@ TEST_SUITE("Suite 8 - Callables")
 		CHECK(result == 7);
 	}
 
+	TEST_CASE("MetaFFICallable — concurrent calls")
+	{
+		MetaFFICallable adder(make_callable(&s_adder_xcall, 2, 1), "test");
+
+		std::vector<std::thread> threads;
+		std::vector<metaffi_int64> sums(4, 0);
+		for(std::size_t t = 0; t < sums.size(); t++)
+		{
+			threads.emplace_back([&adder, &sums, t]()
+			{
+				for(metaffi_int64 i = 0; i < 1000; i++)
+				{
+					auto [v] = adder.call<metaffi_int64>(i, static_cast<metaffi_int64>(t));
+					sums[t] += v;
+				}
+			});
+		}
+
+		for(std::thread& th : threads)
+		{
+			th.join();
+		}
+
+		for(std::size_t t = 0; t < sums.size(); t++)
+		{
+			CHECK(sums[t] == static_cast<metaffi_int64>(499500 + 1000 * t));
+		}
+
+		cdt_metaffi_callable* released = adder.release();
+		CHECK_THROWS_AS(adder.call<metaffi_int64>(metaffi_int64(1), metaffi_int64(2)), std::invalid_argument);
+		MetaFFICallable owner(released, "test"); // frees the callable
+	}
+
 	TEST_CASE("call_callback_string")
 	{
 		// call_callback_string(echo) → plugin calls echo("test") → returns "test"
@@ -710,6 +1039,13 @@ TEST_SUITE("Suite 8 - Callables")
 
 TEST_SUITE("Suite 9 - Errors")
 {
+	TEST_CASE("lazily loaded unknown entity fails on call")
+	{
+		MetaFFIEntity e;
+		CHECK_NOTHROW(e = g_module->load_entity_lazy("test::no_such_entity", {}, {}));
+		CHECK_THROWS_AS(e.call_cdts(), std::runtime_error);
+	}
+
 	TEST_CASE("throw_error")
 	{
 		auto e = g_module->load_entity("test::throw_error");
@@ -743,6 +1079,20 @@ TEST_SUITE("Suite 9 - Errors")
 		auto e = g_module->load_entity("test::error_if_negative", {metaffi_int64_type}, {});
 		CHECK_THROWS_AS(e.call_cdts(metaffi_int64(-1)), std::runtime_error);
 	}
+
+	TEST_CASE("error_if_negative — batch stops at the failing call")
+	{
+		auto e = g_module->load_entity("test::error_if_negative", {metaffi_int64_type}, {});
+		std::vector<std::tuple<metaffi_int64>> args = {{1}, {-1}, {2}};
+		CHECK_THROWS_AS(e.call_batch(args), std::runtime_error);
+	}
+
+	TEST_CASE("error_if_negative — async error is stored in the future")
+	{
+		auto e = g_module->load_entity("test::error_if_negative", {metaffi_int64_type}, {});
+		auto result = e.call_async<>(metaffi_int64(-1));
+		CHECK_THROWS_AS(result.get(), std::runtime_error);
+	}
 }
 
 // ===========================================================================
@@ -70,11 +70,19 @@ void set_cdt_char8_val(struct cdt* c, uint8_t val0, uint8_t val1, uint8_t val2,
 }
 
 char* get_cdt_string8_val(struct cdt* c) {
-	return (char*)c->cdt_val.string8_val;
+	return (char*)metaffi_cdt_string8(c);
 }
 
-void set_cdt_string8_val(struct cdt* c, char* val) {
+void set_cdt_string8_val(struct cdt* c, char* val, metaffi_size length) {
 	c->cdt_val.string8_val = val;
+	c->cdt_val.sized_string_val.length = length;
+	c->has_length = 1;
+	c->is_small_string = 0;
+}
+
+// get_cdt_string8_length returns the stored length of the string8 in c, or -1 if it is not stored
+int64_t get_cdt_string8_length(struct cdt* c) {
+	return metaffi_cdt_string_length(c);
 }
 
 uint16_t get_cdt_char16_val(struct cdt* c) {
@@ -87,31 +95,51 @@ void set_cdt_char16_val(struct cdt* c, uint16_t val) {
 }
 
 metaffi_string16 get_cdt_string16_val(struct cdt* c, int32_t* strlen16) {
-	// find terminating null for utf-16, and return length
+	metaffi_string16 str = metaffi_cdt_string16(c);
+
+	// use the stored length, otherwise find terminating null for utf-16
+	int64_t length = metaffi_cdt_string_length(c);
+	if (length >= 0) {
+		*strlen16 = (int32_t)length;
+		return str;
+	}
+
 	*strlen16 = 0;
-	while (c->cdt_val.string16_val[*strlen16] != 0) {
-		*strlen16++;
+	while (str[*strlen16] != 0) {
+		(*strlen16)++;
 	}
 
-	return c->cdt_val.string16_val;
+	return str;
 }
 
 metaffi_string32 get_cdt_string32_val(struct cdt* c, int32_t* strlen32) {
-	// find terminating null for utf-16, and return length
+	metaffi_string32 str = metaffi_cdt_string32(c);
+
+	// use the stored length, otherwise find terminating null for utf-32
+	int64_t length = metaffi_cdt_string_length(c);
+	if (length >= 0) {
+		*strlen32 = (int32_t)length;
+		return str;
+	}
+
 	*strlen32 = 0;
-	while (c->cdt_val.string32_val[*strlen32] != 0) {
-		*strlen32++;
+	while (str[*strlen32] != 0) {
+		(*strlen32)++;
 	}
 
-	return c->cdt_val.string32_val;
+	return str;
 }
 
 void set_cdt_string16_val(struct cdt* c, metaffi_string16 val) {
 	c->cdt_val.string16_val = val;
+	c->has_length = 0;
+	c->is_small_string = 0;
 }
 
 void set_cdt_string32_val(struct cdt* c, metaffi_string32 val) {
 	c->cdt_val.string32_val = val;
+	c->has_length = 0;
+	c->is_small_string = 0;
 }
 
 char32_t get_cdt_char32_val(struct cdt* c) {
@@ -232,6 +260,11 @@ struct cdt_packed_array* alloc_packed_array(void* data, metaffi_size length) {
 	struct cdt_packed_array* p = (struct cdt_packed_array*)xllr_alloc_memory(sizeof(struct cdt_packed_array));
 	p->data = data;
 	p->length = length;
+	p->is_borrowed = 0;
+	p->is_string_blob = 0;
+	p->rank = 0;
+	p->shape = NULL;
+	p->strides = NULL;
 	return p;
 }
 
@@ -567,6 +600,9 @@ func (cdt *CDT) SetChar32(r rune) {
 }
 
 func (cdt *CDT) GetString8() string {
+	if length := C.get_cdt_string8_length(cdt.c); length >= 0 {
+		return C.GoStringN(C.get_cdt_string8_val(cdt.c), C.int(length))
+	}
 	return C.GoString(C.get_cdt_string8_val(cdt.c))
 }
 
@@ -574,7 +610,7 @@ func (cdt *CDT) SetString8(val string) {
 	cVal := C.CString(val)
 	pval := C.xllr_alloc_string(cVal, C.uint64_t(len(val)))
 	defer C.free(unsafe.Pointer(cVal))
-	C.set_cdt_string8_val(cdt.c, pval)
+	C.set_cdt_string8_val(cdt.c, pval, C.metaffi_size(len(val)))
 }
 
 func (cdt *CDT) GetString16() string {
@@ -52,6 +52,8 @@ struct cdt* cast_to_cdt(void* p)
 void set_cdt_string8(struct cdt* p, metaffi_string8 val)
 {
 	p->cdt_val.string8_val = val;
+	p->has_length = 0;
+	p->is_small_string = 0;
 }
 
 void set_cdt_type(struct cdt* p, metaffi_type t)
@@ -23,6 +23,11 @@ struct cdt_packed_array* tc_alloc_packed_array(void* data, metaffi_size length)
 	struct cdt_packed_array* p = (struct cdt_packed_array*)xllr_alloc_memory(sizeof(struct cdt_packed_array));
 	p->data = data;
 	p->length = length;
+	p->is_borrowed = 0;
+	p->is_string_blob = 0;
+	p->rank = 0;
+	p->shape = NULL;
+	p->strides = NULL;
 	return p;
 }
 
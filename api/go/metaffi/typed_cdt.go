@@ -28,7 +28,8 @@ static metaffi_uint64  td_get_uint64(struct cdt* c)  { return c->cdt_val.uint64_
 static metaffi_float32 td_get_float32(struct cdt* c) { return c->cdt_val.float32_val; }
 static metaffi_float64 td_get_float64(struct cdt* c) { return c->cdt_val.float64_val; }
 static metaffi_bool    td_get_bool(struct cdt* c)    { return c->cdt_val.bool_val; }
-static char*           td_get_string8(struct cdt* c) { return (char*)c->cdt_val.string8_val; }
+static char*           td_get_string8(struct cdt* c) { return (char*)metaffi_cdt_string8(c); }
+static int64_t         td_get_string8_length(struct cdt* c) { return metaffi_cdt_string_length(c); }
 
 // --- Scalar setters (set value, type tag, and free_required) ---
 static void td_set_int8(struct cdt* c, metaffi_int8 v)       { c->type = metaffi_int8_type;    c->cdt_val.int8_val = v;    c->free_required = 0; }
@@ -43,12 +44,30 @@ static void td_set_float32(struct cdt* c, metaffi_float32 v) { c->type = metaffi
 static void td_set_float64(struct cdt* c, metaffi_float64 v) { c->type = metaffi_float64_type; c->cdt_val.float64_val = v; c->free_required = 0; }
 static void td_set_bool(struct cdt* c, metaffi_bool v)       { c->type = metaffi_bool_type;    c->cdt_val.bool_val = v;    c->free_required = 0; }
 
-static void td_set_string8_val(struct cdt* c, char* v) {
+static void td_set_string8_val(struct cdt* c, char* v, metaffi_size length) {
 	c->type = metaffi_string8_type;
 	c->cdt_val.string8_val = (metaffi_string8)v;
+	c->cdt_val.sized_string_val.length = length;
+	c->has_length = 1;
+	c->is_small_string = 0;
 	c->free_required = 1;
 }
 
+// Stores a small string inline in the CDT (no allocation). Returns 0 if v is too long.
+static int td_set_small_string8(struct cdt* c, const char* v, metaffi_size length) {
+	if (length > metaffi_small_string_capacity(sizeof(char8_t))) {
+		return 0;
+	}
+	c->type = metaffi_string8_type;
+	memcpy(c->cdt_val.small_string_val.string8, v, length);
+	c->cdt_val.small_string_val.string8[length] = 0;
+	c->small_string_length = (metaffi_uint8)length;
+	c->is_small_string = 1;
+	c->has_length = 0;
+	c->free_required = 0;
+	return 1;
+}
+
 // --- Packed array helpers ---
 static struct cdt_packed_array* td_get_packed(struct cdt* c) {
 	return c->cdt_val.packed_array_val;
@@ -66,6 +85,11 @@ static void td_set_packed(struct cdt* c, void* data, metaffi_size length, metaff
 	struct cdt_packed_array* p = (struct cdt_packed_array*)xllr_alloc_memory(sizeof(struct cdt_packed_array));
 	p->data = data;
 	p->length = length;
+	p->is_borrowed = 0;
+	p->is_string_blob = 0;
+	p->rank = 0;
+	p->shape = NULL;
+	p->strides = NULL;
 	c->type = packed_type;
 	c->free_required = 1;
 	c->cdt_val.packed_array_val = p;
@@ -114,7 +138,11 @@ func DirectGetCDTBool(cdtsArr unsafe.Pointer, index int) bool {
 	return C.td_get_bool(C.td_cdt_at((*C.struct_cdt)(cdtsArr), C.int(index))) != 0
 }
 func DirectGetCDTString8(cdtsArr unsafe.Pointer, index int) string {
-	return C.GoString(C.td_get_string8(C.td_cdt_at((*C.struct_cdt)(cdtsArr), C.int(index))))
+	cdt := C.td_cdt_at((*C.struct_cdt)(cdtsArr), C.int(index))
+	if length := C.td_get_string8_length(cdt); length >= 0 {
+		return C.GoStringN(C.td_get_string8(cdt), C.int(length))
+	}
+	return C.GoString(C.td_get_string8(cdt))
 }
 
 // ============================================================
@@ -161,9 +189,12 @@ func DirectSetCDTBool(cdtsArr unsafe.Pointer, index int, val bool) {
 func DirectSetCDTString8(cdtsArr unsafe.Pointer, index int, val string) {
 	cdt := C.td_cdt_at((*C.struct_cdt)(cdtsArr), C.int(index))
 	cVal := C.CString(val)
+	defer C.free(unsafe.Pointer(cVal))
+	if C.td_set_small_string8(cdt, cVal, C.metaffi_size(len(val))) != 0 {
+		return
+	}
 	pval := C.xllr_alloc_string(cVal, C.uint64_t(len(val)))
-	C.free(unsafe.Pointer(cVal))
-	C.td_set_string8_val(cdt, (*C.char)(pval))
+	C.td_set_string8_val(cdt, (*C.char)(pval), C.metaffi_size(len(val)))
 }
 
 // ============================================================
@@ -88,6 +88,26 @@ static void advance_index(cdts_serializer_t* ser) {
     }
 }
 
+// Helper function to store a small string inline in the CDT (no allocation).
+// Returns false if the string is too long to be stored inline.
+static bool set_small_string(struct cdt* cdt, const void* val, metaffi_size length, size_t code_unit_size) {
+    if (length > metaffi_small_string_capacity(code_unit_size)) {
+        return false;
+    }
+    
+    char* buf = (char*)&cdt->cdt_val.small_string_val;
+    if (length > 0) {
+        memcpy(buf, val, length * code_unit_size);
+    }
+    memset(buf + length * code_unit_size, 0, code_unit_size);
+    
+    cdt->is_small_string = true;
+    cdt->small_string_length = (metaffi_uint8)length;
+    cdt->has_length = false;
+    cdt->free_required = false;
+    return true;
+}
+
 // Helper function to validate type
 static int validate_type(cdts_serializer_t* ser, metaffi_type expected, char** out_err) {
     struct cdt* cdt = get_current_cdt(ser);
@@ -98,6 +118,102 @@ static int validate_type(cdts_serializer_t* ser, metaffi_type expected, char** o
     return CDTS_SER_SUCCESS;
 }
 
+// Helper function to get the size of a fixed-size packed array element.
+// Returns 0 for element types without a fixed size (strings, handles, callables...).
+static size_t packed_element_size(metaffi_type element_type) {
+    switch (element_type) {
+        case metaffi_int8_type: return sizeof(int8_t);
+        case metaffi_int16_type: return sizeof(int16_t);
+        case metaffi_int32_type: return sizeof(int32_t);
+        case metaffi_int64_type: return sizeof(int64_t);
+        case metaffi_uint8_type: return sizeof(uint8_t);
+        case metaffi_uint16_type: return sizeof(uint16_t);
+        case metaffi_uint32_type: return sizeof(uint32_t);
+        case metaffi_uint64_type: return sizeof(uint64_t);
+        case metaffi_float32_type: return sizeof(float);
+        case metaffi_float64_type: return sizeof(double);
+        case metaffi_bool_type: return sizeof(metaffi_bool);
+        case metaffi_char8_type: return sizeof(struct metaffi_char8);
+        case metaffi_char16_type: return sizeof(struct metaffi_char16);
+        case metaffi_char32_type: return sizeof(struct metaffi_char32);
+        default: return 0;
+    }
+}
+
+// Helper function to set the current CDT to a 1D packed array of data.
+// On failure data is not freed (it is still the caller's).
+static int set_packed_array(cdts_serializer_t* ser, void* data, metaffi_size length, metaffi_type element_type, bool is_borrowed, bool is_string_blob, char** out_err) {
+    struct cdt_packed_array* packed = (struct cdt_packed_array*)xllr_alloc_memory(sizeof(struct cdt_packed_array));
+    if (!packed) {
+        set_error(out_err, "Failed to allocate packed array");
+        return CDTS_SER_ERROR_MEMORY;
+    }
+    
+    packed->data = data;
+    packed->length = length;
+    packed->is_borrowed = is_borrowed ? 1 : 0;
+    packed->is_string_blob = is_string_blob ? 1 : 0;
+    packed->rank = 0;
+    packed->shape = NULL;
+    packed->strides = NULL;
+    
+    struct cdt* cdt = get_current_cdt(ser);
+    cdt->type = element_type | metaffi_array_type | metaffi_packed_type;
+    cdt->free_required = true;
+    cdt->cdt_val.packed_array_val = packed;
+    return CDTS_SER_SUCCESS;
+}
+
+// Helper function to get the contiguous packed array of the current CDT
+static int get_current_packed_array(cdts_serializer_t* ser, metaffi_type element_type, struct cdt_packed_array** packed, char** out_err) {
+    int ret = validate_type(ser, element_type | metaffi_array_type | metaffi_packed_type, out_err);
+    if (ret != CDTS_SER_SUCCESS) return ret;
+    
+    *packed = get_current_cdt(ser)->cdt_val.packed_array_val;
+    if (!*packed) {
+        set_error(out_err, "Packed array value is NULL");
+        return CDTS_SER_ERROR_NULL_POINTER;
+    }
+    if (metaffi_packed_is_tensor(*packed) && (*packed)->strides) {
+        set_error(out_err, "Strided packed tensor is not contiguous");
+        return CDTS_SER_ERROR_INVALID_ARRAY_STATE;
+    }
+    return CDTS_SER_SUCCESS;
+}
+
+// Helper function to get string i of a string8 array CDT (packed, or a CDTS array).
+// Returns false if the element is not a string8.
+static bool get_string8_array_item(const struct cdt* cdt, metaffi_size i, const char** str, metaffi_size* length) {
+    if (metaffi_is_packed_array(cdt->type)) {
+        const struct cdt_packed_array* packed = cdt->cdt_val.packed_array_val;
+        *str = (const char*)((metaffi_string8*)packed->data)[i];
+        if (!*str) {
+            *length = 0;
+        } else {
+            *length = packed->is_string_blob ? metaffi_string_blob_string_length(packed, i) : strlen(*str);
+        }
+        return true;
+    }
+    
+    const struct cdt* item = &cdt->cdt_val.array_val->arr[i];
+    if (item->type == metaffi_null_type) {
+        *str = NULL;
+        *length = 0;
+        return true;
+    }
+    if (item->type != metaffi_string8_type) {
+        return false;
+    }
+    
+    *str = (const char*)metaffi_cdt_string8(item);
+    if (!*str) {
+        *length = 0;
+    } else {
+        *length = item->has_length || item->is_small_string ? (metaffi_size)metaffi_cdt_string_length(item) : strlen(*str);
+    }
+    return true;
+}
+
 // Helper function to get metaffi type from C type (for validation)
 static metaffi_type get_metaffi_type_for_int8(void) { return metaffi_int8_type; }
 static metaffi_type get_metaffi_type_for_int16(void) { return metaffi_int16_type; }
@@ -230,6 +346,10 @@ int cdts_ser_add_bool(cdts_serializer_t* ser, bool val, char** out_err) {
 }
 
 int cdts_ser_add_string8(cdts_serializer_t* ser, const char* val, char** out_err) {
+    return cdts_ser_add_string8_sized(ser, val, val ? strlen(val) : 0, out_err);
+}
+
+int cdts_ser_add_string8_sized(cdts_serializer_t* ser, const char* val, metaffi_size length, char** out_err) {
     if (!ser) {
         set_error(out_err, "Serializer is NULL");
         return CDTS_SER_ERROR_NULL_POINTER;
@@ -243,16 +363,25 @@ int cdts_ser_add_string8(cdts_serializer_t* ser, const char* val, char** out_err
     cdt->type = metaffi_string8_type;
     
     if (val) {
-        size_t len = strlen(val);
-        char8_t* copy = xllr_alloc_string8((const char8_t*)val, len);
+        if (set_small_string(cdt, val, length, sizeof(char8_t))) {
+            advance_index(ser);
+            return CDTS_SER_SUCCESS;
+        }
+        
+        char8_t* copy = xllr_alloc_string8((const char8_t*)val, length);
         if (!copy) {
             set_error(out_err, "Failed to allocate string memory");
             return CDTS_SER_ERROR_MEMORY;
         }
         cdt->cdt_val.string8_val = copy;
+        cdt->cdt_val.sized_string_val.length = length;
+        cdt->has_length = true;
+        cdt->is_small_string = false;
         cdt->free_required = true;
     } else {
         cdt->cdt_val.string8_val = NULL;
+        cdt->has_length = false;
+        cdt->is_small_string = false;
         cdt->free_required = false;
     }
     
@@ -276,15 +405,25 @@ int cdts_ser_add_string16(cdts_serializer_t* ser, const char16_t* val, char** ou
     if (val) {
         size_t len = 0;
         while (val[len] != 0) len++;
+        if (set_small_string(cdt, val, len, sizeof(char16_t))) {
+            advance_index(ser);
+            return CDTS_SER_SUCCESS;
+        }
+        
         char16_t* copy = xllr_alloc_string16(val, len);
         if (!copy) {
             set_error(out_err, "Failed to allocate string memory");
             return CDTS_SER_ERROR_MEMORY;
         }
         cdt->cdt_val.string16_val = copy;
+        cdt->cdt_val.sized_string_val.length = len;
+        cdt->has_length = true;
+        cdt->is_small_string = false;
         cdt->free_required = true;
     } else {
         cdt->cdt_val.string16_val = NULL;
+        cdt->has_length = false;
+        cdt->is_small_string = false;
         cdt->free_required = false;
     }
     
@@ -308,15 +447,25 @@ int cdts_ser_add_string32(cdts_serializer_t* ser, const char32_t* val, char** ou
     if (val) {
         size_t len = 0;
         while (val[len] != 0) len++;
+        if (set_small_string(cdt, val, len, sizeof(char32_t))) {
+            advance_index(ser);
+            return CDTS_SER_SUCCESS;
+        }
+        
         char32_t* copy = xllr_alloc_string32(val, len);
         if (!copy) {
             set_error(out_err, "Failed to allocate string memory");
             return CDTS_SER_ERROR_MEMORY;
         }
         cdt->cdt_val.string32_val = copy;
+        cdt->cdt_val.sized_string_val.length = len;
+        cdt->has_length = true;
+        cdt->is_small_string = false;
         cdt->free_required = true;
     } else {
         cdt->cdt_val.string32_val = NULL;
+        cdt->has_length = false;
+        cdt->is_small_string = false;
         cdt->free_required = false;
     }
     
@@ -591,6 +740,10 @@ int cdts_ser_get_bool(cdts_serializer_t* ser, bool* val, char** out_err) {
 }
 
 int cdts_ser_get_string8(cdts_serializer_t* ser, char** val, char** out_err) {
+    return cdts_ser_get_string8_sized(ser, val, NULL, out_err);
+}
+
+int cdts_ser_get_string8_sized(cdts_serializer_t* ser, char** val, metaffi_size* length, char** out_err) {
     if (!ser) {
         set_error(out_err, "Serializer is NULL");
         return CDTS_SER_ERROR_NULL_POINTER;
@@ -608,9 +761,11 @@ int cdts_ser_get_string8(cdts_serializer_t* ser, char** val, char** out_err) {
     if (ret != CDTS_SER_SUCCESS) return ret;
     
     struct cdt* cdt = get_current_cdt(ser);
-    if (cdt->cdt_val.string8_val) {
-        size_t len = strlen((const char*)cdt->cdt_val.string8_val);
-        *val = (char*)xllr_alloc_string8(cdt->cdt_val.string8_val, len);
+    metaffi_string8 str = metaffi_cdt_string8(cdt);
+    size_t len = 0;
+    if (str) {
+        len = cdt->has_length || cdt->is_small_string ? (size_t)metaffi_cdt_string_length(cdt) : strlen((const char*)str);
+        *val = (char*)xllr_alloc_string8(str, len);
         if (!*val) {
             set_error(out_err, "Failed to allocate string memory");
             return CDTS_SER_ERROR_MEMORY;
@@ -619,6 +774,10 @@ int cdts_ser_get_string8(cdts_serializer_t* ser, char** val, char** out_err) {
         *val = NULL;
     }
     
+    if (length) {
+        *length = len;
+    }
+    
     advance_index(ser);
     return CDTS_SER_SUCCESS;
 }
@@ -641,10 +800,15 @@ int cdts_ser_get_string16(cdts_serializer_t* ser, char16_t** val, char** out_err
     if (ret != CDTS_SER_SUCCESS) return ret;
     
     struct cdt* cdt = get_current_cdt(ser);
-    if (cdt->cdt_val.string16_val) {
+    metaffi_string16 str = metaffi_cdt_string16(cdt);
+    if (str) {
         size_t len = 0;
-        while (cdt->cdt_val.string16_val[len] != 0) len++;
-        *val = xllr_alloc_string16(cdt->cdt_val.string16_val, len);
+        if (cdt->has_length || cdt->is_small_string) {
+            len = (size_t)metaffi_cdt_string_length(cdt);
+        } else {
+            while (str[len] != 0) len++;
+        }
+        *val = xllr_alloc_string16(str, len);
         if (!*val) {
             set_error(out_err, "Failed to allocate string memory");
             return CDTS_SER_ERROR_MEMORY;
@@ -675,10 +839,15 @@ int cdts_ser_get_string32(cdts_serializer_t* ser, char32_t** val, char** out_err
     if (ret != CDTS_SER_SUCCESS) return ret;
     
     struct cdt* cdt = get_current_cdt(ser);
-    if (cdt->cdt_val.string32_val) {
+    metaffi_string32 str = metaffi_cdt_string32(cdt);
+    if (str) {
         size_t len = 0;
-        while (cdt->cdt_val.string32_val[len] != 0) len++;
-        *val = xllr_alloc_string32(cdt->cdt_val.string32_val, len);
+        if (cdt->has_length || cdt->is_small_string) {
+            len = (size_t)metaffi_cdt_string_length(cdt);
+        } else {
+            while (str[len] != 0) len++;
+        }
+        *val = xllr_alloc_string32(str, len);
         if (!*val) {
             set_error(out_err, "Failed to allocate string memory");
             return CDTS_SER_ERROR_MEMORY;
@@ -1035,6 +1204,359 @@ int cdts_ser_get_array_end(cdts_serializer_t* ser, char** out_err) {
     return CDTS_SER_SUCCESS;
 }
 
+// ===== PACKED ARRAYS =====
+
+int cdts_ser_add_packed_array_borrowed(cdts_serializer_t* ser, const void* data, metaffi_size length, metaffi_type element_type, char** out_err) {
+    if (!ser) {
+        set_error(out_err, "Serializer is NULL");
+        return CDTS_SER_ERROR_NULL_POINTER;
+    }
+    if (!data && length > 0) {
+        set_error(out_err, "Packed array data is NULL");
+        return CDTS_SER_ERROR_NULL_POINTER;
+    }
+    
+    switch (element_type) {
+        case metaffi_float32_type:
+        case metaffi_float64_type:
+        case metaffi_int8_type:
+        case metaffi_int16_type:
+        case metaffi_int32_type:
+        case metaffi_int64_type:
+        case metaffi_uint8_type:
+        case metaffi_uint16_type:
+        case metaffi_uint32_type:
+        case metaffi_uint64_type:
+        case metaffi_bool_type:
+        case metaffi_char8_type:
+        case metaffi_char16_type:
+        case metaffi_char32_type:
+        case metaffi_string8_type:
+        case metaffi_string16_type:
+        case metaffi_string32_type:
+            break;
+        
+        default:
+            set_error(out_err, "Unsupported packed array element type: %llu", (unsigned long long)element_type);
+            return CDTS_SER_ERROR_TYPE_MISMATCH;
+    }
+    
+    metaffi_size index = ser->array_stack ? ser->array_stack->current_index : ser->current_index;
+    int ret = check_bounds(ser, index, out_err);
+    if (ret != CDTS_SER_SUCCESS) return ret;
+    
+    // Only the header is allocated (and freed by the CDT) - the data stays owned by the caller
+    ret = set_packed_array(ser, (void*)data, length, element_type, true, false, out_err);
+    if (ret != CDTS_SER_SUCCESS) return ret;
+    
+    advance_index(ser);
+    return CDTS_SER_SUCCESS;
+}
+
+int cdts_ser_add_packed_array(cdts_serializer_t* ser, const void* data, metaffi_size length, metaffi_type element_type, char** out_err) {
+    if (!ser) {
+        set_error(out_err, "Serializer is NULL");
+        return CDTS_SER_ERROR_NULL_POINTER;
+    }
+    if (!data && length > 0) {
+        set_error(out_err, "Packed array data is NULL");
+        return CDTS_SER_ERROR_NULL_POINTER;
+    }
+    
+    size_t element_size = packed_element_size(element_type);
+    if (element_size == 0) {
+        set_error(out_err, "Unsupported packed array element type: %llu", (unsigned long long)element_type);
+        return CDTS_SER_ERROR_TYPE_MISMATCH;
+    }
+    
+    metaffi_size index = ser->array_stack ? ser->array_stack->current_index : ser->current_index;
+    int ret = check_bounds(ser, index, out_err);
+    if (ret != CDTS_SER_SUCCESS) return ret;
+    
+    void* buffer = NULL;
+    if (length > 0) {
+        buffer = xllr_alloc_memory(length * element_size);
+        if (!buffer) {
+            set_error(out_err, "Failed to allocate packed array data");
+            return CDTS_SER_ERROR_MEMORY;
+        }
+        memcpy(buffer, data, length * element_size);
+    }
+    
+    ret = set_packed_array(ser, buffer, length, element_type, false, false, out_err);
+    if (ret != CDTS_SER_SUCCESS) {
+        if (buffer) xllr_free_memory(buffer);
+        return ret;
+    }
+    
+    advance_index(ser);
+    return CDTS_SER_SUCCESS;
+}
+
+int cdts_ser_get_packed_array(cdts_serializer_t* ser, void** data, metaffi_size* length, metaffi_type element_type, char** out_err) {
+    if (!ser) {
+        set_error(out_err, "Serializer is NULL");
+        return CDTS_SER_ERROR_NULL_POINTER;
+    }
+    if (!data || !length) {
+        set_error(out_err, "Output pointers are NULL");
+        return CDTS_SER_ERROR_NULL_POINTER;
+    }
+    
+    size_t element_size = packed_element_size(element_type);
+    if (element_size == 0) {
+        set_error(out_err, "Unsupported packed array element type: %llu", (unsigned long long)element_type);
+        return CDTS_SER_ERROR_TYPE_MISMATCH;
+    }
+    
+    metaffi_size index = ser->array_stack ? ser->array_stack->current_index : ser->current_index;
+    int ret = check_bounds(ser, index, out_err);
+    if (ret != CDTS_SER_SUCCESS) return ret;
+    
+    struct cdt* cdt = get_current_cdt(ser);
+    void* buffer = NULL;
+    metaffi_size buffer_length = 0;
+    
+    if (cdt->type == (element_type | metaffi_array_type)) {
+        // CDTS array - copy element by element
+        struct cdts* array_cdts = cdt->cdt_val.array_val;
+        if (!array_cdts) {
+            set_error(out_err, "Array value is NULL");
+            return CDTS_SER_ERROR_NULL_POINTER;
+        }
+        
+        buffer_length = array_cdts->length;
+        if (buffer_length > 0) {
+            buffer = xllr_alloc_memory(buffer_length * element_size);
+            if (!buffer) {
+                set_error(out_err, "Failed to allocate array data");
+                return CDTS_SER_ERROR_MEMORY;
+            }
+        }
+        
+        for (metaffi_size i = 0; i < buffer_length; i++) {
+            if (array_cdts->arr[i].type != element_type) {
+                xllr_free_memory(buffer);
+                set_error(out_err, "Type mismatch at array element %llu: expected %llu, got %llu",
+                          (unsigned long long)i, (unsigned long long)element_type, (unsigned long long)array_cdts->arr[i].type);
+                return CDTS_SER_ERROR_TYPE_MISMATCH;
+            }
+            memcpy((char*)buffer + i * element_size, &array_cdts->arr[i].cdt_val, element_size);
+        }
+    } else {
+        struct cdt_packed_array* packed = NULL;
+        ret = get_current_packed_array(ser, element_type, &packed, out_err);
+        if (ret != CDTS_SER_SUCCESS) return ret;
+        
+        buffer_length = packed->length;
+        if (buffer_length > 0) {
+            buffer = xllr_alloc_memory(buffer_length * element_size);
+            if (!buffer) {
+                set_error(out_err, "Failed to allocate array data");
+                return CDTS_SER_ERROR_MEMORY;
+            }
+            memcpy(buffer, packed->data, buffer_length * element_size);
+        }
+    }
+    
+    *data = buffer;
+    *length = buffer_length;
+    
+    advance_index(ser);
+    return CDTS_SER_SUCCESS;
+}
+
+int cdts_ser_get_packed_array_borrowed(cdts_serializer_t* ser, const void** data, metaffi_size* length, metaffi_type element_type, char** out_err) {
+    if (!ser) {
+        set_error(out_err, "Serializer is NULL");
+        return CDTS_SER_ERROR_NULL_POINTER;
+    }
+    if (!data || !length) {
+        set_error(out_err, "Output pointers are NULL");
+        return CDTS_SER_ERROR_NULL_POINTER;
+    }
+    
+    metaffi_size index = ser->array_stack ? ser->array_stack->current_index : ser->current_index;
+    int ret = check_bounds(ser, index, out_err);
+    if (ret != CDTS_SER_SUCCESS) return ret;
+    
+    struct cdt_packed_array* packed = NULL;
+    ret = get_current_packed_array(ser, element_type, &packed, out_err);
+    if (ret != CDTS_SER_SUCCESS) return ret;
+    
+    *data = packed->data;
+    *length = packed->length;
+    
+    advance_index(ser);
+    return CDTS_SER_SUCCESS;
+}
+
+#define DEFINE_TYPED_ARRAY_FUNCTIONS(name, c_type) \
+    int cdts_ser_add_##name##_array(cdts_serializer_t* ser, const c_type* vals, metaffi_size length, char** out_err) { \
+        return cdts_ser_add_packed_array(ser, vals, length, get_metaffi_type_for_##name(), out_err); \
+    } \
+    int cdts_ser_add_##name##_array_borrowed(cdts_serializer_t* ser, const c_type* vals, metaffi_size length, char** out_err) { \
+        return cdts_ser_add_packed_array_borrowed(ser, vals, length, get_metaffi_type_for_##name(), out_err); \
+    } \
+    int cdts_ser_get_##name##_array(cdts_serializer_t* ser, c_type** vals, metaffi_size* length, char** out_err) { \
+        return cdts_ser_get_packed_array(ser, (void**)vals, length, get_metaffi_type_for_##name(), out_err); \
+    } \
+    int cdts_ser_get_##name##_array_borrowed(cdts_serializer_t* ser, const c_type** vals, metaffi_size* length, char** out_err) { \
+        return cdts_ser_get_packed_array_borrowed(ser, (const void**)vals, length, get_metaffi_type_for_##name(), out_err); \
+    }
+
+DEFINE_TYPED_ARRAY_FUNCTIONS(int8, int8_t)
+DEFINE_TYPED_ARRAY_FUNCTIONS(int16, int16_t)
+DEFINE_TYPED_ARRAY_FUNCTIONS(int32, int32_t)
+DEFINE_TYPED_ARRAY_FUNCTIONS(int64, int64_t)
+DEFINE_TYPED_ARRAY_FUNCTIONS(uint8, uint8_t)
+DEFINE_TYPED_ARRAY_FUNCTIONS(uint16, uint16_t)
+DEFINE_TYPED_ARRAY_FUNCTIONS(uint32, uint32_t)
+DEFINE_TYPED_ARRAY_FUNCTIONS(uint64, uint64_t)
+DEFINE_TYPED_ARRAY_FUNCTIONS(float32, float)
+DEFINE_TYPED_ARRAY_FUNCTIONS(float64, double)
+
+#undef DEFINE_TYPED_ARRAY_FUNCTIONS
+
+int cdts_ser_add_string8_array(cdts_serializer_t* ser, const char* const* vals, const metaffi_size* lengths, metaffi_size count, char** out_err) {
+    if (!ser) {
+        set_error(out_err, "Serializer is NULL");
+        return CDTS_SER_ERROR_NULL_POINTER;
+    }
+    if (!vals && count > 0) {
+        set_error(out_err, "String array is NULL");
+        return CDTS_SER_ERROR_NULL_POINTER;
+    }
+    
+    metaffi_size index = ser->array_stack ? ser->array_stack->current_index : ser->current_index;
+    int ret = check_bounds(ser, index, out_err);
+    if (ret != CDTS_SER_SUCCESS) return ret;
+    
+    metaffi_size code_units = 0;
+    for (metaffi_size i = 0; i < count; i++) {
+        if (vals[i]) {
+            code_units += lengths ? lengths[i] : strlen(vals[i]);
+        }
+    }
+    
+    // a single string blob: string pointers, offsets and the strings (see cdt_packed_array)
+    void* blob = NULL;
+    if (count > 0) {
+        blob = xllr_alloc_memory(metaffi_string_blob_size(count, code_units, sizeof(char)));
+        if (!blob) {
+            set_error(out_err, "Failed to allocate string array");
+            return CDTS_SER_ERROR_MEMORY;
+        }
+        
+        metaffi_string8* strings = (metaffi_string8*)blob;
+        metaffi_size* offsets = (metaffi_size*)((char*)blob + sizeof(void*) * count);
+        char* chars = (char*)(offsets + count + 1);
+        
+        offsets[0] = 0;
+        for (metaffi_size i = 0; i < count; i++) {
+            if (!vals[i]) {
+                strings[i] = NULL;
+                offsets[i + 1] = offsets[i];
+                continue;
+            }
+            
+            metaffi_size length = lengths ? lengths[i] : strlen(vals[i]);
+            char* str = chars + offsets[i];
+            memcpy(str, vals[i], length);
+            str[length] = '\0';
+            strings[i] = (metaffi_string8)str;
+            offsets[i + 1] = offsets[i] + length + 1;
+        }
+    }
+    
+    ret = set_packed_array(ser, blob, count, metaffi_string8_type, false, blob != NULL, out_err);
+    if (ret != CDTS_SER_SUCCESS) {
+        if (blob) xllr_free_memory(blob);
+        return ret;
+    }
+    
+    advance_index(ser);
+    return CDTS_SER_SUCCESS;
+}
+
+int cdts_ser_get_string8_array(cdts_serializer_t* ser, char*** vals, metaffi_size* count, char** out_err) {
+    if (!ser) {
+        set_error(out_err, "Serializer is NULL");
+        return CDTS_SER_ERROR_NULL_POINTER;
+    }
+    if (!vals || !count) {
+        set_error(out_err, "Output pointers are NULL");
+        return CDTS_SER_ERROR_NULL_POINTER;
+    }
+    
+    metaffi_size index = ser->array_stack ? ser->array_stack->current_index : ser->current_index;
+    int ret = check_bounds(ser, index, out_err);
+    if (ret != CDTS_SER_SUCCESS) return ret;
+    
+    struct cdt* cdt = get_current_cdt(ser);
+    metaffi_size strings_count = 0;
+    if (cdt->type == metaffi_string8_array_type) {
+        if (!cdt->cdt_val.array_val) {
+            set_error(out_err, "Array value is NULL");
+            return CDTS_SER_ERROR_NULL_POINTER;
+        }
+        strings_count = cdt->cdt_val.array_val->length;
+    } else {
+        struct cdt_packed_array* packed = NULL;
+        ret = get_current_packed_array(ser, metaffi_string8_type, &packed, out_err);
+        if (ret != CDTS_SER_SUCCESS) return ret;
+        strings_count = packed->length;
+    }
+    
+    // first pass - the size of all the strings
+    metaffi_size code_units = 0;
+    for (metaffi_size i = 0; i < strings_count; i++) {
+        const char* str = NULL;
+        metaffi_size length = 0;
+        if (!get_string8_array_item(cdt, i, &str, &length)) {
+            set_error(out_err, "Type mismatch at array element %llu: expected string8", (unsigned long long)i);
+            return CDTS_SER_ERROR_TYPE_MISMATCH;
+        }
+        code_units += length + 1;
+    }
+    
+    // second pass - copy the pointers and the strings into a single allocation
+    char** strings = NULL;
+    if (strings_count > 0) {
+        strings = (char**)xllr_alloc_memory(sizeof(char*) * strings_count + code_units);
+        if (!strings) {
+            set_error(out_err, "Failed to allocate string array");
+            return CDTS_SER_ERROR_MEMORY;
+        }
+        
+        char* chars = (char*)(strings + strings_count);
+        for (metaffi_size i = 0; i < strings_count; i++) {
+            const char* str = NULL;
+            metaffi_size length = 0;
+            get_string8_array_item(cdt, i, &str, &length);
+            if (!str) {
+                strings[i] = NULL;
+                continue;
+            }
+            
+            memcpy(chars, str, length);
+            chars[length] = '\0';
+            strings[i] = chars;
+            chars += length + 1;
+        }
+    }
+    
+    *vals = strings;
+    *count = strings_count;
+    
+    advance_index(ser);
+    return CDTS_SER_SUCCESS;
+}
+
+int cdts_ser_get_string8_array_borrowed(cdts_serializer_t* ser, const char* const** vals, metaffi_size* count, char** out_err) {
+    return cdts_ser_get_packed_array_borrowed(ser, (const void**)vals, count, metaffi_string8_type, out_err);
+}
+
 // ===== UTILITY FUNCTIONS =====
 
 metaffi_type cdts_ser_peek_type(cdts_serializer_t* ser, char** out_err) {
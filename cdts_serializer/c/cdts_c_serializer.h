@@ -63,6 +63,7 @@ int cdts_ser_add_float32(cdts_serializer_t* ser, float val, char** out_err);
 int cdts_ser_add_float64(cdts_serializer_t* ser, double val, char** out_err);
 int cdts_ser_add_bool(cdts_serializer_t* ser, bool val, char** out_err);
 int cdts_ser_add_string8(cdts_serializer_t* ser, const char* val, char** out_err);
+int cdts_ser_add_string8_sized(cdts_serializer_t* ser, const char* val, metaffi_size length, char** out_err);  // length in bytes, may contain NULLs
 int cdts_ser_add_string16(cdts_serializer_t* ser, const char16_t* val, char** out_err);
 int cdts_ser_add_string32(cdts_serializer_t* ser, const char32_t* val, char** out_err);
 int cdts_ser_add_char8(cdts_serializer_t* ser, const struct metaffi_char8* val, char** out_err);
@@ -86,6 +87,7 @@ int cdts_ser_get_float32(cdts_serializer_t* ser, float* val, char** out_err);
 int cdts_ser_get_float64(cdts_serializer_t* ser, double* val, char** out_err);
 int cdts_ser_get_bool(cdts_serializer_t* ser, bool* val, char** out_err);
 int cdts_ser_get_string8(cdts_serializer_t* ser, char** val, char** out_err);  // Allocates new string, caller must free
+int cdts_ser_get_string8_sized(cdts_serializer_t* ser, char** val, metaffi_size* length, char** out_err);  // Same, and returns the length in bytes
 int cdts_ser_get_string16(cdts_serializer_t* ser, char16_t** val, char** out_err);
 int cdts_ser_get_string32(cdts_serializer_t* ser, char32_t** val, char** out_err);
 int cdts_ser_get_char8(cdts_serializer_t* ser, struct metaffi_char8* val, char** out_err);
@@ -132,6 +134,140 @@ int cdts_ser_get_array_begin(cdts_serializer_t* ser, metaffi_size* length, metaf
  */
 int cdts_ser_get_array_end(cdts_serializer_t* ser, char** out_err);
 
+// ===== PACKED ARRAYS =====
+
+/**
+ * @brief Add a packed array borrowing the caller's buffer (no copy)
+ * The buffer is never freed by the CDTS, so it must outlive it (e.g. input parameters during the call).
+ * @param ser Serializer handle
+ * @param data Buffer of length elements (numeric, bool, char or string pointers)
+ * @param length Number of elements in the buffer
+ * @param element_type MetaFFI type of the elements (e.g. metaffi_float64_type)
+ * @param out_err Optional output error string
+ * @return CDTS_SER_SUCCESS on success, error code otherwise
+ */
+int cdts_ser_add_packed_array_borrowed(cdts_serializer_t* ser, const void* data, metaffi_size length, metaffi_type element_type, char** out_err);
+
+/**
+ * @brief Add a packed array copying the caller's buffer (a single allocation and memcpy)
+ * @param ser Serializer handle
+ * @param data Buffer of length elements (numeric, bool or char)
+ * @param length Number of elements in the buffer
+ * @param element_type MetaFFI type of the elements (e.g. metaffi_float64_type)
+ * @param out_err Optional output error string
+ * @return CDTS_SER_SUCCESS on success, error code otherwise
+ */
+int cdts_ser_add_packed_array(cdts_serializer_t* ser, const void* data, metaffi_size length, metaffi_type element_type, char** out_err);
+
+/**
+ * @brief Get a 1D array as a copied buffer (a single memcpy for packed arrays)
+ * Accepts contiguous packed arrays (and tensors, in row-major order) and 1D CDTS arrays of element_type.
+ * @param ser Serializer handle
+ * @param data Output: buffer of length elements (caller must free with xllr_free_memory), NULL if empty
+ * @param length Output: number of elements
+ * @param element_type MetaFFI type of the elements (numeric, bool or char)
+ * @param out_err Optional output error string
+ * @return CDTS_SER_SUCCESS on success, error code otherwise
+ */
+int cdts_ser_get_packed_array(cdts_serializer_t* ser, void** data, metaffi_size* length, metaffi_type element_type, char** out_err);
+
+/**
+ * @brief Get a pointer to the buffer of a packed array (no copy)
+ * The buffer is owned by the CDTS, so it is valid only while the CDTS is.
+ * Only contiguous packed arrays can be borrowed (for CDTS arrays use cdts_ser_get_packed_array).
+ * @param ser Serializer handle
+ * @param data Output: the packed array's buffer (for strings - the array of string pointers)
+ * @param length Output: number of elements
+ * @param element_type MetaFFI type of the elements
+ * @param out_err Optional output error string
+ * @return CDTS_SER_SUCCESS on success, error code otherwise
+ */
+int cdts_ser_get_packed_array_borrowed(cdts_serializer_t* ser, const void** data, metaffi_size* length, metaffi_type element_type, char** out_err);
+
+/**
+ * @brief Typed forms of the packed array functions.
+ * cdts_ser_add_<type>_array copies vals, cdts_ser_add_<type>_array_borrowed borrows vals (see cdts_ser_add_packed_array_borrowed),
+ * cdts_ser_get_<type>_array returns a copy (caller must free with xllr_free_memory)
+ * and cdts_ser_get_<type>_array_borrowed returns the CDTS's buffer (see cdts_ser_get_packed_array_borrowed).
+ * Boolean arrays use metaffi_bool buffers with the generic functions and metaffi_bool_type.
+ */
+int cdts_ser_add_int8_array(cdts_serializer_t* ser, const int8_t* vals, metaffi_size length, char** out_err);
+int cdts_ser_add_int16_array(cdts_serializer_t* ser, const int16_t* vals, metaffi_size length, char** out_err);
+int cdts_ser_add_int32_array(cdts_serializer_t* ser, const int32_t* vals, metaffi_size length, char** out_err);
+int cdts_ser_add_int64_array(cdts_serializer_t* ser, const int64_t* vals, metaffi_size length, char** out_err);
+int cdts_ser_add_uint8_array(cdts_serializer_t* ser, const uint8_t* vals, metaffi_size length, char** out_err);
+int cdts_ser_add_uint16_array(cdts_serializer_t* ser, const uint16_t* vals, metaffi_size length, char** out_err);
+int cdts_ser_add_uint32_array(cdts_serializer_t* ser, const uint32_t* vals, metaffi_size length, char** out_err);
+int cdts_ser_add_uint64_array(cdts_serializer_t* ser, const uint64_t* vals, metaffi_size length, char** out_err);
+int cdts_ser_add_float32_array(cdts_serializer_t* ser, const float* vals, metaffi_size length, char** out_err);
+int cdts_ser_add_float64_array(cdts_serializer_t* ser, const double* vals, metaffi_size length, char** out_err);
+
+int cdts_ser_add_int8_array_borrowed(cdts_serializer_t* ser, const int8_t* vals, metaffi_size length, char** out_err);
+int cdts_ser_add_int16_array_borrowed(cdts_serializer_t* ser, const int16_t* vals, metaffi_size length, char** out_err);
+int cdts_ser_add_int32_array_borrowed(cdts_serializer_t* ser, const int32_t* vals, metaffi_size length, char** out_err);
+int cdts_ser_add_int64_array_borrowed(cdts_serializer_t* ser, const int64_t* vals, metaffi_size length, char** out_err);
+int cdts_ser_add_uint8_array_borrowed(cdts_serializer_t* ser, const uint8_t* vals, metaffi_size length, char** out_err);
+int cdts_ser_add_uint16_array_borrowed(cdts_serializer_t* ser, const uint16_t* vals, metaffi_size length, char** out_err);
+int cdts_ser_add_uint32_array_borrowed(cdts_serializer_t* ser, const uint32_t* vals, metaffi_size length, char** out_err);
+int cdts_ser_add_uint64_array_borrowed(cdts_serializer_t* ser, const uint64_t* vals, metaffi_size length, char** out_err);
+int cdts_ser_add_float32_array_borrowed(cdts_serializer_t* ser, const float* vals, metaffi_size length, char** out_err);
+int cdts_ser_add_float64_array_borrowed(cdts_serializer_t* ser, const double* vals, metaffi_size length, char** out_err);
+
+int cdts_ser_get_int8_array(cdts_serializer_t* ser, int8_t** vals, metaffi_size* length, char** out_err);
+int cdts_ser_get_int16_array(cdts_serializer_t* ser, int16_t** vals, metaffi_size* length, char** out_err);
+int cdts_ser_get_int32_array(cdts_serializer_t* ser, int32_t** vals, metaffi_size* length, char** out_err);
+int cdts_ser_get_int64_array(cdts_serializer_t* ser, int64_t** vals, metaffi_size* length, char** out_err);
+int cdts_ser_get_uint8_array(cdts_serializer_t* ser, uint8_t** vals, metaffi_size* length, char** out_err);
+int cdts_ser_get_uint16_array(cdts_serializer_t* ser, uint16_t** vals, metaffi_size* length, char** out_err);
+int cdts_ser_get_uint32_array(cdts_serializer_t* ser, uint32_t** vals, metaffi_size* length, char** out_err);
+int cdts_ser_get_uint64_array(cdts_serializer_t* ser, uint64_t** vals, metaffi_size* length, char** out_err);
+int cdts_ser_get_float32_array(cdts_serializer_t* ser, float** vals, metaffi_size* length, char** out_err);
+int cdts_ser_get_float64_array(cdts_serializer_t* ser, double** vals, metaffi_size* length, char** out_err);
+
+int cdts_ser_get_int8_array_borrowed(cdts_serializer_t* ser, const int8_t** vals, metaffi_size* length, char** out_err);
+int cdts_ser_get_int16_array_borrowed(cdts_serializer_t* ser, const int16_t** vals, metaffi_size* length, char** out_err);
+int cdts_ser_get_int32_array_borrowed(cdts_serializer_t* ser, const int32_t** vals, metaffi_size* length, char** out_err);
+int cdts_ser_get_int64_array_borrowed(cdts_serializer_t* ser, const int64_t** vals, metaffi_size* length, char** out_err);
+int cdts_ser_get_uint8_array_borrowed(cdts_serializer_t* ser, const uint8_t** vals, metaffi_size* length, char** out_err);
+int cdts_ser_get_uint16_array_borrowed(cdts_serializer_t* ser, const uint16_t** vals, metaffi_size* length, char** out_err);
+int cdts_ser_get_uint32_array_borrowed(cdts_serializer_t* ser, const uint32_t** vals, metaffi_size* length, char** out_err);
+int cdts_ser_get_uint64_array_borrowed(cdts_serializer_t* ser, const uint64_t** vals, metaffi_size* length, char** out_err);
+int cdts_ser_get_float32_array_borrowed(cdts_serializer_t* ser, const float** vals, metaffi_size* length, char** out_err);
+int cdts_ser_get_float64_array_borrowed(cdts_serializer_t* ser, const double** vals, metaffi_size* length, char** out_err);
+
+/**
+ * @brief Add a packed string8 array, copying all the strings into a single string blob allocation
+ * @param ser Serializer handle
+ * @param vals Array of count strings (a NULL string stays NULL)
+ * @param lengths Optional length (in bytes) of each string. If NULL, the strings must be NULL-terminated
+ * @param count Number of strings
+ * @param out_err Optional output error string
+ * @return CDTS_SER_SUCCESS on success, error code otherwise
+ */
+int cdts_ser_add_string8_array(cdts_serializer_t* ser, const char* const* vals, const metaffi_size* lengths, metaffi_size count, char** out_err);
+
+/**
+ * @brief Get a string8 array as a single allocation holding the string pointers and the strings
+ * Accepts packed string8 arrays and 1D CDTS arrays of string8.
+ * @param ser Serializer handle
+ * @param vals Output: array of count NULL-terminated strings. The caller frees it (and all the strings) with a single xllr_free_memory
+ * @param count Output: number of strings
+ * @param out_err Optional output error string
+ * @return CDTS_SER_SUCCESS on success, error code otherwise
+ */
+int cdts_ser_get_string8_array(cdts_serializer_t* ser, char*** vals, metaffi_size* count, char** out_err);
+
+/**
+ * @brief Get the string pointers of a packed string8 array (no copy)
+ * The strings are owned by the CDTS, so they are valid only while the CDTS is.
+ * @param ser Serializer handle
+ * @param vals Output: array of count NULL-terminated strings
+ * @param count Output: number of strings
+ * @param out_err Optional output error string
+ * @return CDTS_SER_SUCCESS on success, error code otherwise
+ */
+int cdts_ser_get_string8_array_borrowed(cdts_serializer_t* ser, const char* const** vals, metaffi_size* count, char** out_err);
+
 // ===== UTILITY FUNCTIONS =====
 
 /**
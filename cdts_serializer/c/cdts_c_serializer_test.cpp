@@ -57,7 +57,19 @@ static void free_cdts(struct cdts* cdts) {
         for (metaffi_size i = 0; i < cdts->length; i++) {
             struct cdt* cdt = &cdts->arr[i];
             if (cdt->free_required) {
-                if (cdt->type & metaffi_array_type) {
+                if (metaffi_is_packed_array(cdt->type)) {
+                    // numeric arrays and string blobs are a single data allocation
+                    struct cdt_packed_array* packed = cdt->cdt_val.packed_array_val;
+                    if (packed) {
+                        if (packed->data && !packed->is_borrowed) {
+                            xllr_free_memory(packed->data);
+                        }
+                        xllr_free_memory(packed);
+                    }
+                    cdt->cdt_val.packed_array_val = NULL;
+                    cdt->free_required = false;
+                    cdt->type = metaffi_null_type;
+                } else if (cdt->type & metaffi_array_type) {
                     if (cdt->cdt_val.array_val) {
                         // Recursively free nested arrays first
                         free_cdts(cdt->cdt_val.array_val);
@@ -68,7 +80,7 @@ static void free_cdts(struct cdts* cdts) {
                 } else {
                     switch (cdt->type) {
                     case metaffi_string8_type:
-                        if (cdt->cdt_val.string8_val) {
+                        if (!cdt->is_small_string && cdt->cdt_val.string8_val) {
                             // Set flags FIRST to prevent destructor from trying to free
                             cdt->free_required = false;
                             cdt->type = metaffi_null_type;
@@ -79,7 +91,7 @@ static void free_cdts(struct cdts* cdts) {
                         }
                         break;
                     case metaffi_string16_type:
-                        if (cdt->cdt_val.string16_val) {
+                        if (!cdt->is_small_string && cdt->cdt_val.string16_val) {
                             cdt->free_required = false;
                             cdt->type = metaffi_null_type;
                             void* str_ptr = cdt->cdt_val.string16_val;
@@ -88,7 +100,7 @@ static void free_cdts(struct cdts* cdts) {
                         }
                         break;
                     case metaffi_string32_type:
-                        if (cdt->cdt_val.string32_val) {
+                        if (!cdt->is_small_string && cdt->cdt_val.string32_val) {
                             cdt->free_required = false;
                             cdt->type = metaffi_null_type;
                             void* str_ptr = cdt->cdt_val.string32_val;
@@ -459,6 +471,64 @@ TEST_SUITE("CDTS C Serializer") {
         free_cdts(data);
     }
 
+    TEST_CASE("Serialize and deserialize sized string8 with embedded NULL") {
+        struct cdts* data = create_cdts(1);
+        cdts_serializer_t* ser = cdts_ser_create(data, NULL);
+
+        const char original[] = {'a', '\0', 'b', 'c'};
+        CHECK(cdts_ser_add_string8_sized(ser, original, sizeof(original), NULL) == CDTS_SER_SUCCESS);
+        CHECK(metaffi_cdt_string_length(&data->arr[0]) == (metaffi_int64)sizeof(original));
+
+        CHECK(cdts_ser_reset(ser, NULL) == CDTS_SER_SUCCESS);
+        char* extracted;
+        metaffi_size length = 0;
+        CHECK(cdts_ser_get_string8_sized(ser, &extracted, &length, NULL) == CDTS_SER_SUCCESS);
+
+        CHECK(length == sizeof(original));
+        CHECK(memcmp(extracted, original, sizeof(original)) == 0);
+
+        xllr_free_string(extracted);
+        cdts_ser_destroy(ser);
+        free_cdts(data);
+    }
+
+    TEST_CASE("Small strings are stored inline") {
+        struct cdts* data = create_cdts(3);
+        cdts_serializer_t* ser = cdts_ser_create(data, NULL);
+
+        const char* small = "identifier";           // fits inline
+        const char* large = "a string too long to be inline";
+        const char16_t* small16 = u"key";
+        CHECK(cdts_ser_add_string8(ser, small, NULL) == CDTS_SER_SUCCESS);
+        CHECK(cdts_ser_add_string8(ser, large, NULL) == CDTS_SER_SUCCESS);
+        CHECK(cdts_ser_add_string16(ser, small16, NULL) == CDTS_SER_SUCCESS);
+
+        CHECK(data->arr[0].is_small_string);
+        CHECK(!data->arr[0].free_required);
+        CHECK(metaffi_cdt_string_length(&data->arr[0]) == (metaffi_int64)strlen(small));
+        CHECK(strcmp((const char*)metaffi_cdt_string8(&data->arr[0]), small) == 0);
+        CHECK(!data->arr[1].is_small_string);
+        CHECK(data->arr[1].free_required);
+        CHECK(data->arr[2].is_small_string);
+
+        CHECK(cdts_ser_reset(ser, NULL) == CDTS_SER_SUCCESS);
+        char* extracted_small;
+        char* extracted_large;
+        char16_t* extracted16;
+        CHECK(cdts_ser_get_string8(ser, &extracted_small, NULL) == CDTS_SER_SUCCESS);
+        CHECK(cdts_ser_get_string8(ser, &extracted_large, NULL) == CDTS_SER_SUCCESS);
+        CHECK(cdts_ser_get_string16(ser, &extracted16, NULL) == CDTS_SER_SUCCESS);
+        CHECK(strcmp(extracted_small, small) == 0);
+        CHECK(strcmp(extracted_large, large) == 0);
+        CHECK(std::u16string(extracted16) == small16);
+
+        xllr_free_string(extracted_small);
+        xllr_free_string(extracted_large);
+        xllr_free_string((char*)extracted16);
+        cdts_ser_destroy(ser);
+        free_cdts(data);
+    }
+
     TEST_CASE("Serialize and deserialize string16") {
         struct cdts* data = create_cdts(1);
         cdts_serializer_t* ser = cdts_ser_create(data, NULL);
@@ -1609,4 +1679,156 @@ TEST_SUITE("CDTS C Serializer") {
         cdts_ser_destroy(deser);
         free_cdts(data);
     }
+    
+    TEST_CASE("Borrowed packed array") {
+        double values[] = {1.5, 2.5, 3.5, 4.5};
+        
+        struct cdts* data = create_cdts(2);
+        cdts_serializer_t* ser = cdts_ser_create(data, NULL);
+        CHECK(cdts_ser_add_packed_array_borrowed(ser, values, 4, metaffi_float64_type, NULL) == CDTS_SER_SUCCESS);
+        
+        char* err = NULL;
+        CHECK(cdts_ser_add_packed_array_borrowed(ser, values, 4, metaffi_handle_type, &err) == CDTS_SER_ERROR_TYPE_MISMATCH);
+        CHECK(err != NULL);
+        xllr_free_string(err);
+        
+        CHECK(data->arr[0].type == metaffi_float64_packed_array_type);
+        CHECK(data->arr[0].cdt_val.packed_array_val->data == values); // no copy
+        CHECK(data->arr[0].cdt_val.packed_array_val->length == 4);
+        CHECK(data->arr[0].cdt_val.packed_array_val->is_borrowed);
+        
+        // the caller frees only the packed array header - the data is still the caller's
+        xllr_free_memory(data->arr[0].cdt_val.packed_array_val);
+        data->arr[0].cdt_val.packed_array_val = NULL;
+        data->arr[0].free_required = false;
+        data->arr[0].type = metaffi_null_type;
+        
+        cdts_ser_destroy(ser);
+        free_cdts(data);
+        
+        CHECK(values[3] == 4.5);
+    }
+    
+    TEST_CASE("Bulk packed arrays") {
+        int32_t ints[] = {1, -2, 3, -4, 5};
+        double doubles[] = {0.5, 1.5};
+        
+        struct cdts* data = create_cdts(4);
+        cdts_serializer_t* ser = cdts_ser_create(data, NULL);
+        CHECK(cdts_ser_add_int32_array(ser, ints, 5, NULL) == CDTS_SER_SUCCESS);
+        CHECK(cdts_ser_add_float64_array_borrowed(ser, doubles, 2, NULL) == CDTS_SER_SUCCESS);
+        CHECK(cdts_ser_add_uint8_array(ser, NULL, 0, NULL) == CDTS_SER_SUCCESS);
+        
+        // regular CDTS array of int32
+        CHECK(cdts_ser_add_array_begin(ser, 2, metaffi_int32_type, NULL) == CDTS_SER_SUCCESS);
+        CHECK(cdts_ser_add_int32(ser, 7, NULL) == CDTS_SER_SUCCESS);
+        CHECK(cdts_ser_add_int32(ser, 8, NULL) == CDTS_SER_SUCCESS);
+        CHECK(cdts_ser_add_array_end(ser, NULL) == CDTS_SER_SUCCESS);
+        
+        CHECK(data->arr[0].type == metaffi_int32_packed_array_type);
+        CHECK(data->arr[0].cdt_val.packed_array_val->data != ints); // copied
+        CHECK(!data->arr[0].cdt_val.packed_array_val->is_borrowed);
+        CHECK(data->arr[1].cdt_val.packed_array_val->data == doubles);
+        CHECK(data->arr[1].cdt_val.packed_array_val->is_borrowed);
+        
+        ints[0] = 100; // the CDTS holds its own copy
+        
+        cdts_serializer_t* deser = cdts_ser_create(data, NULL);
+        
+        int32_t* out_ints = NULL;
+        metaffi_size out_length = 0;
+        CHECK(cdts_ser_get_int32_array(deser, &out_ints, &out_length, NULL) == CDTS_SER_SUCCESS);
+        REQUIRE(out_length == 5);
+        CHECK(out_ints[0] == 1);
+        CHECK(out_ints[4] == 5);
+        xllr_free_memory(out_ints);
+        
+        const double* borrowed_doubles = NULL;
+        CHECK(cdts_ser_get_float64_array_borrowed(deser, &borrowed_doubles, &out_length, NULL) == CDTS_SER_SUCCESS);
+        CHECK(borrowed_doubles == doubles);
+        CHECK(out_length == 2);
+        
+        uint8_t* out_bytes = (uint8_t*)1;
+        CHECK(cdts_ser_get_uint8_array(deser, &out_bytes, &out_length, NULL) == CDTS_SER_SUCCESS);
+        CHECK(out_bytes == NULL);
+        CHECK(out_length == 0);
+        
+        // a CDTS array can be copied, but not borrowed
+        char* err = NULL;
+        const int32_t* borrowed_ints = NULL;
+        CHECK(cdts_ser_get_int32_array_borrowed(deser, &borrowed_ints, &out_length, &err) == CDTS_SER_ERROR_TYPE_MISMATCH);
+        CHECK(err != NULL);
+        xllr_free_string(err);
+        err = NULL;
+        
+        CHECK(cdts_ser_get_int64_array(deser, (int64_t**)&out_ints, &out_length, &err) == CDTS_SER_ERROR_TYPE_MISMATCH);
+        xllr_free_string(err);
+        
+        CHECK(cdts_ser_get_int32_array(deser, &out_ints, &out_length, NULL) == CDTS_SER_SUCCESS);
+        REQUIRE(out_length == 2);
+        CHECK(out_ints[0] == 7);
+        CHECK(out_ints[1] == 8);
+        xllr_free_memory(out_ints);
+        
+        // the generic functions accept only fixed-size element types
+        err = NULL;
+        CHECK(cdts_ser_add_packed_array(ser, ints, 5, metaffi_string8_type, &err) == CDTS_SER_ERROR_TYPE_MISMATCH);
+        xllr_free_string(err);
+        
+        cdts_ser_destroy(deser);
+        cdts_ser_destroy(ser);
+        free_cdts(data);
+        
+        CHECK(doubles[1] == 1.5);
+    }
+    
+    TEST_CASE("Bulk string8 arrays") {
+        const char* strings[] = {"alpha", NULL, "", "a longer string than the small string capacity"};
+        metaffi_size lengths[] = {3, 0, 0, 8};
+        
+        struct cdts* data = create_cdts(3);
+        cdts_serializer_t* ser = cdts_ser_create(data, NULL);
+        CHECK(cdts_ser_add_string8_array(ser, strings, NULL, 4, NULL) == CDTS_SER_SUCCESS);
+        CHECK(cdts_ser_add_string8_array(ser, strings, lengths, 4, NULL) == CDTS_SER_SUCCESS);
+        
+        CHECK(cdts_ser_add_array_begin(ser, 2, metaffi_string8_type, NULL) == CDTS_SER_SUCCESS);
+        CHECK(cdts_ser_add_string8(ser, "x", NULL) == CDTS_SER_SUCCESS);
+        CHECK(cdts_ser_add_string8(ser, strings[3], NULL) == CDTS_SER_SUCCESS);
+        CHECK(cdts_ser_add_array_end(ser, NULL) == CDTS_SER_SUCCESS);
+        
+        struct cdt_packed_array* packed = data->arr[0].cdt_val.packed_array_val;
+        CHECK(data->arr[0].type == metaffi_string8_packed_array_type);
+        CHECK(packed->is_string_blob);
+        CHECK(metaffi_string_blob_string_length(packed, 0) == 5);
+        CHECK(metaffi_string_blob_string_length(packed, 2) == 0);
+        
+        cdts_serializer_t* deser = cdts_ser_create(data, NULL);
+        
+        char** out = NULL;
+        metaffi_size count = 0;
+        CHECK(cdts_ser_get_string8_array(deser, &out, &count, NULL) == CDTS_SER_SUCCESS);
+        REQUIRE(count == 4);
+        CHECK(strcmp(out[0], "alpha") == 0);
+        CHECK(out[1] == NULL);
+        CHECK(strcmp(out[2], "") == 0);
+        CHECK(strcmp(out[3], strings[3]) == 0);
+        xllr_free_memory(out); // a single allocation
+        
+        const char* const* borrowed = NULL;
+        CHECK(cdts_ser_get_string8_array_borrowed(deser, &borrowed, &count, NULL) == CDTS_SER_SUCCESS);
+        REQUIRE(count == 4);
+        CHECK(strcmp(borrowed[0], "alp") == 0);
+        CHECK(borrowed[1] == NULL);
+        CHECK(strcmp(borrowed[3], "a longer") == 0);
+        
+        CHECK(cdts_ser_get_string8_array(deser, &out, &count, NULL) == CDTS_SER_SUCCESS);
+        REQUIRE(count == 2);
+        CHECK(strcmp(out[0], "x") == 0);
+        CHECK(strcmp(out[1], strings[3]) == 0);
+        xllr_free_memory(out);
+        
+        cdts_ser_destroy(deser);
+        cdts_ser_destroy(ser);
+        free_cdts(data);
+    }
 }
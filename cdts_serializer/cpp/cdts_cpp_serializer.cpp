@@ -9,7 +9,12 @@ namespace metaffi::utils
 // ===== Constructor =====
 
 cdts_cpp_serializer::cdts_cpp_serializer(cdts& pcdts)
-	: data(pcdts), current_index(0)
+	: data(pcdts), current_index(0), arena(nullptr), borrow_packed_arrays(false), pack_tensors(false)
+{
+}
+
+cdts_cpp_serializer::cdts_cpp_serializer(cdts& pcdts, metaffi::runtime::cdts_arena* arena)
+	: data(pcdts), current_index(0), arena(arena), borrow_packed_arrays(false), pack_tensors(false)
 {
 }
 
@@ -25,6 +30,77 @@ void cdts_cpp_serializer::check_bounds(metaffi_size index) const
 	}
 }
 
+cdts& cdts_cpp_serializer::set_new_array_at(cdts& target, metaffi_size index, metaffi_size length, metaffi_int64 fixed_dimensions, metaffi_types common_type)
+{
+	if(arena)
+	{
+		// the arena owns the nested array - the CDT must not delete it
+		target[index].set_array(arena->alloc_cdts(length, fixed_dimensions), common_type);
+		target[index].free_required = false;
+	}
+	else
+	{
+		target[index].set_new_array(length, fixed_dimensions, common_type);
+	}
+
+	return static_cast<cdts&>(target[index]);
+}
+
+cdt_packed_array* cdts_cpp_serializer::alloc_packed_array(metaffi_size length, size_t element_size, size_t element_alignment)
+{
+	if(arena)
+	{
+		return arena->alloc_packed_array(length, element_size, element_alignment);
+	}
+
+	// Allocate packed array struct via xllr_alloc_memory (matching xllr_free_memory in cdt::free_packed_array)
+	cdt_packed_array* packed = static_cast<cdt_packed_array*>(xllr_alloc_memory(sizeof(cdt_packed_array)));
+	if(!packed)
+	{
+		throw std::runtime_error("Failed to allocate packed array");
+	}
+
+	packed->length = length;
+	packed->is_borrowed = 0;
+	packed->is_string_blob = 0;
+	packed->rank = 0;
+	packed->shape = nullptr;
+	packed->strides = nullptr;
+	packed->data = nullptr;
+	if(length > 0)
+	{
+		packed->data = xllr_alloc_memory(length * element_size);
+		if(!packed->data)
+		{
+			xllr_free_memory(packed);
+			throw std::runtime_error("Failed to allocate packed array buffer");
+		}
+	}
+
+	return packed;
+}
+
+void cdts_cpp_serializer::set_packed_array_at(metaffi_size index, cdt_packed_array* packed, metaffi_types element_type)
+{
+	data[index].set_packed_array(packed, element_type);
+	if(arena)
+	{
+		data[index].free_required = false; // owned by the arena
+	}
+}
+
+void cdts_cpp_serializer::set_packed_shape_of(cdt_packed_array* packed, metaffi_size rank, const metaffi_size* shape, const metaffi_int64* strides)
+{
+	if(!arena)
+	{
+		metaffi::runtime::alloc_packed_shape(packed, rank, shape, strides);
+		return;
+	}
+
+	void* shape_buffer = rank > 1 ? arena->alloc(metaffi_packed_shape_size(rank, strides != nullptr), alignof(metaffi_size)) : nullptr;
+	metaffi::runtime::set_packed_shape(packed, shape_buffer, rank, shape, strides);
+}
+
 // ===== SERIALIZATION (C++ → CDT) =====
 
 // Primitives (standard C++ types)
@@ -132,7 +208,7 @@ cdts_cpp_serializer& cdts_cpp_serializer::operator<<(unsigned long long val)
 cdts_cpp_serializer& cdts_cpp_serializer::operator<<(const std::string& val)
 {
 	check_bounds(current_index);
-	data[current_index].set_string((const char8_t*)val.c_str(), true);  // is_copy=true
+	set_string_at(current_index, reinterpret_cast<const char8_t*>(val.c_str()), val.length());
 	current_index++;
 	return *this;
 }
@@ -140,7 +216,7 @@ cdts_cpp_serializer& cdts_cpp_serializer::operator<<(const std::string& val)
 cdts_cpp_serializer& cdts_cpp_serializer::operator<<(const std::u16string& val)
 {
 	check_bounds(current_index);
-	data[current_index].set_string(val.c_str(), true);  // is_copy=true
+	set_string_at(current_index, val.c_str(), val.length());
 	current_index++;
 	return *this;
 }
@@ -148,7 +224,7 @@ cdts_cpp_serializer& cdts_cpp_serializer::operator<<(const std::u16string& val)
 cdts_cpp_serializer& cdts_cpp_serializer::operator<<(const std::u32string& val)
 {
 	check_bounds(current_index);
-	data[current_index].set_string(val.c_str(), true);  // is_copy=true
+	set_string_at(current_index, val.c_str(), val.length());
 	current_index++;
 	return *this;
 }
@@ -156,7 +232,7 @@ cdts_cpp_serializer& cdts_cpp_serializer::operator<<(const std::u32string& val)
 cdts_cpp_serializer& cdts_cpp_serializer::operator<<(const char* val)
 {
 	check_bounds(current_index);
-	data[current_index].set_string((const char8_t*)val, true);  // is_copy=true
+	set_string_at(current_index, reinterpret_cast<const char8_t*>(val), std::strlen(val));
 	current_index++;
 	return *this;
 }
@@ -469,7 +545,8 @@ cdts_cpp_serializer& cdts_cpp_serializer::operator>>(unsigned long long& val)
 cdts_cpp_serializer& cdts_cpp_serializer::operator>>(std::string& val)
 {
 	validate_type_at<std::string>(current_index);
-	val = std::string((const char*)data[current_index].cdt_val.string8_val);
+	std::u8string_view view = data[current_index].get_string8_view();
+	val.assign(reinterpret_cast<const char*>(view.data()), view.size());
 	current_index++;
 	return *this;
 }
@@ -477,7 +554,7 @@ cdts_cpp_serializer& cdts_cpp_serializer::operator>>(std::string& val)
 cdts_cpp_serializer& cdts_cpp_serializer::operator>>(std::u16string& val)
 {
 	validate_type_at<std::u16string>(current_index);
-	val = std::u16string(data[current_index].cdt_val.string16_val);
+	val = data[current_index].get_string16_view();
 	current_index++;
 	return *this;
 }
@@ -485,7 +562,41 @@ cdts_cpp_serializer& cdts_cpp_serializer::operator>>(std::u16string& val)
 cdts_cpp_serializer& cdts_cpp_serializer::operator>>(std::u32string& val)
 {
 	validate_type_at<std::u32string>(current_index);
-	val = std::u32string(data[current_index].cdt_val.string32_val);
+	val = data[current_index].get_string32_view();
+	current_index++;
+	return *this;
+}
+
+// String views
+cdts_cpp_serializer& cdts_cpp_serializer::operator>>(std::string_view& val)
+{
+	validate_type_at<std::string>(current_index);
+	std::u8string_view view = data[current_index].get_string8_view();
+	val = std::string_view(reinterpret_cast<const char*>(view.data()), view.size());
+	current_index++;
+	return *this;
+}
+
+cdts_cpp_serializer& cdts_cpp_serializer::operator>>(std::u8string_view& val)
+{
+	validate_type_at<std::string>(current_index);
+	val = data[current_index].get_string8_view();
+	current_index++;
+	return *this;
+}
+
+cdts_cpp_serializer& cdts_cpp_serializer::operator>>(std::u16string_view& val)
+{
+	validate_type_at<std::u16string>(current_index);
+	val = data[current_index].get_string16_view();
+	current_index++;
+	return *this;
+}
+
+cdts_cpp_serializer& cdts_cpp_serializer::operator>>(std::u32string_view& val)
+{
+	validate_type_at<std::u32string>(current_index);
+	val = data[current_index].get_string32_view();
 	current_index++;
 	return *this;
 }
@@ -727,7 +838,10 @@ cdts_cpp_serializer::cdts_any_variant cdts_cpp_serializer::extract_any()
 		case metaffi_string8_type:
 		{
 			cdt& source = data[current_index];
-			metaffi_string8 val = source.cdt_val.string8_val;
+			// the caller owns the returned string - inline small strings are copied out of the CDT
+			metaffi_string8 val = source.is_small_string ?
+				xllr_alloc_string8(source.cdt_val.small_string_val.string8, source.small_string_length) :
+				source.cdt_val.string8_val;
 			source.free_required = false;
 			current_index++;
 			return val;
@@ -735,7 +849,10 @@ cdts_cpp_serializer::cdts_any_variant cdts_cpp_serializer::extract_any()
 		case metaffi_string16_type:
 		{
 			cdt& source = data[current_index];
-			metaffi_string16 val = source.cdt_val.string16_val;
+			// the caller owns the returned string - inline small strings are copied out of the CDT
+			metaffi_string16 val = source.is_small_string ?
+				xllr_alloc_string16(source.cdt_val.small_string_val.string16, source.small_string_length) :
+				source.cdt_val.string16_val;
 			source.free_required = false;
 			current_index++;
 			return val;
@@ -743,7 +860,10 @@ cdts_cpp_serializer::cdts_any_variant cdts_cpp_serializer::extract_any()
 		case metaffi_string32_type:
 		{
 			cdt& source = data[current_index];
-			metaffi_string32 val = source.cdt_val.string32_val;
+			// the caller owns the returned string - inline small strings are copied out of the CDT
+			metaffi_string32 val = source.is_small_string ?
+				xllr_alloc_string32(source.cdt_val.small_string_val.string32, source.small_string_length) :
+				source.cdt_val.string32_val;
 			source.free_required = false;
 			current_index++;
 			return val;
@@ -775,6 +895,23 @@ metaffi_type cdts_cpp_serializer::peek_type() const
 	return data[current_index].type;
 }
 
+std::vector<metaffi_size> cdts_cpp_serializer::peek_packed_shape() const
+{
+	check_bounds(current_index);
+	if(!metaffi_is_packed_array(data[current_index].type) || !data[current_index].cdt_val.packed_array_val)
+	{
+		throw std::runtime_error("peek_packed_shape: element is not a packed array");
+	}
+
+	const cdt_packed_array* packed = data[current_index].cdt_val.packed_array_val;
+	std::vector<metaffi_size> shape(metaffi::runtime::packed_rank(packed));
+	for(metaffi_size dim = 0; dim < shape.size(); dim++)
+	{
+		shape[dim] = metaffi::runtime::packed_extent(packed, dim);
+	}
+	return shape;
+}
+
 bool cdts_cpp_serializer::is_null() const
 {
 	check_bounds(current_index);
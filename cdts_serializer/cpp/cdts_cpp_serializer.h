@@ -1,18 +1,117 @@
 #pragma once
 
 #include <runtime/cdt.h>
+#include <runtime/cdts_arena.h>
 #include <runtime/metaffi_primitives.h>
+#include <runtime/packed_string_blob.h>
+#include <runtime/packed_tensor.h>
 #include <runtime/xllr_capi_loader.h>
+#include <algorithm>
+#include <array>
+#include <ranges>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <variant>
 #include <stdexcept>
 #include <sstream>
 #include <type_traits>
+#include <version>
+#if __has_include(<mdspan>)
+#include <mdspan>
+#endif
 
 namespace metaffi::utils
 {
 
+/**
+ * @brief Elements allocated with xllr_alloc_memory, freed with xllr_free_memory.
+ *
+ * Returned by the take-ownership extractors of cdts_cpp_serializer: the elements of a packed array
+ * (with its shape) or the code units of a string (NULL terminated), moved out of the CDT without copying.
+ */
+template<typename T>
+class xllr_buffer
+{
+public:
+	xllr_buffer() = default;
+
+	/**
+	 * @param data Allocated with xllr_alloc_memory (owned by the buffer)
+	 * @param shape Extents of a packed tensor (empty: a 1D array of size elements)
+	 */
+	xllr_buffer(T* data, size_t size, std::vector<metaffi_size> shape = {}) : _data(data), _size(size), _shape(std::move(shape))
+	{
+		if(_shape.empty())
+		{
+			_shape.push_back(static_cast<metaffi_size>(size));
+		}
+	}
+
+	xllr_buffer(const xllr_buffer&) = delete;
+	xllr_buffer& operator=(const xllr_buffer&) = delete;
+
+	xllr_buffer(xllr_buffer&& other) noexcept : _data(other._data), _size(other._size), _shape(std::move(other._shape))
+	{
+		other._data = nullptr;
+		other._size = 0;
+	}
+
+	xllr_buffer& operator=(xllr_buffer&& other) noexcept
+	{
+		if(this != &other)
+		{
+			reset();
+			_data = other._data;
+			_size = other._size;
+			_shape = std::move(other._shape);
+			other._data = nullptr;
+			other._size = 0;
+		}
+		return *this;
+	}
+
+	~xllr_buffer()
+	{
+		reset();
+	}
+
+	[[nodiscard]] T* data() const { return _data; }
+	[[nodiscard]] size_t size() const { return _size; }
+	[[nodiscard]] bool empty() const { return _size == 0; }
+	[[nodiscard]] std::span<T> span() const { return {_data, _size}; }
+
+	/// @brief Extents of the elements, outermost first ({size()} for 1D arrays and strings)
+	[[nodiscard]] const std::vector<metaffi_size>& shape() const { return _shape; }
+
+	/// @brief Give up ownership of the elements. The caller frees them with xllr_free_memory.
+	T* release()
+	{
+		T* data = _data;
+		_data = nullptr;
+		_size = 0;
+		_shape.clear();
+		return data;
+	}
+
+	void reset()
+	{
+		if(_data)
+		{
+			xllr_free_memory(_data);
+		}
+		_data = nullptr;
+		_size = 0;
+		_shape.clear();
+	}
+
+private:
+	T* _data = nullptr;
+	size_t _size = 0;
+	std::vector<metaffi_size> _shape;
+};
+
 /**
  * @brief CDTS C++ Serializer/Deserializer
  *
@@ -34,6 +133,25 @@ namespace metaffi::utils
  * std::vector<std::vector<int32_t>> matrix = {{1,2},{3,4}};
  * ser << matrix;  // Automatically handles 2D structure
  *
+ * // Packed N-D tensors (a single buffer instead of a CDT per element)
+ * ser.set_pack_tensors(true);
+ * ser << matrix;  // 2x2 packed int32 tensor
+ * ser.add_packed_tensor(values.data(), 2, shape);
+ *
+ * // Arena-backed serialization (strings, nested and packed arrays are allocated from the arena)
+ * metaffi::runtime::cdts_arena_scope scope(metaffi::runtime::cdts_arena::thread_local_instance());
+ * cdts params(scope.get().alloc_cdt_array(2), 2, MIXED_OR_UNKNOWN_DIMENSIONS, 1);
+ * cdts_cpp_serializer arena_ser(params, &scope.get());
+ * arena_ser << std::string("hello") << std::vector<double>{1.0, 2.0};
+ *
+ * // Zero-copy views - valid until the CDTS is destroyed (or its element is overwritten)
+ * std::u8string_view text; std::span<const double> values;
+ * deser >> text >> values;
+ *
+ * // Take ownership of a returned buffer without copying it
+ * xllr_buffer<double> owned;
+ * deser >> owned;  // the CDT no longer frees the elements - owned does
+ *
  * // ANY type handling
  * auto value = ser.extract_any();  // Returns std::variant
  * if (ser.peek_type() == metaffi_int32_type) {
@@ -53,6 +171,9 @@ public:
 private:
 	cdts& data;
 	metaffi_size current_index;
+	metaffi::runtime::cdts_arena* arena;
+	bool borrow_packed_arrays;
+	bool pack_tensors;
 
 	// ===== Type Traits =====
 
@@ -103,6 +224,28 @@ private:
 	template<typename T>
 	static constexpr metaffi_type get_metaffi_type();
 
+	/**
+	 * @brief Numeric element types (serialized as packed arrays)
+	 */
+	template<typename T>
+	static constexpr bool is_packed_element = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && get_metaffi_type<T>() != metaffi_any_type;
+
+	/**
+	 * @brief Contiguous sized ranges of numeric elements, other than std::vector (see operator<<(const R&))
+	 */
+	template<typename R>
+	static constexpr bool is_packable_range = []()
+	{
+		if constexpr (std::ranges::contiguous_range<R> && std::ranges::sized_range<R> && !is_vector<std::remove_cvref_t<R>>::value)
+		{
+			return is_packed_element<std::remove_cv_t<std::ranges::range_value_t<R>>>;
+		}
+		else
+		{
+			return false;
+		}
+	}();
+
 	/**
 	 * @brief Validate that CDT at index matches expected type
 	 * @throws std::runtime_error if type mismatch
@@ -110,6 +253,67 @@ private:
 	template<typename T>
 	void validate_type_at(metaffi_size index) const;
 
+	/**
+	 * @brief Set a copy of a string at index (arena copy if serializing into an arena)
+	 */
+	template<typename char_t>
+	void set_string_at(metaffi_size index, const char_t* val, size_t length);
+
+	/**
+	 * @brief Set a new nested array at target[index] (arena allocated if serializing into an arena)
+	 * @return The new nested array
+	 */
+	cdts& set_new_array_at(cdts& target, metaffi_size index, metaffi_size length, metaffi_int64 fixed_dimensions, metaffi_types common_type);
+
+	/**
+	 * @brief Allocate a packed array header and a buffer of length elements (from the arena if set)
+	 */
+	cdt_packed_array* alloc_packed_array(metaffi_size length, size_t element_size, size_t element_alignment);
+
+	/**
+	 * @brief Set packed array at index. Arena packed arrays are not owned by the CDT.
+	 */
+	void set_packed_array_at(metaffi_size index, cdt_packed_array* packed, metaffi_types element_type);
+
+	/**
+	 * @brief Set the shape of packed (from the arena if set). See metaffi::runtime::set_packed_shape.
+	 */
+	void set_packed_shape_of(cdt_packed_array* packed, metaffi_size rank, const metaffi_size* shape, const metaffi_int64* strides);
+
+	/**
+	 * @brief Shape of rectangular nested vectors (one extent per depth)
+	 * @return false if the nested vectors are ragged
+	 */
+	template<typename T>
+	static bool nested_vector_shape(const std::vector<T>& vec, std::vector<metaffi_size>& shape, size_t dim);
+
+	/**
+	 * @brief Copy the elements of rectangular nested vectors to out in row-major order
+	 * @return The end of the copied elements
+	 */
+	template<typename T, typename E>
+	static E* flatten_nested_vector(const std::vector<T>& vec, E* out);
+
+	/**
+	 * @brief Fill nested vectors of shape from row-major elements
+	 * @return The end of the consumed elements
+	 */
+	template<typename T, typename E>
+	static const E* unflatten_nested_vector(std::vector<T>& vec, const metaffi_size* shape, const E* in);
+
+	/**
+	 * @brief The packed array of T elements at index (nullptr for a null packed array)
+	 * @throws std::runtime_error if the CDT at index is not a packed array of T
+	 */
+	template<typename T>
+	const cdt_packed_array* packed_array_at(metaffi_size index) const;
+
+	/**
+	 * @brief The string pointer of a string CDT of char_t code units (not inline small strings)
+	 */
+	template<typename char_t>
+	static char_t*& string_pointer_of(cdt& item);
+
 public:
 	/**
 	 * @brief Construct serializer wrapping existing CDTS
@@ -117,6 +321,29 @@ public:
 	 */
 	explicit cdts_cpp_serializer(cdts& pcdts);
 
+	/**
+	 * @brief Construct serializer that allocates strings, nested and packed arrays from an arena
+	 * @param pcdts Reference to CDTS
+	 * @param arena Arena to allocate from (nullptr to use xllr_alloc_memory). Must outlive pcdts.
+	 */
+	cdts_cpp_serializer(cdts& pcdts, metaffi::runtime::cdts_arena* arena);
+
+	/**
+	 * @brief Serialize 1D vectors of numeric types as borrowed packed arrays pointing to the vector's buffer (no copy).
+	 * Use only if the serialized vectors outlive the CDTS (e.g. input parameters of a call).
+	 * bool and string vectors are still copied.
+	 */
+	void set_borrow_packed_arrays(bool borrow) { borrow_packed_arrays = borrow; }
+	[[nodiscard]] bool is_borrowing_packed_arrays() const { return borrow_packed_arrays; }
+
+	/**
+	 * @brief Serialize rectangular multi-dimensional vectors of numeric/bool types as packed N-D tensors
+	 * (a single buffer, see cdt_packed_array) instead of nested CDTS arrays with a CDT per element.
+	 * Enable only if the receiving runtime reads packed tensors. Ragged vectors stay nested CDTS arrays.
+	 */
+	void set_pack_tensors(bool pack) { pack_tensors = pack; }
+	[[nodiscard]] bool is_packing_tensors() const { return pack_tensors; }
+
 	// ===== SERIALIZATION (C++ → CDT) =====
 
 	// Primitives (standard C++ types)
@@ -151,6 +378,30 @@ public:
 	template<typename T>
 	cdts_cpp_serializer& operator<<(const std::vector<T>& vec);
 
+	/**
+	 * @brief Serialize a contiguous range of numeric elements (std::span, std::array, ...) as a packed array.
+	 * The elements are copied with a single memcpy, or borrowed if is_borrowing_packed_arrays().
+	 * For a pointer and a length, serialize std::span(pointer, length).
+	 */
+	template<typename R>
+	cdts_cpp_serializer& operator<<(const R& range) requires is_packable_range<R>;
+
+	/**
+	 * @brief Serialize a packed N-D tensor of numeric elements
+	 * @param values Elements of the tensor (row-major if strides is nullptr)
+	 * @param shape rank extents, outermost first
+	 * @param strides Optional rank strides in elements. Strided tensors are copied to a contiguous buffer.
+	 * Contiguous tensors are borrowed if is_borrowing_packed_arrays().
+	 */
+	template<typename T>
+	cdts_cpp_serializer& add_packed_tensor(const T* values, metaffi_size rank, const metaffi_size* shape, const metaffi_int64* strides = nullptr);
+
+#if defined(__cpp_lib_mdspan)
+	// Tensors - serialized as packed N-D tensors
+	template<typename T, typename Extents, typename Layout, typename Accessor>
+	cdts_cpp_serializer& operator<<(const std::mdspan<T, Extents, Layout, Accessor>& tensor);
+#endif
+
 	// Handles
 	cdts_cpp_serializer& operator<<(metaffi_handle val);
 	cdts_cpp_serializer& operator<<(const cdt_metaffi_handle& handle);
@@ -193,15 +444,51 @@ public:
 	cdts_cpp_serializer& operator>>(std::u16string& val);
 	cdts_cpp_serializer& operator>>(std::u32string& val);
 
+	// String views - point into the CDTS (no copy), valid as long as the CDTS
+	cdts_cpp_serializer& operator>>(std::string_view& val);
+	cdts_cpp_serializer& operator>>(std::u8string_view& val);
+	cdts_cpp_serializer& operator>>(std::u16string_view& val);
+	cdts_cpp_serializer& operator>>(std::u32string_view& val);
+
 	// Characters
 	cdts_cpp_serializer& operator>>(metaffi_char8& val);
 	cdts_cpp_serializer& operator>>(metaffi_char16& val);
 	cdts_cpp_serializer& operator>>(metaffi_char32& val);
 
-	// Arrays - automatic multi-level nesting
+	// Arrays - automatic multi-level nesting (also from packed tensors of the same rank)
 	template<typename T>
 	cdts_cpp_serializer& operator>>(std::vector<T>& vec);
 
+	/**
+	 * @brief View of the elements of a packed numeric array (row-major for N-D tensors), valid as long as the CDTS.
+	 * @throws std::runtime_error if the element is not a packed array of T, or a strided tensor (use std::vector or mdspan)
+	 */
+	template<typename T>
+	cdts_cpp_serializer& operator>>(std::span<const T>& view);
+
+	/**
+	 * @brief Take ownership of a string (char8_t/char16_t/char32_t) or a packed numeric array (see xllr_buffer).
+	 * The CDT gives up its buffer without copying; buffers the CDT does not own (arena, borrowed,
+	 * inline small strings) and strided tensors are copied.
+	 */
+	template<typename T>
+	cdts_cpp_serializer& operator>>(xllr_buffer<T>& buffer);
+
+#if defined(__cpp_lib_mdspan)
+	// Tensors - copies a packed tensor into the mdspan's elements. Extents must match.
+	template<typename T, typename Extents, typename Layout, typename Accessor>
+	cdts_cpp_serializer& operator>>(const std::mdspan<T, Extents, Layout, Accessor>& tensor);
+
+	/**
+	 * @brief View of a packed tensor (no copy), valid as long as the CDTS.
+	 * layout_right views require a contiguous tensor, layout_stride views take the tensor's strides.
+	 * @throws std::runtime_error if the rank, static extents or element type do not match
+	 */
+	template<typename T, typename Extents, typename Layout>
+		requires std::is_const_v<T>
+	cdts_cpp_serializer& operator>>(std::mdspan<T, Extents, Layout>& view);
+#endif
+
 	// Handles
 	cdts_cpp_serializer& operator>>(metaffi_handle& val);
 	cdts_cpp_serializer& operator>>(cdt_metaffi_handle& handle);
@@ -231,6 +518,12 @@ public:
 	 */
 	metaffi_type peek_type() const;
 
+	/**
+	 * @brief Shape of the packed array at current index (a single extent for 1D packed arrays)
+	 * @throws std::runtime_error if the current element is not a packed array
+	 */
+	std::vector<metaffi_size> peek_packed_shape() const;
+
 	/**
 	 * @brief Check if current element is null
 	 */
@@ -308,6 +601,323 @@ void cdts_cpp_serializer::validate_type_at(metaffi_size index) const
 	}
 }
 
+template<typename T>
+const cdt_packed_array* cdts_cpp_serializer::packed_array_at(metaffi_size index) const
+{
+	check_bounds(index);
+
+	if(!metaffi_is_packed_array(data[index].type) || metaffi_packed_element_type(data[index].type) != get_metaffi_type<T>())
+	{
+		std::stringstream ss;
+		ss << "Type mismatch at index " << index << ": expected packed array of type " << get_metaffi_type<T>() << ", got type " << data[index].type;
+		throw std::runtime_error(ss.str());
+	}
+
+	return data[index].cdt_val.packed_array_val;
+}
+
+template<typename char_t>
+char_t*& cdts_cpp_serializer::string_pointer_of(cdt& item)
+{
+	if constexpr (std::is_same_v<char_t, char8_t>) return item.cdt_val.string8_val;
+	else if constexpr (std::is_same_v<char_t, char16_t>) return item.cdt_val.string16_val;
+	else return item.cdt_val.string32_val;
+}
+
+template<typename char_t>
+void cdts_cpp_serializer::set_string_at(metaffi_size index, const char_t* val, size_t length)
+{
+	if(arena && length > metaffi_small_string_capacity(sizeof(char_t))) // small strings are stored inline anyway
+	{
+		data[index].set_string(arena->copy_string(val, length), length, false);
+	}
+	else
+	{
+		data[index].set_string(val, length, true);
+	}
+}
+
+template<typename T>
+bool cdts_cpp_serializer::nested_vector_shape(const std::vector<T>& vec, std::vector<metaffi_size>& shape, size_t dim)
+{
+	if(shape.size() == dim)
+	{
+		shape.push_back(static_cast<metaffi_size>(vec.size()));
+	}
+	else if(shape[dim] != vec.size())
+	{
+		return false;
+	}
+
+	if constexpr (is_vector<T>::value)
+	{
+		if(vec.empty() && shape.size() == dim + 1)
+		{
+			shape.resize(array_depth<std::vector<T>>::value + dim, 0); // no elements - inner extents are 0
+		}
+
+		for(const T& inner : vec)
+		{
+			if(!nested_vector_shape(inner, shape, dim + 1))
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+template<typename T, typename E>
+E* cdts_cpp_serializer::flatten_nested_vector(const std::vector<T>& vec, E* out)
+{
+	if constexpr (is_vector<T>::value)
+	{
+		for(const T& inner : vec)
+		{
+			out = flatten_nested_vector(inner, out);
+		}
+		return out;
+	}
+	else if constexpr (std::is_same_v<T, bool>)
+	{
+		for(bool val : vec)
+		{
+			*out++ = val ? 1 : 0;
+		}
+		return out;
+	}
+	else
+	{
+		if(!vec.empty())
+		{
+			std::memcpy(out, vec.data(), vec.size() * sizeof(T));
+		}
+		return out + vec.size();
+	}
+}
+
+template<typename T, typename E>
+const E* cdts_cpp_serializer::unflatten_nested_vector(std::vector<T>& vec, const metaffi_size* shape, const E* in)
+{
+	vec.resize(shape[0]);
+
+	if constexpr (is_vector<T>::value)
+	{
+		for(T& inner : vec)
+		{
+			in = unflatten_nested_vector(inner, shape + 1, in);
+		}
+		return in;
+	}
+	else if constexpr (std::is_same_v<T, bool>)
+	{
+		for(size_t i = 0; i < vec.size(); ++i)
+		{
+			vec[i] = in[i] != 0;
+		}
+		return in + vec.size();
+	}
+	else
+	{
+		if(!vec.empty())
+		{
+			std::memcpy(vec.data(), in, vec.size() * sizeof(T));
+		}
+		return in + vec.size();
+	}
+}
+
+template<typename T>
+cdts_cpp_serializer& cdts_cpp_serializer::add_packed_tensor(const T* values, metaffi_size rank, const metaffi_size* shape, const metaffi_int64* strides)
+{
+	static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && get_metaffi_type<T>() != metaffi_any_type, "packed tensors elements must be numeric");
+	check_bounds(current_index);
+
+	metaffi_size length = rank > 0 ? 1 : 0;
+	for(metaffi_size dim = 0; dim < rank; dim++)
+	{
+		length *= shape[dim];
+	}
+
+	// view of the caller's elements - decides contiguity and copies strided elements
+	cdt_packed_array view(const_cast<T*>(values), length, true);
+	if(rank > 1)
+	{
+		view.rank = rank;
+		view.shape = const_cast<metaffi_size*>(shape);
+		view.strides = const_cast<metaffi_int64*>(strides);
+	}
+	bool strided_1d = rank == 1 && strides && strides[0] != 1;
+	bool contiguous = !strided_1d && metaffi::runtime::packed_is_contiguous(&view);
+
+	cdt_packed_array* packed = nullptr;
+	if(borrow_packed_arrays && contiguous)
+	{
+		packed = alloc_packed_array(0, sizeof(T), alignof(T));
+		packed->data = const_cast<T*>(values);
+		packed->is_borrowed = 1;
+	}
+	else
+	{
+		packed = alloc_packed_array(length, sizeof(T), alignof(T));
+		if(strided_1d)
+		{
+			for(metaffi_size i = 0; i < length; i++)
+			{
+				static_cast<T*>(packed->data)[i] = values[static_cast<metaffi_int64>(i) * strides[0]];
+			}
+		}
+		else if(length > 0)
+		{
+			metaffi::runtime::copy_packed_elements(&view, sizeof(T), packed->data);
+		}
+	}
+
+	set_packed_array_at(current_index, packed, static_cast<metaffi_types>(get_metaffi_type<T>()));
+	set_packed_shape_of(packed, rank, shape, nullptr);
+	current_index++;
+	return *this;
+}
+
+#if defined(__cpp_lib_mdspan)
+template<typename T, typename Extents, typename Layout, typename Accessor>
+cdts_cpp_serializer& cdts_cpp_serializer::operator<<(const std::mdspan<T, Extents, Layout, Accessor>& tensor)
+{
+	static_assert(std::is_same_v<Accessor, std::default_accessor<T>>, "only mdspans of plain element pointers can be packed");
+
+	constexpr size_t rank = Extents::rank();
+	metaffi_size shape[rank > 0 ? rank : 1] = {};
+	metaffi_int64 strides[rank > 0 ? rank : 1] = {};
+	for(size_t dim = 0; dim < rank; dim++)
+	{
+		shape[dim] = static_cast<metaffi_size>(tensor.extent(dim));
+		strides[dim] = static_cast<metaffi_int64>(tensor.stride(dim));
+	}
+
+	using element_t = std::remove_const_t<T>;
+	return add_packed_tensor<element_t>(tensor.data_handle(), rank, shape, tensor.is_exhaustive() && std::is_same_v<Layout, std::layout_right> ? nullptr : strides);
+}
+
+template<typename T, typename Extents, typename Layout, typename Accessor>
+cdts_cpp_serializer& cdts_cpp_serializer::operator>>(const std::mdspan<T, Extents, Layout, Accessor>& tensor)
+{
+	static_assert(!std::is_const_v<T> && std::is_same_v<Accessor, std::default_accessor<T>>, "packed tensors are copied into mdspans of mutable plain element pointers");
+	check_bounds(current_index);
+
+	if(!metaffi_is_packed_array(data[current_index].type) || metaffi_packed_element_type(data[current_index].type) != get_metaffi_type<T>())
+	{
+		std::stringstream ss;
+		ss << "Type mismatch at index " << current_index << ": expected packed tensor of type " << get_metaffi_type<T>() << ", got type " << data[current_index].type;
+		throw std::runtime_error(ss.str());
+	}
+
+	const cdt_packed_array* packed = data[current_index].cdt_val.packed_array_val;
+	constexpr size_t rank = Extents::rank();
+	if(metaffi::runtime::packed_rank(packed) != rank)
+	{
+		throw std::runtime_error("Packed tensor rank does not match the mdspan rank");
+	}
+
+	for(size_t dim = 0; dim < rank; dim++)
+	{
+		if(metaffi::runtime::packed_extent(packed, dim) != static_cast<metaffi_size>(tensor.extent(dim)))
+		{
+			throw std::runtime_error("Packed tensor extents do not match the mdspan extents");
+		}
+	}
+
+	// copy_packed_elements writes row-major - other layouts are filled from a row-major copy
+	if(tensor.is_exhaustive() && std::is_same_v<Layout, std::layout_right>)
+	{
+		metaffi::runtime::copy_packed_elements(packed, sizeof(T), tensor.data_handle());
+	}
+	else
+	{
+		std::vector<T> flat(packed->length);
+		metaffi::runtime::copy_packed_elements(packed, sizeof(T), flat.data());
+
+		metaffi_size index[rank > 0 ? rank : 1] = {};
+		for(metaffi_size i = 0; i < packed->length; i++)
+		{
+			size_t offset = 0;
+			for(size_t dim = 0; dim < rank; dim++)
+			{
+				offset += index[dim] * tensor.stride(dim);
+			}
+			tensor.data_handle()[offset] = flat[i];
+
+			for(size_t dim = rank; dim-- > 0;)
+			{
+				if(++index[dim] < static_cast<metaffi_size>(tensor.extent(dim)))
+				{
+					break;
+				}
+				index[dim] = 0;
+			}
+		}
+	}
+
+	current_index++;
+	return *this;
+}
+template<typename T, typename Extents, typename Layout>
+	requires std::is_const_v<T>
+cdts_cpp_serializer& cdts_cpp_serializer::operator>>(std::mdspan<T, Extents, Layout>& view)
+{
+	static_assert(std::is_same_v<Layout, std::layout_right> || std::is_same_v<Layout, std::layout_stride>, "packed tensor views are layout_right or layout_stride mdspans");
+
+	using element_t = std::remove_const_t<T>;
+	using index_t = typename Extents::index_type;
+	constexpr size_t rank = Extents::rank();
+
+	const cdt_packed_array* packed = packed_array_at<element_t>(current_index);
+	if(!packed || metaffi::runtime::packed_rank(packed) != rank)
+	{
+		throw std::runtime_error("Packed tensor rank does not match the mdspan rank");
+	}
+
+	std::array<index_t, rank> extents{};
+	for(size_t dim = 0; dim < rank; dim++)
+	{
+		extents[dim] = static_cast<index_t>(metaffi::runtime::packed_extent(packed, dim));
+		if(Extents::static_extent(dim) != std::dynamic_extent && Extents::static_extent(dim) != static_cast<size_t>(extents[dim]))
+		{
+			throw std::runtime_error("Packed tensor extents do not match the mdspan extents");
+		}
+	}
+
+	T* elements = static_cast<T*>(packed->data);
+	if constexpr (std::is_same_v<Layout, std::layout_right>)
+	{
+		if(!metaffi::runtime::packed_is_contiguous(packed))
+		{
+			throw std::runtime_error("Strided packed tensor cannot be viewed as a layout_right mdspan - use layout_stride");
+		}
+		view = std::mdspan<T, Extents, Layout>(elements, Extents(extents));
+	}
+	else
+	{
+		std::array<index_t, rank> strides{};
+		index_t row_major_stride = 1;
+		for(size_t dim = rank; dim-- > 0;)
+		{
+			metaffi_int64 stride = metaffi_packed_is_tensor(packed) && packed->strides ? packed->strides[dim] : static_cast<metaffi_int64>(row_major_stride);
+			if(stride < 0)
+			{
+				throw std::runtime_error("Packed tensor with negative strides cannot be viewed as an mdspan");
+			}
+			strides[dim] = static_cast<index_t>(stride);
+			row_major_stride *= extents[dim];
+		}
+		view = std::mdspan<T, Extents, Layout>(elements, typename Layout::template mapping<Extents>(Extents(extents), strides));
+	}
+
+	current_index++;
+	return *this;
+}
+#endif
+
 template<typename T>
 cdts_cpp_serializer& cdts_cpp_serializer::operator<<(const std::vector<T>& vec)
 {
@@ -318,17 +928,42 @@ cdts_cpp_serializer& cdts_cpp_serializer::operator<<(const std::vector<T>& vec)
 	using ElementType = typename vector_element_type<std::vector<T>>::type;
 	constexpr metaffi_type common_type = get_metaffi_type<ElementType>();
 
+	// Rectangular multi-dimensional numeric/bool vectors: a single packed N-D tensor buffer
+	if constexpr (depth >= 2 && std::is_arithmetic_v<ElementType> && common_type != metaffi_any_type)
+	{
+		std::vector<metaffi_size> shape;
+		if(pack_tensors && data.fixed_dimensions == MIXED_OR_UNKNOWN_DIMENSIONS && nested_vector_shape(vec, shape, 0))
+		{
+			using storage_t = std::conditional_t<std::is_same_v<ElementType, bool>, metaffi_bool, ElementType>;
+
+			metaffi_size length = 1;
+			for(metaffi_size extent : shape)
+			{
+				length *= extent;
+			}
+
+			cdt_packed_array* packed = alloc_packed_array(length, sizeof(storage_t), alignof(storage_t));
+			set_packed_array_at(current_index, packed, static_cast<metaffi_types>(common_type));
+			if(length > 0)
+			{
+				flatten_nested_vector(vec, static_cast<storage_t*>(packed->data));
+			}
+			set_packed_shape_of(packed, static_cast<metaffi_size>(shape.size()), shape.data(), nullptr);
+
+			current_index++;
+			return *this;
+		}
+	}
+
 	// Special-case: vector<vector<uint8_t/int8_t>> -> array of bytes buffers (list of bytes)
 	if constexpr (depth == 2 && (std::is_same_v<ElementType, metaffi_uint8> || std::is_same_v<ElementType, metaffi_int8>))
 	{
-		data[current_index].set_new_array(vec.size(), 1, metaffi_any_type);
-		cdts& arr = static_cast<cdts&>(data[current_index]);
+		cdts& arr = set_new_array_at(data, current_index, vec.size(), 1, metaffi_any_type);
 		for(size_t i = 0; i < vec.size(); ++i)
 		{
 			const auto& inner = vec[i];
 			const metaffi_types inner_type = std::is_same_v<ElementType, metaffi_uint8> ? metaffi_uint8_type : metaffi_int8_type;
-			arr[i].set_new_array(inner.size(), 1, inner_type);
-			cdts& inner_arr = static_cast<cdts&>(arr[i]);
+			cdts& inner_arr = set_new_array_at(arr, i, inner.size(), 1, inner_type);
 			for(size_t j = 0; j < inner.size(); ++j)
 			{
 				inner_arr[j] = inner[j];
@@ -347,9 +982,8 @@ cdts_cpp_serializer& cdts_cpp_serializer::operator<<(const std::vector<T>& vec)
 	{
 		if(data.fixed_dimensions != MIXED_OR_UNKNOWN_DIMENSIONS)
 		{
-			data[current_index].set_new_array(vec.size(), 1, static_cast<metaffi_types>(common_type));
-			cdts& arr = static_cast<cdts&>(data[current_index]);
-			cdts_cpp_serializer nested(arr);
+			cdts& arr = set_new_array_at(data, current_index, vec.size(), 1, static_cast<metaffi_types>(common_type));
+			cdts_cpp_serializer nested(arr, arena);
 			for(size_t i = 0; i < vec.size(); ++i)
 			{
 				nested.set_index(i);
@@ -360,116 +994,76 @@ cdts_cpp_serializer& cdts_cpp_serializer::operator<<(const std::vector<T>& vec)
 			return *this;
 		}
 
-		// Allocate packed array struct via xllr_alloc_memory (matching xllr_free_memory in cdt::free_packed_array)
-		cdt_packed_array* packed = static_cast<cdt_packed_array*>(xllr_alloc_memory(sizeof(cdt_packed_array)));
-		packed->length = static_cast<metaffi_size>(vec.size());
-
-		if (vec.empty())
-		{
-			packed->data = nullptr;
-			data[current_index].set_packed_array(packed, static_cast<metaffi_types>(common_type));
-			current_index++;
-			return *this;
-		}
-
-		// Allocate and copy data based on element type.
-		// All data buffers use xllr_alloc_memory to match xllr_free_memory in free_packed_array.
-		if constexpr (std::is_same_v<T, metaffi_int8>)
-		{
-			auto* buf = static_cast<metaffi_int8*>(xllr_alloc_memory(vec.size() * sizeof(metaffi_int8)));
-			std::memcpy(buf, vec.data(), vec.size() * sizeof(metaffi_int8));
-			packed->data = buf;
-		}
-		else if constexpr (std::is_same_v<T, metaffi_uint8>)
-		{
-			auto* buf = static_cast<metaffi_uint8*>(xllr_alloc_memory(vec.size() * sizeof(metaffi_uint8)));
-			std::memcpy(buf, vec.data(), vec.size() * sizeof(metaffi_uint8));
-			packed->data = buf;
-		}
-		else if constexpr (std::is_same_v<T, metaffi_int16>)
-		{
-			auto* buf = static_cast<metaffi_int16*>(xllr_alloc_memory(vec.size() * sizeof(metaffi_int16)));
-			std::memcpy(buf, vec.data(), vec.size() * sizeof(metaffi_int16));
-			packed->data = buf;
-		}
-		else if constexpr (std::is_same_v<T, metaffi_uint16>)
-		{
-			auto* buf = static_cast<metaffi_uint16*>(xllr_alloc_memory(vec.size() * sizeof(metaffi_uint16)));
-			std::memcpy(buf, vec.data(), vec.size() * sizeof(metaffi_uint16));
-			packed->data = buf;
-		}
-		else if constexpr (std::is_same_v<T, metaffi_int32>)
+		// Allocate the packed array and copy data based on element type.
+		// Without an arena, all buffers use xllr_alloc_memory to match xllr_free_memory in free_packed_array.
+		cdt_packed_array* packed = nullptr;
+		if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && common_type != metaffi_any_type)
 		{
-			auto* buf = static_cast<metaffi_int32*>(xllr_alloc_memory(vec.size() * sizeof(metaffi_int32)));
-			std::memcpy(buf, vec.data(), vec.size() * sizeof(metaffi_int32));
-			packed->data = buf;
-		}
-		else if constexpr (std::is_same_v<T, metaffi_uint32>)
-		{
-			auto* buf = static_cast<metaffi_uint32*>(xllr_alloc_memory(vec.size() * sizeof(metaffi_uint32)));
-			std::memcpy(buf, vec.data(), vec.size() * sizeof(metaffi_uint32));
-			packed->data = buf;
-		}
-		else if constexpr (std::is_same_v<T, metaffi_int64>)
-		{
-			auto* buf = static_cast<metaffi_int64*>(xllr_alloc_memory(vec.size() * sizeof(metaffi_int64)));
-			std::memcpy(buf, vec.data(), vec.size() * sizeof(metaffi_int64));
-			packed->data = buf;
-		}
-		else if constexpr (std::is_same_v<T, metaffi_uint64>)
-		{
-			auto* buf = static_cast<metaffi_uint64*>(xllr_alloc_memory(vec.size() * sizeof(metaffi_uint64)));
-			std::memcpy(buf, vec.data(), vec.size() * sizeof(metaffi_uint64));
-			packed->data = buf;
-		}
-		else if constexpr (std::is_same_v<T, metaffi_float32>)
-		{
-			auto* buf = static_cast<metaffi_float32*>(xllr_alloc_memory(vec.size() * sizeof(metaffi_float32)));
-			std::memcpy(buf, vec.data(), vec.size() * sizeof(metaffi_float32));
-			packed->data = buf;
-		}
-		else if constexpr (std::is_same_v<T, metaffi_float64>)
-		{
-			auto* buf = static_cast<metaffi_float64*>(xllr_alloc_memory(vec.size() * sizeof(metaffi_float64)));
-			std::memcpy(buf, vec.data(), vec.size() * sizeof(metaffi_float64));
-			packed->data = buf;
+			if(borrow_packed_arrays)
+			{
+				// point to the vector's buffer - the CDT frees only the packed array header
+				packed = alloc_packed_array(0, sizeof(T), alignof(T));
+				packed->data = const_cast<T*>(vec.data());
+				packed->length = static_cast<metaffi_size>(vec.size());
+				packed->is_borrowed = 1;
+			}
+			else
+			{
+				packed = alloc_packed_array(static_cast<metaffi_size>(vec.size()), sizeof(T), alignof(T));
+				if(!vec.empty())
+				{
+					std::memcpy(packed->data, vec.data(), vec.size() * sizeof(T));
+				}
+			}
 		}
 		else if constexpr (std::is_same_v<T, bool>)
 		{
-			auto* buf = static_cast<metaffi_bool*>(xllr_alloc_memory(vec.size() * sizeof(metaffi_bool)));
+			packed = alloc_packed_array(static_cast<metaffi_size>(vec.size()), sizeof(metaffi_bool), alignof(metaffi_bool));
+			auto* buf = static_cast<metaffi_bool*>(packed->data);
 			for (size_t i = 0; i < vec.size(); ++i)
 			{
 				buf[i] = vec[i] ? 1 : 0;
 			}
-			packed->data = buf;
 		}
 		else if constexpr (std::is_same_v<T, std::string>)
 		{
-			auto* buf = static_cast<metaffi_string8*>(xllr_alloc_memory(vec.size() * sizeof(metaffi_string8)));
-			for (size_t i = 0; i < vec.size(); ++i)
+			// single blob of all the strings (see cdt_packed_array) - one buffer instead of one per string
+			metaffi_size total_length = 0;
+			for (const std::string& str : vec)
 			{
-				buf[i] = xllr_alloc_string8(reinterpret_cast<const char8_t*>(vec[i].c_str()), vec[i].length());
+				total_length += str.length();
+			}
+
+			metaffi_size count = static_cast<metaffi_size>(vec.size());
+			packed = alloc_packed_array(count > 0 ? static_cast<metaffi_size>(metaffi::runtime::packed_string_blob_writer<char8_t>::blob_size(count, total_length)) : 0, 1, alignof(metaffi_size));
+			packed->length = count;
+			packed->is_string_blob = count > 0 ? 1 : 0;
+
+			if(count > 0)
+			{
+				metaffi::runtime::packed_string_blob_writer<char8_t> writer(packed->data, count);
+				for (const std::string& str : vec)
+				{
+					writer.append(reinterpret_cast<const char8_t*>(str.data()), str.length());
+				}
 			}
-			packed->data = buf;
 		}
 		else
 		{
-			// Unsupported type for packed array - clean up and throw
-			xllr_free_memory(packed);
+			// Unsupported type for packed array
 			throw std::runtime_error("Unsupported type for packed array serialization");
 		}
 
-		data[current_index].set_packed_array(packed, static_cast<metaffi_types>(common_type));
+		set_packed_array_at(current_index, packed, static_cast<metaffi_types>(common_type));
 		current_index++;
 		return *this;
 	}
 
 	// For multi-dimensional arrays or vector<metaffi_variant>: use regular CDTS arrays
-	data[current_index].set_new_array(vec.size(), depth, static_cast<metaffi_types>(common_type));
-	cdts& arr = static_cast<cdts&>(data[current_index]);
+	cdts& arr = set_new_array_at(data, current_index, vec.size(), depth, static_cast<metaffi_types>(common_type));
 
 	// Fill array elements
-	cdts_cpp_serializer nested(arr);
+	cdts_cpp_serializer nested(arr, arena);
 	for (size_t i = 0; i < vec.size(); ++i)
 	{
 		nested.set_index(i);
@@ -480,6 +1074,32 @@ cdts_cpp_serializer& cdts_cpp_serializer::operator<<(const std::vector<T>& vec)
 	return *this;
 }
 
+template<typename R>
+cdts_cpp_serializer& cdts_cpp_serializer::operator<<(const R& range) requires is_packable_range<R>
+{
+	using T = std::remove_cv_t<std::ranges::range_value_t<R>>;
+	const T* values = std::ranges::data(range);
+	metaffi_size length = static_cast<metaffi_size>(std::ranges::size(range));
+
+	// fixed dimensions - a CDTS array, as for std::vector
+	if(data.fixed_dimensions != MIXED_OR_UNKNOWN_DIMENSIONS)
+	{
+		check_bounds(current_index);
+		cdts& arr = set_new_array_at(data, current_index, length, 1, static_cast<metaffi_types>(get_metaffi_type<T>()));
+		cdts_cpp_serializer nested(arr, arena);
+		for(metaffi_size i = 0; i < length; ++i)
+		{
+			nested.set_index(i);
+			nested << values[i];
+		}
+
+		current_index++;
+		return *this;
+	}
+
+	return add_packed_tensor(values, 1, &length);
+}
+
 template<typename T>
 cdts_cpp_serializer& cdts_cpp_serializer::operator>>(std::vector<T>& vec)
 {
@@ -505,49 +1125,80 @@ cdts_cpp_serializer& cdts_cpp_serializer::operator>>(std::vector<T>& vec)
 			return *this;
 		}
 
-		vec.resize(packed->length);
 		metaffi_type elem_type = metaffi_packed_element_type(data[current_index].type);
 
+		// Packed N-D tensor into nested vectors of the same rank
+		constexpr int depth = array_depth<std::vector<T>>::value;
+		if constexpr (depth >= 2)
+		{
+			using ElementType = typename vector_element_type<std::vector<T>>::type;
+			if constexpr (std::is_arithmetic_v<ElementType> && get_metaffi_type<ElementType>() != metaffi_any_type)
+			{
+				using storage_t = std::conditional_t<std::is_same_v<ElementType, bool>, metaffi_bool, ElementType>;
+
+				if(elem_type != get_metaffi_type<ElementType>() || metaffi::runtime::packed_rank(packed) != static_cast<metaffi_size>(depth))
+				{
+					std::stringstream ss;
+					ss << "Type mismatch at index " << current_index << ": expected packed tensor of rank " << depth << " and type "
+					   << get_metaffi_type<ElementType>() << ", got rank " << metaffi::runtime::packed_rank(packed) << " and type " << elem_type;
+					throw std::runtime_error(ss.str());
+				}
+
+				std::vector<storage_t> flat(packed->length);
+				metaffi::runtime::copy_packed_elements(packed, sizeof(storage_t), flat.data());
+				unflatten_nested_vector(vec, packed->shape, flat.data());
+
+				current_index++;
+				return *this;
+			}
+			else
+			{
+				throw std::runtime_error("Unsupported type for packed tensor deserialization");
+			}
+		}
+
+		vec.resize(packed->length);
+
 		// Extract based on element type
 		if constexpr (std::is_same_v<T, metaffi_int8>)
 		{
-			std::memcpy(vec.data(), packed->data, packed->length * sizeof(metaffi_int8));
+			metaffi::runtime::copy_packed_elements(packed, sizeof(metaffi_int8), vec.data());
 		}
 		else if constexpr (std::is_same_v<T, metaffi_uint8>)
 		{
-			std::memcpy(vec.data(), packed->data, packed->length * sizeof(metaffi_uint8));
+			metaffi::runtime::copy_packed_elements(packed, sizeof(metaffi_uint8), vec.data());
 		}
 		else if constexpr (std::is_same_v<T, metaffi_int16>)
 		{
-			std::memcpy(vec.data(), packed->data, packed->length * sizeof(metaffi_int16));
+			metaffi::runtime::copy_packed_elements(packed, sizeof(metaffi_int16), vec.data());
 		}
 		else if constexpr (std::is_same_v<T, metaffi_uint16>)
 		{
-			std::memcpy(vec.data(), packed->data, packed->length * sizeof(metaffi_uint16));
+			metaffi::runtime::copy_packed_elements(packed, sizeof(metaffi_uint16), vec.data());
 		}
 		else if constexpr (std::is_same_v<T, metaffi_int32>)
 		{
-			std::memcpy(vec.data(), packed->data, packed->length * sizeof(metaffi_int32));
+			metaffi::runtime::copy_packed_elements(packed, sizeof(metaffi_int32), vec.data());
 		}
 		else if constexpr (std::is_same_v<T, metaffi_uint32>)
 		{
-			std::memcpy(vec.data(), packed->data, packed->length * sizeof(metaffi_uint32));
+			metaffi::runtime::copy_packed_elements(packed, sizeof(metaffi_uint32), vec.data());
 		}
 		else if constexpr (std::is_same_v<T, metaffi_int64>)
 		{
-			std::memcpy(vec.data(), packed->data, packed->length * sizeof(metaffi_int64));
+			metaffi::runtime::copy_packed_elements(packed, sizeof(metaffi_int64), vec.data());
 		}
 		else if constexpr (std::is_same_v<T, metaffi_uint64>)
 		{
-			std::memcpy(vec.data(), packed->data, packed->length * sizeof(metaffi_uint64));
+			metaffi::runtime::copy_packed_elements(packed, sizeof(metaffi_uint64), vec.data());
 		}
 		else if constexpr (std::is_same_v<T, metaffi_float32>)
 		{
-			std::memcpy(vec.data(), packed->data, packed->length * sizeof(metaffi_float32));
+			metaffi::runtime::copy_packed_elements(packed, sizeof(metaffi_float32), vec.data());
 		}
 		else if constexpr (std::is_same_v<T, metaffi_float64>)
 		{
-			std::memcpy(vec.data(), packed->data, packed->length * sizeof(metaffi_float64));
+			metaffi::runtime::copy_packed_elements(packed, sizeof(metaffi_float64), vec.data());
 		}
 		else if constexpr (std::is_same_v<T, bool>)
 		{
@@ -562,7 +1213,7 @@ cdts_cpp_serializer& cdts_cpp_serializer::operator>>(std::vector<T>& vec)
 			const metaffi_string8* buf = static_cast<const metaffi_string8*>(packed->data);
 			for (size_t i = 0; i < packed->length; ++i)
 			{
-				vec[i] = std::string(reinterpret_cast<const char*>(buf[i]));
+				vec[i].assign(reinterpret_cast<const char*>(buf[i]), metaffi::runtime::packed_string_length<char8_t>(packed, i));
 			}
 		}
 		else
@@ -583,7 +1234,117 @@ cdts_cpp_serializer& cdts_cpp_serializer::operator>>(std::vector<T>& vec)
 	for (size_t i = 0; i < arr.length; ++i)
 	{
 		nested.set_index(i);
-		nested >> vec[i];
+		if constexpr (std::is_same_v<T, bool>)
+		{
+			bool val = false; // std::vector<bool> elements are proxies
+			nested >> val;
+			vec[i] = val;
+		}
+		else
+		{
+			nested >> vec[i];
+		}
+	}
+
+	current_index++;
+	return *this;
+}
+
+template<typename T>
+cdts_cpp_serializer& cdts_cpp_serializer::operator>>(std::span<const T>& view)
+{
+	static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && get_metaffi_type<T>() != metaffi_any_type, "packed array views elements must be numeric");
+
+	const cdt_packed_array* packed = packed_array_at<T>(current_index);
+	if(!packed)
+	{
+		view = {};
+	}
+	else if(!metaffi::runtime::packed_is_contiguous(packed))
+	{
+		throw std::runtime_error("Strided packed tensor cannot be viewed as a span");
+	}
+	else
+	{
+		view = std::span<const T>(static_cast<const T*>(packed->data), packed->length);
+	}
+
+	current_index++;
+	return *this;
+}
+
+template<typename T>
+cdts_cpp_serializer& cdts_cpp_serializer::operator>>(xllr_buffer<T>& buffer)
+{
+	check_bounds(current_index);
+	cdt& item = data[current_index];
+
+	if constexpr (std::is_same_v<T, char8_t> || std::is_same_v<T, char16_t> || std::is_same_v<T, char32_t>)
+	{
+		validate_type_at<std::conditional_t<std::is_same_v<T, char8_t>, std::string, std::basic_string<T>>>(current_index);
+
+		std::basic_string_view<T> view;
+		if constexpr (std::is_same_v<T, char8_t>) view = item.get_string8_view();
+		else if constexpr (std::is_same_v<T, char16_t>) view = item.get_string16_view();
+		else view = item.get_string32_view();
+
+		if(item.free_required && !item.is_small_string && string_pointer_of<T>(item))
+		{
+			// the CDT's copy is allocated with xllr_alloc_memory - hand it over
+			buffer = xllr_buffer<T>(string_pointer_of<T>(item), view.size());
+			string_pointer_of<T>(item) = nullptr;
+			item.free_required = false;
+			item.has_length = 0;
+		}
+		else
+		{
+			T* copy = static_cast<T*>(xllr_alloc_memory((view.size() + 1) * sizeof(T)));
+			if(!copy)
+			{
+				throw std::bad_alloc();
+			}
+			std::char_traits<T>::copy(copy, view.data(), view.size());
+			copy[view.size()] = 0;
+			buffer = xllr_buffer<T>(copy, view.size());
+		}
+	}
+	else
+	{
+		static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && get_metaffi_type<T>() != metaffi_any_type, "xllr_buffer elements must be numeric or character code units");
+
+		cdt_packed_array* packed = const_cast<cdt_packed_array*>(packed_array_at<T>(current_index));
+		if(!packed)
+		{
+			buffer = xllr_buffer<T>();
+			current_index++;
+			return *this;
+		}
+
+		std::vector<metaffi_size> shape(metaffi::runtime::packed_rank(packed));
+		for(metaffi_size dim = 0; dim < shape.size(); dim++)
+		{
+			shape[dim] = metaffi::runtime::packed_extent(packed, dim);
+		}
+
+		if(item.free_required && !packed->is_borrowed && packed->data && metaffi::runtime::packed_is_contiguous(packed))
+		{
+			buffer = xllr_buffer<T>(static_cast<T*>(packed->data), packed->length, std::move(shape));
+
+			// leave an empty 1D packed array - the CDT still frees the header and the shape allocation
+			packed->data = nullptr;
+			packed->length = 0;
+			packed->rank = 0;
+		}
+		else
+		{
+			T* copy = static_cast<T*>(xllr_alloc_memory((std::max)(packed->length, metaffi_size(1)) * sizeof(T)));
+			if(!copy)
+			{
+				throw std::bad_alloc();
+			}
+			metaffi::runtime::copy_packed_elements(packed, sizeof(T), copy);
+			buffer = xllr_buffer<T>(copy, packed->length, std::move(shape));
+		}
 	}
 
 	current_index++;
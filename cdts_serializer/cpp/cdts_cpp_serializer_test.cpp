@@ -1079,4 +1079,404 @@ TEST_SUITE("CDTS C++ Serializer")
 		CHECK(std::get<metaffi_float64>(v3) == doctest::Approx(3.14));
 		CHECK(std::get<metaffi_uint8>(v4) == 1);
 	}
+
+	TEST_CASE("Arena-backed serialization")
+	{
+		metaffi::runtime::cdts_arena arena;
+		{
+			metaffi::runtime::cdts_arena_scope scope(arena);
+			cdts data(arena.alloc_cdt_array(4), 4, MIXED_OR_UNKNOWN_DIMENSIONS, 1);
+			cdts_cpp_serializer ser(data, &arena);
+
+			std::vector<std::vector<int32_t>> matrix = {{1, 2}, {3, 4, 5}};
+			ser << std::string("hello") << std::vector<double>{1.5, 2.5, 3.5} << matrix << std::vector<std::string>{"a", "bc"};
+
+			// arena memory is never owned by the CDTs
+			CHECK(data[0].free_required == 0);
+			CHECK(data[1].free_required == 0);
+			CHECK(data[2].free_required == 0);
+			CHECK(data[3].free_required == 0);
+			CHECK(metaffi_is_packed_array(data[1].type));
+
+			ser.reset();
+			std::string s;
+			std::vector<double> d;
+			std::vector<std::vector<int32_t>> m;
+			std::vector<std::string> vs;
+			ser >> s >> d >> m >> vs;
+
+			CHECK(s == "hello");
+			CHECK(d == std::vector<double>{1.5, 2.5, 3.5});
+			CHECK(m == matrix);
+			CHECK(vs == std::vector<std::string>{"a", "bc"});
+		}
+
+		// released memory is reused by the next call
+		CHECK(arena.mark().used == 0);
+		CHECK(arena.heap_blocks_count() == 0);
+	}
+
+	TEST_CASE("Borrowed packed arrays")
+	{
+		std::vector<double> vec = {1.5, 2.5, 3.5};
+
+		cdts data(2);
+		cdts_cpp_serializer ser(data);
+		CHECK_FALSE(ser.is_borrowing_packed_arrays());
+		ser << vec; // copied
+
+		ser.set_borrow_packed_arrays(true);
+		ser << vec; // borrowed
+
+		cdt_packed_array* copied = data[0].get_packed_array();
+		CHECK(copied->data != vec.data());
+		CHECK_FALSE(copied->is_borrowed);
+
+		cdt_packed_array* borrowed = data[1].get_packed_array();
+		CHECK(borrowed->data == vec.data());
+		CHECK(borrowed->length == 3);
+		CHECK(borrowed->is_borrowed);
+
+		ser.reset();
+		std::vector<double> d1, d2;
+		ser >> d1 >> d2;
+		CHECK(d1 == vec);
+		CHECK(d2 == vec);
+	}
+
+	TEST_CASE("Packed string blob")
+	{
+		std::vector<std::string> vec = {"one", "", std::string("with\0nul", 8)};
+
+		cdts data(1);
+		cdts_cpp_serializer ser(data);
+		ser << vec;
+
+		REQUIRE(data[0].type == metaffi_string8_packed_array_type);
+		cdt_packed_array* packed = data[0].get_packed_array();
+		CHECK(packed->is_string_blob);
+		CHECK(packed->length == 3);
+		CHECK(metaffi_string_blob_string_length(packed, 2) == 8);
+
+		ser.reset();
+		std::vector<std::string> result;
+		ser >> result;
+		CHECK(result == vec);
+	}
+
+	TEST_CASE("Sized strings keep embedded NULLs")
+	{
+		std::string str8("a string with\0an embedded NULL", 31);
+		std::u16string str16(u"a string\0with a NULL", 20);
+
+		cdts data(2);
+		cdts_cpp_serializer ser(data);
+		ser << str8 << str16;
+
+		CHECK(data[0].has_length);
+		CHECK(data[0].cdt_val.sized_string_val.length == 31);
+		CHECK(data[1].has_length);
+		CHECK(data[1].cdt_val.sized_string_val.length == 20);
+
+		ser.reset();
+		std::string result8;
+		std::u16string result16;
+		ser >> result8 >> result16;
+		CHECK(result8 == str8);
+		CHECK(result16 == str16);
+	}
+
+	TEST_CASE("Small strings are stored inline")
+	{
+		std::string small8("key\0id", 6);
+		std::u32string small32 = U"abc";
+		std::string large8 = "a string too long to be stored inline";
+
+		cdts data(3);
+		cdts_cpp_serializer ser(data);
+		ser << small8 << small32 << large8;
+
+		CHECK(data[0].is_small_string);
+		CHECK(!data[0].free_required);
+		CHECK(data[1].is_small_string);
+		CHECK(!data[2].is_small_string);
+
+		// inline even with an arena
+		metaffi::runtime::cdts_arena arena;
+		cdts arena_data(1);
+		cdts_cpp_serializer arena_ser(arena_data, &arena);
+		arena_ser << std::string("arena");
+		CHECK(arena_data[0].is_small_string);
+
+		ser.reset();
+		std::string result8;
+		std::u32string result32;
+		std::string result_large;
+		ser >> result8 >> result32 >> result_large;
+		CHECK(result8 == small8);
+		CHECK(result32 == small32);
+		CHECK(result_large == large8);
+
+		// extract_any hands out an owned copy of inline strings
+		ser.reset();
+		auto any = ser.extract_any();
+		REQUIRE(std::holds_alternative<metaffi_string8>(any));
+		metaffi_string8 owned = std::get<metaffi_string8>(any);
+		CHECK(owned != metaffi_cdt_string8(&data[0]));
+		CHECK(std::string(reinterpret_cast<const char*>(owned)) == "key");
+		xllr_free_memory(owned);
+	}
+	TEST_CASE("Packed tensors")
+	{
+		std::vector<std::vector<double>> matrix = {{1.5, 2.5, 3.5}, {4.5, 5.5, 6.5}};
+		std::vector<std::vector<std::vector<int32_t>>> cube = {{{1, 2}, {3, 4}}, {{5, 6}, {7, 8}}};
+		std::vector<std::vector<bool>> flags = {{true, false}, {false, true}};
+		std::vector<std::vector<int32_t>> ragged = {{1, 2}, {3}};
+
+		cdts data(5);
+		cdts_cpp_serializer ser(data);
+		CHECK_FALSE(ser.is_packing_tensors());
+		ser.set_pack_tensors(true);
+		ser << matrix << cube << flags << ragged;
+
+		REQUIRE(data[0].type == metaffi_float64_packed_array_type);
+		cdt_packed_array* packed = data[0].get_packed_array();
+		REQUIRE(metaffi_packed_is_tensor(packed));
+		CHECK(packed->rank == 2);
+		CHECK(packed->shape[0] == 2);
+		CHECK(packed->shape[1] == 3);
+		CHECK(packed->strides == nullptr);
+		CHECK(packed->length == 6);
+		CHECK(static_cast<double*>(packed->data)[3] == 4.5); // row-major
+
+		CHECK(data[1].get_packed_array()->rank == 3);
+		CHECK(data[2].type == metaffi_bool_packed_array_type);
+		CHECK_FALSE(metaffi_is_packed_array(data[3].type)); // ragged - nested CDTS arrays
+
+		// strided (transposed) tensor is copied row-major
+		std::vector<int64_t> values = {1, 2, 3, 4, 5, 6}; // 2x3
+		metaffi_size shape[] = {3, 2};
+		metaffi_int64 strides[] = {1, 3};
+		ser.add_packed_tensor(values.data(), 2, shape, strides);
+
+		ser.reset();
+		std::vector<std::vector<double>> m;
+		std::vector<std::vector<std::vector<int32_t>>> c;
+		std::vector<std::vector<bool>> f;
+		std::vector<std::vector<int32_t>> r;
+		ser >> m >> c >> f >> r;
+		CHECK(m == matrix);
+		CHECK(c == cube);
+		CHECK(f == flags);
+		CHECK(r == ragged);
+
+		CHECK(ser.peek_packed_shape() == std::vector<metaffi_size>{3, 2});
+		std::vector<std::vector<int64_t>> transposed;
+		ser >> transposed;
+		CHECK(transposed == std::vector<std::vector<int64_t>>{{1, 4}, {2, 5}, {3, 6}});
+
+		// rank mismatch
+		ser.set_index(0);
+		std::vector<std::vector<std::vector<double>>> wrong_rank;
+		CHECK_THROWS_AS(ser >> wrong_rank, std::runtime_error);
+
+		// a tensor read as a 1D array is its elements in row-major order
+		ser.set_index(0);
+		std::vector<double> flat;
+		ser >> flat;
+		CHECK(flat == std::vector<double>{1.5, 2.5, 3.5, 4.5, 5.5, 6.5});
+	}
+
+	TEST_CASE("Arena-backed packed tensors")
+	{
+		metaffi::runtime::cdts_arena arena;
+		{
+			metaffi::runtime::cdts_arena_scope scope(arena);
+			cdts data(arena.alloc_cdt_array(1), 1, MIXED_OR_UNKNOWN_DIMENSIONS, 1);
+			cdts_cpp_serializer ser(data, &arena);
+			ser.set_pack_tensors(true);
+
+			std::vector<std::vector<float>> matrix = {{1.0f, 2.0f}, {3.0f, 4.0f}};
+			ser << matrix;
+			CHECK(data[0].free_required == 0);
+			CHECK(data[0].get_packed_array()->rank == 2);
+
+			ser.reset();
+			std::vector<std::vector<float>> m;
+			ser >> m;
+			CHECK(m == matrix);
+		}
+
+		CHECK(arena.mark().used == 0);
+	}
+
+	TEST_CASE("Zero-copy views")
+	{
+		std::string large8 = "a string too long to be stored inline";
+		std::u16string str16 = u"utf16";
+		std::vector<int32_t> vec = {1, 2, 3};
+		std::vector<std::vector<double>> matrix = {{1.5, 2.5}, {3.5, 4.5}};
+
+		cdts data(4);
+		cdts_cpp_serializer ser(data);
+		ser.set_pack_tensors(true);
+		ser << large8 << str16 << vec << matrix;
+
+		ser.reset();
+		std::string_view view8;
+		std::u16string_view view16;
+		std::span<const int32_t> ints;
+		std::span<const double> doubles;
+		ser >> view8 >> view16 >> ints >> doubles;
+
+		CHECK(view8 == large8);
+		CHECK(reinterpret_cast<const void*>(view8.data()) == metaffi_cdt_string8(&data[0]));
+		CHECK(view16 == str16);
+		REQUIRE(ints.size() == 3);
+		CHECK(ints.data() == data[2].get_packed_array()->data);
+		CHECK(ints[2] == 3);
+		REQUIRE(doubles.size() == 4); // tensors are viewed row-major
+		CHECK(doubles[2] == 3.5);
+
+		// type mismatch
+		ser.set_index(2);
+		std::span<const int64_t> wrong;
+		CHECK_THROWS_AS(ser >> wrong, std::runtime_error);
+		ser.set_index(0);
+		std::u32string_view wrong_string;
+		CHECK_THROWS_AS(ser >> wrong_string, std::runtime_error);
+	}
+
+	TEST_CASE("Strided tensors are not viewed as spans")
+	{
+		// transposed 2x3 tensor, as a runtime may return it
+		std::vector<int64_t> values = {1, 2, 3, 4, 5, 6};
+		std::vector<metaffi_size> shape_strides = {3, 2, 1, 3};
+		cdt_packed_array strided(values.data(), 6, true);
+		strided.rank = 2;
+		strided.shape = shape_strides.data();
+		strided.strides = reinterpret_cast<metaffi_int64*>(shape_strides.data() + 2);
+		cdts strided_data(1);
+		strided_data[0].type = metaffi_int64_packed_array_type;
+		strided_data[0].cdt_val.packed_array_val = &strided;
+		strided_data[0].free_required = false;
+
+		cdts_cpp_serializer ser(strided_data);
+		std::span<const int64_t> view;
+		CHECK_THROWS_AS(ser >> view, std::runtime_error);
+
+		// copying extractors still read it
+		ser.reset();
+		std::vector<std::vector<int64_t>> transposed;
+		ser >> transposed;
+		CHECK(transposed == std::vector<std::vector<int64_t>>{{1, 4}, {2, 5}, {3, 6}});
+	}
+
+	TEST_CASE("Take ownership of returned buffers")
+	{
+		std::string large8 = "a string too long to be stored inline";
+		std::vector<double> vec = {1.5, 2.5, 3.5};
+		std::vector<std::vector<int32_t>> matrix = {{1, 2, 3}, {4, 5, 6}};
+
+		cdts data(4);
+		cdts_cpp_serializer ser(data);
+		ser.set_pack_tensors(true);
+		ser << large8 << vec << matrix << std::string("small");
+
+		const void* string_buffer = metaffi_cdt_string8(&data[0]);
+		const void* vec_buffer = data[1].get_packed_array()->data;
+
+		ser.reset();
+		xllr_buffer<char8_t> owned_string;
+		xllr_buffer<double> owned_vec;
+		xllr_buffer<int32_t> owned_matrix;
+		xllr_buffer<char8_t> small;
+		ser >> owned_string >> owned_vec >> owned_matrix >> small;
+
+		// moved out without copying - the CDTs no longer own them
+		CHECK(owned_string.data() == string_buffer);
+		CHECK(std::string(reinterpret_cast<const char*>(owned_string.data()), owned_string.size()) == large8);
+		CHECK_FALSE(data[0].free_required);
+
+		CHECK(owned_vec.data() == vec_buffer);
+		CHECK(std::vector<double>(owned_vec.span().begin(), owned_vec.span().end()) == vec);
+		CHECK(data[1].get_packed_array()->data == nullptr);
+		CHECK(data[1].get_packed_array()->length == 0);
+
+		CHECK(owned_matrix.shape() == std::vector<metaffi_size>{2, 3});
+		CHECK(owned_matrix.data()[4] == 5);
+
+		// inline small strings are copied
+		CHECK(small.size() == 5);
+		CHECK(std::u8string_view(small.data()) == u8"small");
+
+		xllr_buffer<double> moved = std::move(owned_vec);
+		CHECK(owned_vec.data() == nullptr);
+		CHECK(moved.size() == 3);
+
+		double* released = moved.release();
+		CHECK(moved.empty());
+		xllr_free_memory(released);
+	}
+
+	TEST_CASE("Take ownership copies arena buffers")
+	{
+		metaffi::runtime::cdts_arena arena;
+		{
+			metaffi::runtime::cdts_arena_scope scope(arena);
+			cdts data(arena.alloc_cdt_array(1), 1, MIXED_OR_UNKNOWN_DIMENSIONS, 1);
+			cdts_cpp_serializer ser(data, &arena);
+			ser << std::vector<int64_t>{1, 2, 3};
+
+			ser.reset();
+			xllr_buffer<int64_t> owned;
+			ser >> owned;
+			CHECK(owned.data() != data[0].get_packed_array()->data);
+			CHECK(owned.data()[2] == 3);
+		}
+
+		CHECK(arena.mark().used == 0);
+	}
+
+	TEST_CASE("Contiguous ranges")
+	{
+		std::array<int32_t, 3> arr = {1, 2, 3};
+		std::vector<double> vec = {1.5, 2.5};
+		std::span<const double> span(vec);
+		const uint8_t raw[] = {7, 8, 9, 10};
+
+		cdts data(4);
+		cdts_cpp_serializer ser(data);
+		ser << arr << span << std::span(raw, 2);
+		ser.set_borrow_packed_arrays(true);
+		ser << span;
+
+		REQUIRE(data[0].type == metaffi_int32_packed_array_type);
+		CHECK(data[0].get_packed_array()->length == 3);
+		CHECK(data[1].type == metaffi_float64_packed_array_type);
+		CHECK(data[1].get_packed_array()->data != vec.data());
+		CHECK(data[2].get_packed_array()->length == 2);
+		CHECK(data[3].get_packed_array()->data == vec.data());
+		CHECK(data[3].get_packed_array()->is_borrowed);
+
+		ser.reset();
+		std::vector<int32_t> ints;
+		std::vector<double> d1, d2;
+		std::vector<uint8_t> bytes;
+		ser >> ints >> d1 >> bytes >> d2;
+		CHECK(ints == std::vector<int32_t>{1, 2, 3});
+		CHECK(d1 == vec);
+		CHECK(bytes == std::vector<uint8_t>{7, 8});
+		CHECK(d2 == vec);
+
+		// fixed dimensions - a CDTS array, as for vectors
+		cdts fixed(1, 1);
+		cdts_cpp_serializer fixed_ser(fixed);
+		fixed_ser << arr;
+		CHECK_FALSE(metaffi_is_packed_array(fixed[0].type));
+		fixed_ser.reset();
+		std::vector<int32_t> fixed_ints;
+		fixed_ser >> fixed_ints;
+		CHECK(fixed_ints == std::vector<int32_t>{1, 2, 3});
+	}
 }
@@ -12,10 +12,17 @@
 #include <runtime_manager/cpython3/py_metaffi_handle.h>
 #include <runtime/xllr_capi_loader.h>
 #include <runtime/xcall.h>
+#include <runtime/packed_string_blob.h>
+#include <runtime/packed_tensor.h>
 #include <cdts_serializer/cpython3/runtime_id.h>
+#include <algorithm>
+#include <atomic>
 #include <sstream>
 #include <cstring>
 #include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
 #include <utils/logger.hpp>
 #include <utils/safe_func.h>
 
@@ -34,11 +41,25 @@ static auto LOG = metaffi::get_logger("cpython3.serializer");
 // ============================================================================
 
 cdts_python3_serializer::cdts_python3_serializer(cpython3_runtime_manager& runtime, cdts& pcdts)
-	: m_runtime(runtime), data(pcdts), current_index(0)
+	: m_runtime(runtime), data(pcdts), current_index(0), m_borrow_buffers(false), m_packed_extraction(default_packed_array_extraction())
 {
 	// Constructor - runtime and CDTS references stored, index initialized to 0
 }
 
+cdts_python3_serializer::~cdts_python3_serializer()
+{
+	if(m_borrowed_views.empty())
+	{
+		return;
+	}
+
+	auto gil = m_runtime.acquire_gil();
+	for(std::unique_ptr<Py_buffer>& view : m_borrowed_views)
+	{
+		pPyBuffer_Release(view.get());
+	}
+}
+
 void cdts_python3_serializer::reset()
 {
 	current_index = 0;
@@ -109,9 +130,22 @@ cdts_python3_serializer& cdts_python3_serializer::add_packed_array(PyObject* obj
 
 	check_bounds(current_index);
 
+	if(py_bytes::check(obj) && (element_type == metaffi_uint8_type || element_type == metaffi_int8_type))
+	{
+		bytes_to_packed_cdt(obj, data[current_index], element_type);
+		current_index++;
+		return *this;
+	}
+
+	if(pyobject_to_packed_tensor(obj, data[current_index], element_type))
+	{
+		current_index++;
+		return *this;
+	}
+
 	if(!py_list::check(obj) && !py_tuple::check(obj))
 	{
-		throw_py_err("add_packed_array: expected list or tuple");
+		throw_py_err("add_packed_array: expected list, tuple or buffer");
 	}
 
 	Py_ssize_t length = py_list::check(obj) ? pPyList_Size(obj) : pPyTuple_Size(obj);
@@ -121,6 +155,11 @@ cdts_python3_serializer& cdts_python3_serializer::add_packed_array(PyObject* obj
 	if(!packed) { throw_py_err("add_packed_array: xllr_alloc_memory failed for cdt_packed_array"); }
 	packed->data = nullptr;
 	packed->length = static_cast<metaffi_size>(length);
+	packed->is_borrowed = 0;
+	packed->is_string_blob = 0;
+	packed->rank = 0;
+	packed->shape = nullptr;
+	packed->strides = nullptr;
 
 	if(length == 0)
 	{
@@ -256,25 +295,7 @@ cdts_python3_serializer& cdts_python3_serializer::add_packed_array(PyObject* obj
 			break;
 		}
 		case metaffi_string8_type: {
-			auto* buf = static_cast<metaffi_string8*>(xllr_alloc_memory(static_cast<size_t>(length) * sizeof(metaffi_string8)));
-			if(!buf) { xllr_free_memory(packed); throw_py_err("add_packed_array: xllr_alloc_memory failed for string8"); }
-			for(Py_ssize_t i = 0; i < length; i++) {
-				PyObject* item = get_item(i);
-				if(item == pPy_None) {
-					buf[i] = nullptr;
-				} else {
-					Py_ssize_t str_len;
-					const char* utf8 = pPyUnicode_AsUTF8AndSize(item, &str_len);
-					if(!utf8) {
-						// Clean up previously allocated strings
-						for(Py_ssize_t j = 0; j < i; j++) { if(buf[j]) xllr_free_memory(buf[j]); }
-						xllr_free_memory(buf); xllr_free_memory(packed);
-						throw_py_err("add_packed_array: failed converting element to string8");
-					}
-					buf[i] = xllr_alloc_string8(reinterpret_cast<const char8_t*>(utf8), static_cast<uint64_t>(str_len));
-				}
-			}
-			packed->data = buf;
+			pystrings_to_packed_blob(obj, length, packed, "add_packed_array");
 			break;
 		}
 		default:
@@ -287,6 +308,745 @@ cdts_python3_serializer& cdts_python3_serializer::add_packed_array(PyObject* obj
 	return *this;
 }
 
+void cdts_python3_serializer::pystrings_to_packed_blob(PyObject* seq, Py_ssize_t length, cdt_packed_array* packed, const char* caller)
+{
+	bool is_list = py_list::check(seq);
+	auto get_item = [&](Py_ssize_t i) -> PyObject* {
+		return is_list ? pPyList_GetItem(seq, i) : pPyTuple_GetItem(seq, i);
+	};
+
+	// first pass - total UTF-8 size.
+	// str objects cache their UTF-8 form, so the second pass does not encode again.
+	metaffi_size total_length = 0;
+	for(Py_ssize_t i = 0; i < length; i++)
+	{
+		PyObject* item = get_item(i);
+		if(item == pPy_None)
+		{
+			continue;
+		}
+
+		Py_ssize_t str_len = 0;
+		if(!py_str::utf8_data(item, str_len))
+		{
+			xllr_free_memory(packed);
+			throw_py_err(std::string(caller) + ": failed converting element " + std::to_string(i) + " to string8");
+		}
+		total_length += static_cast<metaffi_size>(str_len);
+	}
+
+	auto count = static_cast<metaffi_size>(length);
+	packed->data = xllr_alloc_memory(metaffi::runtime::packed_string_blob_writer<char8_t>::blob_size(count, total_length));
+	if(!packed->data)
+	{
+		xllr_free_memory(packed);
+		throw_py_err(std::string(caller) + ": xllr_alloc_memory failed for string8 blob");
+	}
+	packed->is_string_blob = 1;
+
+	metaffi::runtime::packed_string_blob_writer<char8_t> writer(packed->data, count);
+	for(Py_ssize_t i = 0; i < length; i++)
+	{
+		PyObject* item = get_item(i);
+		if(item == pPy_None)
+		{
+			writer.append_null();
+			continue;
+		}
+
+		Py_ssize_t str_len = 0;
+		const char* utf8 = py_str::utf8_data(item, str_len);
+		writer.append(reinterpret_cast<const char8_t*>(utf8), static_cast<metaffi_size>(str_len));
+	}
+}
+
+void cdts_python3_serializer::bytes_to_packed_cdt(PyObject* obj, cdt& target, metaffi_type element_type)
+{
+	Py_ssize_t size;
+	char* bytes_data;
+	if(pPyBytes_AsStringAndSize(obj, &bytes_data, &size) == -1)
+	{
+		std::string error_msg = check_python_error();
+		throw_py_err("Failed to get bytes data: " + error_msg);
+	}
+
+	if(m_borrow_buffers)
+	{
+		// bytes are immutable - point to the object's buffer, which the caller keeps alive
+		target.set_borrowed_packed_array(size > 0 ? bytes_data : nullptr, static_cast<metaffi_size>(size), static_cast<metaffi_types>(element_type));
+		return;
+	}
+
+	// Create packed array via xllr allocator
+	cdt_packed_array* packed = static_cast<cdt_packed_array*>(xllr_alloc_memory(sizeof(cdt_packed_array)));
+	if(!packed) { throw_py_err("Failed to allocate cdt_packed_array for packed bytes array"); }
+	packed->data = nullptr;
+	packed->length = static_cast<metaffi_size>(size);
+	packed->is_borrowed = 0;
+	packed->is_string_blob = 0;
+	packed->rank = 0;
+	packed->shape = nullptr;
+	packed->strides = nullptr;
+
+	if(size > 0)
+	{
+		auto* buf = static_cast<metaffi_uint8*>(xllr_alloc_memory(static_cast<size_t>(size) * sizeof(metaffi_uint8)));
+		if(!buf)
+		{
+			xllr_free_memory(packed);
+			throw_py_err("Failed to allocate buffer for packed bytes array");
+		}
+
+		std::memcpy(buf, bytes_data, static_cast<size_t>(size));
+		packed->data = buf;
+	}
+
+	target.set_packed_array(packed, static_cast<metaffi_types>(element_type));
+}
+
+namespace
+{
+
+bool is_pysequence(PyObject* obj)
+{
+	return py_list::check(obj) || py_tuple::check(obj);
+}
+
+Py_ssize_t pysequence_size(PyObject* seq)
+{
+	return py_list::check(seq) ? pPyList_Size(seq) : pPyTuple_Size(seq);
+}
+
+PyObject* pysequence_item(PyObject* seq, Py_ssize_t i)
+{
+	return py_list::check(seq) ? pPyList_GetItem(seq, i) : pPyTuple_GetItem(seq, i);
+}
+
+// 'i' signed, 'u' unsigned, 'f' floating point, 'b' bool, 0 for other element types
+char packed_element_kind(metaffi_type element_type)
+{
+	switch(element_type)
+	{
+		case metaffi_int8_type:
+		case metaffi_int16_type:
+		case metaffi_int32_type:
+		case metaffi_int64_type:
+			return 'i';
+		case metaffi_uint8_type:
+		case metaffi_uint16_type:
+		case metaffi_uint32_type:
+		case metaffi_uint64_type:
+			return 'u';
+		case metaffi_float32_type:
+		case metaffi_float64_type:
+			return 'f';
+		case metaffi_bool_type:
+			return 'b';
+		default:
+			return 0;
+	}
+}
+
+// element kind of a single-element buffer format (struct module syntax), 0 if not supported
+char buffer_format_kind(const char* format)
+{
+	if(!format) // unsigned bytes
+	{
+		return 'u';
+	}
+
+	if(*format == '@' || *format == '=' || *format == '<')
+	{
+		format++;
+	}
+
+	if(format[0] == 0 || format[1] != 0)
+	{
+		return 0;
+	}
+
+	switch(format[0])
+	{
+		case 'b': case 'h': case 'i': case 'l': case 'q': case 'n':
+			return 'i';
+		case 'B': case 'H': case 'I': case 'L': case 'Q': case 'N':
+			return 'u';
+		case 'f': case 'd':
+			return 'f';
+		case '?':
+			return 'b';
+		default:
+			return 0;
+	}
+}
+
+// element type of a single-element buffer format and item size, 0 if not supported
+metaffi_type buffer_format_type(const char* format, Py_ssize_t itemsize)
+{
+	switch(buffer_format_kind(format))
+	{
+		case 'i':
+			return itemsize == 1 ? metaffi_int8_type : itemsize == 2 ? metaffi_int16_type : itemsize == 4 ? metaffi_int32_type : itemsize == 8 ? metaffi_int64_type : 0;
+		case 'u':
+			return itemsize == 1 ? metaffi_uint8_type : itemsize == 2 ? metaffi_uint16_type : itemsize == 4 ? metaffi_uint32_type : itemsize == 8 ? metaffi_uint64_type : 0;
+		case 'f':
+			return itemsize == 4 ? metaffi_float32_type : itemsize == 8 ? metaffi_float64_type : 0;
+		case 'b':
+			return itemsize == static_cast<Py_ssize_t>(sizeof(metaffi_bool)) ? metaffi_bool_type : 0;
+		default:
+			return 0;
+	}
+}
+
+// buffer format (struct module syntax) of a packed element type, nullptr if not numeric/bool
+const char* packed_buffer_format(metaffi_type element_type)
+{
+	switch(element_type)
+	{
+		case metaffi_int8_type: return "b";
+		case metaffi_int16_type: return "h";
+		case metaffi_int32_type: return "i";
+		case metaffi_int64_type: return "q";
+		case metaffi_uint8_type: return "B";
+		case metaffi_uint16_type: return "H";
+		case metaffi_uint32_type: return "I";
+		case metaffi_uint64_type: return "Q";
+		case metaffi_float32_type: return "f";
+		case metaffi_float64_type: return "d";
+		case metaffi_bool_type: return "?";
+		default: return nullptr;
+	}
+}
+
+// whether a buffer's elements are in row-major order without gaps
+bool is_c_contiguous_buffer(const Py_buffer& view)
+{
+	if(!view.strides)
+	{
+		return true;
+	}
+
+	Py_ssize_t expected = view.itemsize;
+	for(int dim = view.ndim - 1; dim >= 0; dim--)
+	{
+		if(view.shape[dim] > 1 && view.strides[dim] != expected)
+		{
+			return false;
+		}
+		expected *= view.shape[dim];
+	}
+
+	return true;
+}
+
+// Owner of an xllr buffer exported to Python (the base object of the memoryview of a returned packed array).
+// A capsule cannot export a buffer, so this minimal type exports it and frees it with xllr_free_memory on dealloc.
+struct xllr_buffer_object : public PyObject
+{
+	void* data;              // xllr_alloc_memory
+	Py_ssize_t length;       // in bytes
+	Py_ssize_t itemsize;
+	const char* format;      // static string
+	int ndim;
+	Py_ssize_t* shape;       // ndim extents followed by ndim strides (in bytes), new[]
+};
+
+int xllr_buffer_object_getbuffer(PyObject* self, Py_buffer* view, int flags)
+{
+	auto* owner = static_cast<xllr_buffer_object*>(self);
+	bool nd = (flags & PyBUF_ND) == PyBUF_ND;
+
+	view->buf = owner->data;
+	view->obj = self;
+	Py_INCREF(self);
+	view->len = owner->length;
+	view->itemsize = owner->itemsize;
+	view->readonly = 0;
+	view->ndim = nd ? owner->ndim : 1;
+	view->format = (flags & PyBUF_FORMAT) ? const_cast<char*>(owner->format) : nullptr;
+	view->shape = nd ? owner->shape : nullptr;
+	view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? owner->shape + owner->ndim : nullptr;
+	view->suboffsets = nullptr;
+	view->internal = nullptr;
+	return 0;
+}
+
+void xllr_buffer_object_dealloc(PyObject* self)
+{
+	auto* owner = static_cast<xllr_buffer_object*>(self);
+	if(owner->data)
+	{
+		xllr_free_memory(owner->data);
+	}
+	delete[] owner->shape;
+
+	PyTypeObject* type = Py_TYPE(self);
+	pPyObject_Free(self); // the default tp_free of heap types without GC
+	Py_DECREF(type); // instances of heap types own a reference to their type
+}
+
+// created once, while holding the GIL
+PyTypeObject* xllr_buffer_type()
+{
+	static PyType_Slot slots[] = {
+		{Py_bf_getbuffer, reinterpret_cast<void*>(&xllr_buffer_object_getbuffer)},
+		{Py_tp_dealloc, reinterpret_cast<void*>(&xllr_buffer_object_dealloc)},
+		{0, nullptr}
+	};
+	static PyType_Spec spec = {"metaffi.xllr_buffer", static_cast<int>(sizeof(xllr_buffer_object)), 0, Py_TPFLAGS_DEFAULT, slots};
+	static PyTypeObject* type = nullptr;
+	if(!type)
+	{
+		type = reinterpret_cast<PyTypeObject*>(pPyType_FromSpec(&spec));
+	}
+	return type;
+}
+
+// an owner without data (set by the caller) of a row-major buffer of the given shape.
+// nullptr with a Python error set on failure.
+xllr_buffer_object* new_xllr_buffer_object(const char* format, size_t element_size, const std::vector<metaffi_size>& shape)
+{
+	PyTypeObject* type = xllr_buffer_type();
+	auto* owner = type ? static_cast<xllr_buffer_object*>(pPyType_GenericAlloc(type, 0)) : nullptr;
+	if(!owner)
+	{
+		return nullptr;
+	}
+
+	// from here the owner frees its fields on failure
+	metaffi_size rank = shape.size();
+	owner->data = nullptr;
+	owner->itemsize = static_cast<Py_ssize_t>(element_size);
+	owner->format = format;
+	owner->ndim = static_cast<int>(rank);
+	owner->shape = new(std::nothrow) Py_ssize_t[rank * 2];
+	if(!owner->shape)
+	{
+		Py_DECREF(owner);
+		pPyErr_SetString(pPyExc_RuntimeError, "failed to allocate the buffer shape");
+		return nullptr;
+	}
+
+	// row-major strides in bytes
+	Py_ssize_t stride = static_cast<Py_ssize_t>(element_size);
+	for(metaffi_size dim = rank; dim > 0; dim--)
+	{
+		owner->shape[dim - 1] = static_cast<Py_ssize_t>(shape[dim - 1]);
+		owner->shape[rank + dim - 1] = stride;
+		stride *= owner->shape[dim - 1];
+	}
+	owner->length = stride;
+
+	return owner;
+}
+
+// array.array of type code format holding a copy of size bytes of data (a single memcpy by array.frombytes).
+// nullptr with a Python error set on failure.
+PyObject* new_pyarray(const char* format, const void* data, size_t size)
+{
+	static PyObject* array_type = nullptr; // array.array, imported once while holding the GIL
+	if(!array_type)
+	{
+		PyObject* array_module = pPyImport_ImportModule("array");
+		if(!array_module)
+		{
+			return nullptr;
+		}
+
+		array_type = pPyObject_GetAttrString(array_module, "array");
+		Py_DECREF(array_module);
+		if(!array_type)
+		{
+			return nullptr;
+		}
+	}
+
+	PyObject* arr = pPyObject_CallFunction(array_type, "s", format);
+	if(!arr || size == 0)
+	{
+		return arr;
+	}
+
+	// a read-only view of data, frombytes copies it
+	PyObject* view = pPyMemoryView_FromMemory(static_cast<char*>(const_cast<void*>(data)), static_cast<Py_ssize_t>(size), PyBUF_READ);
+	PyObject* res = view ? pPyObject_CallMethod(arr, "frombytes", "O", view) : nullptr;
+	Py_XDECREF(view);
+	if(!res)
+	{
+		Py_DECREF(arr);
+		return nullptr;
+	}
+
+	Py_DECREF(res);
+	return arr;
+}
+
+// returns false with a Python error set if item cannot be converted
+bool pyobject_to_packed_element(PyObject* item, metaffi_type element_type, unsigned char* dst)
+{
+	switch(element_type)
+	{
+		case metaffi_int8_type: *reinterpret_cast<metaffi_int8*>(dst) = static_cast<metaffi_int8>(pPyLong_AsLongLong(item)); break;
+		case metaffi_int16_type: *reinterpret_cast<metaffi_int16*>(dst) = static_cast<metaffi_int16>(pPyLong_AsLongLong(item)); break;
+		case metaffi_int32_type: *reinterpret_cast<metaffi_int32*>(dst) = static_cast<metaffi_int32>(pPyLong_AsLongLong(item)); break;
+		case metaffi_int64_type: *reinterpret_cast<metaffi_int64*>(dst) = static_cast<metaffi_int64>(pPyLong_AsLongLong(item)); break;
+		case metaffi_uint8_type: *reinterpret_cast<metaffi_uint8*>(dst) = static_cast<metaffi_uint8>(pPyLong_AsLongLong(item)); break;
+		case metaffi_uint16_type: *reinterpret_cast<metaffi_uint16*>(dst) = static_cast<metaffi_uint16>(pPyLong_AsLongLong(item)); break;
+		case metaffi_uint32_type: *reinterpret_cast<metaffi_uint32*>(dst) = static_cast<metaffi_uint32>(pPyLong_AsUnsignedLongLong(item)); break;
+		case metaffi_uint64_type: *reinterpret_cast<metaffi_uint64*>(dst) = static_cast<metaffi_uint64>(pPyLong_AsUnsignedLongLong(item)); break;
+		case metaffi_float32_type: *reinterpret_cast<metaffi_float32*>(dst) = static_cast<metaffi_float32>(pPyFloat_AsDouble(item)); break;
+		case metaffi_float64_type: *reinterpret_cast<metaffi_float64*>(dst) = pPyFloat_AsDouble(item); break;
+		case metaffi_bool_type:
+		{
+			int val = pPyObject_IsTrue(item);
+			if(val < 0)
+			{
+				return false;
+			}
+			*reinterpret_cast<metaffi_bool*>(dst) = static_cast<metaffi_bool>(val);
+			return true;
+		}
+		default:
+			return false;
+	}
+
+	return !pPyErr_Occurred();
+}
+
+// copies the leaves of rectangular nested lists/tuples to out (row-major). false if ragged or a leaf fails to convert.
+bool flatten_pysequence(PyObject* seq, const std::vector<metaffi_size>& shape, size_t dim, metaffi_type element_type, size_t element_size, unsigned char*& out)
+{
+	if(!is_pysequence(seq) || static_cast<metaffi_size>(pysequence_size(seq)) != shape[dim])
+	{
+		return false;
+	}
+
+	bool innermost = dim + 1 == shape.size();
+	for(Py_ssize_t i = 0; i < static_cast<Py_ssize_t>(shape[dim]); i++)
+	{
+		PyObject* item = pysequence_item(seq, i);
+		if(innermost)
+		{
+			if(!pyobject_to_packed_element(item, element_type, out))
+			{
+				return false;
+			}
+			out += element_size;
+		}
+		else if(!flatten_pysequence(item, shape, dim + 1, element_type, element_size, out))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+PyObject* packed_element_to_pyobject(const unsigned char* element, metaffi_type element_type)
+{
+	switch(element_type)
+	{
+		case metaffi_int8_type: return pPyLong_FromLongLong(*reinterpret_cast<const metaffi_int8*>(element));
+		case metaffi_int16_type: return pPyLong_FromLongLong(*reinterpret_cast<const metaffi_int16*>(element));
+		case metaffi_int32_type: return pPyLong_FromLongLong(*reinterpret_cast<const metaffi_int32*>(element));
+		case metaffi_int64_type: return pPyLong_FromLongLong(*reinterpret_cast<const metaffi_int64*>(element));
+		case metaffi_uint8_type: return pPyLong_FromUnsignedLongLong(*reinterpret_cast<const metaffi_uint8*>(element));
+		case metaffi_uint16_type: return pPyLong_FromUnsignedLongLong(*reinterpret_cast<const metaffi_uint16*>(element));
+		case metaffi_uint32_type: return pPyLong_FromUnsignedLongLong(*reinterpret_cast<const metaffi_uint32*>(element));
+		case metaffi_uint64_type: return pPyLong_FromUnsignedLongLong(*reinterpret_cast<const metaffi_uint64*>(element));
+		case metaffi_float32_type: return pPyFloat_FromDouble(static_cast<double>(*reinterpret_cast<const metaffi_float32*>(element)));
+		case metaffi_float64_type: return pPyFloat_FromDouble(*reinterpret_cast<const metaffi_float64*>(element));
+		case metaffi_bool_type: return pPyBool_FromLong(*reinterpret_cast<const metaffi_bool*>(element) ? 1 : 0);
+		default: return nullptr;
+	}
+}
+
+// nested lists of dimension dim of a tensor, starting at offset (in elements). nullptr on failure.
+PyObject* tensor_dimension_to_pylist(const cdt_packed_array* packed, const std::vector<metaffi_int64>& strides, metaffi_type elem_type, size_t element_size, size_t dim, metaffi_int64 offset)
+{
+	const auto* elements = static_cast<const unsigned char*>(packed->data);
+	auto extent = static_cast<Py_ssize_t>(packed->shape[dim]);
+	bool innermost = dim + 1 == packed->rank;
+
+	// rows of bytes, like 1D packed uint8/int8 arrays
+	if(innermost && (elem_type == metaffi_uint8_type || elem_type == metaffi_int8_type))
+	{
+		if(strides[dim] == 1 || extent == 0)
+		{
+			return pPyBytes_FromStringAndSize(extent > 0 ? reinterpret_cast<const char*>(elements + offset) : "", extent);
+		}
+
+		std::string row(static_cast<size_t>(extent), '\0');
+		for(Py_ssize_t i = 0; i < extent; i++)
+		{
+			row[i] = static_cast<char>(elements[offset + i * strides[dim]]);
+		}
+		return pPyBytes_FromStringAndSize(row.data(), extent);
+	}
+
+	PyObject* list = pPyList_New(extent);
+	if(!list)
+	{
+		return nullptr;
+	}
+
+	for(Py_ssize_t i = 0; i < extent; i++)
+	{
+		metaffi_int64 item_offset = offset + i * strides[dim];
+		PyObject* item = innermost ?
+			packed_element_to_pyobject(elements + item_offset * static_cast<metaffi_int64>(element_size), elem_type) :
+			tensor_dimension_to_pylist(packed, strides, elem_type, element_size, dim + 1, item_offset);
+
+		if(!item)
+		{
+			Py_DECREF(list);
+			return nullptr;
+		}
+
+		pPyList_SetItem(list, i, item); // Steals reference
+	}
+
+	return list;
+}
+
+
+// Sets a string16/string32 CDT from the canonical code units of a str, converting straight
+// into the CDT's buffer (inline for small strings). Same-width code units take a single memcpy.
+template<typename char_t>
+void set_ucs_string(cdt& target, PyUnicode_Kind kind, const void* units, Py_ssize_t length)
+{
+	if(kind == static_cast<PyUnicode_Kind>(sizeof(char_t)))
+	{
+		target.set_string(static_cast<const char_t*>(units), static_cast<metaffi_size>(length), true);
+		return;
+	}
+
+	auto copy = [&](char_t* dst) {
+		if constexpr(sizeof(char_t) == sizeof(char16_t)) { py_str::copy_utf16(kind, units, length, dst); }
+		else { py_str::copy_utf32(kind, units, length, dst); }
+	};
+
+	Py_ssize_t size = sizeof(char_t) == sizeof(char16_t) ? py_str::utf16_length(kind, units, length) : length;
+	constexpr Py_ssize_t small_capacity = metaffi_small_string_capacity(sizeof(char_t));
+	if(size <= small_capacity)
+	{
+		char_t small[small_capacity + 1];
+		copy(small);
+		target.set_string(small, static_cast<metaffi_size>(size), true);
+		return;
+	}
+
+	auto* buf = static_cast<char_t*>(xllr_alloc_memory(static_cast<size_t>(size + 1) * sizeof(char_t)));
+	if(!buf)
+	{
+		throw std::bad_alloc();
+	}
+	copy(buf);
+	buf[size] = 0;
+
+	target.set_string(buf, static_cast<metaffi_size>(size), false);
+	target.free_required = true; // the CDT owns buf
+}
+
+}
+
+bool cdts_python3_serializer::pyobject_to_packed_tensor(PyObject* obj, cdt& target, metaffi_type element_type)
+{
+	bool format_element_type = element_type == metaffi_any_type;
+	char kind = packed_element_kind(element_type);
+	size_t element_size = metaffi::runtime::packed_element_size(element_type);
+	if(kind == 0 && !format_element_type)
+	{
+		return false;
+	}
+
+	// rectangular nested lists/tuples - the shape follows the first item of each level
+	if(is_pysequence(obj))
+	{
+		if(format_element_type)
+		{
+			return false;
+		}
+
+		std::vector<metaffi_size> shape;
+		for(PyObject* level = obj; is_pysequence(level); level = pysequence_item(level, 0))
+		{
+			Py_ssize_t size = pysequence_size(level);
+			shape.push_back(static_cast<metaffi_size>(size));
+			if(size == 0)
+			{
+				break;
+			}
+		}
+
+		if(shape.size() < 2)
+		{
+			return false;
+		}
+
+		// the CDT owns the tensor from here - freed with the CDTS if the conversion fails
+		cdt_packed_array* packed = metaffi::runtime::alloc_packed_tensor(shape.size(), shape.data(), element_size);
+		target.set_packed_array(packed, static_cast<metaffi_types>(element_type));
+
+		auto* out = static_cast<unsigned char*>(packed->data);
+		if(!flatten_pysequence(obj, shape, 0, element_type, element_size, out))
+		{
+			std::string error = check_python_error();
+			throw_py_err("pyobject_to_packed_tensor: expected rectangular nested lists of element type " + std::to_string(element_type) + (error.empty() ? "" : ": " + error));
+		}
+
+		return true;
+	}
+
+	// buffer protocol objects (bytes are handled by bytes_to_packed_cdt)
+	PyTypeObject* type = Py_TYPE(obj);
+	if(py_bytes::check(obj) || !type->tp_as_buffer || !type->tp_as_buffer->bf_getbuffer)
+	{
+		return false;
+	}
+
+	// heap allocated, as exporters may point view.shape into the Py_buffer itself
+	auto pview = std::make_unique<Py_buffer>();
+	Py_buffer& view = *pview;
+	if(pPyObject_GetBuffer(obj, &view, PyBUF_RECORDS_RO) != 0)
+	{
+		std::string error = check_python_error();
+		if(format_element_type)
+		{
+			return false;
+		}
+		throw_py_err("pyobject_to_packed_tensor: failed getting buffer: " + error);
+	}
+
+	if(format_element_type)
+	{
+		element_type = buffer_format_type(view.format, view.itemsize);
+		if(element_type == 0)
+		{
+			pPyBuffer_Release(&view);
+			return false;
+		}
+		kind = packed_element_kind(element_type);
+		element_size = metaffi::runtime::packed_element_size(element_type);
+	}
+
+	try
+	{
+		if(static_cast<size_t>(view.itemsize) != element_size || buffer_format_kind(view.format) != kind)
+		{
+			throw_py_err("pyobject_to_packed_tensor: buffer format \"" + std::string(view.format ? view.format : "B") + "\" does not match element type " + std::to_string(element_type));
+		}
+
+		// 0-dim buffers are a single element
+		metaffi_size rank = view.ndim > 0 ? static_cast<metaffi_size>(view.ndim) : 1;
+		std::vector<metaffi_size> shape(rank, 1);
+		std::vector<metaffi_int64> strides(rank, 1);
+		for(int dim = 0; dim < view.ndim; dim++)
+		{
+			if(view.strides[dim] % view.itemsize != 0)
+			{
+				throw_py_err("pyobject_to_packed_tensor: buffer strides are not a multiple of the item size");
+			}
+
+			shape[dim] = static_cast<metaffi_size>(view.shape[dim]);
+			strides[dim] = static_cast<metaffi_int64>(view.strides[dim] / view.itemsize);
+		}
+
+		// point to the buffer, which stays exported (and the object alive) until the serializer is destroyed
+		if(m_borrow_buffers && is_c_contiguous_buffer(view))
+		{
+			metaffi_size length = 1;
+			for(metaffi_size extent : shape)
+			{
+				length *= extent;
+			}
+
+			target.set_borrowed_packed_array(length > 0 ? view.buf : nullptr, length, static_cast<metaffi_types>(element_type));
+			if(rank > 1)
+			{
+				metaffi::runtime::alloc_packed_shape(target.get_packed_array(), rank, shape.data());
+			}
+
+			m_borrowed_views.push_back(std::move(pview));
+			return true;
+		}
+
+		cdt_packed_array* packed = metaffi::runtime::alloc_packed_tensor(rank, shape.data(), element_size);
+		target.set_packed_array(packed, static_cast<metaffi_types>(element_type));
+
+		if(is_c_contiguous_buffer(view))
+		{
+			if(packed->length > 0)
+			{
+				std::memcpy(packed->data, view.buf, packed->length * element_size);
+			}
+		}
+		else if(rank == 1)
+		{
+			const auto* src = static_cast<const unsigned char*>(view.buf);
+			auto* dst = static_cast<unsigned char*>(packed->data);
+			for(metaffi_size i = 0; i < packed->length; i++)
+			{
+				std::memcpy(dst + i * element_size, src + static_cast<metaffi_int64>(i) * strides[0] * static_cast<metaffi_int64>(element_size), element_size);
+			}
+		}
+		else
+		{
+			cdt_packed_array source(view.buf, packed->length, true);
+			source.rank = rank;
+			source.shape = shape.data();
+			source.strides = strides.data();
+			metaffi::runtime::copy_packed_elements(&source, element_size, packed->data);
+		}
+	}
+	catch(...)
+	{
+		pPyBuffer_Release(&view);
+		throw;
+	}
+
+	pPyBuffer_Release(&view);
+	return true;
+}
+
+PyObject* cdts_python3_serializer::packed_tensor_to_pylist(const cdt_packed_array* packed, metaffi_type elem_type)
+{
+	// GIL assumed to be held
+	size_t element_size = metaffi::runtime::packed_element_size(elem_type);
+	if(packed_element_kind(elem_type) == 0)
+	{
+		throw_py_err("packed_tensor_to_pylist: unsupported element type " + std::to_string(elem_type));
+	}
+
+	// element strides of each dimension
+	std::vector<metaffi_int64> strides(packed->rank, 1);
+	if(packed->strides)
+	{
+		strides.assign(packed->strides, packed->strides + packed->rank);
+	}
+	else
+	{
+		for(metaffi_size dim = packed->rank - 1; dim > 0; dim--)
+		{
+			strides[dim - 1] = strides[dim] * static_cast<metaffi_int64>(packed->shape[dim]);
+		}
+	}
+
+	if(pPyErr_Occurred())
+	{
+		pPyErr_Clear();
+	}
+
+	PyObject* list = tensor_dimension_to_pylist(packed, strides, elem_type, element_size, 0, 0);
+	if(!list)
+	{
+		std::string error = check_python_error();
+		throw_py_err("packed_tensor_to_pylist: failed to create nested lists: " + (error.empty() ? std::string("unknown error") : error));
+	}
+
+	return list;
+}
+
 // ============================================================================
 // VALIDATION HELPERS
 // ============================================================================
@@ -373,6 +1133,12 @@ void cdts_python3_serializer::pyobject_to_cdt(PyObject* obj, cdt& target, metaff
 		// For other types, detect and recurse
 		if(!py_list::check(obj) && !py_tuple::check(obj))
 		{
+			// buffer protocol objects (memoryview, bytearray, array.array, numpy arrays...) as packed arrays of the buffer's format
+			if(pyobject_to_packed_tensor(obj, target, metaffi_any_type))
+			{
+				return;
+			}
+
 			metaffi_type detected_type = py_object::get_metaffi_type(obj);
 			// Recursively call with detected type
 			pyobject_to_cdt(obj, target, detected_type);
@@ -490,71 +1256,85 @@ void cdts_python3_serializer::pyobject_to_cdt(PyObject* obj, cdt& target, metaff
 		{
 			case metaffi_string8_type:
 			{
-				// Convert to UTF-8
-				PyObject* utf8_bytes = pPyUnicode_AsUTF8String(obj);
-				if(!utf8_bytes)
+				// UTF-8 cached on the str (or the str itself, if compact ASCII) - no intermediate bytes object
+				Py_ssize_t size;
+				const char* str_data = py_str::utf8_data(obj, size);
+				if(!str_data)
 				{
 					std::string error_msg = check_python_error();
 					throw_py_err("Failed to convert Unicode to UTF-8: " + error_msg);
 				}
 
-				Py_ssize_t size;
-				char* str_data;
-				if(pPyBytes_AsStringAndSize(utf8_bytes, &str_data, &size) == -1)
+				// Small strings are stored inline in the CDT, others are allocated using xllr
+				try
 				{
-					Py_DECREF(utf8_bytes);
-					std::string error_msg = check_python_error();
-					throw_py_err("Failed to get UTF-8 string data: " + error_msg);
+					target.set_string((const char8_t*)str_data, (metaffi_size)size, true);
 				}
-
-				// Allocate using xllr
-				char8_t* allocated_str = xllr_alloc_string8((const char8_t*)str_data, size);
-				Py_DECREF(utf8_bytes);
-
-				if(!allocated_str)
+				catch(const std::bad_alloc&)
 				{
-					throw_py_err("xllr_alloc_string8 failed");
+					throw_py_err("Failed to allocate string8");
 				}
-
-				target.type = metaffi_string8_type;
-				target.cdt_val.string8_val = allocated_str;
-				target.free_required = true;
 				break;
 			}
 			case metaffi_string16_type:
 			case metaffi_string32_type:
 			{
-				std::ostringstream oss;
-				oss << "String encoding " << (target_type == metaffi_string16_type ? "UTF-16" : "UTF-32") 
-				    << " not yet implemented for Python3 serializer";
-				throw_py_err(oss.str());
+				// Encode straight from the canonical code units
+				PyUnicode_Kind kind;
+				const void* units;
+				Py_ssize_t length;
+				if(!py_str::canonical_data(obj, kind, units, length))
+				{
+					std::string error_msg = check_python_error();
+					throw_py_err("Failed to read Unicode data: " + error_msg);
+				}
+				if(!py_str::check_no_surrogates(kind, units, length))
+				{
+					std::string error_msg = check_python_error();
+					throw_py_err((target_type == metaffi_string16_type ? "Failed to convert Unicode to UTF-16: " : "Failed to convert Unicode to UTF-32: ") + error_msg);
+				}
+
+				try
+				{
+					if(target_type == metaffi_string16_type)
+					{
+						set_ucs_string<char16_t>(target, kind, units, length);
+					}
+					else
+					{
+						set_ucs_string<char32_t>(target, kind, units, length);
+					}
+				}
+				catch(const std::bad_alloc&)
+				{
+					throw_py_err(target_type == metaffi_string16_type ? "Failed to allocate string16" : "Failed to allocate string32");
+				}
+				break;
 			}
 			case metaffi_char8_type:
 			case metaffi_char16_type:
 			case metaffi_char32_type:
 			{
-				// Single character: get first code point from Python str
-				PyObject* utf32_bytes = pPyUnicode_AsUTF32String(obj);
-				if(!utf32_bytes)
+				// Single character: first code point of the Python str
+				PyUnicode_Kind kind;
+				const void* units;
+				Py_ssize_t length;
+				if(!py_str::canonical_data(obj, kind, units, length))
 				{
 					std::string error_msg = check_python_error();
-					throw_py_err("Failed to convert Unicode to UTF-32: " + error_msg);
+					throw_py_err("Failed to read Unicode data: " + error_msg);
 				}
-				char* buf = nullptr;
-				Py_ssize_t buf_size = 0;
-				if(pPyBytes_AsStringAndSize(utf32_bytes, &buf, &buf_size) == -1)
+				if(length < 1)
 				{
-					Py_DECREF(utf32_bytes);
-					std::string error_msg = check_python_error();
-					throw_py_err("Failed to get UTF-32 buffer: " + error_msg);
+					throw_py_err("Python string is empty; cannot convert to single character");
 				}
-				if(buf_size < 8)  // BOM (4) + at least one code point (4)
+				if(!py_str::check_no_surrogates(kind, units, 1))
 				{
-					Py_DECREF(utf32_bytes);
-					throw_py_err("Python string is empty; cannot convert to single character");
+					std::string error_msg = check_python_error();
+					throw_py_err("Failed to convert Unicode to UTF-32: " + error_msg);
 				}
-				char32_t cp = *reinterpret_cast<const char32_t*>(buf + 4);  // skip BOM
-				Py_DECREF(utf32_bytes);
+				char32_t cp;
+				py_str::copy_utf32(kind, units, 1, &cp);
 
 				target.free_required = false;
 				if(target_type == metaffi_char32_type)
@@ -632,34 +1412,7 @@ void cdts_python3_serializer::pyobject_to_cdt(PyObject* obj, cdt& target, metaff
 			// Check if target expects a packed array
 			if(metaffi_is_packed_array(target_type))
 			{
-				// Create packed uint8 array via xllr allocator
-				cdt_packed_array* packed = static_cast<cdt_packed_array*>(xllr_alloc_memory(sizeof(cdt_packed_array)));
-				if(!packed) { throw_py_err("Failed to allocate cdt_packed_array for packed bytes array"); }
-				packed->data = nullptr;
-				packed->length = static_cast<metaffi_size>(size);
-
-				if(size == 0)
-				{
-					// packed->data already nullptr
-				}
-				else
-				{
-					auto* buf = static_cast<metaffi_uint8*>(xllr_alloc_memory(static_cast<size_t>(size) * sizeof(metaffi_uint8)));
-					if(!buf)
-					{
-						xllr_free_memory(packed);
-						throw_py_err("Failed to allocate buffer for packed bytes array");
-					}
-
-					// Copy bytes to buffer
-					for(Py_ssize_t i = 0; i < size; i++)
-					{
-						buf[i] = static_cast<metaffi_uint8>(data[i]);
-					}
-					packed->data = buf;
-				}
-
-				target.set_packed_array(packed, metaffi_uint8_type);
+				bytes_to_packed_cdt(obj, target, metaffi_uint8_type);
 				return;
 			}
 
@@ -680,6 +1433,27 @@ void cdts_python3_serializer::pyobject_to_cdt(PyObject* obj, cdt& target, metaff
 		// For handle, fall through to handle serialization
 	}
 
+	// Nested lists/tuples and buffer protocol objects (array.array, memoryview, numpy arrays...) to packed tensors
+	if(metaffi_is_packed_array(target_type) && pyobject_to_packed_tensor(obj, target, metaffi_packed_element_type(target_type)))
+	{
+		return;
+	}
+
+	// buffer protocol objects passed as regular arrays are packed as well, instead of converting each element to a CDT
+	if((target_type & metaffi_array_type) && !metaffi_is_packed_array(target_type) && !is_pysequence(obj))
+	{
+		metaffi_type element_type = static_cast<metaffi_type>(target_type & ~metaffi_array_type);
+		if(packed_element_kind(element_type) == 0)
+		{
+			element_type = metaffi_any_type;
+		}
+
+		if(pyobject_to_packed_tensor(obj, target, element_type))
+		{
+			return;
+		}
+	}
+
 	// Handle list/tuple - treat as array unless explicitly requested as handle.
 	if(py_list::check(obj) || py_tuple::check(obj))
 	{
@@ -696,6 +1470,11 @@ void cdts_python3_serializer::pyobject_to_cdt(PyObject* obj, cdt& target, metaff
 				if(!packed) { throw_py_err("pyobject_to_cdt packed: xllr_alloc_memory failed for cdt_packed_array"); }
 				packed->data = nullptr;
 				packed->length = static_cast<metaffi_size>(length);
+				packed->is_borrowed = 0;
+				packed->is_string_blob = 0;
+				packed->rank = 0;
+				packed->shape = nullptr;
+				packed->strides = nullptr;
 
 				if(length == 0)
 				{
@@ -743,15 +1522,7 @@ void cdts_python3_serializer::pyobject_to_cdt(PyObject* obj, cdt& target, metaff
 						break;
 					}
 					case metaffi_string8_type: {
-						auto* buf = static_cast<metaffi_string8*>(xllr_alloc_memory(static_cast<size_t>(length) * sizeof(metaffi_string8)));
-						if(!buf) { xllr_free_memory(packed); throw_py_err("pyobject_to_cdt packed: xllr_alloc_memory failed for string8"); }
-						for(Py_ssize_t i = 0; i < length; i++) {
-							Py_ssize_t str_len = 0;
-							const char* str = pPyUnicode_AsUTF8AndSize(get_item(i), &str_len);
-							if(!str) { xllr_free_memory(buf); xllr_free_memory(packed); throw_py_err("pyobject_to_cdt packed: string conversion failed"); }
-							buf[i] = xllr_alloc_string8(reinterpret_cast<const char8_t*>(str), static_cast<uint64_t>(str_len));
-						}
-						packed->data = buf;
+						pystrings_to_packed_blob(obj, length, packed, "pyobject_to_cdt packed");
 						break;
 					}
 					default:
@@ -1095,33 +1866,127 @@ void cdts_python3_serializer::pyobject_to_cdt(PyObject* obj, cdt& target, metaff
 		return;
 	}
 
-	// Wrap the PyObject in a handle and increment refcount
-	Py_INCREF(obj);  // Keep object alive while in handle
+	// Wrap the PyObject in a handle and increment refcount
+	Py_INCREF(obj);  // Keep object alive while in handle
+
+	target.type = metaffi_handle_type;
+	void* handle_mem = xllr_alloc_memory(sizeof(cdt_metaffi_handle));
+	if(!handle_mem)
+	{
+		Py_DECREF(obj);  // Release the reference we just added
+		throw_py_err("Failed to allocate memory for cdt_metaffi_handle");
+	}
+	target.cdt_val.handle_val = new (handle_mem) cdt_metaffi_handle();
+	target.cdt_val.handle_val->handle = obj;
+	target.cdt_val.handle_val->runtime_id = PYTHON3_RUNTIME_ID;
+	target.cdt_val.handle_val->release = cpython3_runtime_manager::py_object_releaser;
+	target.free_required = true;
+}
+
+PyObject* cdts_python3_serializer::extract_pyobject()
+{
+	auto gil = m_runtime.acquire_gil();
+
+	check_bounds(current_index);
+
+	PyObject* result = extract_cdt(data[current_index], m_packed_extraction);
+	current_index++;
+
+	return result;  // New reference
+}
+
+PyObject* cdts_python3_serializer::extract_pyobject(const metaffi_type_info& type_info)
+{
+	auto gil = m_runtime.acquire_gil();
+
+	check_bounds(current_index);
+
+	PyObject* result = extract_cdt(data[current_index], packed_array_extraction_from_alias(type_info.alias, m_packed_extraction));
+	current_index++;
+
+	return result;  // New reference
+}
+
+PyObject* cdts_python3_serializer::extract_cdt(cdt& source, packed_array_extraction mode)
+{
+	// GIL is assumed to be held by caller
+	if(mode == packed_array_extraction::list)
+	{
+		return cdt_to_pyobject(source);
+	}
+
+	if(metaffi_is_packed_array(source.type))
+	{
+		return mode == packed_array_extraction::array ? packed_cdt_to_pyarray(source) : packed_cdt_to_memoryview(source);
+	}
+
+	if((source.type & metaffi_array_type) && source.type != metaffi_array_type && source.cdt_val.array_val)
+	{
+		PyObject* res = cdt_array_to_buffer_object(*source.cdt_val.array_val, source.type & ~metaffi_array_type, mode);
+		if(res)
+		{
+			return res;
+		}
+	}
+
+	return cdt_to_pyobject(source);
+}
+
+namespace
+{
+std::atomic<packed_array_extraction>& default_extraction()
+{
+	static std::atomic<packed_array_extraction> mode([]()
+	{
+		packed_array_extraction res = packed_array_extraction::list;
+		char* env = metaffi_getenv_alloc("METAFFI_PYTHON3_PACKED_ARRAYS");
+		if(env)
+		{
+			if(std::strcmp(env, "memoryview") == 0)
+			{
+				res = packed_array_extraction::memoryview;
+			}
+			else if(std::strcmp(env, "array") == 0)
+			{
+				res = packed_array_extraction::array;
+			}
+			metaffi_free_env(env);
+		}
+		return res;
+	}());
+
+	return mode;
+}
+}
 
-	target.type = metaffi_handle_type;
-	void* handle_mem = xllr_alloc_memory(sizeof(cdt_metaffi_handle));
-	if(!handle_mem)
-	{
-		Py_DECREF(obj);  // Release the reference we just added
-		throw_py_err("Failed to allocate memory for cdt_metaffi_handle");
-	}
-	target.cdt_val.handle_val = new (handle_mem) cdt_metaffi_handle();
-	target.cdt_val.handle_val->handle = obj;
-	target.cdt_val.handle_val->runtime_id = PYTHON3_RUNTIME_ID;
-	target.cdt_val.handle_val->release = cpython3_runtime_manager::py_object_releaser;
-	target.free_required = true;
+void cdts_python3_serializer::set_default_packed_array_extraction(packed_array_extraction mode)
+{
+	default_extraction() = mode;
 }
 
-PyObject* cdts_python3_serializer::extract_pyobject()
+packed_array_extraction cdts_python3_serializer::default_packed_array_extraction()
 {
-	auto gil = m_runtime.acquire_gil();
+	return default_extraction();
+}
 
-	check_bounds(current_index);
+packed_array_extraction cdts_python3_serializer::packed_array_extraction_from_alias(const char* alias, packed_array_extraction fallback)
+{
+	if(!alias)
+	{
+		return fallback;
+	}
 
-	PyObject* result = cdt_to_pyobject(data[current_index]);
-	current_index++;
+	if(std::strcmp(alias, "memoryview") == 0)
+	{
+		return packed_array_extraction::memoryview;
+	}
 
-	return result;  // New reference
+	if(std::strcmp(alias, "array.array") == 0)
+	{
+		return packed_array_extraction::array;
+	}
+
+	return fallback;
 }
 
 // ============================================================================
@@ -1815,14 +2680,16 @@ PyObject* cdts_python3_serializer::cdt_to_pyobject(const cdt& source)
 		case metaffi_string8_type:
 		{
 			PyObject* result;
-			if(!source.cdt_val.string8_val)
+			if(!metaffi_cdt_string8(&source))
 			{
 				// Empty string
 				result = pPyUnicode_FromString("");
 			}
 			else
 			{
-				result = pPyUnicode_FromString((const char*)source.cdt_val.string8_val);
+				// sized strings keep their length (and embedded NULLs)
+				std::u8string_view view = source.get_string8_view();
+				result = pPyUnicode_FromStringAndSize((const char*)view.data(), (Py_ssize_t)view.size());
 			}
 			if(!result || pPyErr_Occurred())
 			{
@@ -1839,23 +2706,18 @@ PyObject* cdts_python3_serializer::cdt_to_pyobject(const cdt& source)
 		case metaffi_string16_type:
 		{
 			PyObject* result;
-			if(!source.cdt_val.string16_val)
+			if(!metaffi_cdt_string16(&source))
 			{
 				// Empty string
 				result = pPyUnicode_FromString("");
 			}
 			else
 			{
-				// Count UTF-16 code units (find null terminator)
-				size_t length = 0;
-				while(source.cdt_val.string16_val[length] != 0)
-				{
-					length++;
-				}
-
+				// UTF-16 code units (stored length, or up to the null terminator)
+				std::u16string_view view = source.get_string16_view();
 				result = pPyUnicode_FromKindAndData(PyUnicode_2BYTE_KIND,
-				                                 source.cdt_val.string16_val,
-				                                 length);
+				                                 view.data(),
+				                                 (Py_ssize_t)view.size());
 			}
 			if(!result || pPyErr_Occurred())
 			{
@@ -1872,23 +2734,18 @@ PyObject* cdts_python3_serializer::cdt_to_pyobject(const cdt& source)
 		case metaffi_string32_type:
 		{
 			PyObject* result;
-			if(!source.cdt_val.string32_val)
+			if(!metaffi_cdt_string32(&source))
 			{
 				// Empty string
 				result = pPyUnicode_FromString("");
 			}
 			else
 			{
-				// Count UTF-32 code units (find null terminator)
-				size_t length = 0;
-				while(source.cdt_val.string32_val[length] != 0)
-				{
-					length++;
-				}
-
+				// UTF-32 code units (stored length, or up to the null terminator)
+				std::u32string_view view = source.get_string32_view();
 				result = pPyUnicode_FromKindAndData(PyUnicode_4BYTE_KIND,
-				                                 source.cdt_val.string32_val,
-				                                 length);
+				                                 view.data(),
+				                                 (Py_ssize_t)view.size());
 			}
 			if(!result || pPyErr_Occurred())
 			{
@@ -2115,8 +2972,8 @@ PyObject* cdts_python3_serializer::extract_as_tuple()
 			METAFFI_DEBUG(LOG, "extract_as_tuple: data[{}].type={}", (current_index + i), data[current_index + i].type);
 			try
 			{
-				PyObject* item = cdt_to_pyobject(data[current_index + i]);
-				METAFFI_DEBUG(LOG, "extract_as_tuple: cdt_to_pyobject returned {}", static_cast<void*>(item));
+				PyObject* item = extract_cdt(data[current_index + i], m_packed_extraction);
+				METAFFI_DEBUG(LOG, "extract_as_tuple: extract_cdt returned {}", static_cast<void*>(item));
 				int set_result = pPyTuple_SetItem(tuple, i, item);  // Steals reference to item
 				if(set_result == -1 || pPyErr_Occurred())
 				{
@@ -2151,6 +3008,45 @@ PyObject* cdts_python3_serializer::extract_as_tuple()
 	}
 }
 
+PyObject* cdts_python3_serializer::extract_as_tuple(const metaffi_type_info* types, metaffi_size types_count)
+{
+	auto gil = m_runtime.acquire_gil();
+
+	metaffi_size remaining = data.length - current_index;
+	if(types_count != remaining)
+	{
+		throw_py_err("extract_as_tuple: got " + std::to_string(types_count) + " types for " + std::to_string(remaining) + " remaining elements");
+	}
+
+	PyObject* tuple = pPyTuple_New(remaining);
+	if(!tuple)
+	{
+		throw_py_err("Failed to create Python tuple");
+	}
+
+	try
+	{
+		for(metaffi_size i = 0; i < remaining; i++)
+		{
+			packed_array_extraction mode = packed_array_extraction_from_alias(types[i].alias, m_packed_extraction);
+			PyObject* item = extract_cdt(data[current_index + i], mode);
+			if(pPyTuple_SetItem(tuple, i, item) == -1)  // Steals reference to item
+			{
+				std::string error = check_python_error();
+				throw_py_err("Failed to set item in tuple at index " + std::to_string(i) + ": " + error);
+			}
+		}
+
+		current_index = data.length;  // Mark all extracted
+		return tuple;  // New reference
+	}
+	catch(...)
+	{
+		Py_DECREF(tuple);
+		throw;
+	}
+}
+
 // ============================================================================
 // ARRAY SUPPORT
 // ============================================================================
@@ -2331,6 +3227,172 @@ static bool try_fill_1d_primitive_cdts_from_pysequence(PyObject* list, cdts& arr
 	return true;
 }
 
+// Type-specialized loops for the speculative single-pass conversion below.
+// Each returns false (with no Python error set) on the first item of an unexpected exact type,
+// or that fails to convert, leaving the caller to rerun the general path.
+
+template<typename T, typename get_item_t>
+static bool fill_int_items(get_item_t get_item, Py_ssize_t len, cdts& arr)
+{
+	for(Py_ssize_t i = 0; i < len; i++)
+	{
+		PyObject* item = get_item(i);
+		if(!pPyLong_Check(item))
+		{
+			return false;
+		}
+
+		if constexpr(std::is_same_v<T, metaffi_uint64>)
+		{
+			unsigned long long v = pPyLong_AsUnsignedLongLong(item);
+			if(v == (unsigned long long)-1 && pPyErr_Occurred())
+			{
+				pPyErr_Clear();
+				return false;
+			}
+			arr[i] = static_cast<T>(v);
+		}
+		else
+		{
+			long long v = pPyLong_AsLongLong(item);
+			if(v == -1 && pPyErr_Occurred())
+			{
+				pPyErr_Clear();
+				return false;
+			}
+			if constexpr(sizeof(T) < sizeof(long long))
+			{
+				if(v < (long long)std::numeric_limits<T>::min() || v > (long long)std::numeric_limits<T>::max())
+				{
+					return false;
+				}
+			}
+			arr[i] = static_cast<T>(v);
+		}
+	}
+
+	return true;
+}
+
+template<typename T, typename get_item_t>
+static bool fill_float_items(get_item_t get_item, Py_ssize_t len, cdts& arr)
+{
+	for(Py_ssize_t i = 0; i < len; i++)
+	{
+		PyObject* item = get_item(i);
+		if(!pPyFloat_Check(item))
+		{
+			return false;
+		}
+		arr[i] = static_cast<T>(pPyFloat_AS_DOUBLE(item));
+	}
+
+	return true;
+}
+
+template<typename get_item_t>
+static bool fill_bool_items(get_item_t get_item, Py_ssize_t len, cdts& arr)
+{
+	for(Py_ssize_t i = 0; i < len; i++)
+	{
+		PyObject* item = get_item(i);
+		if(!pPyBool_Check(item))
+		{
+			return false;
+		}
+		arr[i] = (item == pPy_True);
+	}
+
+	return true;
+}
+
+template<typename get_item_t>
+static bool fill_string8_items(get_item_t get_item, Py_ssize_t len, cdts& arr)
+{
+	for(Py_ssize_t i = 0; i < len; i++)
+	{
+		PyObject* item = get_item(i);
+		if(!pPyUnicode_Check(item))
+		{
+			return false;
+		}
+
+		Py_ssize_t size = 0;
+		const char* utf8 = py_str::utf8_data(item, size);
+		if(!utf8)
+		{
+			pPyErr_Clear();
+			return false;
+		}
+		arr[i].set_string((const char8_t*)utf8, (metaffi_size)size, true);
+	}
+
+	return true;
+}
+
+template<typename get_item_t>
+static bool fill_homogeneous_items(get_item_t get_item, Py_ssize_t len, cdts& arr, metaffi_type element_type)
+{
+	switch(element_type)
+	{
+		case metaffi_int8_type: return fill_int_items<metaffi_int8>(get_item, len, arr);
+		case metaffi_int16_type: return fill_int_items<metaffi_int16>(get_item, len, arr);
+		case metaffi_int32_type: return fill_int_items<metaffi_int32>(get_item, len, arr);
+		case metaffi_int64_type: return fill_int_items<metaffi_int64>(get_item, len, arr);
+		case metaffi_uint8_type: return fill_int_items<metaffi_uint8>(get_item, len, arr);
+		case metaffi_uint16_type: return fill_int_items<metaffi_uint16>(get_item, len, arr);
+		case metaffi_uint32_type: return fill_int_items<metaffi_uint32>(get_item, len, arr);
+		case metaffi_uint64_type: return fill_int_items<metaffi_uint64>(get_item, len, arr);
+		case metaffi_float32_type: return fill_float_items<metaffi_float32>(get_item, len, arr);
+		case metaffi_float64_type: return fill_float_items<metaffi_float64>(get_item, len, arr);
+		case metaffi_bool_type: return fill_bool_items(get_item, len, arr);
+		case metaffi_string8_type: return fill_string8_items(get_item, len, arr);
+		default: return false;
+	}
+}
+
+// Speculative single-pass conversion of a flat, homogeneous list/tuple.
+// Assumes every item has exactly the Python type of the expected element type (or of the first
+// item, if no specific type is expected) and converts it without the get_metadata() pre-walk.
+// Exact type checks keep bool apart from int and leave subclasses to the general path.
+// Returns false, leaving target untouched, on any mismatch.
+static bool try_single_pass_pylist_to_cdt_array(PyObject* list, Py_ssize_t len, cdt& target, metaffi_type element_type)
+{
+	bool is_list = py_list::check(list);
+
+	if(element_type == 0 || element_type == metaffi_any_type || element_type == metaffi_null_type)
+	{
+		PyObject* first = is_list ? pPyList_ITEMS(list)[0] : pPyTuple_GetItem(list, 0);
+		if(pPyLong_Check(first)) { element_type = metaffi_int64_type; }
+		else if(pPyFloat_Check(first)) { element_type = metaffi_float64_type; }
+		else if(pPyUnicode_Check(first)) { element_type = metaffi_string8_type; }
+		else if(pPyBool_Check(first)) { element_type = metaffi_bool_type; }
+		else { return false; }
+	}
+
+	std::unique_ptr<cdts> arr(new cdts((metaffi_size)len, 1));
+
+	bool converted;
+	if(is_list)
+	{
+		// Exact type checks run no Python code, so the item vector stays valid throughout
+		PyObject** items = pPyList_ITEMS(list);
+		converted = fill_homogeneous_items([items](Py_ssize_t i) { return items[i]; }, len, *arr, element_type);
+	}
+	else
+	{
+		converted = fill_homogeneous_items([list](Py_ssize_t i) { return pPyTuple_GetItem(list, i); }, len, *arr, element_type);
+	}
+
+	if(!converted)
+	{
+		return false; // arr frees the strings converted so far
+	}
+
+	target.set_array(arr.release(), static_cast<metaffi_types>(element_type));
+	return true;
+}
+
 void cdts_python3_serializer::pylist_to_cdt_array(PyObject* list, cdt& target, metaffi_type element_type)
 {
 	// GIL assumed to be held
@@ -2350,6 +3412,12 @@ void cdts_python3_serializer::pylist_to_cdt_array(PyObject* list, cdt& target, m
 		return;
 	}
 
+	// Fast path: flat lists of a single exact type convert in one pass
+	if(try_single_pass_pylist_to_cdt_array(list, len, target, element_type))
+	{
+		return;
+	}
+
 	// Determine common type and fixed dimensions
 	bool is_1d_array = true;
 	bool is_fixed_dimension = true;
@@ -2506,6 +3574,11 @@ PyObject* cdts_python3_serializer::packed_cdt_to_pyobject(const cdt& source)
 	metaffi_type elem_type = metaffi_packed_element_type(source.type);
 	const cdt_packed_array* packed = source.cdt_val.packed_array_val;
 
+	if(packed && metaffi_packed_is_tensor(packed))
+	{
+		return packed_tensor_to_pylist(packed, elem_type);
+	}
+
 	if(!packed || packed->length == 0)
 	{
 		if(pPyErr_Occurred()) pPyErr_Clear();
@@ -2602,7 +3675,7 @@ PyObject* cdts_python3_serializer::packed_cdt_to_pyobject(const cdt& source)
 				case metaffi_string8_type: {
 					metaffi_string8 s = static_cast<metaffi_string8*>(packed->data)[i];
 					if(s) {
-						item = pPyUnicode_FromString(reinterpret_cast<const char*>(s));
+						item = pPyUnicode_FromStringAndSize(reinterpret_cast<const char*>(s), static_cast<Py_ssize_t>(metaffi::runtime::packed_string_length<char8_t>(packed, i)));
 					} else {
 						Py_INCREF(pPy_None);
 						item = pPy_None;
@@ -2632,4 +3705,164 @@ PyObject* cdts_python3_serializer::packed_cdt_to_pyobject(const cdt& source)
 	}
 }
 
+PyObject* cdts_python3_serializer::packed_cdt_to_memoryview(cdt& source)
+{
+	// GIL assumed to be held
+	if(!metaffi_is_packed_array(source.type))
+	{
+		throw_py_err("packed_cdt_to_memoryview: CDT is not a packed array");
+	}
+
+	metaffi_type elem_type = metaffi_packed_element_type(source.type);
+	const char* format = packed_buffer_format(elem_type);
+	if(!format)
+	{
+		return packed_cdt_to_pyobject(source);
+	}
+
+	size_t element_size = metaffi::runtime::packed_element_size(elem_type);
+	cdt_packed_array* packed = source.cdt_val.packed_array_val;
+	metaffi_size rank = packed ? metaffi::runtime::packed_rank(packed) : 1;
+	metaffi_size length = packed ? packed->length : 0;
+
+	std::vector<metaffi_size> shape(rank);
+	for(metaffi_size dim = 0; dim < rank; dim++)
+	{
+		shape[dim] = packed ? metaffi::runtime::packed_extent(packed, dim) : 0;
+	}
+
+	xllr_buffer_object* owner = new_xllr_buffer_object(format, element_size, shape);
+	if(!owner)
+	{
+		std::string error = check_python_error();
+		throw_py_err("packed_cdt_to_memoryview: failed to allocate the buffer object: " + error);
+	}
+
+	if(source.free_required && packed && !packed->is_borrowed && packed->data && metaffi::runtime::packed_is_contiguous(packed))
+	{
+		// take the buffer - leave an empty 1D packed array, the CDT still frees the header and the shape allocation
+		owner->data = packed->data;
+		packed->data = nullptr;
+		packed->length = 0;
+		packed->rank = 0;
+	}
+	else
+	{
+		owner->data = xllr_alloc_memory((std::max)(length, metaffi_size(1)) * element_size);
+		if(!owner->data)
+		{
+			Py_DECREF(owner);
+			throw_py_err("packed_cdt_to_memoryview: failed to allocate the buffer");
+		}
+
+		if(length > 0)
+		{
+			metaffi::runtime::copy_packed_elements(packed, element_size, owner->data);
+		}
+	}
+
+	PyObject* view = pPyMemoryView_FromObject(owner);
+	Py_DECREF(owner); // the memoryview holds the owner
+	if(!view)
+	{
+		std::string error = check_python_error();
+		throw_py_err("packed_cdt_to_memoryview: failed to create memoryview: " + error);
+	}
+
+	return view;
+}
+
+PyObject* cdts_python3_serializer::packed_cdt_to_pyarray(cdt& source)
+{
+	// GIL assumed to be held
+	if(!metaffi_is_packed_array(source.type))
+	{
+		throw_py_err("packed_cdt_to_pyarray: CDT is not a packed array");
+	}
+
+	metaffi_type elem_type = metaffi_packed_element_type(source.type);
+	const char* format = packed_buffer_format(elem_type);
+	cdt_packed_array* packed = source.cdt_val.packed_array_val;
+	if(!format || elem_type == metaffi_bool_type ||
+		(packed && (metaffi::runtime::packed_rank(packed) > 1 || !metaffi::runtime::packed_is_contiguous(packed))))
+	{
+		return packed_cdt_to_memoryview(source);
+	}
+
+	size_t element_size = metaffi::runtime::packed_element_size(elem_type);
+	metaffi_size length = packed && packed->data ? packed->length : 0;
+
+	PyObject* arr = new_pyarray(format, length > 0 ? packed->data : nullptr, length * element_size);
+	if(!arr)
+	{
+		std::string error = check_python_error();
+		throw_py_err("packed_cdt_to_pyarray: failed to create array.array: " + error);
+	}
+
+	return arr;
+}
+
+PyObject* cdts_python3_serializer::cdt_array_to_buffer_object(const cdts& arr, metaffi_type elem_type, packed_array_extraction mode)
+{
+	// GIL assumed to be held
+	const char* format = packed_buffer_format(elem_type);
+	if(!format)
+	{
+		return nullptr;
+	}
+
+	for(metaffi_size i = 0; i < arr.length; i++)
+	{
+		if(arr[i].type != elem_type)
+		{
+			return nullptr;
+		}
+	}
+
+	// gather the elements into an xllr buffer, owned by the memoryview (or copied into the array.array)
+	size_t element_size = metaffi::runtime::packed_element_size(elem_type);
+	auto* buffer = static_cast<unsigned char*>(xllr_alloc_memory((std::max)(arr.length, metaffi_size(1)) * element_size));
+	if(!buffer)
+	{
+		throw_py_err("cdt_array_to_buffer_object: failed to allocate the buffer");
+	}
+
+	for(metaffi_size i = 0; i < arr.length; i++)
+	{
+		std::memcpy(buffer + i * element_size, &arr[i].cdt_val, element_size);
+	}
+
+	if(mode == packed_array_extraction::array && elem_type != metaffi_bool_type)
+	{
+		PyObject* res = new_pyarray(format, buffer, arr.length * element_size);
+		xllr_free_memory(buffer);
+		if(!res)
+		{
+			std::string error = check_python_error();
+			throw_py_err("cdt_array_to_buffer_object: failed to create array.array: " + error);
+		}
+
+		return res;
+	}
+
+	xllr_buffer_object* owner = new_xllr_buffer_object(format, element_size, {arr.length});
+	if(!owner)
+	{
+		xllr_free_memory(buffer);
+		std::string error = check_python_error();
+		throw_py_err("cdt_array_to_buffer_object: failed to allocate the buffer object: " + error);
+	}
+	owner->data = buffer;
+
+	PyObject* view = pPyMemoryView_FromObject(owner);
+	Py_DECREF(owner); // the memoryview holds the owner
+	if(!view)
+	{
+		std::string error = check_python_error();
+		throw_py_err("cdt_array_to_buffer_object: failed to create memoryview: " + error);
+	}
+
+	return view;
+}
+
 } // namespace metaffi::utils
@@ -3,8 +3,10 @@
 #include <runtime/cdt.h>
 #include <runtime/metaffi_primitives.h>
 #include <runtime_manager/cpython3/python_api_wrapper.h>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 // Forward declaration
 class cpython3_runtime_manager;
@@ -12,6 +14,16 @@ class cpython3_runtime_manager;
 namespace metaffi::utils
 {
 
+/**
+ * @brief The Python objects numeric and bool arrays are extracted as
+ */
+enum class packed_array_extraction
+{
+	list,       // list of int/float/bool (bytes for int8/uint8), nested lists for tensors
+	memoryview, // memoryview owning the elements' buffer, in the array's format and shape
+	array       // array.array (1D numeric arrays), memoryview for tensors and bool arrays
+};
+
 /**
  * @brief CDTS Python3 Serializer - Converts between Python objects and CDTS structures
  *
@@ -39,6 +51,9 @@ private:
 	cpython3_runtime_manager& m_runtime;  // Reference to runtime manager for GIL
 	cdts& data;                           // Reference to CDTS being serialized/deserialized
 	metaffi_size current_index;           // Current position in CDTS
+	bool m_borrow_buffers;                // Borrow Python buffers instead of copying them
+	packed_array_extraction m_packed_extraction; // How numeric arrays are extracted
+	std::vector<std::unique_ptr<Py_buffer>> m_borrowed_views; // Buffer exports held for borrowed packed arrays
 
 public:
 	/**
@@ -48,6 +63,49 @@ public:
 	 */
 	cdts_python3_serializer(cpython3_runtime_manager& runtime, cdts& pcdts);
 
+	/**
+	 * @brief Releases the buffer exports held for borrowed packed arrays (see set_borrow_buffers)
+	 */
+	~cdts_python3_serializer();
+
+	/**
+	 * @brief Serialize bytes and C-contiguous buffer protocol objects (memoryview, bytearray, array.array, numpy arrays...)
+	 * as borrowed packed arrays pointing to the object's buffer (no copy).
+	 * bytes are borrowed as is, so they must be kept alive while the CDTS is used (e.g. input parameters of a call).
+	 * Other buffers are exported (PyObject_GetBuffer) until the serializer is destroyed, which keeps the object alive
+	 * and prevents resizing it - so the serializer must outlive the use of the CDTS.
+	 * Non-contiguous buffers are copied.
+	 */
+	void set_borrow_buffers(bool borrow) { m_borrow_buffers = borrow; }
+	[[nodiscard]] bool is_borrowing_buffers() const { return m_borrow_buffers; }
+
+	/**
+	 * @brief Extract numeric and bool arrays as memoryview or array.array objects instead of lists (or bytes),
+	 * avoiding a Python object per element.
+	 * - memoryview: takes ownership of a packed array's buffer if the CDT owns it (otherwise the elements are copied once),
+	 *   and frees it with xllr_free_memory when the memoryview and its exports are released.
+	 * - array: copies the elements into an array.array with a single memcpy (packed arrays).
+	 * 1D CDTS arrays of a numeric common type are gathered into a buffer.
+	 * Applies to the extracted values themselves, arrays nested in CDTS arrays are extracted as lists.
+	 * Defaults to default_packed_array_extraction(), and can be set per value by extract_pyobject(const metaffi_type_info&).
+	 */
+	void set_packed_array_extraction(packed_array_extraction mode) { m_packed_extraction = mode; }
+	[[nodiscard]] packed_array_extraction get_packed_array_extraction() const { return m_packed_extraction; }
+
+	/**
+	 * @brief Process-wide default of set_packed_array_extraction() for new serializers.
+	 * Initialized from the METAFFI_PYTHON3_PACKED_ARRAYS environment variable ("list", "memoryview" or "array"),
+	 * list if not set.
+	 */
+	static void set_default_packed_array_extraction(packed_array_extraction mode);
+	[[nodiscard]] static packed_array_extraction default_packed_array_extraction();
+
+	/**
+	 * @brief Extraction mode selected by a type alias: "memoryview" or "array.array".
+	 * @return fallback for other aliases (or nullptr)
+	 */
+	[[nodiscard]] static packed_array_extraction packed_array_extraction_from_alias(const char* alias, packed_array_extraction fallback);
+
 	// ===== SERIALIZATION (Python → CDTS) =====
 
 	/**
@@ -81,8 +139,9 @@ public:
 	 * All elements must be convertible to the specified element_type.
 	 * Uses contiguous memory layout for maximum performance.
 	 * Supports: int8-64, uint8-64, float32/64, bool, string8.
-	 * For bytes objects: pass as list of int, not bytes.
-	 * @param obj Python list or tuple (borrowed reference)
+	 * bytes objects are accepted for int8/uint8, and buffer protocol objects of a matching format for all the numeric types
+	 * (borrowed if set_borrow_buffers(true), otherwise copied).
+	 * @param obj Python list, tuple, bytes or buffer protocol object (borrowed reference)
 	 * @param element_type Base element type (e.g. metaffi_int32_type)
 	 * @return Reference to this serializer (for chaining)
 	 * @throws std::runtime_error if obj is not a list/tuple, or element_type unsupported
@@ -104,6 +163,16 @@ public:
 	 */
 	PyObject* extract_pyobject();
 
+	/**
+	 * @brief Extract single PyObject from CDTS at current index, as expected by type_info.
+	 * Numeric arrays are extracted as memoryview or array.array if the type's alias is "memoryview" or "array.array"
+	 * (see set_packed_array_extraction), letting each entity choose how its return values are extracted.
+	 * @return New Python reference (caller must DECREF)
+	 * @throws std::out_of_range if no more elements
+	 * @throws std::runtime_error if CDTS type cannot be converted
+	 */
+	PyObject* extract_pyobject(const metaffi_type_info& type_info);
+
 	/**
 	 * @brief Extract all remaining elements as Python tuple
 	 * @return New Python tuple reference (caller must DECREF)
@@ -116,6 +185,15 @@ public:
 	 */
 	PyObject* extract_as_tuple();
 
+	/**
+	 * @brief Extract all remaining elements as Python tuple, as expected by types (see extract_pyobject(const metaffi_type_info&))
+	 * @param types Type of each remaining element
+	 * @param types_count Number of types - must match the number of remaining elements
+	 * @return New Python tuple reference (caller must DECREF)
+	 * @throws std::runtime_error if any element cannot be converted, or types_count does not match
+	 */
+	PyObject* extract_as_tuple(const metaffi_type_info* types, metaffi_size types_count);
+
 	// ===== TYPE INTROSPECTION =====
 
 	/**
@@ -184,6 +262,41 @@ private:
 	 */
 	void pyobject_to_cdt(PyObject* obj, cdt& target, metaffi_type target_type);
 
+	/**
+	 * @brief Convert a bytes object to a packed int8/uint8 CDT (borrowed if m_borrow_buffers, otherwise copied)
+	 *
+	 * Assumes GIL is held
+	 */
+	void bytes_to_packed_cdt(PyObject* obj, cdt& target, metaffi_type element_type);
+
+	/**
+	 * @brief Fill packed with a string8 blob of the items (str or None) of a list/tuple.
+	 * On failure packed is freed and the error is thrown.
+	 *
+	 * Assumes GIL is held
+	 */
+	void pystrings_to_packed_blob(PyObject* seq, Py_ssize_t length, cdt_packed_array* packed, const char* caller);
+
+	/**
+	 * @brief Convert a rectangular nested list/tuple, or a buffer protocol object (array.array, memoryview, numpy array...),
+	 * of numbers/bools to a packed CDT - an N-D tensor if it has more than one dimension.
+	 * The elements are copied, except C-contiguous buffers if m_borrow_buffers.
+	 * @param element_type Element type, or metaffi_any_type to take it from the buffer's format (buffers only)
+	 * @return false if obj is neither a nested list/tuple nor a buffer (e.g. a flat list), or element_type is not numeric/bool.
+	 * With metaffi_any_type, also false if obj does not export a buffer of a numeric/bool format.
+	 * @throws std::runtime_error if the nested lists are ragged, or the buffer format does not match element_type
+	 *
+	 * Assumes GIL is held
+	 */
+	bool pyobject_to_packed_tensor(PyObject* obj, cdt& target, metaffi_type element_type);
+
+	/**
+	 * @brief Convert an extracted CDT - as cdt_to_pyobject, or numeric arrays as memoryview/array.array objects (see mode)
+	 *
+	 * Assumes GIL is held
+	 */
+	PyObject* extract_cdt(cdt& source, packed_array_extraction mode);
+
 	/**
 	 * @brief Convert CDT to Python object
 	 * @param source Source CDT to convert
@@ -227,7 +340,7 @@ private:
 	PyObject* cdt_array_to_pybytes(const cdts& arr, metaffi_type element_type);
 
 	/**
-	 * @brief Convert a packed CDT array to a Python list (or bytes for uint8/int8).
+	 * @brief Convert a packed CDT array to a Python list (or bytes for uint8/int8), and N-D tensors to nested lists.
 	 * @param source CDT with packed array data
 	 * @return New Python reference (list or bytes)
 	 * @throws std::runtime_error if source is not a packed array
@@ -236,6 +349,41 @@ private:
 	 */
 	PyObject* packed_cdt_to_pyobject(const cdt& source);
 
+	/**
+	 * @brief Convert a numeric/bool packed CDT array (or tensor) to a writable memoryview of the same format and shape.
+	 * Takes the buffer if source owns a contiguous one (leaving an empty packed array), otherwise copies the elements.
+	 * Other element types are converted by packed_cdt_to_pyobject.
+	 * @return New Python memoryview reference
+	 *
+	 * Assumes GIL is held
+	 */
+	PyObject* packed_cdt_to_memoryview(cdt& source);
+
+	/**
+	 * @brief Convert a 1D contiguous numeric packed CDT array to an array.array (a single memcpy).
+	 * Tensors and bool arrays (no array.array type code) are converted by packed_cdt_to_memoryview.
+	 * @return New Python array.array reference
+	 *
+	 * Assumes GIL is held
+	 */
+	PyObject* packed_cdt_to_pyarray(cdt& source);
+
+	/**
+	 * @brief Gather a 1D CDTS array whose elements all have the numeric/bool type elem_type into a memoryview or array.array.
+	 * @return New Python reference, or nullptr if an element is of another type (convert with cdt_array_to_pylist)
+	 *
+	 * Assumes GIL is held
+	 */
+	PyObject* cdt_array_to_buffer_object(const cdts& arr, metaffi_type elem_type, packed_array_extraction mode);
+
+	/**
+	 * @brief Convert a packed N-D tensor to nested lists (innermost uint8/int8 rows as bytes)
+	 * @return New Python list reference
+	 *
+	 * Assumes GIL is held
+	 */
+	PyObject* packed_tensor_to_pylist(const cdt_packed_array* packed, metaffi_type elem_type);
+
 	/**
 	 * @brief Validate that a Python integer fits in the target type
 	 * @param value Python long long value
@@ -3,9 +3,11 @@
 #include "cdts_python3_serializer.h"
 #include <runtime_manager/cpython3/runtime_manager.h>
 #include <runtime_manager/cpython3/python_api_wrapper.h>
+#include <runtime_manager/cpython3/py_str.h>
 #include <runtime/xllr_capi_loader.h>
 #include <runtime/xcall.h>
 #include <cdts_serializer/cpython3/runtime_id.h>
+#include <chrono>
 #include <cstdlib>
 #include <utils/safe_func.h>
 #include <utils/logger.hpp>
@@ -471,6 +473,88 @@ TEST_SUITE("CDTS Python3 Serializer")
 		Py_DECREF(extracted);
 	}
 
+	TEST_CASE("Serialize strings of every canonical width")
+	{
+		// Latin-1 (ASCII and not), UCS-2 and UCS-4 canonical forms, short (inline) and long (allocated)
+		const char* samples[] = {
+			"ascii",
+			"a compact ASCII string longer than the inline capacity",
+			"café",
+			"café crème brûlée, naïve façade",
+			"שלום",
+			"שלום שלום שלום",
+			"\U0001F680",
+			"rocket \U0001F680 to the moon \U0001F315 and back"
+		};
+
+		for(const char* sample : samples)
+		{
+			CAPTURE(sample);
+
+			cdts data(5);
+			cdts_python3_serializer ser(*g_runtime, data);
+
+			PyObject* str = pPyUnicode_FromString(sample);
+			ser.add(str, metaffi_string8_type).add(str, metaffi_string16_type).add(str, metaffi_string32_type);
+			ser.add(str, metaffi_char32_type).add(str, metaffi_char16_type);
+
+			PyObject* utf16 = pPyUnicode_AsUTF16String(str); // with BOM
+			PyObject* utf32 = pPyUnicode_AsUTF32String(str); // with BOM
+			std::u16string expected16((const char16_t*)pPyBytes_AsString(utf16) + 1, pPyBytes_Size(utf16) / 2 - 1);
+			std::u32string expected32((const char32_t*)pPyBytes_AsString(utf32) + 1, pPyBytes_Size(utf32) / 4 - 1);
+			Py_DECREF(utf16);
+			Py_DECREF(utf32);
+			Py_DECREF(str);
+
+			CHECK(data[0].get_string8_view() == std::u8string_view((const char8_t*)sample));
+			CHECK(data[1].type == metaffi_string16_type);
+			CHECK(data[1].get_string16_view() == expected16);
+			CHECK(data[2].type == metaffi_string32_type);
+			CHECK(data[2].get_string32_view() == expected32);
+			CHECK(data[3].cdt_val.char32_val.c == expected32[0]);
+			CHECK(data[4].cdt_val.char16_val.c[0] == expected16[0]);
+
+			// back to Python
+			ser.reset(); // string8
+			PyObject* extracted = ser.extract_pyobject();
+			CHECK(std::string(pPyUnicode_AsUTF8(extracted)) == sample);
+			Py_DECREF(extracted);
+
+			ser.set_index(2); // string32
+			extracted = ser.extract_pyobject();
+			CHECK(std::string(pPyUnicode_AsUTF8(extracted)) == sample);
+			Py_DECREF(extracted);
+		}
+	}
+
+	TEST_CASE("Serializing a str with a lone surrogate to UTF-16/UTF-32 throws")
+	{
+		// UCS-2 and UCS-4 canonical forms, surrogate after a valid prefix
+		const char16_t ucs2[] = { u'a', 0xD800 };
+		const char32_t ucs4[] = { U'\U0001F680', 0xDC00 };
+		PyObject* strs[] = {
+			pPyUnicode_FromKindAndData(PyUnicode_2BYTE_KIND, ucs2, 2),
+			pPyUnicode_FromKindAndData(PyUnicode_4BYTE_KIND, ucs4, 2)
+		};
+
+		for(PyObject* str : strs)
+		{
+			REQUIRE(str);
+
+			cdts data(3);
+			cdts_python3_serializer ser(*g_runtime, data);
+			CHECK_THROWS_WITH(ser.add(str, metaffi_string16_type), doctest::Contains("surrogates not allowed"));
+			CHECK_THROWS_WITH(ser.add(str, metaffi_string32_type), doctest::Contains("surrogates not allowed"));
+			CHECK(!pPyErr_Occurred());
+
+			py_str wrapper(*g_runtime, str);
+			CHECK_THROWS_AS((void)static_cast<std::u16string>(wrapper), std::runtime_error);
+			CHECK_THROWS_AS((void)static_cast<std::u32string>(wrapper), std::runtime_error);
+
+			Py_DECREF(str);
+		}
+	}
+
 	TEST_CASE("Deserialize pre-filled CDTS with string")
 	{
 		// Manually create CDTS with string
@@ -680,6 +764,106 @@ TEST_SUITE("CDTS Python3 Serializer")
 		Py_DECREF(extracted);
 	}
 
+	TEST_CASE("Single-pass homogeneous list conversion")
+	{
+		SUBCASE("Common type taken from the items")
+		{
+			cdts data(4);
+			cdts_python3_serializer ser(*g_runtime, data);
+
+			PyObject* ints = pPyList_New(3);
+			PyObject* floats = pPyList_New(2);
+			PyObject* bools = pPyList_New(2);
+			PyObject* strs = pPyTuple_New(2);
+			for(int i = 0; i < 3; i++) { pPyList_SetItem(ints, i, pPyLong_FromLongLong(-i)); }
+			pPyList_SetItem(floats, 0, pPyFloat_FromDouble(0.5));
+			pPyList_SetItem(floats, 1, pPyFloat_FromDouble(-1.5));
+			Py_INCREF(pPy_True); pPyList_SetItem(bools, 0, pPy_True);
+			Py_INCREF(pPy_False); pPyList_SetItem(bools, 1, pPy_False);
+			pPyTuple_SetItem(strs, 0, pPyUnicode_FromString("short"));
+			pPyTuple_SetItem(strs, 1, pPyUnicode_FromString("a string longer than the inline capacity"));
+
+			ser.add(ints, metaffi_any_type).add(floats, metaffi_any_type).add(bools, metaffi_any_type).add(strs, metaffi_any_type);
+			Py_DECREF(ints);
+			Py_DECREF(floats);
+			Py_DECREF(bools);
+			Py_DECREF(strs);
+
+			REQUIRE(data[0].type == (metaffi_array_type | metaffi_int64_type));
+			CHECK(data[0].cdt_val.array_val->fixed_dimensions == 1);
+			CHECK((*data[0].cdt_val.array_val)[2].cdt_val.int64_val == -2);
+
+			REQUIRE(data[1].type == (metaffi_array_type | metaffi_float64_type));
+			CHECK((*data[1].cdt_val.array_val)[1].cdt_val.float64_val == -1.5);
+
+			REQUIRE(data[2].type == (metaffi_array_type | metaffi_bool_type));
+			CHECK((*data[2].cdt_val.array_val)[0].type == metaffi_bool_type);
+			CHECK((*data[2].cdt_val.array_val)[0].cdt_val.bool_val != 0);
+			CHECK((*data[2].cdt_val.array_val)[1].cdt_val.bool_val == 0);
+
+			REQUIRE(data[3].type == (metaffi_array_type | metaffi_string8_type));
+			CHECK((*data[3].cdt_val.array_val)[0].get_string8_view() == u8"short");
+			CHECK((*data[3].cdt_val.array_val)[1].get_string8_view() == u8"a string longer than the inline capacity");
+		}
+
+		SUBCASE("Expected element type")
+		{
+			cdts data(2);
+			cdts_python3_serializer ser(*g_runtime, data);
+
+			PyObject* ints = pPyList_New(2);
+			pPyList_SetItem(ints, 0, pPyLong_FromLongLong(-128));
+			pPyList_SetItem(ints, 1, pPyLong_FromLongLong(127));
+			PyObject* floats = pPyList_New(1);
+			pPyList_SetItem(floats, 0, pPyFloat_FromDouble(2.5));
+
+			ser.add(ints, metaffi_int8_type).add(floats, metaffi_float32_type);
+			Py_DECREF(ints);
+			Py_DECREF(floats);
+
+			REQUIRE(data[0].type == (metaffi_array_type | metaffi_int8_type));
+			CHECK((*data[0].cdt_val.array_val)[0].cdt_val.int8_val == -128);
+			CHECK((*data[0].cdt_val.array_val)[1].cdt_val.int8_val == 127);
+
+			REQUIRE(data[1].type == (metaffi_array_type | metaffi_float32_type));
+			CHECK((*data[1].cdt_val.array_val)[0].cdt_val.float32_val == 2.5f);
+		}
+
+		SUBCASE("Mismatches fall back to the general path")
+		{
+			cdts data(1);
+			cdts_python3_serializer ser(*g_runtime, data);
+
+			// bool is not taken as int: the items have no common type
+			PyObject* mixed = pPyList_New(3);
+			pPyList_SetItem(mixed, 0, pPyLong_FromLongLong(1));
+			pPyList_SetItem(mixed, 1, pPyUnicode_FromString("two"));
+			Py_INCREF(pPy_True); pPyList_SetItem(mixed, 2, pPy_True);
+
+			ser.add(mixed, metaffi_any_type);
+			Py_DECREF(mixed);
+
+			REQUIRE(data[0].type == (metaffi_array_type | metaffi_any_type));
+			cdts& arr = *data[0].cdt_val.array_val;
+			CHECK(arr[0].type == metaffi_int64_type);
+			CHECK(arr[1].type == metaffi_string8_type);
+			CHECK(arr[2].type == metaffi_bool_type);
+		}
+
+		SUBCASE("Out of range items still raise")
+		{
+			cdts data(1);
+			cdts_python3_serializer ser(*g_runtime, data);
+
+			PyObject* ints = pPyList_New(2);
+			pPyList_SetItem(ints, 0, pPyLong_FromLongLong(1));
+			pPyList_SetItem(ints, 1, pPyLong_FromLongLong(256));
+
+			CHECK_THROWS(ser.add(ints, metaffi_uint8_type));
+			Py_DECREF(ints);
+		}
+	}
+
 	TEST_CASE("Serialize and deserialize ragged 2D array")
 	{
 		cdts data(1);
@@ -1211,6 +1395,50 @@ TEST_SUITE("CDTS Python3 Serializer")
 		Py_DECREF(extracted);
 	}
 
+	TEST_CASE("Borrowed packed bytes array")
+	{
+		PyObject* bytes = pPyBytes_FromStringAndSize("\x01\x02\xff", 3);
+		char* bytes_data;
+		Py_ssize_t bytes_size;
+		pPyBytes_AsStringAndSize(bytes, &bytes_data, &bytes_size);
+
+		{
+			cdts data(2);
+			cdts_python3_serializer ser(*g_runtime, data);
+			ser.set_borrow_buffers(true);
+
+			ser.add_packed_array(bytes, metaffi_uint8_type);
+			ser.add(bytes, metaffi_uint8_packed_array_type);
+
+			for(int i = 0; i < 2; i++)
+			{
+				REQUIRE(metaffi_is_packed_array(data[i].type));
+				const cdt_packed_array* packed = data[i].cdt_val.packed_array_val;
+				CHECK(packed->is_borrowed);
+				CHECK(packed->data == bytes_data); // no copy
+				CHECK(packed->length == 3);
+			}
+
+			ser.reset();
+			PyObject* extracted = ser.extract_pyobject();
+			REQUIRE(pPyBytes_Check(extracted));
+			CHECK(pPyBytes_Size(extracted) == 3);
+			Py_DECREF(extracted);
+		} // frees only the packed array headers
+
+		// without borrowing, bytes are copied
+		{
+			cdts data(1);
+			cdts_python3_serializer ser(*g_runtime, data);
+			ser.add_packed_array(bytes, metaffi_uint8_type);
+			CHECK(!data[0].cdt_val.packed_array_val->is_borrowed);
+			CHECK(data[0].cdt_val.packed_array_val->data != bytes_data);
+		}
+
+		CHECK(static_cast<uint8_t>(bytes_data[2]) == 0xff);
+		Py_DECREF(bytes);
+	}
+
 	TEST_CASE("Packed bool array round-trip")
 	{
 		cdts data(1);
@@ -1254,6 +1482,12 @@ TEST_SUITE("CDTS Python3 Serializer")
 		CHECK(metaffi_is_packed_array(data[0].type));
 		CHECK(metaffi_packed_element_type(data[0].type) == metaffi_string8_type);
 
+		// all the strings are in a single blob
+		cdt_packed_array* packed = data[0].cdt_val.packed_array_val;
+		REQUIRE(packed->is_string_blob);
+		CHECK(metaffi_string_blob_string_length(packed, 1) == 6);
+		CHECK(std::string((const char*)static_cast<metaffi_string8*>(packed->data)[2]) == "world");
+
 		ser.reset();
 		PyObject* extracted = ser.extract_pyobject();
 
@@ -1312,6 +1546,376 @@ TEST_SUITE("CDTS Python3 Serializer")
 		Py_DECREF(extracted);
 	}
 
+	TEST_CASE("Packed float64 tensor round-trip")
+	{
+		cdts data(1);
+		cdts_python3_serializer ser(*g_runtime, data);
+
+		// [[0, 1, 2], [10, 11, 12]]
+		PyObject* rows = pPyList_New(2);
+		for(int r = 0; r < 2; r++)
+		{
+			PyObject* row = pPyList_New(3);
+			for(int c = 0; c < 3; c++)
+			{
+				pPyList_SetItem(row, c, pPyFloat_FromDouble(r * 10 + c));
+			}
+			pPyList_SetItem(rows, r, row);
+		}
+
+		ser.add_packed_array(rows, metaffi_float64_type);
+		Py_DECREF(rows);
+
+		cdt_packed_array* packed = data[0].cdt_val.packed_array_val;
+		REQUIRE(metaffi_packed_is_tensor(packed));
+		CHECK(packed->rank == 2);
+		CHECK(packed->shape[0] == 2);
+		CHECK(packed->shape[1] == 3);
+		CHECK(packed->length == 6);
+		CHECK(static_cast<double*>(packed->data)[4] == 11.0);
+
+		ser.reset();
+		PyObject* extracted = ser.extract_pyobject();
+
+		REQUIRE(pPyList_Check(extracted));
+		REQUIRE(pPyList_Size(extracted) == 2);
+		PyObject* second = pPyList_GetItem(extracted, 1);
+		REQUIRE(pPyList_Check(second));
+		CHECK(pPyList_Size(second) == 3);
+		CHECK(pPyFloat_AsDouble(pPyList_GetItem(second, 2)) == doctest::Approx(12.0));
+
+		Py_DECREF(extracted);
+	}
+
+	TEST_CASE("Packed tensor from a buffer")
+	{
+		cdts data(1);
+		cdts_python3_serializer ser(*g_runtime, data);
+
+		// memoryview of array('i', [0..5]) cast to shape (2, 3)
+		PyObject* values = pPyList_New(6);
+		for(int i = 0; i < 6; i++)
+		{
+			pPyList_SetItem(values, i, pPyLong_FromLongLong(i));
+		}
+		PyObject* array_module = pPyImport_ImportModule("array");
+		REQUIRE(array_module);
+		PyObject* arr = pPyObject_CallMethod(array_module, "array", "sO", "i", values);
+		REQUIRE(arr);
+		PyObject* builtins = pPyImport_ImportModule("builtins");
+		PyObject* view = pPyObject_CallMethod(builtins, "memoryview", "O", arr);
+		PyObject* bytes_view = pPyObject_CallMethod(view, "cast", "s", "B");
+		PyObject* tensor_view = pPyObject_CallMethod(bytes_view, "cast", "s(ii)", "i", 2, 3);
+		REQUIRE(tensor_view);
+
+		ser.add_packed_array(tensor_view, metaffi_int32_type);
+
+		Py_DECREF(tensor_view);
+		Py_DECREF(bytes_view);
+		Py_DECREF(view);
+		Py_DECREF(builtins);
+		Py_DECREF(arr);
+		Py_DECREF(array_module);
+		Py_DECREF(values);
+
+		cdt_packed_array* packed = data[0].cdt_val.packed_array_val;
+		REQUIRE(metaffi_packed_is_tensor(packed));
+		CHECK(packed->rank == 2);
+		CHECK(packed->shape[1] == 3);
+		CHECK(static_cast<int32_t*>(packed->data)[5] == 5);
+
+		// ragged nested lists are rejected
+		cdts ragged_data(1);
+		cdts_python3_serializer ragged_ser(*g_runtime, ragged_data);
+		PyObject* ragged = pPyList_New(2);
+		PyObject* first = pPyList_New(2);
+		pPyList_SetItem(first, 0, pPyLong_FromLongLong(1));
+		pPyList_SetItem(first, 1, pPyLong_FromLongLong(2));
+		PyObject* second = pPyList_New(1);
+		pPyList_SetItem(second, 0, pPyLong_FromLongLong(3));
+		pPyList_SetItem(ragged, 0, first);
+		pPyList_SetItem(ragged, 1, second);
+
+		CHECK_THROWS(ragged_ser.add_packed_array(ragged, metaffi_int32_type));
+		Py_DECREF(ragged);
+	}
+
+	TEST_CASE("Buffer protocol objects as packed arrays")
+	{
+		PyObject* array_module = pPyImport_ImportModule("array");
+		PyObject* builtins = pPyImport_ImportModule("builtins");
+		REQUIRE(array_module);
+		REQUIRE(builtins);
+
+		PyObject* values = pPyList_New(4);
+		for(int i = 0; i < 4; i++)
+		{
+			pPyList_SetItem(values, i, pPyLong_FromLongLong(i * 10));
+		}
+		PyObject* doubles = pPyObject_CallMethod(array_module, "array", "sO", "d", values);
+		PyObject* ints = pPyObject_CallMethod(array_module, "array", "sO", "i", values);
+		PyObject* bytes = pPyBytes_FromStringAndSize("\x01\x02\x03", 3);
+		PyObject* byte_array = pPyObject_CallMethod(builtins, "bytearray", "O", bytes);
+		PyObject* int_view = pPyObject_CallMethod(builtins, "memoryview", "O", ints);
+		PyObject* byte_view = pPyObject_CallMethod(int_view, "cast", "s", "B");
+		PyObject* matrix = pPyObject_CallMethod(byte_view, "cast", "s(ii)", "i", 2, 2);
+		REQUIRE(doubles);
+		REQUIRE(byte_array);
+		REQUIRE(matrix);
+
+		cdts data(4);
+		cdts_python3_serializer ser(*g_runtime, data);
+		ser.add(doubles, metaffi_any_type)             // element type from the format
+		   .add(byte_array, metaffi_any_type)
+		   .add(matrix, metaffi_int32_array_type)      // regular arrays are packed too
+		   .add(ints, metaffi_int32_packed_array_type);
+
+		CHECK(data[0].type == metaffi_float64_packed_array_type);
+		CHECK(static_cast<double*>(data[0].cdt_val.packed_array_val->data)[3] == 30.0);
+		CHECK(!data[0].cdt_val.packed_array_val->is_borrowed);
+		CHECK(data[1].type == metaffi_uint8_packed_array_type);
+		CHECK(data[1].cdt_val.packed_array_val->length == 3);
+		REQUIRE(data[2].type == metaffi_int32_packed_array_type);
+		CHECK(metaffi_packed_is_tensor(data[2].cdt_val.packed_array_val));
+		CHECK(static_cast<int32_t*>(data[2].cdt_val.packed_array_val->data)[3] == 30);
+		CHECK(data[3].cdt_val.packed_array_val->length == 4);
+
+		// the buffer format must match the element type
+		cdts mismatch_data(1);
+		cdts_python3_serializer mismatch_ser(*g_runtime, mismatch_data);
+		CHECK_THROWS(mismatch_ser.add(ints, metaffi_float64_packed_array_type));
+
+		Py_DECREF(matrix);
+		Py_DECREF(byte_view);
+		Py_DECREF(int_view);
+		Py_DECREF(byte_array);
+		Py_DECREF(bytes);
+		Py_DECREF(ints);
+		Py_DECREF(doubles);
+		Py_DECREF(values);
+		Py_DECREF(builtins);
+		Py_DECREF(array_module);
+	}
+
+	TEST_CASE("Borrowed buffer protocol objects")
+	{
+		PyObject* array_module = pPyImport_ImportModule("array");
+		PyObject* builtins = pPyImport_ImportModule("builtins");
+		PyObject* values = pPyList_New(6);
+		for(int i = 0; i < 6; i++)
+		{
+			pPyList_SetItem(values, i, pPyLong_FromLongLong(i));
+		}
+		PyObject* arr = pPyObject_CallMethod(array_module, "array", "sO", "q", values);
+		REQUIRE(arr);
+
+		Py_buffer arr_buffer{};
+		REQUIRE(pPyObject_GetBuffer(arr, &arr_buffer, PyBUF_SIMPLE) == 0);
+		void* arr_data = arr_buffer.buf;
+		pPyBuffer_Release(&arr_buffer);
+
+		// every other element - not contiguous
+		PyObject* slice = pPyObject_CallMethod(builtins, "slice", "OOi", pPy_None, pPy_None, 2);
+		PyObject* view = pPyObject_CallMethod(builtins, "memoryview", "O", arr);
+		PyObject* strided = pPyObject_GetItem(view, slice);
+		REQUIRE(strided);
+
+		{
+			cdts data(2);
+			cdts_python3_serializer ser(*g_runtime, data);
+			ser.set_borrow_buffers(true);
+			ser.add(arr, metaffi_int64_packed_array_type)
+			   .add(strided, metaffi_int64_packed_array_type);
+
+			CHECK(data[0].cdt_val.packed_array_val->is_borrowed);
+			CHECK(data[0].cdt_val.packed_array_val->data == arr_data); // no copy
+			CHECK(!data[1].cdt_val.packed_array_val->is_borrowed);
+			CHECK(data[1].cdt_val.packed_array_val->length == 3);
+			CHECK(static_cast<int64_t*>(data[1].cdt_val.packed_array_val->data)[2] == 4);
+
+			// the buffer stays exported while the serializer lives - the array cannot be resized
+			PyObject* appended = pPyObject_CallMethod(arr, "append", "i", 6);
+			CHECK(appended == nullptr);
+			pPyErr_Clear();
+		}
+
+		// released - once the memoryviews are released as well, the array can be resized
+		Py_DECREF(strided);
+		Py_DECREF(view);
+		PyObject* appended = pPyObject_CallMethod(arr, "append", "i", 6);
+		CHECK(appended != nullptr);
+		Py_XDECREF(appended);
+
+		Py_DECREF(slice);
+		Py_DECREF(arr);
+		Py_DECREF(values);
+		Py_DECREF(builtins);
+		Py_DECREF(array_module);
+	}
+
+	TEST_CASE("Packed arrays extracted as memoryview")
+	{
+		PyObject* builtins = pPyImport_ImportModule("builtins");
+		PyObject* memoryview_type = pPyObject_GetAttrString(builtins, "memoryview");
+
+		cdts data(3);
+		cdts_python3_serializer ser(*g_runtime, data);
+
+		PyObject* list = pPyList_New(3);
+		pPyList_SetItem(list, 0, pPyFloat_FromDouble(1.5));
+		pPyList_SetItem(list, 1, pPyFloat_FromDouble(2.5));
+		pPyList_SetItem(list, 2, pPyFloat_FromDouble(3.5));
+		ser.add_packed_array(list, metaffi_float64_type);
+
+		PyObject* matrix = pPyList_New(2);
+		for(int row = 0; row < 2; row++)
+		{
+			PyObject* items = pPyList_New(3);
+			for(int col = 0; col < 3; col++)
+			{
+				pPyList_SetItem(items, col, pPyLong_FromLongLong(row * 3 + col));
+			}
+			pPyList_SetItem(matrix, row, items);
+		}
+		ser.add_packed_array(matrix, metaffi_int32_type);
+		ser.add_packed_array(list, metaffi_float32_type);
+		Py_DECREF(matrix);
+		Py_DECREF(list);
+
+		void* float64_data = data[0].cdt_val.packed_array_val->data;
+
+		ser.reset();
+		ser.set_packed_array_extraction(packed_array_extraction::memoryview);
+		PyObject* extracted = ser.extract_as_tuple();
+		REQUIRE(extracted);
+
+		// the memoryview took the buffer
+		PyObject* doubles = pPyTuple_GetItem(extracted, 0);
+		CHECK(pPyObject_IsInstance(doubles, memoryview_type) == 1);
+		Py_buffer doubles_buffer{};
+		REQUIRE(pPyObject_GetBuffer(doubles, &doubles_buffer, PyBUF_RECORDS_RO) == 0);
+		CHECK(doubles_buffer.buf == float64_data);
+		CHECK(std::string(doubles_buffer.format) == "d");
+		CHECK(doubles_buffer.len == 3 * sizeof(double));
+		CHECK(static_cast<double*>(doubles_buffer.buf)[2] == 3.5);
+		pPyBuffer_Release(&doubles_buffer);
+		CHECK(data[0].cdt_val.packed_array_val->data == nullptr);
+
+		PyObject* tensor = pPyTuple_GetItem(extracted, 1);
+		Py_buffer tensor_buffer{};
+		REQUIRE(pPyObject_GetBuffer(tensor, &tensor_buffer, PyBUF_RECORDS_RO) == 0);
+		CHECK(tensor_buffer.ndim == 2);
+		CHECK(tensor_buffer.shape[0] == 2);
+		CHECK(tensor_buffer.shape[1] == 3);
+		CHECK(tensor_buffer.strides[0] == 3 * sizeof(int32_t));
+		CHECK(static_cast<int32_t*>(tensor_buffer.buf)[5] == 5);
+		pPyBuffer_Release(&tensor_buffer);
+
+		PyObject* floats = pPyObject_CallMethod(pPyTuple_GetItem(extracted, 2), "tolist", nullptr);
+		REQUIRE(pPyList_Check(floats));
+		CHECK(pPyFloat_AsDouble(pPyList_GetItem(floats, 1)) == doctest::Approx(2.5));
+		Py_DECREF(floats);
+
+		Py_DECREF(extracted); // frees the xllr buffers
+		Py_DECREF(memoryview_type);
+		Py_DECREF(builtins);
+	}
+
+	TEST_CASE("Numeric arrays extracted as array.array or memoryview by type alias")
+	{
+		PyObject* builtins = pPyImport_ImportModule("builtins");
+		PyObject* memoryview_type = pPyObject_GetAttrString(builtins, "memoryview");
+		PyObject* array_module = pPyImport_ImportModule("array");
+		PyObject* array_type = pPyObject_GetAttrString(array_module, "array");
+
+		cdts data(4);
+		cdts_python3_serializer ser(*g_runtime, data);
+
+		PyObject* list = pPyList_New(3);
+		pPyList_SetItem(list, 0, pPyFloat_FromDouble(1.5));
+		pPyList_SetItem(list, 1, pPyFloat_FromDouble(2.5));
+		pPyList_SetItem(list, 2, pPyFloat_FromDouble(3.5));
+
+		PyObject* matrix = pPyList_New(2);
+		for(int row = 0; row < 2; row++)
+		{
+			PyObject* items = pPyList_New(3);
+			for(int col = 0; col < 3; col++)
+			{
+				pPyList_SetItem(items, col, pPyLong_FromLongLong(row * 3 + col));
+			}
+			pPyList_SetItem(matrix, row, items);
+		}
+
+		ser.add_packed_array(list, metaffi_float64_type);
+		ser.add_packed_array(matrix, metaffi_int32_type);
+		ser.add(list, metaffi_float64_array_type);
+		ser.add_packed_array(list, metaffi_float64_type);
+		Py_DECREF(matrix);
+		Py_DECREF(list);
+
+		ser.reset();
+		metaffi_type_info types[4] = {
+			metaffi_type_info(metaffi_float64_packed_array_type, "array.array"),
+			metaffi_type_info(metaffi_int32_packed_array_type, "array.array"),
+			metaffi_type_info(metaffi_float64_array_type, "memoryview"),
+			metaffi_type_info(metaffi_float64_packed_array_type)
+		};
+		CHECK_THROWS(ser.extract_as_tuple(types, 3));
+		PyObject* extracted = ser.extract_as_tuple(types, 4);
+		REQUIRE(extracted);
+
+		PyObject* doubles = pPyTuple_GetItem(extracted, 0);
+		REQUIRE(pPyObject_IsInstance(doubles, array_type) == 1);
+		PyObject* typecode = pPyObject_GetAttrString(doubles, "typecode");
+		CHECK(std::string(pPyUnicode_AsUTF8(typecode)) == "d");
+		Py_DECREF(typecode);
+		CHECK(pPySequence_Size(doubles) == 3);
+		PyObject* item = pPySequence_GetItem(doubles, 2);
+		CHECK(pPyFloat_AsDouble(item) == 3.5);
+		Py_DECREF(item);
+
+		// array.array is 1D only - tensors stay memoryview
+		PyObject* tensor = pPyTuple_GetItem(extracted, 1);
+		CHECK(pPyObject_IsInstance(tensor, memoryview_type) == 1);
+		Py_buffer tensor_buffer{};
+		REQUIRE(pPyObject_GetBuffer(tensor, &tensor_buffer, PyBUF_RECORDS_RO) == 0);
+		CHECK(tensor_buffer.ndim == 2);
+		CHECK(static_cast<int32_t*>(tensor_buffer.buf)[4] == 4);
+		pPyBuffer_Release(&tensor_buffer);
+
+		// CDTS array gathered into a buffer
+		PyObject* gathered = pPyTuple_GetItem(extracted, 2);
+		CHECK(pPyObject_IsInstance(gathered, memoryview_type) == 1);
+		Py_buffer gathered_buffer{};
+		REQUIRE(pPyObject_GetBuffer(gathered, &gathered_buffer, PyBUF_RECORDS_RO) == 0);
+		CHECK(std::string(gathered_buffer.format) == "d");
+		CHECK(gathered_buffer.len == 3 * sizeof(double));
+		CHECK(static_cast<double*>(gathered_buffer.buf)[1] == 2.5);
+		pPyBuffer_Release(&gathered_buffer);
+
+		// no alias - the serializer's mode (list)
+		CHECK(pPyList_Check(pPyTuple_GetItem(extracted, 3)));
+		Py_DECREF(extracted);
+
+		// serializer-wide mode
+		ser.reset();
+		ser.set_packed_array_extraction(packed_array_extraction::array);
+		ser.set_index(2);
+		PyObject* gathered_array = ser.extract_pyobject();
+		CHECK(pPyObject_IsInstance(gathered_array, array_type) == 1);
+		CHECK(pPySequence_Size(gathered_array) == 3);
+		Py_DECREF(gathered_array);
+
+		CHECK(cdts_python3_serializer::packed_array_extraction_from_alias("other", packed_array_extraction::list) == packed_array_extraction::list);
+		CHECK(cdts_python3_serializer::packed_array_extraction_from_alias(nullptr, packed_array_extraction::array) == packed_array_extraction::array);
+
+		Py_DECREF(array_type);
+		Py_DECREF(array_module);
+		Py_DECREF(memoryview_type);
+		Py_DECREF(builtins);
+	}
+
 	TEST_CASE("Manually constructed packed CDT → Python")
 	{
 		// Build packed float32 array manually, extract via serializer
@@ -1335,4 +1939,84 @@ TEST_SUITE("CDTS Python3 Serializer")
 
 		Py_DECREF(extracted);
 	}
+
+	TEST_CASE("Homogeneous list conversion benchmark")
+	{
+		// large lists take seconds (10M elements take several GB of memory) - only run when asked for
+		char* large = metaffi_getenv_alloc("METAFFI_LARGE_BENCHMARKS");
+		bool run_large = large && *large;
+		metaffi_free_env(large);
+
+		std::vector<Py_ssize_t> sizes = {1000};
+		if(run_large)
+		{
+			sizes.push_back(1000000);
+			sizes.push_back(10000000);
+		}
+
+		auto make_item = [](const char* kind, Py_ssize_t i) -> PyObject*
+		{
+			switch(kind[0])
+			{
+				case 'i': return pPyLong_FromLongLong(i);
+				case 'f': return pPyFloat_FromDouble((double)i + 0.5);
+				default: return pPyUnicode_FromString(std::to_string(i).c_str());
+			}
+		};
+
+		// Converts list to data[0], returns ns per element
+		auto convert = [](PyObject* list, Py_ssize_t len, cdts& data) -> double
+		{
+			cdts_python3_serializer ser(*g_runtime, data);
+
+			auto start = std::chrono::steady_clock::now();
+			ser.add(list, metaffi_any_type);
+			auto end = std::chrono::steady_clock::now();
+
+			REQUIRE(data[0].cdt_val.array_val->length == (metaffi_size)len);
+			return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / (double)len;
+		};
+
+		for(const char* kind : {"int", "float", "str"})
+		{
+			for(Py_ssize_t len : sizes)
+			{
+				PyObject* list = pPyList_New(len);
+				REQUIRE(list != nullptr);
+				for(Py_ssize_t i = 0; i < len; i++)
+				{
+					pPyList_SetItem(list, i, make_item(kind, i));
+				}
+
+				cdts single_pass_data(1);
+				double single_pass = convert(list, len, single_pass_data);
+
+				// Worst case: the speculation fails on the last item and the general path reruns
+				pPyList_SetItem(list, len - 1, pPyBytes_FromStringAndSize("x", 1));
+				cdts fallback_data(1);
+				double fallback = convert(list, len, fallback_data);
+
+				Py_DECREF(list);
+
+				// both paths give the same items (but the last)
+				const cdts& single_pass_items = *single_pass_data[0].cdt_val.array_val;
+				const cdts& fallback_items = *fallback_data[0].cdt_val.array_val;
+				for(metaffi_size i = 0; i + 1 < (metaffi_size)len; i++)
+				{
+					REQUIRE(single_pass_items[i].type == fallback_items[i].type);
+					if(single_pass_items[i].type == metaffi_string8_type)
+					{
+						REQUIRE(std::u8string(metaffi_cdt_string8(&single_pass_items[i])) == std::u8string(metaffi_cdt_string8(&fallback_items[i])));
+					}
+					else
+					{
+						REQUIRE(single_pass_items[i].cdt_val.int64_val == fallback_items[i].cdt_val.int64_val); // float64 bits for floats
+					}
+				}
+
+				MESSAGE("list[" << kind << "] x " << len << ": " << single_pass << " ns/element single-pass, "
+				        << fallback << " ns/element with a mismatch on the last item");
+			}
+		}
+	}
 }
@@ -166,27 +166,64 @@ void set_cdt_char32_val(struct cdt* c, char32_t val) {
 
 // String getters/setters
 char* get_cdt_string8_val(struct cdt* c) {
-    return (char*)c->cdt_val.string8_val;
+    return (char*)metaffi_cdt_string8(c);
 }
 
 void set_cdt_string8_val(struct cdt* c, char8_t* val) {
     c->cdt_val.string8_val = val;
+    c->has_length = 0;
+    c->is_small_string = 0;
+}
+
+// set_cdt_string_length stores the length (in code units) of the string set in c
+void set_cdt_string_length(struct cdt* c, metaffi_size length) {
+    c->cdt_val.sized_string_val.length = length;
+    c->has_length = 1;
+}
+
+// get_cdt_string_length returns the stored length of the string in c, or -1 if it is not stored
+int64_t get_cdt_string_length(struct cdt* c) {
+    return metaffi_cdt_string_length(c);
+}
+
+// set_cdt_small_string stores a string of length code units inline in c (no allocation, nothing to free).
+// Returns 0 if the string is too long to be stored inline.
+int set_cdt_small_string(struct cdt* c, const void* val, metaffi_size length, size_t code_unit_size) {
+    if (length > metaffi_small_string_capacity(code_unit_size)) {
+        return 0;
+    }
+
+    char* buf = (char*)&c->cdt_val.small_string_val;
+    if (length > 0) {
+        memcpy(buf, val, length * code_unit_size);
+    }
+    memset(buf + length * code_unit_size, 0, code_unit_size);
+
+    c->is_small_string = 1;
+    c->small_string_length = (metaffi_uint8)length;
+    c->has_length = 0;
+    c->free_required = 0;
+    return 1;
 }
 
 char16_t* get_cdt_string16_val(struct cdt* c) {
-    return c->cdt_val.string16_val;
+    return metaffi_cdt_string16(c);
 }
 
 void set_cdt_string16_val(struct cdt* c, char16_t* val) {
     c->cdt_val.string16_val = val;
+    c->has_length = 0;
+    c->is_small_string = 0;
 }
 
 char32_t* get_cdt_string32_val(struct cdt* c) {
-    return c->cdt_val.string32_val;
+    return metaffi_cdt_string32(c);
 }
 
 void set_cdt_string32_val(struct cdt* c, char32_t* val) {
     c->cdt_val.string32_val = val;
+    c->has_length = 0;
+    c->is_small_string = 0;
 }
 
 // Array getter/setter
@@ -223,6 +260,11 @@ struct cdt_packed_array* alloc_packed_array(metaffi_size length, size_t elem_siz
     struct cdt_packed_array* p = (struct cdt_packed_array*)xllr_alloc_memory(sizeof(struct cdt_packed_array));
     if (!p) return NULL;
     p->length = length;
+    p->is_borrowed = 0;
+    p->is_string_blob = 0;
+    p->rank = 0;
+    p->shape = NULL;
+    p->strides = NULL;
     if (length > 0 && elem_size > 0) {
         p->data = xllr_alloc_memory(length * elem_size);
         if (!p->data) { xllr_free_memory(p); return NULL; }
@@ -697,12 +739,20 @@ func (s *CDTSGoSerializer) AddString(val string) (*CDTSGoSerializer, error) {
 	cStr := C.CString(val)
 	defer C.free(unsafe.Pointer(cStr))
 
+	// small strings are stored inline in the CDT
+	if C.set_cdt_small_string(cdt, unsafe.Pointer(cStr), C.metaffi_size(len(val)), 1) != 0 {
+		C.set_cdt_type(cdt, C.metaffi_string8_type)
+		s.currentIndex++
+		return s, nil
+	}
+
 	allocated := C.xllr_alloc_string8((*C.char8_t)(unsafe.Pointer(cStr)), C.uint64_t(len(val)))
 	if allocated == nil {
 		return nil, errors.New("xllr_alloc_string8 failed: memory allocation error")
 	}
 
 	C.set_cdt_string8_val(cdt, allocated)
+	C.set_cdt_string_length(cdt, C.metaffi_size(len(val)))
 	C.set_cdt_type(cdt, C.metaffi_string8_type)
 	C.set_cdt_free_required(cdt, 1)
 	s.currentIndex++
@@ -722,8 +772,20 @@ func (s *CDTSGoSerializer) AddString16(val string) (*CDTSGoSerializer, error) {
 		return nil, errors.New("failed to encode string as UTF-16")
 	}
 
+	var utf16Ptr unsafe.Pointer
+	if len(utf16Buf) > 0 {
+		utf16Ptr = unsafe.Pointer(&utf16Buf[0])
+	}
+
+	// small strings (including the empty string) are stored inline in the CDT
+	if C.set_cdt_small_string(cdt, utf16Ptr, C.metaffi_size(len(utf16Buf)), 2) != 0 {
+		C.set_cdt_type(cdt, C.metaffi_string16_type)
+		s.currentIndex++
+		return s, nil
+	}
+
 	// Allocate UTF-16 string
-	allocated := C.xllr_alloc_string16((*C.char16_t)(unsafe.Pointer(&utf16Buf[0])), C.uint64_t(len(utf16Buf)))
+	allocated := C.xllr_alloc_string16((*C.char16_t)(utf16Ptr), C.uint64_t(len(utf16Buf)))
 	if allocated == nil {
 		return nil, errors.New("xllr_alloc_string16 failed: memory allocation error")
 	}
@@ -748,8 +810,20 @@ func (s *CDTSGoSerializer) AddString32(val string) (*CDTSGoSerializer, error) {
 		return nil, errors.New("failed to convert string to runes")
 	}
 
+	var runesPtr unsafe.Pointer
+	if len(runes) > 0 {
+		runesPtr = unsafe.Pointer(&runes[0])
+	}
+
+	// small strings (including the empty string) are stored inline in the CDT
+	if C.set_cdt_small_string(cdt, runesPtr, C.metaffi_size(len(runes)), 4) != 0 {
+		C.set_cdt_type(cdt, C.metaffi_string32_type)
+		s.currentIndex++
+		return s, nil
+	}
+
 	// Allocate UTF-32 string
-	allocated := C.xllr_alloc_string32((*C.char32_t)(unsafe.Pointer(&runes[0])), C.uint64_t(len(runes)))
+	allocated := C.xllr_alloc_string32((*C.char32_t)(runesPtr), C.uint64_t(len(runes)))
 	if allocated == nil {
 		return nil, errors.New("xllr_alloc_string32 failed: memory allocation error")
 	}
@@ -1712,7 +1786,12 @@ func (s *CDTSGoSerializer) ExtractString() (string, error) {
 		return "", fmt.Errorf("string8 value is nil at index %d", s.currentIndex)
 	}
 
-	val := C.GoString(cStr)
+	var val string
+	if length := C.get_cdt_string_length(cdt); length >= 0 {
+		val = C.GoStringN(cStr, C.int(length))
+	} else {
+		val = C.GoString(cStr)
+	}
 	s.currentIndex++
 	return val, nil
 }
@@ -1734,11 +1813,14 @@ func (s *CDTSGoSerializer) ExtractString16() (string, error) {
 		return "", fmt.Errorf("string16 value is nil at index %d", s.currentIndex)
 	}
 
-	// Find length (null-terminated) - use pointer arithmetic
-	length := 0
-	cStr16Ptr := (*[1 << 30]C.char16_t)(unsafe.Pointer(cStr16))
-	for length < (1<<30) && cStr16Ptr[length] != 0 {
-		length++
+	// Stored length (sized and inline strings), otherwise find the null terminator
+	length := int(C.get_cdt_string_length(cdt))
+	if length < 0 {
+		length = 0
+		cStr16Ptr := (*[1 << 30]C.char16_t)(unsafe.Pointer(cStr16))
+		for length < (1<<30) && cStr16Ptr[length] != 0 {
+			length++
+		}
 	}
 
 	// Convert UTF-16 to Go string
@@ -1767,11 +1849,14 @@ func (s *CDTSGoSerializer) ExtractString32() (string, error) {
 		return "", fmt.Errorf("string32 value is nil at index %d", s.currentIndex)
 	}
 
-	// Find length (null-terminated) - use pointer arithmetic
-	length := 0
-	cStr32Ptr := (*[1 << 30]C.char32_t)(unsafe.Pointer(cStr32))
-	for length < (1<<30) && cStr32Ptr[length] != 0 {
-		length++
+	// Stored length (sized and inline strings), otherwise find the null terminator
+	length := int(C.get_cdt_string_length(cdt))
+	if length < 0 {
+		length = 0
+		cStr32Ptr := (*[1 << 30]C.char32_t)(unsafe.Pointer(cStr32))
+		for length < (1<<30) && cStr32Ptr[length] != 0 {
+			length++
+		}
 	}
 
 	// Convert UTF-32 (runes) to Go string
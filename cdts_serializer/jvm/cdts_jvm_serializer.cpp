@@ -1,8 +1,11 @@
 #include "cdts_jvm_serializer.h"
 #include "runtime_id.h"
 #include <runtime/xllr_capi_loader.h>
+#include <runtime/packed_string_blob.h>
+#include <runtime/packed_tensor.h>
 #include <algorithm>
 #include <cstring>
+#include <vector>
 
 namespace metaffi::utils
 {
@@ -444,6 +447,20 @@ void* packed_from_jni_array(JNIEnv* env, jarray arr, jsize length, size_t elem_s
 	return buf;
 }
 
+/**
+ * @brief Memcpy from a JNI primitive array into an existing packed buffer via GetPrimitiveArrayCritical.
+ */
+void packed_to_jni_buffer(JNIEnv* env, jarray arr, void* dst, jsize length, size_t elem_size)
+{
+	void* src = env->GetPrimitiveArrayCritical(arr, nullptr);
+	if (!src)
+	{
+		throw std::runtime_error("add_packed_tensor: GetPrimitiveArrayCritical failed");
+	}
+	std::memcpy(dst, src, static_cast<size_t>(length) * elem_size);
+	env->ReleasePrimitiveArrayCritical(arr, src, JNI_ABORT);
+}
+
 /**
  * @brief Memcpy from a packed buffer into a JNI primitive array via GetPrimitiveArrayCritical.
  * @param env JNI environment
@@ -463,6 +480,160 @@ void packed_to_jni_array(JNIEnv* env, jarray arr, const void* data, jsize length
 	env->ReleasePrimitiveArrayCritical(arr, dst, 0);
 }
 
+/**
+ * @brief JNI signature of the primitive array of a packed element type ("[D" for float64), or nullptr.
+ */
+const char* jni_primitive_array_signature(metaffi_type element_type)
+{
+	switch(element_type)
+	{
+		case metaffi_int8_type:
+		case metaffi_uint8_type:    return "[B";
+		case metaffi_int16_type:
+		case metaffi_uint16_type:   return "[S";
+		case metaffi_int32_type:
+		case metaffi_uint32_type:   return "[I";
+		case metaffi_int64_type:
+		case metaffi_uint64_type:   return "[J";
+		case metaffi_float32_type:  return "[F";
+		case metaffi_float64_type:  return "[D";
+		case metaffi_bool_type:     return "[Z";
+		default:                    return nullptr;
+	}
+}
+
+/**
+ * @brief Create a Java primitive array of a packed element type.
+ */
+jarray new_jni_primitive_array(JNIEnv* env, metaffi_type element_type, jsize length)
+{
+	switch(element_type)
+	{
+		case metaffi_int8_type:
+		case metaffi_uint8_type:    return env->NewByteArray(length);
+		case metaffi_int16_type:
+		case metaffi_uint16_type:   return env->NewShortArray(length);
+		case metaffi_int32_type:
+		case metaffi_uint32_type:   return env->NewIntArray(length);
+		case metaffi_int64_type:
+		case metaffi_uint64_type:   return env->NewLongArray(length);
+		case metaffi_float32_type:  return env->NewFloatArray(length);
+		case metaffi_float64_type:  return env->NewDoubleArray(length);
+		case metaffi_bool_type:     return env->NewBooleanArray(length);
+		default:
+			throw std::runtime_error("new_jni_primitive_array: unsupported element type " + std::to_string(element_type));
+	}
+}
+
+/**
+ * @brief Whether arr is an array of objects (e.g. double[][] or String[]) rather than a primitive array.
+ */
+bool is_jni_object_array(JNIEnv* env, jarray arr)
+{
+	jclass object_array_class = env->FindClass("[Ljava/lang/Object;");
+	if (!object_array_class)
+	{
+		throw std::runtime_error("is_jni_object_array: FindClass [Ljava/lang/Object; failed");
+	}
+	bool res = env->IsInstanceOf(arr, object_array_class) == JNI_TRUE;
+	env->DeleteLocalRef(object_array_class);
+	return res;
+}
+
+/**
+ * @brief Copy the rows of rectangular nested Java arrays into a packed tensor buffer (row-major).
+ * @param level Array of dimension dim
+ * @param row_class Class of the innermost primitive arrays
+ * @param out Advanced past the copied elements
+ */
+void copy_jni_tensor_rows(JNIEnv* env, jarray level, jclass row_class, const std::vector<metaffi_size>& shape, size_t dim, size_t elem_size, unsigned char*& out)
+{
+	if (!level || static_cast<metaffi_size>(env->GetArrayLength(level)) != shape[dim])
+	{
+		throw std::runtime_error("add_packed_tensor: nested arrays are not rectangular");
+	}
+
+	if (dim + 1 == shape.size())
+	{
+		if (env->IsInstanceOf(level, row_class) != JNI_TRUE)
+		{
+			throw std::runtime_error("add_packed_tensor: innermost arrays do not match the element type");
+		}
+
+		jsize length = static_cast<jsize>(shape[dim]);
+		if (length > 0)
+		{
+			packed_to_jni_buffer(env, level, out, length, elem_size);
+			out += static_cast<size_t>(length) * elem_size;
+		}
+		return;
+	}
+
+	for (jsize i = 0; i < static_cast<jsize>(shape[dim]); i++)
+	{
+		jarray item = static_cast<jarray>(env->GetObjectArrayElement(static_cast<jobjectArray>(level), i));
+		try
+		{
+			copy_jni_tensor_rows(env, item, row_class, shape, dim + 1, elem_size, out);
+		}
+		catch (...)
+		{
+			if (item) { env->DeleteLocalRef(item); }
+			throw;
+		}
+		env->DeleteLocalRef(item);
+	}
+}
+
+/**
+ * @brief Create nested Java arrays of dimension dim of a contiguous tensor buffer.
+ * @param in Advanced past the copied elements
+ */
+jarray tensor_dimension_to_jni_array(JNIEnv* env, const cdt_packed_array* packed, size_t dim, metaffi_type elem_type, size_t elem_size, const unsigned char*& in)
+{
+	jsize length = static_cast<jsize>(packed->shape[dim]);
+
+	if (dim + 1 == packed->rank)
+	{
+		jarray row = new_jni_primitive_array(env, elem_type, length);
+		if (!row)
+		{
+			throw std::runtime_error("extract_packed_array: failed to create a primitive array");
+		}
+
+		if (length > 0)
+		{
+			packed_to_jni_array(env, row, in, length, elem_size);
+			in += static_cast<size_t>(length) * elem_size;
+		}
+		return row;
+	}
+
+	// items of dimension dim are arrays of (rank - dim - 1) dimensions, e.g. "[D" or "[[D"
+	std::string item_signature = std::string(packed->rank - dim - 2, '[') + jni_primitive_array_signature(elem_type);
+	jclass item_class = env->FindClass(item_signature.c_str());
+	if (!item_class)
+	{
+		throw std::runtime_error("extract_packed_array: FindClass " + item_signature + " failed");
+	}
+
+	jobjectArray arr = env->NewObjectArray(length, item_class, nullptr);
+	env->DeleteLocalRef(item_class);
+	if (!arr)
+	{
+		throw std::runtime_error("extract_packed_array: NewObjectArray failed");
+	}
+
+	for (jsize i = 0; i < length; i++)
+	{
+		jarray item = tensor_dimension_to_jni_array(env, packed, dim + 1, elem_type, elem_size, in);
+		env->SetObjectArrayElement(arr, i, item);
+		env->DeleteLocalRef(item);
+	}
+
+	return arr;
+}
+
 // ===== Phase 1: Core Infrastructure =====
 
 //--------------------------------------------------------------------
@@ -1054,7 +1225,7 @@ jchar cdts_jvm_serializer::extract_char_from_wrapper(jobject obj)
 // Phase 4: String Conversion
 //--------------------------------------------------------------------
 
-metaffi_string8 cdts_jvm_serializer::jstring_to_string8(jstring str)
+metaffi_string8 cdts_jvm_serializer::jstring_to_string8(jstring str, metaffi_size* out_length)
 {
 	if (!str) {
 		return nullptr;
@@ -1067,15 +1238,19 @@ metaffi_string8 cdts_jvm_serializer::jstring_to_string8(jstring str)
 	}
 
 	// Allocate with XLLR
-	metaffi_size len = std::strlen(utf8);
+	metaffi_size len = static_cast<metaffi_size>(env->GetStringUTFLength(str));
 	metaffi_string8 result = xllr_alloc_string8((const char8_t*)utf8, len);
 
 	env->ReleaseStringUTFChars(str, utf8);
 
+	if (out_length) {
+		*out_length = len;
+	}
+
 	return result;
 }
 
-metaffi_string16 cdts_jvm_serializer::jstring_to_string16(jstring str)
+metaffi_string16 cdts_jvm_serializer::jstring_to_string16(jstring str, metaffi_size* out_length)
 {
 	if (!str) {
 		return nullptr;
@@ -1094,10 +1269,14 @@ metaffi_string16 cdts_jvm_serializer::jstring_to_string16(jstring str)
 
 	env->ReleaseStringChars(str, utf16);
 
+	if (out_length) {
+		*out_length = static_cast<metaffi_size>(len);
+	}
+
 	return result;
 }
 
-metaffi_string32 cdts_jvm_serializer::jstring_to_string32(jstring str)
+metaffi_string32 cdts_jvm_serializer::jstring_to_string32(jstring str, metaffi_size* out_length)
 {
 	if (!str) {
 		return nullptr;
@@ -1152,6 +1331,10 @@ metaffi_string32 cdts_jvm_serializer::jstring_to_string32(jstring str)
 		throw std::runtime_error("Failed to allocate UTF-32 string");
 	}
 
+	if (out_length) {
+		*out_length = static_cast<metaffi_size>(utf32.size());
+	}
+
 	return result;
 }
 
@@ -1170,17 +1353,13 @@ jstring cdts_jvm_serializer::string8_to_jstring(metaffi_string8 str)
 	return result;
 }
 
-jstring cdts_jvm_serializer::string16_to_jstring(metaffi_string16 str)
+jstring cdts_jvm_serializer::string16_to_jstring(std::u16string_view str)
 {
-	if (!str) {
+	if (!str.data()) {
 		return nullptr;
 	}
 
-	// Get length
-	metaffi_size len = 0;
-	while (str[len] != 0) len++;
-
-	jstring result = env->NewString((const jchar*)str, static_cast<jsize>(len));
+	jstring result = env->NewString((const jchar*)str.data(), static_cast<jsize>(str.size()));
 	if (!result) {
 		check_jni_exception("NewString");
 		throw std::runtime_error("Failed to create jstring from UTF-16");
@@ -1189,16 +1368,15 @@ jstring cdts_jvm_serializer::string16_to_jstring(metaffi_string16 str)
 	return result;
 }
 
-jstring cdts_jvm_serializer::string32_to_jstring(metaffi_string32 str)
+jstring cdts_jvm_serializer::string32_to_jstring(std::u32string_view str)
 {
-	if (!str) {
+	if (!str.data()) {
 		return nullptr;
 	}
 
 	// Convert UTF-32 to UTF-16 (simplified - doesn't handle surrogates properly)
 	// For now, truncate to 16-bit (this is a limitation)
-	metaffi_size len = 0;
-	while (str[len] != 0) len++;
+	metaffi_size len = str.size();
 
 	std::vector<jchar> utf16;
 	utf16.reserve(len);
@@ -1445,17 +1623,23 @@ cdts_jvm_serializer& cdts_jvm_serializer::add(jstring val, metaffi_type target_t
 
 	switch(target_type) {
 		case metaffi_string8_type:
-			data[current_index].cdt_val.string8_val = jstring_to_string8(val);
+			data[current_index].cdt_val.string8_val = jstring_to_string8(val, &data[current_index].cdt_val.sized_string_val.length);
+			data[current_index].has_length = 1;
+			data[current_index].is_small_string = 0;
 			data[current_index].type = metaffi_string8_type;
 			data[current_index].free_required = true;
 			break;
 		case metaffi_string16_type:
-			data[current_index].cdt_val.string16_val = jstring_to_string16(val);
+			data[current_index].cdt_val.string16_val = jstring_to_string16(val, &data[current_index].cdt_val.sized_string_val.length);
+			data[current_index].has_length = 1;
+			data[current_index].is_small_string = 0;
 			data[current_index].type = metaffi_string16_type;
 			data[current_index].free_required = true;
 			break;
 		case metaffi_string32_type:
-			data[current_index].cdt_val.string32_val = jstring_to_string32(val);
+			data[current_index].cdt_val.string32_val = jstring_to_string32(val, &data[current_index].cdt_val.sized_string_val.length);
+			data[current_index].has_length = 1;
+			data[current_index].is_small_string = 0;
 			data[current_index].type = metaffi_string32_type;
 			data[current_index].free_required = true;
 			break;
@@ -1544,6 +1728,11 @@ cdts_jvm_serializer& cdts_jvm_serializer::add_packed_array(jarray arr, metaffi_t
 		throw std::runtime_error("add_packed_array: null array not allowed for packed arrays");
 	}
 
+	// double[][] and other nested primitive arrays are packed as a tensor
+	if (jni_primitive_array_signature(element_type) && is_jni_object_array(env, arr)) {
+		return add_packed_tensor(static_cast<jobjectArray>(arr), element_type);
+	}
+
 	jsize length = env->GetArrayLength(arr);
 	check_jni_exception("GetArrayLength in add_packed_array");
 
@@ -1552,6 +1741,11 @@ cdts_jvm_serializer& cdts_jvm_serializer::add_packed_array(jarray arr, metaffi_t
 	if (!packed) { throw std::runtime_error("add_packed_array: xllr_alloc_memory failed for cdt_packed_array"); }
 	packed->data = nullptr;
 	packed->length = static_cast<metaffi_size>(length);
+	packed->is_borrowed = 0;
+	packed->is_string_blob = 0;
+	packed->rank = 0;
+	packed->shape = nullptr;
+	packed->strides = nullptr;
 
 	if (length == 0) {
 		packed->data = nullptr;
@@ -1594,26 +1788,36 @@ cdts_jvm_serializer& cdts_jvm_serializer::add_packed_array(jarray arr, metaffi_t
 			break;
 		}
 		case metaffi_string8_type: {
-			// String arrays: element-by-element JNI string conversion
-			metaffi_string8* str_buf = static_cast<metaffi_string8*>(
-				xllr_alloc_memory(static_cast<size_t>(length) * sizeof(metaffi_string8))
-			);
-			if (!str_buf) {
+			// String arrays: a single blob of all the strings (see cdt_packed_array).
+			// First pass sums the UTF-8 lengths, second pass writes the strings directly into the blob.
+			jobjectArray objArr = (jobjectArray)arr;
+			metaffi_size total_length = 0;
+			for (jsize i = 0; i < length; i++) {
+				jstring jstr = (jstring)env->GetObjectArrayElement(objArr, i);
+				if (jstr) {
+					total_length += static_cast<metaffi_size>(env->GetStringUTFLength(jstr));
+					env->DeleteLocalRef(jstr);
+				}
+			}
+
+			packed->data = xllr_alloc_memory(metaffi::runtime::packed_string_blob_writer<char8_t>::blob_size(packed->length, total_length));
+			if (!packed->data) {
 				xllr_free_memory(packed);
-				throw std::runtime_error("add_packed_array: xllr_alloc_memory failed for string8 pointer array");
+				throw std::runtime_error("add_packed_array: xllr_alloc_memory failed for string8 blob");
 			}
+			packed->is_string_blob = 1;
 
-			jobjectArray objArr = (jobjectArray)arr;
+			metaffi::runtime::packed_string_blob_writer<char8_t> writer(packed->data, packed->length);
 			for (jsize i = 0; i < length; i++) {
 				jstring jstr = (jstring)env->GetObjectArrayElement(objArr, i);
 				if (jstr) {
-					str_buf[i] = jstring_to_string8(jstr);
+					char8_t* dst = writer.append(static_cast<metaffi_size>(env->GetStringUTFLength(jstr)));
+					env->GetStringUTFRegion(jstr, 0, env->GetStringLength(jstr), reinterpret_cast<char*>(dst));
 					env->DeleteLocalRef(jstr);
 				} else {
-					str_buf[i] = nullptr;
+					writer.append_null();
 				}
 			}
-			packed->data = str_buf;
 			break;
 		}
 		default:
@@ -1628,6 +1832,195 @@ cdts_jvm_serializer& cdts_jvm_serializer::add_packed_array(jarray arr, metaffi_t
 	return *this;
 }
 
+cdts_jvm_serializer& cdts_jvm_serializer::add_packed_tensor(jobjectArray arr, metaffi_type element_type)
+{
+	check_bounds(current_index);
+
+	if (!arr) {
+		throw std::runtime_error("add_packed_tensor: null array not allowed for packed tensors");
+	}
+
+	const char* row_signature = jni_primitive_array_signature(element_type);
+	if (!row_signature) {
+		throw std::runtime_error("add_packed_tensor: unsupported element type " + std::to_string(element_type));
+	}
+	size_t elem_size = metaffi::runtime::packed_element_size(element_type);
+
+	jclass row_class = env->FindClass(row_signature);
+	check_jni_exception("FindClass in add_packed_tensor");
+
+	// the shape follows the first item of each dimension, down to the primitive rows
+	std::vector<metaffi_size> shape;
+	jarray level = arr;
+	try {
+		while (true) {
+			jsize length = env->GetArrayLength(level);
+			shape.push_back(static_cast<metaffi_size>(length));
+
+			if (env->IsInstanceOf(level, row_class) == JNI_TRUE || length == 0) {
+				break;
+			}
+
+			if (!is_jni_object_array(env, level)) {
+				throw std::runtime_error("add_packed_tensor: innermost arrays do not match the element type");
+			}
+
+			jarray first = static_cast<jarray>(env->GetObjectArrayElement(static_cast<jobjectArray>(level), 0));
+			if (level != arr) { env->DeleteLocalRef(level); }
+			level = first;
+
+			if (!level) {
+				throw std::runtime_error("add_packed_tensor: null nested array");
+			}
+		}
+	} catch (...) {
+		if (level && level != arr) { env->DeleteLocalRef(level); }
+		env->DeleteLocalRef(row_class);
+		throw;
+	}
+	if (level != arr) { env->DeleteLocalRef(level); }
+
+	// the CDT owns the tensor from here - freed with the CDTS if copying fails
+	cdt_packed_array* packed = metaffi::runtime::alloc_packed_tensor(shape.size(), shape.data(), elem_size);
+	data[current_index].set_packed_array(packed, static_cast<metaffi_types>(element_type));
+
+	if (packed->length > 0) {
+		auto* out = static_cast<unsigned char*>(packed->data);
+		try {
+			copy_jni_tensor_rows(env, arr, row_class, shape, 0, elem_size, out);
+		} catch (...) {
+			env->DeleteLocalRef(row_class);
+			throw;
+		}
+	}
+
+	env->DeleteLocalRef(row_class);
+	current_index++;
+	return *this;
+}
+
+cdts_jvm_serializer& cdts_jvm_serializer::add_packed_direct_buffer(jobject buffer, metaffi_type element_type)
+{
+	check_bounds(current_index);
+
+	if (!buffer) {
+		throw std::runtime_error("add_packed_direct_buffer: null buffer not allowed for packed arrays");
+	}
+
+	// typed buffers must hold element_type's width - a ByteBuffer can hold any element type
+	size_t elem_size = 0;
+	const char* typed_buffer_class = nullptr;
+	switch(element_type) {
+		case metaffi_int8_type:
+		case metaffi_uint8_type:
+		case metaffi_bool_type:
+			elem_size = sizeof(metaffi_int8);
+			break;
+		case metaffi_int16_type:
+		case metaffi_uint16_type:
+			elem_size = sizeof(metaffi_int16);
+			typed_buffer_class = "java/nio/ShortBuffer";
+			break;
+		case metaffi_int32_type:
+		case metaffi_uint32_type:
+			elem_size = sizeof(metaffi_int32);
+			typed_buffer_class = "java/nio/IntBuffer";
+			break;
+		case metaffi_int64_type:
+		case metaffi_uint64_type:
+			elem_size = sizeof(metaffi_int64);
+			typed_buffer_class = "java/nio/LongBuffer";
+			break;
+		case metaffi_float32_type:
+			elem_size = sizeof(metaffi_float32);
+			typed_buffer_class = "java/nio/FloatBuffer";
+			break;
+		case metaffi_float64_type:
+			elem_size = sizeof(metaffi_float64);
+			typed_buffer_class = "java/nio/DoubleBuffer";
+			break;
+		default:
+			throw std::runtime_error(
+				"add_packed_direct_buffer: unsupported element type " + std::to_string(element_type)
+			);
+	}
+
+	char* address = static_cast<char*>(env->GetDirectBufferAddress(buffer));
+	if (!address || env->GetDirectBufferCapacity(buffer) < 0) {
+		throw std::runtime_error("add_packed_direct_buffer: buffer is not a direct buffer");
+	}
+
+	jclass byte_buffer_class = env->FindClass("java/nio/ByteBuffer");
+	check_jni_exception("FindClass java/nio/ByteBuffer in add_packed_direct_buffer");
+	bool is_byte_buffer = env->IsInstanceOf(buffer, byte_buffer_class) == JNI_TRUE;
+	env->DeleteLocalRef(byte_buffer_class);
+
+	if (!is_byte_buffer) {
+		bool matches = false;
+		if (typed_buffer_class) {
+			jclass cls = env->FindClass(typed_buffer_class);
+			check_jni_exception("FindClass typed buffer in add_packed_direct_buffer");
+			local_ref_guard cls_guard(env, cls);
+			matches = env->IsInstanceOf(buffer, cls) == JNI_TRUE;
+		}
+
+		if (!matches) {
+			throw std::runtime_error(
+				"add_packed_direct_buffer: buffer class does not match element type " + std::to_string(element_type)
+			);
+		}
+	}
+
+	// multi-byte elements are read in native order - ByteBuffers (and views of them) default to BIG_ENDIAN
+	if (elem_size > 1) {
+		jclass byte_order_class = env->FindClass("java/nio/ByteOrder");
+		check_jni_exception("FindClass java/nio/ByteOrder in add_packed_direct_buffer");
+		local_ref_guard byte_order_guard(env, byte_order_class);
+		jmethodID native_order = env->GetStaticMethodID(byte_order_class, "nativeOrder", "()Ljava/nio/ByteOrder;");
+		check_jni_exception("GetStaticMethodID ByteOrder.nativeOrder in add_packed_direct_buffer");
+
+		// order() is declared by each buffer class, not by java.nio.Buffer
+		jclass buffer_class = env->GetObjectClass(buffer);
+		local_ref_guard buffer_class_guard(env, buffer_class);
+		jmethodID order = env->GetMethodID(buffer_class, "order", "()Ljava/nio/ByteOrder;");
+		check_jni_exception("GetMethodID order in add_packed_direct_buffer");
+
+		jobject native = env->CallStaticObjectMethod(byte_order_class, native_order);
+		check_jni_exception("ByteOrder.nativeOrder in add_packed_direct_buffer");
+		local_ref_guard native_guard(env, native);
+		jobject buffer_order = env->CallObjectMethod(buffer, order);
+		check_jni_exception("order in add_packed_direct_buffer");
+		local_ref_guard buffer_order_guard(env, buffer_order);
+
+		if (env->IsSameObject(native, buffer_order) != JNI_TRUE) {
+			throw std::runtime_error("add_packed_direct_buffer: buffer byte order is not the native byte order");
+		}
+	}
+
+	// the content is between position and limit - in bytes for ByteBuffer, in elements for typed buffers
+	jclass nio_buffer_class = env->FindClass("java/nio/Buffer");
+	check_jni_exception("FindClass java/nio/Buffer in add_packed_direct_buffer");
+	local_ref_guard nio_buffer_guard(env, nio_buffer_class);
+	jmethodID position_method = env->GetMethodID(nio_buffer_class, "position", "()I");
+	check_jni_exception("GetMethodID Buffer.position in add_packed_direct_buffer");
+	jmethodID limit_method = env->GetMethodID(nio_buffer_class, "limit", "()I");
+	check_jni_exception("GetMethodID Buffer.limit in add_packed_direct_buffer");
+
+	jint position = env->CallIntMethod(buffer, position_method);
+	check_jni_exception("Buffer.position in add_packed_direct_buffer");
+	jint limit = env->CallIntMethod(buffer, limit_method);
+	check_jni_exception("Buffer.limit in add_packed_direct_buffer");
+
+	size_t unit_size = is_byte_buffer ? 1 : elem_size;
+	char* start = address + static_cast<size_t>(position) * unit_size;
+	metaffi_size length = static_cast<metaffi_size>(static_cast<size_t>(limit - position) * unit_size / elem_size);
+
+	// direct buffers are outside the Java heap - the GC does not move them, so the memory is borrowed
+	data[current_index].set_borrowed_packed_array(length > 0 ? start : nullptr, length, static_cast<metaffi_types>(element_type));
+	current_index++;
+	return *this;
+}
+
 // Extraction methods
 
 jbyte cdts_jvm_serializer::extract_byte()
@@ -1811,13 +2204,13 @@ jstring cdts_jvm_serializer::extract_string()
 
 	switch(current.type) {
 		case metaffi_string8_type:
-			result = string8_to_jstring(current.cdt_val.string8_val);
+			result = string8_to_jstring(metaffi_cdt_string8(&current));
 			break;
 		case metaffi_string16_type:
-			result = string16_to_jstring(current.cdt_val.string16_val);
+			result = string16_to_jstring(current.get_string16_view());
 			break;
 		case metaffi_string32_type:
-			result = string32_to_jstring(current.cdt_val.string32_val);
+			result = string32_to_jstring(current.get_string32_view());
 			break;
 		default:
 			throw std::runtime_error("Type mismatch: expected string8/string16/string32");
@@ -1971,7 +2364,9 @@ void cdts_jvm_serializer::serialize_array_into(jarray arr, cdt& target, int dime
 				for (jsize i = 0; i < length; i++) {
 					jstring jstr = (jstring)env->GetObjectArrayElement(objArr, i);
 					if (jstr) {
-						arr_cdts[i].cdt_val.string8_val = jstring_to_string8(jstr);
+						arr_cdts[i].cdt_val.string8_val = jstring_to_string8(jstr, &arr_cdts[i].cdt_val.sized_string_val.length);
+						arr_cdts[i].has_length = 1;
+						arr_cdts[i].is_small_string = 0;
 						arr_cdts[i].type = metaffi_string8_type;
 						arr_cdts[i].free_required = true;
 						env->DeleteLocalRef(jstr);
@@ -2100,7 +2495,9 @@ void cdts_jvm_serializer::serialize_array(jarray arr, int dimensions, metaffi_ty
 						break;
 					}
 					case metaffi_string8_type:
-						arr_cdts[i].cdt_val.string8_val = jstring_to_string8((jstring)obj);
+						arr_cdts[i].cdt_val.string8_val = jstring_to_string8((jstring)obj, &arr_cdts[i].cdt_val.sized_string_val.length);
+						arr_cdts[i].has_length = 1;
+						arr_cdts[i].is_small_string = 0;
 						arr_cdts[i].type = metaffi_string8_type;
 						arr_cdts[i].free_required = true;
 						break;
@@ -2236,7 +2633,9 @@ void cdts_jvm_serializer::serialize_array(jarray arr, int dimensions, metaffi_ty
 				for (jsize i = 0; i < length; i++) {
 					jstring jstr = (jstring)env->GetObjectArrayElement(objArr, i);
 					if (jstr) {
-						arr_cdts[i].cdt_val.string8_val = jstring_to_string8(jstr);
+						arr_cdts[i].cdt_val.string8_val = jstring_to_string8(jstr, &arr_cdts[i].cdt_val.sized_string_val.length);
+						arr_cdts[i].has_length = 1;
+						arr_cdts[i].is_small_string = 0;
 						arr_cdts[i].type = metaffi_string8_type;
 						arr_cdts[i].free_required = true;
 						env->DeleteLocalRef(jstr);
@@ -2634,7 +3033,7 @@ jobjectArray cdts_jvm_serializer::create_object_array(cdts& arr_cdts, metaffi_ty
 					break;
 				}
 				case metaffi_string8_type: {
-					element = string8_to_jstring(arr_cdts[i].cdt_val.string8_val);
+					element = string8_to_jstring(metaffi_cdt_string8(&arr_cdts[i]));
 					break;
 				}
 			case metaffi_handle_type: {
@@ -2905,6 +3304,24 @@ jarray cdts_jvm_serializer::extract_packed_array()
 	metaffi_type elem_type = metaffi_packed_element_type(current.type);
 	cdt_packed_array* packed = current.get_packed_array();
 
+	// Tensors to nested primitive arrays (double[][], int[][][], ...)
+	if (packed && metaffi_packed_is_tensor(packed) && jni_primitive_array_signature(elem_type)) {
+		size_t elem_size = metaffi::runtime::packed_element_size(elem_type);
+
+		std::vector<unsigned char> contiguous;
+		const unsigned char* in = static_cast<const unsigned char*>(packed->data);
+		if (!metaffi::runtime::packed_is_contiguous(packed)) {
+			contiguous.resize(packed->length * elem_size);
+			metaffi::runtime::copy_packed_elements(packed, elem_size, contiguous.data());
+			in = contiguous.data();
+		}
+
+		jarray result = tensor_dimension_to_jni_array(env, packed, 0, elem_type, elem_size, in);
+		check_jni_exception("extract_packed_array tensor");
+		current_index++;
+		return result;
+	}
+
 	// Handle null/empty packed arrays
 	if (!packed || packed->length == 0) {
 		current_index++;
@@ -3231,7 +3648,9 @@ cdts_jvm_serializer& cdts_jvm_serializer::operator<<(jobject val)
 		}
 		case metaffi_string8_type: {
 			jstring str = (jstring)val;
-			data[current_index].cdt_val.string8_val = jstring_to_string8(str);
+			data[current_index].cdt_val.string8_val = jstring_to_string8(str, &data[current_index].cdt_val.sized_string_val.length);
+			data[current_index].has_length = 1;
+			data[current_index].is_small_string = 0;
 			data[current_index].type = metaffi_string8_type;
 			data[current_index].free_required = true;
 			break;
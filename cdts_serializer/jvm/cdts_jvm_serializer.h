@@ -6,6 +6,7 @@
 #include <stdexcept>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <utility>
 
 namespace metaffi::utils
@@ -164,20 +165,23 @@ private:
 	/**
 	 * @brief Convert jstring to metaffi_string8 (UTF-8)
 	 * Allocates memory with xllr_alloc_string8
+	 * @param out_length If not null, receives the length of the string (in code units)
 	 */
-	metaffi_string8 jstring_to_string8(jstring str);
+	metaffi_string8 jstring_to_string8(jstring str, metaffi_size* out_length = nullptr);
 
 	/**
 	 * @brief Convert jstring to metaffi_string16 (UTF-16)
 	 * Allocates memory with xllr_alloc_string16
+	 * @param out_length If not null, receives the length of the string (in code units)
 	 */
-	metaffi_string16 jstring_to_string16(jstring str);
+	metaffi_string16 jstring_to_string16(jstring str, metaffi_size* out_length = nullptr);
 
 	/**
 	 * @brief Convert jstring to metaffi_string32 (UTF-32)
 	 * Allocates memory with xllr_alloc_string32
+	 * @param out_length If not null, receives the length of the string (in code units)
 	 */
-	metaffi_string32 jstring_to_string32(jstring str);
+	metaffi_string32 jstring_to_string32(jstring str, metaffi_size* out_length = nullptr);
 
 	/**
 	 * @brief Convert metaffi_string8 to jstring
@@ -187,12 +191,12 @@ private:
 	/**
 	 * @brief Convert metaffi_string16 to jstring
 	 */
-	jstring string16_to_jstring(metaffi_string16 str);
+	jstring string16_to_jstring(std::u16string_view str);
 
 	/**
 	 * @brief Convert metaffi_string32 to jstring
 	 */
-	jstring string32_to_jstring(metaffi_string32 str);
+	jstring string32_to_jstring(std::u32string_view str);
 
 	// ===== Array Handling =====
 
@@ -355,6 +359,31 @@ public:
 	 */
 	cdts_jvm_serializer& add_packed_array(jarray arr, metaffi_type element_type);
 
+	/**
+	 * @brief Add rectangular nested primitive arrays (double[][], int[][][], ...) as a packed N-D tensor.
+	 * add_packed_array forwards nested arrays here.
+	 * The shape follows the first array of each dimension - ragged arrays throw.
+	 * @param arr Java array of primitive arrays (or of arrays of them)
+	 * @param element_type Numeric or bool element type of the innermost arrays
+	 * @throws std::runtime_error if arr is null or ragged, or element_type is unsupported
+	 */
+	cdts_jvm_serializer& add_packed_tensor(jobjectArray arr, metaffi_type element_type);
+
+	/**
+	 * @brief Add a direct NIO buffer as a borrowed packed CDT (no copy).
+	 * Java heap arrays may be moved by the GC, so only direct buffers can be borrowed.
+	 * The buffer must stay reachable and unmodified until the CDTS is freed.
+	 * The borrowed elements are the ones between the buffer's position and limit - in bytes for
+	 * ByteBuffer (divided by the element size), in elements for typed buffers (IntBuffer, DoubleBuffer, etc.).
+	 * Multi-byte elements must be in native byte order (call order(ByteOrder.nativeOrder()) on ByteBuffers).
+	 * @param buffer Direct java.nio.Buffer
+	 * @param element_type Numeric or bool element type (e.g. metaffi_float64_type)
+	 * @return Reference to this for chaining
+	 * @throws std::runtime_error if buffer is null, not direct, a typed buffer of another element type,
+	 *         not in native byte order, or element_type is unsupported
+	 */
+	cdts_jvm_serializer& add_packed_direct_buffer(jobject buffer, metaffi_type element_type);
+
 	// Wrapper objects and other objects - auto-detect type
 
 	/**
@@ -449,6 +478,7 @@ public:
 	/**
 	 * @brief Extract a packed array CDT to a Java primitive array.
 	 * Uses memcpy from packed buffer for numeric types.
+	 * Packed tensors are extracted to nested primitive arrays (e.g. double[][]).
 	 * @return jarray (local reference to Java primitive array)
 	 * @throws std::runtime_error if current CDT is not a packed array
 	 */
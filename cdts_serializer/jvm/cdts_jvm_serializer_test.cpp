@@ -263,6 +263,63 @@ int main(int argc, char** argv)
 	}
 }
 
+// Java-side helpers for the direct buffer tests
+
+// ByteBuffer.order(ByteOrder.nativeOrder()), or the other byte order if native is false
+static void set_byte_order(jobject byte_buffer, bool native)
+{
+	jclass order_class = g_env->FindClass("java/nio/ByteOrder");
+	REQUIRE(order_class != nullptr);
+	jmethodID native_order = g_env->GetStaticMethodID(order_class, "nativeOrder", "()Ljava/nio/ByteOrder;");
+	jobject order = g_env->CallStaticObjectMethod(order_class, native_order);
+	if(!native)
+	{
+		jobject big_endian = g_env->GetStaticObjectField(order_class,
+			g_env->GetStaticFieldID(order_class, "BIG_ENDIAN", "Ljava/nio/ByteOrder;"));
+		jobject little_endian = g_env->GetStaticObjectField(order_class,
+			g_env->GetStaticFieldID(order_class, "LITTLE_ENDIAN", "Ljava/nio/ByteOrder;"));
+		jobject other = g_env->NewLocalRef(g_env->IsSameObject(order, big_endian) ? little_endian : big_endian);
+		g_env->DeleteLocalRef(big_endian);
+		g_env->DeleteLocalRef(little_endian);
+		g_env->DeleteLocalRef(order);
+		order = other;
+	}
+
+	jclass buffer_class = g_env->FindClass("java/nio/ByteBuffer");
+	jmethodID set_order = g_env->GetMethodID(buffer_class, "order", "(Ljava/nio/ByteOrder;)Ljava/nio/ByteBuffer;");
+	jobject same_buffer = g_env->CallObjectMethod(byte_buffer, set_order, order);
+	REQUIRE(!g_env->ExceptionCheck());
+
+	g_env->DeleteLocalRef(same_buffer);
+	g_env->DeleteLocalRef(buffer_class);
+	g_env->DeleteLocalRef(order);
+	g_env->DeleteLocalRef(order_class);
+}
+
+// Buffer.position(int) or Buffer.limit(int)
+static void set_buffer_index(jobject buffer, const char* method_name, jint value)
+{
+	jclass buffer_class = g_env->FindClass("java/nio/Buffer");
+	jmethodID method = g_env->GetMethodID(buffer_class, method_name, "(I)Ljava/nio/Buffer;");
+	REQUIRE(method != nullptr);
+	jobject same_buffer = g_env->CallObjectMethod(buffer, method, value);
+	REQUIRE(!g_env->ExceptionCheck());
+
+	g_env->DeleteLocalRef(same_buffer);
+	g_env->DeleteLocalRef(buffer_class);
+}
+
+// ByteBuffer.asDoubleBuffer() - a view starting at the byte buffer's position, in its byte order
+static jobject as_double_buffer(jobject byte_buffer)
+{
+	jclass buffer_class = g_env->FindClass("java/nio/ByteBuffer");
+	jmethodID method = g_env->GetMethodID(buffer_class, "asDoubleBuffer", "()Ljava/nio/DoubleBuffer;");
+	jobject view = g_env->CallObjectMethod(byte_buffer, method);
+	REQUIRE(!g_env->ExceptionCheck());
+	g_env->DeleteLocalRef(buffer_class);
+	return view;
+}
+
 TEST_SUITE("CDTS JVM Serializer")
 {
 	//--------------------------------------------------------------------
@@ -1868,6 +1925,123 @@ TEST_SUITE("CDTS JVM Serializer")
 		g_env->DeleteLocalRef(arr);
 	}
 
+	TEST_CASE("Packed direct buffer is borrowed")
+	{
+		cdts data(1);
+		cdts_jvm_serializer ser(g_env, data);
+
+		metaffi_float64 values[] = {1.5, 2.5, 3.5, 4.5};
+		jobject buffer = g_env->NewDirectByteBuffer(values, sizeof(values));
+		REQUIRE(buffer != nullptr);
+		set_byte_order(buffer, true);
+
+		ser.add_packed_direct_buffer(buffer, metaffi_float64_type);
+
+		REQUIRE(metaffi_is_packed_array(data[0].type));
+		CHECK(metaffi_packed_element_type(data[0].type) == metaffi_float64_type);
+		cdt_packed_array* packed = data[0].cdt_val.packed_array_val;
+		CHECK(packed->data == values);
+		CHECK(packed->length == 4);
+		CHECK(packed->is_borrowed);
+
+		ser.reset();
+		jdoubleArray extracted = (jdoubleArray)ser.extract_array();
+		REQUIRE(extracted != nullptr);
+		CHECK(g_env->GetArrayLength(extracted) == 4);
+		g_env->DeleteLocalRef(extracted);
+
+		data[0].free(); // frees the header only
+		CHECK(values[3] == 4.5);
+
+		g_env->DeleteLocalRef(buffer);
+	}
+
+	TEST_CASE("Packed direct buffer borrows from position to limit")
+	{
+		metaffi_float64 values[] = {1.5, 2.5, 3.5, 4.5, 5.5};
+		jobject buffer = g_env->NewDirectByteBuffer(values, sizeof(values));
+		REQUIRE(buffer != nullptr);
+		set_byte_order(buffer, true);
+
+		// ByteBuffer: position and limit in bytes
+		set_buffer_index(buffer, "position", sizeof(metaffi_float64));
+		set_buffer_index(buffer, "limit", 4 * sizeof(metaffi_float64));
+		{
+			cdts data(1);
+			cdts_jvm_serializer ser(g_env, data);
+			ser.add_packed_direct_buffer(buffer, metaffi_float64_type);
+
+			cdt_packed_array* packed = data[0].cdt_val.packed_array_val;
+			CHECK(packed->data == &values[1]);
+			CHECK(packed->length == 3);
+		}
+
+		// DoubleBuffer view: position and limit in elements
+		jobject view = as_double_buffer(buffer); // elements 1..3
+		set_buffer_index(view, "position", 1);
+		set_buffer_index(view, "limit", 2);
+		{
+			cdts data(1);
+			cdts_jvm_serializer ser(g_env, data);
+			ser.add_packed_direct_buffer(view, metaffi_float64_type);
+
+			cdt_packed_array* packed = data[0].cdt_val.packed_array_val;
+			CHECK(packed->data == &values[2]);
+			CHECK(packed->length == 1);
+			CHECK(static_cast<metaffi_float64*>(packed->data)[0] == 3.5);
+		}
+
+		g_env->DeleteLocalRef(view);
+		g_env->DeleteLocalRef(buffer);
+	}
+
+	TEST_CASE("Packed direct buffer rejects non-native byte order")
+	{
+		metaffi_float64 values[] = {1.5, 2.5};
+		jobject buffer = g_env->NewDirectByteBuffer(values, sizeof(values));
+		REQUIRE(buffer != nullptr);
+		set_byte_order(buffer, false);
+
+		cdts data(2);
+		cdts_jvm_serializer ser(g_env, data);
+		CHECK_THROWS_WITH(ser.add_packed_direct_buffer(buffer, metaffi_float64_type),
+		                  doctest::Contains("native byte order"));
+
+		// views keep the byte order of the buffer they were created from
+		jobject view = as_double_buffer(buffer);
+		CHECK_THROWS_WITH(ser.add_packed_direct_buffer(view, metaffi_float64_type),
+		                  doctest::Contains("native byte order"));
+
+		// single-byte elements have no byte order
+		ser.add_packed_direct_buffer(buffer, metaffi_uint8_type);
+		CHECK(data[0].cdt_val.packed_array_val->length == sizeof(values));
+
+		g_env->DeleteLocalRef(view);
+		g_env->DeleteLocalRef(buffer);
+	}
+
+	TEST_CASE("Packed direct buffer rejects a typed buffer of another element type")
+	{
+		metaffi_float64 values[] = {1.5, 2.5};
+		jobject buffer = g_env->NewDirectByteBuffer(values, sizeof(values));
+		REQUIRE(buffer != nullptr);
+		set_byte_order(buffer, true);
+		jobject view = as_double_buffer(buffer);
+
+		cdts data(1);
+		cdts_jvm_serializer ser(g_env, data);
+		CHECK_THROWS_WITH(ser.add_packed_direct_buffer(view, metaffi_int32_type),
+		                  doctest::Contains("does not match element type"));
+		CHECK_THROWS_WITH(ser.add_packed_direct_buffer(view, metaffi_int8_type),
+		                  doctest::Contains("does not match element type"));
+
+		ser.add_packed_direct_buffer(view, metaffi_float64_type);
+		CHECK(data[0].cdt_val.packed_array_val->length == 2);
+
+		g_env->DeleteLocalRef(view);
+		g_env->DeleteLocalRef(buffer);
+	}
+
 	TEST_CASE("extract_packed_array directly")
 	{
 		// Manually construct a packed CDT and extract via extract_packed_array
@@ -164,18 +164,9 @@ void CppXcallGenerator::emit_prologue(std::ostringstream& out,
         << "    if (*err) memcpy(*err, msg, n);\n"
         << "}\n"
         << "\n"
-        << "// Helper: pack a string8 return value into a cdt (heap-allocated copy).\n"
+        << "// Helper: pack a string8 return value into a cdt (copy, small strings are stored inline).\n"
         << "static void pack_string8(struct cdt& c, const char* s) {\n"
-        << "    c.type = metaffi_string8_type;\n"
-        << "    if (s) {\n"
-        << "        const size_t n = strlen(s) + 1;\n"
-        << "        c.cdt_val.string8_val = static_cast<char8_t*>(malloc(n));\n"
-        << "        if (c.cdt_val.string8_val) memcpy(c.cdt_val.string8_val, s, n);\n"
-        << "        c.free_required = 1;\n"
-        << "    } else {\n"
-        << "        c.cdt_val.string8_val = nullptr;\n"
-        << "        c.free_required = 0;\n"
-        << "    }\n"
+        << "    c.set_string(reinterpret_cast<const char8_t*>(s), s ? strlen(s) : 0, s != nullptr);\n"
         << "}\n"
         << "\n";
 }
@@ -393,11 +384,8 @@ void CppXcallGenerator::emit_unpack_params(
 
         if (is_string) {
             // Strings are char8_t* in the CDT; convert to std::string for native call
-            out << "        std::string _p" << i << ";\n"
-                << "        if (params_ret[0].arr[" << i << "].cdt_val.string8_val) {\n"
-                << "            _p" << i << " = reinterpret_cast<const char*>(\n"
-                << "                params_ret[0].arr[" << i << "].cdt_val.string8_val);\n"
-                << "        }\n";
+            out << "        std::u8string_view _v" << i << " = params_ret[0].arr[" << i << "].get_string8_view();\n"
+                << "        std::string _p" << i << "(_v" << i << ".begin(), _v" << i << ".end());\n";
         } else if (p.is_array()) {
             // Packed or CDTS array — emit a placeholder comment; full handling
             // requires knowledge of element type and packing convention.
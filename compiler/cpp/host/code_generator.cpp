@@ -21,6 +21,7 @@ CppCodeGenerator::generate(const metaffi::idl::IDLDefinition& idl,
     header << "#pragma once\n"
            << "// Generated by MetaFFI C++ host compiler. DO NOT EDIT.\n"
            << "#include <metaffi/api/metaffi_api.h>\n"
+           << "#include <metaffi/api/metaffi_warmup.h>\n"
            << "#include <cstdint>\n"
            << "#include <string>\n"
            << "#include <vector>\n"
@@ -59,6 +60,11 @@ void CppCodeGenerator::generate_module_header(std::ostringstream& out,
         << "// module_path: path to the foreign module file.\n"
         << "// runtime_plugin: e.g. \"xllr.python3\"\n"
         << "void bind(const std::string& module_path, const std::string& runtime_plugin);\n"
+        << "\n"
+        << "// Alternative to bind(): add the module's entities to a warm-up shared by several\n"
+        << "// modules, run it (runtimes and entities load concurrently), then bind(report).\n"
+        << "void prepare_bind(metaffi::api::MetaFFIWarmup& warmup, const std::string& module_path, const std::string& runtime_plugin);\n"
+        << "void bind(metaffi::api::MetaFFIWarmupReport& report);\n"
         << "\n";
 
     // Free functions declarations
@@ -237,6 +243,10 @@ void CppCodeGenerator::generate_module_source(std::ostringstream& out,
     emit_bind_function(out, module, idl);
     out << "\n";
 
+    // prepare_bind() + bind(report): bind through a shared MetaFFIWarmup
+    emit_warmup_bind_functions(out, module, idl);
+    out << "\n";
+
     // Free function stubs
     emit_free_function_impls(out, module);
 
@@ -302,43 +312,29 @@ void CppCodeGenerator::emit_entity_statics(std::ostringstream& out,
     }
 }
 
-void CppCodeGenerator::emit_bind_function(std::ostringstream& out,
-                                           const metaffi::idl::ModuleDefinition& module,
-                                           const metaffi::idl::IDLDefinition& idl) const {
-    out << "void bind(const std::string& module_path, const std::string& runtime_plugin) {\n"
-        << "    // Load runtime plugin and open module\n"
-        << "    _runtime = std::make_unique<MetaFFIRuntime>(runtime_plugin);\n"
-        << "    _runtime->load_runtime_plugin();\n"
-        << "    _module  = std::make_unique<MetaFFIModule>(_runtime->runtime_plugin(), module_path);\n"
-        << "\n";
+std::vector<CppCodeGenerator::BindEntry>
+CppCodeGenerator::bind_entries(const metaffi::idl::ModuleDefinition& module,
+                               const metaffi::idl::IDLDefinition& idl) const {
+    std::vector<BindEntry> entries;
+    auto add = [&](const std::string& var, const auto& entity, const std::string& retvals) {
+        entries.push_back({var, entity.entity_path_as_string(idl),
+                           type_info_list(entity.parameters()), retvals});
+    };
 
     // Free functions — use entity_path_as_string to include metaffi_guest_lib
     for (const auto& func : module.functions()) {
-        const std::string ep = func.entity_path_as_string(idl);
-        out << "    " << entity_var("", func.name())
-            << " = std::make_unique<MetaFFIEntity>(_module->load_entity_with_info(\n"
-            << "        \"" << ep << "\",\n"
-            << "        " << type_info_list(func.parameters()) << ",\n"
-            << "        " << type_info_list(func.return_values()) << "));\n\n";
+        add(entity_var("", func.name()), func, type_info_list(func.return_values()));
     }
 
     // Globals
     for (const auto& global : module.globals()) {
         if (global.getter()) {
-            const std::string ep = global.getter()->entity_path_as_string(idl);
-            out << "    " << entity_var("", global.getter()->name())
-                << " = std::make_unique<MetaFFIEntity>(_module->load_entity_with_info(\n"
-                << "        \"" << ep << "\",\n"
-                << "        " << type_info_list(global.getter()->parameters()) << ",\n"
-                << "        " << type_info_list(global.getter()->return_values()) << "));\n\n";
+            add(entity_var("", global.getter()->name()), *global.getter(),
+                type_info_list(global.getter()->return_values()));
         }
         if (global.setter()) {
-            const std::string ep = global.setter()->entity_path_as_string(idl);
-            out << "    " << entity_var("", global.setter()->name())
-                << " = std::make_unique<MetaFFIEntity>(_module->load_entity_with_info(\n"
-                << "        \"" << ep << "\",\n"
-                << "        " << type_info_list(global.setter()->parameters()) << ",\n"
-                << "        " << type_info_list(global.setter()->return_values()) << "));\n\n";
+            add(entity_var("", global.setter()->name()), *global.setter(),
+                type_info_list(global.setter()->return_values()));
         }
     }
 
@@ -352,57 +348,91 @@ void CppCodeGenerator::emit_bind_function(std::ostringstream& out,
             std::string label = "ctor";
             if (cls.constructors().size() > 1) label += "_" + std::to_string(i);
 
-            const std::string ep = ctor.entity_path_as_string(idl);
-            out << "    " << entity_var(cn, label)
-                << " = std::make_unique<MetaFFIEntity>(_module->load_entity_with_info(\n"
-                << "        \"" << ep << "\",\n"
-                << "        " << type_info_list(ctor.parameters()) << ",\n"
-                << "        " << type_info_list(ctor.return_values()) << "));\n\n";
+            add(entity_var(cn, label), ctor, type_info_list(ctor.return_values()));
         }
 
         // Destructor
         if (cls.release()) {
-            const auto* rel = cls.release();
-            const std::string ep = rel->entity_path_as_string(idl);
-            out << "    " << entity_var(cn, "dtor")
-                << " = std::make_unique<MetaFFIEntity>(_module->load_entity_with_info(\n"
-                << "        \"" << ep << "\",\n"
-                << "        " << type_info_list(rel->parameters()) << ",\n"
-                << "        {}));\n\n";
+            add(entity_var(cn, "dtor"), *cls.release(), "{}");
         }
 
         // Methods — IDL params already include the instance handle as first param;
         // use type_info_list directly (no extra handle prepended)
         for (const auto& method : cls.methods()) {
-            const std::string ep = method.entity_path_as_string(idl);
-            out << "    " << entity_var(cn, method.name())
-                << " = std::make_unique<MetaFFIEntity>(_module->load_entity_with_info(\n"
-                << "        \"" << ep << "\",\n"
-                << "        " << type_info_list(method.parameters()) << ",\n"
-                << "        " << type_info_list(method.return_values()) << "));\n\n";
+            add(entity_var(cn, method.name()), method, type_info_list(method.return_values()));
         }
 
         // Fields
         for (const auto& field : cls.fields()) {
             if (field.getter()) {
-                const std::string ep = field.getter()->entity_path_as_string(idl);
-                out << "    " << entity_var(cn, field.getter()->name())
-                    << " = std::make_unique<MetaFFIEntity>(_module->load_entity_with_info(\n"
-                    << "        \"" << ep << "\",\n"
-                    << "        " << type_info_list(field.getter()->parameters()) << ",\n"
-                    << "        " << type_info_list(field.getter()->return_values()) << "));\n\n";
+                add(entity_var(cn, field.getter()->name()), *field.getter(),
+                    type_info_list(field.getter()->return_values()));
             }
             if (field.setter()) {
-                const std::string ep = field.setter()->entity_path_as_string(idl);
-                out << "    " << entity_var(cn, field.setter()->name())
-                    << " = std::make_unique<MetaFFIEntity>(_module->load_entity_with_info(\n"
-                    << "        \"" << ep << "\",\n"
-                    << "        " << type_info_list(field.setter()->parameters()) << ",\n"
-                    << "        " << type_info_list(field.setter()->return_values()) << "));\n\n";
+                add(entity_var(cn, field.setter()->name()), *field.setter(),
+                    type_info_list(field.setter()->return_values()));
             }
         }
     }
 
+    return entries;
+}
+
+void CppCodeGenerator::emit_bind_function(std::ostringstream& out,
+                                           const metaffi::idl::ModuleDefinition& module,
+                                           const metaffi::idl::IDLDefinition& idl) const {
+    const std::vector<BindEntry> entries = bind_entries(module, idl);
+
+    out << "void bind(const std::string& module_path, const std::string& runtime_plugin) {\n"
+        << "    // Load runtime plugin and open module\n"
+        << "    _runtime = std::make_unique<MetaFFIRuntime>(runtime_plugin);\n"
+        << "    _runtime->load_runtime_plugin();\n"
+        << "    _module  = std::make_unique<MetaFFIModule>(_runtime->runtime_plugin(), module_path);\n"
+        << "\n";
+
+    for (const auto& entry : entries) {
+        out << "    " << entry.var
+            << " = std::make_unique<MetaFFIEntity>(_module->load_entity_with_info(\n"
+            << "        \"" << entry.entity_path << "\",\n"
+            << "        " << entry.params << ",\n"
+            << "        " << entry.retvals << "));\n\n";
+    }
+
+    out << "}\n";
+}
+
+void CppCodeGenerator::emit_warmup_bind_functions(std::ostringstream& out,
+                                                   const metaffi::idl::ModuleDefinition& module,
+                                                   const metaffi::idl::IDLDefinition& idl) const {
+    const std::vector<BindEntry> entries = bind_entries(module, idl);
+
+    // prepare_bind() records where the module's entities start in the warm-up manifest
+    out << "static size_t _warmup_first_entity = 0;\n"
+        << "\n"
+        << "void prepare_bind(MetaFFIWarmup& warmup, const std::string& module_path, const std::string& runtime_plugin) {\n"
+        << "    _runtime = std::make_unique<MetaFFIRuntime>(runtime_plugin);\n"
+        << "    _module  = std::make_unique<MetaFFIModule>(_runtime->runtime_plugin(), module_path);\n"
+        << "    _warmup_first_entity = warmup.size();\n"
+        << "\n";
+
+    for (const auto& entry : entries) {
+        out << "    warmup.add(runtime_plugin, module_path,\n"
+            << "        \"" << entry.entity_path << "\",\n"
+            << "        " << entry.params << ",\n"
+            << "        " << entry.retvals << ");\n\n";
+    }
+
+    out << "}\n"
+        << "\n"
+        << "void bind(MetaFFIWarmupReport& report) {\n";
+
+    if (!entries.empty()) {
+        out << "    size_t index = _warmup_first_entity;\n";
+    }
+    for (const auto& entry : entries) {
+        out << "    " << entry.var << " = report.take_entity(index++);\n";
+    }
+
     out << "}\n";
 }
 
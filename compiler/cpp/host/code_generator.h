@@ -58,6 +58,10 @@ private:
                             const metaffi::idl::ModuleDefinition& module,
                             const metaffi::idl::IDLDefinition& idl) const;
 
+    void emit_warmup_bind_functions(std::ostringstream& out,
+                                    const metaffi::idl::ModuleDefinition& module,
+                                    const metaffi::idl::IDLDefinition& idl) const;
+
     void emit_free_function_impls(std::ostringstream& out,
                                   const metaffi::idl::ModuleDefinition& module) const;
 
@@ -70,6 +74,18 @@ private:
 
     // --- Utility helpers ---
 
+    // An entity loaded by bind(): its static variable, entity path and type info lists.
+    struct BindEntry {
+        std::string var;
+        std::string entity_path;
+        std::string params;
+        std::string retvals;
+    };
+
+    // The entities bind() loads, in load order.
+    std::vector<BindEntry> bind_entries(const metaffi::idl::ModuleDefinition& module,
+                                        const metaffi::idl::IDLDefinition& idl) const;
+
     // Build comma-separated list of "type name" pairs from parameters.
     std::string params_decl(const std::vector<metaffi::idl::ArgDefinition>& params) const;
 
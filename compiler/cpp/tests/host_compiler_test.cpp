@@ -282,6 +282,17 @@ TEST_SUITE("Suite 4 - Code Generator: Free Functions") {
         CHECK(files.source_content.find("load_runtime_plugin()") != std::string::npos);
     }
 
+    TEST_CASE("Generated code contains warm-up prepare_bind() and bind(report)") {
+        auto idl = load_fixture_idl();
+        auto files = CppCodeGenerator{}.generate(idl, "test_MetaFFIHost");
+        CHECK(files.header_content.find("#include <metaffi/api/metaffi_warmup.h>") != std::string::npos);
+        CHECK(files.header_content.find("void prepare_bind(metaffi::api::MetaFFIWarmup& warmup,") != std::string::npos);
+        CHECK(files.header_content.find("void bind(metaffi::api::MetaFFIWarmupReport& report);") != std::string::npos);
+        CHECK(files.source_content.find("_warmup_first_entity = warmup.size();") != std::string::npos);
+        CHECK(files.source_content.find("warmup.add(runtime_plugin, module_path,\n        \"callable=?add@@YAHHH@Z") != std::string::npos);
+        CHECK(files.source_content.find("_Point_sum_entity = report.take_entity(index++);") != std::string::npos);
+    }
+
     TEST_CASE("Generated source contains load_entity_with_info for add with correct entity path") {
         auto idl = load_fixture_idl();
         auto files = CppCodeGenerator{}.generate(idl, "test_MetaFFIHost");
@@ -23,10 +23,16 @@ void cdts::set(metaffi_size index, cdt&& val) const
 {
 	arr[index].type = val.type;
 	arr[index].free_required = val.free_required;
+	arr[index].has_length = val.has_length;
+	arr[index].is_small_string = val.is_small_string;
+	arr[index].small_string_length = val.small_string_length;
 	arr[index].cdt_val = val.cdt_val;
 	
 	val.type = metaffi_null_type;
 	val.free_required = 0;
+	val.has_length = 0;
+	val.is_small_string = 0;
+	val.small_string_length = 0;
 	std::memset(&val.cdt_val, 0, sizeof(val.cdt_val));
 }
 
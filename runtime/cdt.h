@@ -17,6 +17,8 @@ void xllr_free_memory(void* ptr);
 
 #ifdef __cplusplus
 #include <cstdlib>
+#include <cstring>
+#include <new>
 #include <vector>
 #include <string_view>
 #include <sstream>
@@ -89,6 +91,33 @@ struct cdts
 #endif
 };
 
+/**
+ * @brief Length of a string8/16/32 CDT, aliasing the string pointer of cdt_types.
+ * Valid only if the CDT's has_length is set.
+ * length is in code units (bytes for string8) without the NULL terminator,
+ * so strings may contain embedded NULLs.
+ */
+struct cdt_sized_string
+{
+	void* val; // same as string8_val/string16_val/string32_val
+	metaffi_size length;
+};
+
+/**
+ * @brief Inline storage of small strings (see cdt::is_small_string), aliasing cdt_types.
+ * Holds up to metaffi_small_string_capacity(code unit size) code units and a NULL terminator,
+ * i.e. 15 (string8), 7 (string16) or 3 (string32) code units.
+ */
+#define metaffi_small_string_size 16
+#define metaffi_small_string_capacity(code_unit_size) ((metaffi_small_string_size / (code_unit_size)) - 1)
+
+union cdt_small_string
+{
+	char8_t string8[metaffi_small_string_size];
+	char16_t string16[metaffi_small_string_size / sizeof(char16_t)];
+	char32_t string32[metaffi_small_string_size / sizeof(char32_t)];
+};
+
 union cdt_types
 {
 	metaffi_float32 float32_val;
@@ -112,20 +141,40 @@ union cdt_types
 	struct cdt_metaffi_callable* callable_val;
 	struct cdts* array_val;
 	struct cdt_packed_array* packed_array_val;
+	struct cdt_sized_string sized_string_val;
+	union cdt_small_string small_string_val;
 
 #ifdef __cplusplus
-	cdt_types() : int64_val(0) {}
+	cdt_types() : sized_string_val{nullptr, 0} {}
 #endif
 };
 
+/**
+ * @brief String pointer of a string8/16/32 CDT (pc is a pointer to the CDT), inline small strings included.
+ * Use these instead of reading cdt_val.string8_val/string16_val/string32_val directly.
+ */
+#define metaffi_cdt_string8(pc) ((pc)->is_small_string ? (metaffi_string8)(pc)->cdt_val.small_string_val.string8 : (pc)->cdt_val.string8_val)
+#define metaffi_cdt_string16(pc) ((pc)->is_small_string ? (metaffi_string16)(pc)->cdt_val.small_string_val.string16 : (pc)->cdt_val.string16_val)
+#define metaffi_cdt_string32(pc) ((pc)->is_small_string ? (metaffi_string32)(pc)->cdt_val.small_string_val.string32 : (pc)->cdt_val.string32_val)
+
+/**
+ * @brief Length (in code units) of a string8/16/32 CDT, or -1 if it is unknown (NULL terminated string).
+ */
+#define metaffi_cdt_string_length(pc) \
+	((pc)->is_small_string ? (metaffi_int64)(pc)->small_string_length : \
+	 (pc)->has_length ? (metaffi_int64)(pc)->cdt_val.sized_string_val.length : (metaffi_int64)-1)
+
 struct cdt
 {
 	metaffi_type type;
 	union cdt_types cdt_val;
 	metaffi_bool free_required;
+	metaffi_bool has_length; // strings: cdt_val.sized_string_val.length is set (otherwise the string is NULL terminated)
+	metaffi_bool is_small_string; // strings: stored inline in cdt_val.small_string_val (not allocated, nothing to free)
+	metaffi_uint8 small_string_length; // length (in code units) of an inline string
 	
 #ifdef __cplusplus
-	cdt() : type(metaffi_null_type), free_required(false), cdt_val(){}
+	cdt() : type(metaffi_null_type), free_required(false), has_length(0), is_small_string(0), small_string_length(0), cdt_val(){}
 	explicit cdt(metaffi_float32 val): cdt() { *this = val; }
 	cdt& operator=(metaffi_float32 val) { cdt_val.float32_val = val; type = metaffi_float32_type; return *this; }
 	explicit cdt(metaffi_float64 val): cdt() { *this = val; }
@@ -152,21 +201,61 @@ struct cdt
 	cdt& operator=(metaffi_char8 val) { cdt_val.char8_val = val; type = metaffi_char8_type; return *this; }
 	
 	cdt(const char8_t* val, bool is_copy): cdt(){ set_string(val, is_copy);	}
-	cdt(const std::u8string_view& val, bool is_copy): cdt(){ set_string(val.data(), is_copy); }
+	cdt(const std::u8string_view& val, bool is_copy): cdt(){ set_string(val.data(), val.size(), is_copy); }
 	void set_string(const char8_t* val, bool is_copy)
+	{
+		if(is_copy)
+		{
+			set_string(val, std::u8string_view(val).size(), true);
+		}
+		else
+		{
+			type = metaffi_string8_type;
+			free_required = false;
+			has_length = 0;
+			is_small_string = 0;
+			cdt_val.string8_val = (metaffi_string8)val;
+		}
+	}
+	
+	/**
+	 * @brief Set a string of length code units (may contain NULLs). A copy is NULL terminated.
+	 * Copies of small strings are stored inline, without allocating.
+	 */
+	void set_string(const char8_t* val, metaffi_size length, bool is_copy)
 	{
 		type = metaffi_string8_type;
+		
+		if(is_copy && length <= metaffi_small_string_capacity(sizeof(char8_t)))
+		{
+			free_required = false;
+			has_length = 0;
+			is_small_string = 1;
+			small_string_length = static_cast<metaffi_uint8>(length);
+			
+			if(length > 0)
+			{
+				std::memcpy(cdt_val.small_string_val.string8, val, length * sizeof(char8_t));
+			}
+			cdt_val.small_string_val.string8[length] = 0;
+			return;
+		}
+		
 		free_required = is_copy;
+		has_length = 1;
+		is_small_string = 0;
+		cdt_val.sized_string_val.length = length;
 		
 		if(is_copy)
 		{
-			// calculate the length of val - a char8_t*
-			std::u8string_view val_view(val);
-			cdt_val.string8_val = static_cast<char8_t*>(xllr_alloc_memory((val_view.size() + 1) * sizeof(char8_t)));
+			cdt_val.string8_val = static_cast<char8_t*>(xllr_alloc_memory((length + 1) * sizeof(char8_t)));
+			if(!cdt_val.string8_val)
+			{
+				throw std::bad_alloc();
+			}
 
-			// copy val, using val_view to cdt_val.string8_val
-			std::memcpy(cdt_val.string8_val, val_view.data(), val_view.size());
-			cdt_val.string8_val[val_view.size()] = 0;
+			std::memcpy(cdt_val.string8_val, val, length * sizeof(char8_t));
+			cdt_val.string8_val[length] = 0;
 		}
 		else
 		{
@@ -174,23 +263,81 @@ struct cdt
 		}
 	}
 	
-	explicit cdt(metaffi_char16 val): type(metaffi_char16_type), free_required(false) { cdt_val.char16_val = val; }
+	/**
+	 * @brief The string8 value - uses the stored length if set, otherwise scans for the NULL terminator.
+	 */
+	[[nodiscard]] std::u8string_view get_string8_view() const
+	{
+		if(is_small_string)
+		{
+			return {cdt_val.small_string_val.string8, small_string_length};
+		}
+		
+		if(!cdt_val.string8_val)
+		{
+			return {};
+		}
+		
+		return has_length ? std::u8string_view(cdt_val.string8_val, cdt_val.sized_string_val.length) : std::u8string_view(cdt_val.string8_val);
+	}
+	
+	explicit cdt(metaffi_char16 val): type(metaffi_char16_type), free_required(false), has_length(0), is_small_string(0), small_string_length(0) { cdt_val.char16_val = val; }
 	cdt(const char16_t* val, bool is_copy): cdt(){ set_string(val, is_copy); }
-	explicit cdt(const std::u16string_view& val, bool is_copy): cdt(){ set_string(val.data(), is_copy); }
+	explicit cdt(const std::u16string_view& val, bool is_copy): cdt(){ set_string(val.data(), val.size(), is_copy); }
 	void set_string(const char16_t* val, bool is_copy)
+	{
+		if(is_copy)
+		{
+			set_string(val, std::u16string_view(val).size(), true);
+		}
+		else
+		{
+			type = metaffi_string16_type;
+			free_required = false;
+			has_length = 0;
+			is_small_string = 0;
+			cdt_val.string16_val = (metaffi_string16)val;
+		}
+	}
+	
+	/**
+	 * @brief Set a string of length code units (may contain NULLs). A copy is NULL terminated.
+	 * Copies of small strings are stored inline, without allocating.
+	 */
+	void set_string(const char16_t* val, metaffi_size length, bool is_copy)
 	{
 		type = metaffi_string16_type;
+		
+		if(is_copy && length <= metaffi_small_string_capacity(sizeof(char16_t)))
+		{
+			free_required = false;
+			has_length = 0;
+			is_small_string = 1;
+			small_string_length = static_cast<metaffi_uint8>(length);
+			
+			if(length > 0)
+			{
+				std::memcpy(cdt_val.small_string_val.string16, val, length * sizeof(char16_t));
+			}
+			cdt_val.small_string_val.string16[length] = 0;
+			return;
+		}
+		
 		free_required = is_copy;
+		has_length = 1;
+		is_small_string = 0;
+		cdt_val.sized_string_val.length = length;
 		
 		if(is_copy)
 		{
-			// calculate the length of val - a char16_t*
-			std::u16string_view val_view(val);
-			cdt_val.string16_val = static_cast<char16_t*>(xllr_alloc_memory((val_view.size() + 1) * sizeof(char16_t)));
+			cdt_val.string16_val = static_cast<char16_t*>(xllr_alloc_memory((length + 1) * sizeof(char16_t)));
+			if(!cdt_val.string16_val)
+			{
+				throw std::bad_alloc();
+			}
 
-			// copy val, using val_view to cdt_val.string16_val
-			std::memcpy(cdt_val.string16_val, val_view.data(), val_view.size() * sizeof(char16_t));
-			cdt_val.string16_val[val_view.size()] = 0;
+			std::memcpy(cdt_val.string16_val, val, length * sizeof(char16_t));
+			cdt_val.string16_val[length] = 0;
 		}
 		else
 		{
@@ -198,23 +345,81 @@ struct cdt
 		}
 	}
 	
-	explicit cdt(metaffi_char32 val): type(metaffi_char32_type), free_required(false) { cdt_val.char32_val = val; }
+	/**
+	 * @brief The string16 value - uses the stored length if set, otherwise scans for the NULL terminator.
+	 */
+	[[nodiscard]] std::u16string_view get_string16_view() const
+	{
+		if(is_small_string)
+		{
+			return {cdt_val.small_string_val.string16, small_string_length};
+		}
+		
+		if(!cdt_val.string16_val)
+		{
+			return {};
+		}
+		
+		return has_length ? std::u16string_view(cdt_val.string16_val, cdt_val.sized_string_val.length) : std::u16string_view(cdt_val.string16_val);
+	}
+	
+	explicit cdt(metaffi_char32 val): type(metaffi_char32_type), free_required(false), has_length(0), is_small_string(0), small_string_length(0) { cdt_val.char32_val = val; }
 	cdt(const char32_t* val, bool is_copy): cdt(){ set_string(val, is_copy); }
-	cdt(const std::u32string_view& val, bool is_copy): cdt(){ set_string(val.data(), is_copy); }
+	cdt(const std::u32string_view& val, bool is_copy): cdt(){ set_string(val.data(), val.size(), is_copy); }
 	void set_string(const char32_t* val, bool is_copy)
+	{
+		if(is_copy)
+		{
+			set_string(val, std::u32string_view(val).size(), true);
+		}
+		else
+		{
+			type = metaffi_string32_type;
+			free_required = false;
+			has_length = 0;
+			is_small_string = 0;
+			cdt_val.string32_val = (metaffi_string32)val;
+		}
+	}
+	
+	/**
+	 * @brief Set a string of length code units (may contain NULLs). A copy is NULL terminated.
+	 * Copies of small strings are stored inline, without allocating.
+	 */
+	void set_string(const char32_t* val, metaffi_size length, bool is_copy)
 	{
 		type = metaffi_string32_type;
+		
+		if(is_copy && length <= metaffi_small_string_capacity(sizeof(char32_t)))
+		{
+			free_required = false;
+			has_length = 0;
+			is_small_string = 1;
+			small_string_length = static_cast<metaffi_uint8>(length);
+			
+			if(length > 0)
+			{
+				std::memcpy(cdt_val.small_string_val.string32, val, length * sizeof(char32_t));
+			}
+			cdt_val.small_string_val.string32[length] = 0;
+			return;
+		}
+		
 		free_required = is_copy;
+		has_length = 1;
+		is_small_string = 0;
+		cdt_val.sized_string_val.length = length;
 		
 		if(is_copy)
 		{
-			// calculate the length of val - a char32_t*
-			std::u32string_view val_view(val);
-			cdt_val.string32_val = static_cast<char32_t*>(xllr_alloc_memory((val_view.size() + 1) * sizeof(char32_t)));
+			cdt_val.string32_val = static_cast<char32_t*>(xllr_alloc_memory((length + 1) * sizeof(char32_t)));
+			if(!cdt_val.string32_val)
+			{
+				throw std::bad_alloc();
+			}
 
-			// copy val, using val_view to cdt_val.string32_val
-			std::memcpy(cdt_val.string32_val, val_view.data(), val_view.size() * sizeof(char32_t));
-			cdt_val.string32_val[val_view.size()] = 0;
+			std::memcpy(cdt_val.string32_val, val, length * sizeof(char32_t));
+			cdt_val.string32_val[length] = 0;
 		}
 		else
 		{
@@ -222,6 +427,24 @@ struct cdt
 		}
 	}
 	
+	/**
+	 * @brief The string32 value - uses the stored length if set, otherwise scans for the NULL terminator.
+	 */
+	[[nodiscard]] std::u32string_view get_string32_view() const
+	{
+		if(is_small_string)
+		{
+			return {cdt_val.small_string_val.string32, small_string_length};
+		}
+		
+		if(!cdt_val.string32_val)
+		{
+			return {};
+		}
+		
+		return has_length ? std::u32string_view(cdt_val.string32_val, cdt_val.sized_string_val.length) : std::u32string_view(cdt_val.string32_val);
+	}
+	
 	explicit cdt(cdt_metaffi_handle* val): cdt() { set_handle(val); }
 	explicit cdt(const cdt_metaffi_handle* val): cdt() { set_handle(val); }
 	void set_handle(cdt_metaffi_handle* val)
@@ -241,8 +464,8 @@ struct cdt
 		free_required = false;
 	}
 	
-	explicit cdt(cdt_metaffi_callable* val): type(metaffi_callable_type), free_required(true) { cdt_val.callable_val = val; }
-	explicit cdt(const cdt_metaffi_callable* val): type(metaffi_callable_type), free_required(true) { cdt_val.callable_val = (cdt_metaffi_callable*)val; }
+	explicit cdt(cdt_metaffi_callable* val): type(metaffi_callable_type), free_required(true), has_length(0), is_small_string(0), small_string_length(0) { cdt_val.callable_val = val; }
+	explicit cdt(const cdt_metaffi_callable* val): type(metaffi_callable_type), free_required(true), has_length(0), is_small_string(0), small_string_length(0) { cdt_val.callable_val = (cdt_metaffi_callable*)val; }
 	
 	cdt(metaffi_size length, metaffi_int64 fixed_dimensions, metaffi_types common_type = metaffi_any_type): cdt()
 	{
@@ -271,6 +494,23 @@ struct cdt
 		cdt_val.packed_array_val = packed;
 	}
 	
+	/**
+	 * @brief Set a packed array borrowing a buffer owned by the caller (no copy).
+	 * The buffer must outlive the CDT's use (e.g. an input parameter during the call) and is never freed by the CDT.
+	 * @param data Caller's buffer of length elements of element_type
+	 */
+	void set_borrowed_packed_array(void* data, metaffi_size length, metaffi_types element_type)
+	{
+		auto* packed = static_cast<cdt_packed_array*>(xllr_alloc_memory(sizeof(cdt_packed_array)));
+		if(!packed)
+		{
+			throw std::bad_alloc();
+		}
+		
+		new (packed) cdt_packed_array(data, length, true);
+		set_packed_array(packed, element_type);
+	}
+	
 	/**
 	 * @brief Get the packed array pointer. Caller must check metaffi_is_packed_array(type) first.
 	 */
@@ -424,11 +664,11 @@ struct cdt
 	explicit operator metaffi_uint64() const { return cdt_val.uint64_val; }
 	explicit operator bool() const { return cdt_val.bool_val != 0; }
 	explicit operator const metaffi_char8&() const { return cdt_val.char8_val; }
-	explicit operator metaffi_string8() const { return cdt_val.string8_val; }
+	explicit operator metaffi_string8() const { return metaffi_cdt_string8(this); }
 	explicit operator const metaffi_char16&() const { return cdt_val.char16_val; }
-	explicit operator metaffi_string16() const { return cdt_val.string16_val; }
+	explicit operator metaffi_string16() const { return metaffi_cdt_string16(this); }
 	explicit operator const metaffi_char32&() const { return cdt_val.char32_val; }
-	explicit operator metaffi_string32() const { return cdt_val.string32_val; }
+	explicit operator metaffi_string32() const { return metaffi_cdt_string32(this); }
 	
 	explicit operator cdts&() const
 	{
@@ -482,18 +722,21 @@ struct cdt
 					{
 						xllr_free_memory(cdt_val.string8_val);
 						cdt_val.string8_val = nullptr;
+						has_length = 0;
 					}break;
 				
 					case metaffi_string16_type:
 					{
 						xllr_free_memory(cdt_val.string16_val);
 						cdt_val.string16_val = nullptr;
+						has_length = 0;
 					}break;
 				
 					case metaffi_string32_type:
 					{
 						xllr_free_memory(cdt_val.string32_val);
 						cdt_val.string32_val = nullptr;
+						has_length = 0;
 					}break;
 				
 					// If free_required is true, the handle was allocated with xllr_alloc_memory
@@ -541,9 +784,11 @@ private:
 	 * All allocations/frees go through xllr_alloc_memory/xllr_free_memory
 	 * to avoid cross-DLL CRT mismatches.
 	 * Numeric/bool/char/size: single xllr_free_memory on the data buffer.
-	 * Strings: xllr_free_memory each string + the pointer array.
+	 * Strings: xllr_free_memory each string + the pointer array (string blobs: only the blob).
 	 * Handles: release callbacks + xllr_free_memory the array.
 	 * Callables: free sub-allocations + xllr_free_memory the array.
+	 * Borrowed packed arrays: only the struct is freed.
+	 * N-D tensors: the shape allocation is freed as well.
 	 */
 	void free_packed_array()
 	{
@@ -553,7 +798,7 @@ private:
 			return;
 		}
 
-		if(packed->data)
+		if(packed->data && !packed->is_borrowed)
 		{
 			metaffi_type elem_type = metaffi_packed_element_type(type);
 
@@ -586,7 +831,7 @@ private:
 				case metaffi_string8_type:
 				{
 					auto* strings = static_cast<metaffi_string8*>(packed->data);
-					for(metaffi_size i = 0; i < packed->length; i++)
+					for(metaffi_size i = 0; !packed->is_string_blob && i < packed->length; i++)
 					{
 						xllr_free_memory(strings[i]);
 					}
@@ -596,7 +841,7 @@ private:
 				case metaffi_string16_type:
 				{
 					auto* strings = static_cast<metaffi_string16*>(packed->data);
-					for(metaffi_size i = 0; i < packed->length; i++)
+					for(metaffi_size i = 0; !packed->is_string_blob && i < packed->length; i++)
 					{
 						xllr_free_memory(strings[i]);
 					}
@@ -606,7 +851,7 @@ private:
 				case metaffi_string32_type:
 				{
 					auto* strings = static_cast<metaffi_string32*>(packed->data);
-					for(metaffi_size i = 0; i < packed->length; i++)
+					for(metaffi_size i = 0; !packed->is_string_blob && i < packed->length; i++)
 					{
 						xllr_free_memory(strings[i]);
 					}
@@ -652,6 +897,14 @@ private:
 			packed->data = nullptr;
 		}
 
+		// the shape (and strides) are owned by the packed array, even if data is borrowed
+		if(packed->shape)
+		{
+			xllr_free_memory(packed->shape);
+			packed->shape = nullptr;
+			packed->strides = nullptr;
+		}
+
 		xllr_free_memory(packed);
 		cdt_val.packed_array_val = nullptr;
 	}
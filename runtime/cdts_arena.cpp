@@ -0,0 +1,102 @@
+#include "cdts_arena.h"
+#include <stdexcept>
+
+namespace metaffi::runtime
+{
+
+//--------------------------------------------------------------------
+cdts_arena::cdts_arena() : first{nullptr, inline_storage, inline_block_size}, current(&first), current_used(0), nested_head(nullptr)
+{
+}
+//--------------------------------------------------------------------
+cdts_arena::~cdts_arena()
+{
+	reset();
+
+	block* b = first.next;
+	while(b)
+	{
+		block* next = b->next;
+		xllr_free_memory(b);
+		b = next;
+	}
+	first.next = nullptr;
+}
+//--------------------------------------------------------------------
+cdts_arena& cdts_arena::thread_local_instance()
+{
+	thread_local cdts_arena arena;
+	return arena;
+}
+//--------------------------------------------------------------------
+cdts* cdts_arena::alloc_cdts(metaffi_size length, metaffi_int64 fixed_dimensions)
+{
+	auto* node = static_cast<nested_cdts*>(alloc(sizeof(nested_cdts), alignof(nested_cdts)));
+	node->prev = nested_head;
+	new (&node->value) cdts(alloc_cdt_array(length), length, fixed_dimensions, 1);
+	nested_head = node;
+
+	return &node->value;
+}
+//--------------------------------------------------------------------
+void cdts_arena::rewind(const marker& m)
+{
+	// destruct the elements of nested arrays allocated after the marker (newest first).
+	// arrays are allocated_on_cache, so cdts::free() does not delete the arena memory.
+	while(nested_head != m.nested)
+	{
+		nested_head->value.free();
+		nested_head = nested_head->prev;
+	}
+
+	current = m.blk;
+	current_used = m.used;
+}
+//--------------------------------------------------------------------
+void cdts_arena::reset()
+{
+	rewind(marker{&first, 0, nullptr});
+}
+//--------------------------------------------------------------------
+size_t cdts_arena::heap_blocks_count() const
+{
+	size_t count = 0;
+	for(block* b = first.next; b; b = b->next)
+	{
+		count++;
+	}
+	return count;
+}
+//--------------------------------------------------------------------
+void* cdts_arena::alloc_slow(size_t size, size_t alignment)
+{
+	// blocks start max_align_t aligned, so "size + alignment" always fits
+	size_t required = size + alignment;
+
+	// reuse the next block if it is large enough (kept from a previous rewind)
+	if(!current->next || current->next->capacity < required)
+	{
+		size_t capacity = required > default_block_size ? required : default_block_size;
+		void* mem = xllr_alloc_memory(sizeof(block) + alignof(std::max_align_t) + capacity);
+		if(!mem)
+		{
+			throw std::bad_alloc();
+		}
+
+		auto* b = static_cast<block*>(mem);
+		uintptr_t data_start = reinterpret_cast<uintptr_t>(b + 1);
+		data_start = (data_start + alignof(std::max_align_t) - 1) & ~(uintptr_t)(alignof(std::max_align_t) - 1);
+
+		b->data = reinterpret_cast<unsigned char*>(data_start);
+		b->capacity = capacity;
+		b->next = current->next;
+		current->next = b;
+	}
+
+	current = current->next;
+	current_used = 0;
+
+	return alloc(size, alignment);
+}
+//--------------------------------------------------------------------
+}
@@ -0,0 +1,190 @@
+#pragma once
+#include "cdt.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+namespace metaffi::runtime
+{
+
+/************************************************
+*   CDTS arena
+*************************************************/
+
+/**
+ * @brief Bump allocator for the CDTS frames of a single call.
+ *
+ * The cdt arrays, nested cdts, copied strings and packed buffers of a call are carved
+ * out of a few large blocks instead of one xllr_alloc_memory per item, and are released
+ * together by rewind()/reset(). Blocks are kept for reuse, so once warmed up, calls
+ * do not touch the allocator at all.
+ *
+ * Memory handed out by the arena is never freed by cdt/cdts:
+ * - cdt arrays are marked allocated_on_cache (elements are destructed, the array is not deleted).
+ * - strings, packed arrays and nested arrays are set with free_required = false.
+ * Nested cdts are tracked by the arena, so rewind() still destructs their elements
+ * (e.g. handles, or values a callee allocated into an arena frame).
+ *
+ * Not thread-safe. Use one arena per thread (see thread_local_instance()).
+ * Re-entrant calls on the same thread are supported by mark()/rewind() (see cdts_arena_scope).
+ */
+class cdts_arena
+{
+private:
+	struct block
+	{
+		block* next;
+		unsigned char* data;
+		size_t capacity;
+	};
+
+	struct nested_cdts
+	{
+		nested_cdts* prev;
+		cdts value;
+	};
+
+public:
+	static constexpr size_t inline_block_size = 4096;
+	static constexpr size_t default_block_size = 64 * 1024;
+
+	/**
+	 * @brief Position in the arena, used to release everything allocated after it.
+	 */
+	struct marker
+	{
+		block* blk;
+		size_t used;
+		nested_cdts* nested;
+	};
+
+	cdts_arena();
+	~cdts_arena();
+
+	cdts_arena(const cdts_arena&) = delete;
+	cdts_arena& operator=(const cdts_arena&) = delete;
+
+	/**
+	 * @brief Arena of the calling thread.
+	 */
+	static cdts_arena& thread_local_instance();
+
+	/**
+	 * @brief Allocate raw memory from the arena.
+	 */
+	void* alloc(size_t size, size_t alignment = alignof(std::max_align_t))
+	{
+		size_t offset = (current_used + alignment - 1) & ~(alignment - 1);
+		if(offset + size > current->capacity)
+		{
+			return alloc_slow(size, alignment);
+		}
+
+		current_used = offset + size;
+		return current->data + offset;
+	}
+
+	/**
+	 * @brief Allocate a default-constructed cdt array.
+	 * To be wrapped by a cdts with allocated_on_cache set.
+	 */
+	cdt* alloc_cdt_array(metaffi_size length)
+	{
+		if(length == 0)
+		{
+			return nullptr;
+		}
+
+		cdt* arr = static_cast<cdt*>(alloc(sizeof(cdt) * length, alignof(cdt)));
+		for(metaffi_size i = 0; i < length; i++)
+		{
+			new (&arr[i]) cdt();
+		}
+
+		return arr;
+	}
+
+	/**
+	 * @brief Allocate a nested cdts (struct and elements) whose elements are destructed on rewind.
+	 */
+	cdts* alloc_cdts(metaffi_size length, metaffi_int64 fixed_dimensions);
+
+	/**
+	 * @brief Copy a string (and its NULL terminator) into the arena.
+	 */
+	template<typename char_t>
+	char_t* copy_string(const char_t* str, size_t length)
+	{
+		char_t* res = static_cast<char_t*>(alloc((length + 1) * sizeof(char_t), alignof(char_t)));
+		if(length > 0)
+		{
+			std::memcpy(res, str, length * sizeof(char_t));
+		}
+		res[length] = 0;
+		return res;
+	}
+
+	/**
+	 * @brief Allocate a packed array header with an uninitialized buffer of length elements.
+	 */
+	cdt_packed_array* alloc_packed_array(metaffi_size length, size_t element_size, size_t element_alignment)
+	{
+		cdt_packed_array* packed = static_cast<cdt_packed_array*>(alloc(sizeof(cdt_packed_array), alignof(cdt_packed_array)));
+		packed->length = length;
+		packed->is_borrowed = 0;
+		packed->is_string_blob = 0;
+		packed->rank = 0;
+		packed->shape = nullptr;
+		packed->strides = nullptr;
+		packed->data = length > 0 ? alloc(length * element_size, element_alignment) : nullptr;
+		return packed;
+	}
+
+	[[nodiscard]] marker mark() const { return marker{current, current_used, nested_head}; }
+
+	/**
+	 * @brief Release everything allocated after m. Blocks are kept for reuse.
+	 */
+	void rewind(const marker& m);
+
+	/**
+	 * @brief Release everything allocated from the arena. Blocks are kept for reuse.
+	 */
+	void reset();
+
+	/**
+	 * @brief Count of blocks allocated with xllr_alloc_memory (excluding the inline block).
+	 */
+	[[nodiscard]] size_t heap_blocks_count() const;
+
+private:
+	void* alloc_slow(size_t size, size_t alignment);
+
+	block first;
+	block* current;
+	size_t current_used;
+	nested_cdts* nested_head;
+	alignas(std::max_align_t) unsigned char inline_storage[inline_block_size];
+};
+
+/**
+ * @brief RAII scope releasing everything allocated from the arena during its lifetime.
+ */
+class cdts_arena_scope
+{
+public:
+	explicit cdts_arena_scope(cdts_arena& arena) : arena(arena), start(arena.mark()) {}
+	~cdts_arena_scope() { arena.rewind(start); }
+
+	cdts_arena_scope(const cdts_arena_scope&) = delete;
+	cdts_arena_scope& operator=(const cdts_arena_scope&) = delete;
+
+	[[nodiscard]] cdts_arena& get() const { return arena; }
+
+private:
+	cdts_arena& arena;
+	cdts_arena::marker start;
+};
+
+}
@@ -0,0 +1,147 @@
+#include "cdts_cache.h"
+#include <new>
+#include <stdexcept>
+
+namespace metaffi::runtime
+{
+
+//--------------------------------------------------------------------
+cdts_cache::cdts_cache() : slots(reinterpret_cast<cdt*>(slots_storage)), slots_used(0), frames_used(0)
+{
+}
+//--------------------------------------------------------------------
+cdts_cache::~cdts_cache()
+{
+	for(auto& frame : frames)
+	{
+		frame[0].free();
+		frame[1].free();
+	}
+}
+//--------------------------------------------------------------------
+cdts_cache& cdts_cache::thread_local_instance()
+{
+	thread_local cdts_cache cache;
+	return cache;
+}
+//--------------------------------------------------------------------
+cdt* cdts_cache::acquire_cdt_array(metaffi_size length)
+{
+	if(length == 0 || length > cdt_cache_size - slots_used)
+	{
+		return nullptr;
+	}
+
+	cdt* arr = slots + slots_used;
+	for(metaffi_size i = 0; i < length; i++)
+	{
+		new (&arr[i]) cdt();
+	}
+
+	slots_used += length;
+	return arr;
+}
+//--------------------------------------------------------------------
+void cdts_cache::release_cdt_array(cdt* arr)
+{
+	if(!is_cached(arr))
+	{
+		return;
+	}
+
+	slots_used = static_cast<metaffi_size>(arr - slots);
+}
+//--------------------------------------------------------------------
+cdts* cdts_cache::acquire_frame()
+{
+	if(frames_used == cdts_cache_size)
+	{
+		return nullptr;
+	}
+
+	return frames[frames_used++];
+}
+//--------------------------------------------------------------------
+void cdts_cache::release_frame(cdts* frame)
+{
+	if(!is_cached(frame))
+	{
+		return;
+	}
+
+	frames_used = static_cast<metaffi_size>((frame - &frames[0][0]) / 2);
+}
+//--------------------------------------------------------------------
+cdts_frame::cdts_frame(metaffi_size params_count, metaffi_size retvals_count, bool cache_retvals)
+	: params_ret(nullptr), cached_params(nullptr), cached_retvals(nullptr), cached_frame(false)
+{
+	cdts_cache& cache = cdts_cache::thread_local_instance();
+
+	params_ret = cache.acquire_frame();
+	cached_frame = params_ret != nullptr;
+	if(!cached_frame)
+	{
+		params_ret = new cdts[2];
+	}
+
+	cached_params = cache.acquire_cdt_array(params_count);
+	if(cached_params)
+	{
+		params_ret[0] = cdts(cached_params, params_count, MIXED_OR_UNKNOWN_DIMENSIONS, 1);
+	}
+	else
+	{
+		params_ret[0] = cdts(params_count);
+	}
+
+	cached_retvals = cache_retvals ? cache.acquire_cdt_array(retvals_count) : nullptr;
+	if(cached_retvals)
+	{
+		params_ret[1] = cdts(cached_retvals, retvals_count, MIXED_OR_UNKNOWN_DIMENSIONS, 1);
+	}
+	else
+	{
+		params_ret[1] = cdts(retvals_count);
+	}
+}
+//--------------------------------------------------------------------
+cdts_frame::~cdts_frame()
+{
+	// destruct the elements (cached arrays are not deleted)
+	params_ret[0].free();
+	params_ret[1].free();
+
+	cdts_cache& cache = cdts_cache::thread_local_instance();
+
+	// release in reverse order of acquisition
+	if(cached_retvals)
+	{
+		cache.release_cdt_array(cached_retvals);
+	}
+
+	if(cached_params)
+	{
+		cache.release_cdt_array(cached_params);
+	}
+
+	if(cached_frame)
+	{
+		cache.release_frame(params_ret);
+	}
+	else
+	{
+		delete[] params_ret;
+	}
+}
+//--------------------------------------------------------------------
+cdts cdts_frame::detach_retvals()
+{
+	if(cached_retvals)
+	{
+		throw std::logic_error("Cannot detach return values allocated on the thread cache");
+	}
+
+	return std::move(params_ret[1]);
+}
+//--------------------------------------------------------------------
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include "cdt.h"
+
+namespace metaffi::runtime
+{
+
+/************************************************
+*   CDTS thread cache
+*************************************************/
+
+/**
+ * @brief Per-thread cache of cdt slots (cdt_cache_size) and cdts[2] frames (cdts_cache_size).
+ *
+ * Used to build the parameters/return values frames of calls whose arity fits
+ * the cache without touching the heap. Arrays taken from the cache are wrapped
+ * by cdts with allocated_on_cache set, so cdts::free() only destructs their elements.
+ *
+ * Slots and frames are handed out and released LIFO - a frame lives for the duration
+ * of a call, and re-entrant calls on the same thread nest within it.
+ * Use cdts_frame instead of calling acquire/release directly.
+ */
+class cdts_cache
+{
+public:
+	cdts_cache();
+	~cdts_cache();
+
+	cdts_cache(const cdts_cache&) = delete;
+	cdts_cache& operator=(const cdts_cache&) = delete;
+
+	/**
+	 * @brief Cache of the calling thread.
+	 */
+	static cdts_cache& thread_local_instance();
+
+	/**
+	 * @brief Take length default-constructed cdt slots.
+	 * @return nullptr if the cache does not have enough free slots.
+	 */
+	cdt* acquire_cdt_array(metaffi_size length);
+
+	/**
+	 * @brief Return slots taken by acquire_cdt_array (and every slot taken after them).
+	 * The elements must already be destructed (e.g. by cdts::free()).
+	 */
+	void release_cdt_array(cdt* arr);
+
+	/**
+	 * @brief Take a cdts[2] frame.
+	 * @return nullptr if all frames are in use.
+	 */
+	cdts* acquire_frame();
+
+	/**
+	 * @brief Return a frame taken by acquire_frame (and every frame taken after it).
+	 */
+	void release_frame(cdts* frame);
+
+	[[nodiscard]] bool is_cached(const cdt* arr) const { return arr >= slots && arr < slots + cdt_cache_size; }
+	[[nodiscard]] bool is_cached(const cdts* frame) const { return frame >= &frames[0][0] && frame < &frames[0][0] + (cdts_cache_size * 2); }
+
+	[[nodiscard]] metaffi_size free_slots() const { return cdt_cache_size - slots_used; }
+	[[nodiscard]] metaffi_size free_frames() const { return cdts_cache_size - frames_used; }
+
+private:
+	// raw storage - slots are constructed when acquired and destructed by their cdts
+	alignas(cdt) unsigned char slots_storage[sizeof(cdt) * cdt_cache_size];
+	cdt* slots;
+	metaffi_size slots_used;
+
+	cdts frames[cdts_cache_size][2];
+	metaffi_size frames_used;
+};
+
+/**
+ * @brief Parameters/return values frame (cdts[2]) for a single call.
+ *
+ * Taken from the thread's cdts_cache when the arity fits, otherwise allocated on the heap.
+ * The frame's elements are destructed when the frame is destroyed.
+ * Must be destroyed on the thread that created it, in reverse order of creation (i.e. scoped).
+ */
+class cdts_frame
+{
+public:
+	/**
+	 * @param params_count Parameters count
+	 * @param retvals_count Return values count
+	 * @param cache_retvals If false, return values are always heap allocated, so they can be detached and outlive the frame.
+	 */
+	cdts_frame(metaffi_size params_count, metaffi_size retvals_count, bool cache_retvals = true);
+	~cdts_frame();
+
+	cdts_frame(const cdts_frame&) = delete;
+	cdts_frame& operator=(const cdts_frame&) = delete;
+
+	/**
+	 * @brief The frame, as passed to xcall (params_ret[0] = parameters, params_ret[1] = return values)
+	 */
+	[[nodiscard]] cdts* get() const { return params_ret; }
+	[[nodiscard]] cdts& params() const { return params_ret[0]; }
+	[[nodiscard]] cdts& retvals() const { return params_ret[1]; }
+
+	/**
+	 * @brief Move the return values out of the frame.
+	 * @throws std::logic_error if the return values are on the thread cache.
+	 */
+	cdts detach_retvals();
+
+private:
+	cdts* params_ret;
+	cdt* cached_params;
+	cdt* cached_retvals;
+	bool cached_frame;
+};
+
+}
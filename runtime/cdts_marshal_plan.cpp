@@ -0,0 +1,198 @@
+#include "cdts_marshal_plan.h"
+#include <sstream>
+#include <stdexcept>
+
+namespace metaffi::runtime
+{
+
+//--------------------------------------------------------------------
+
+namespace
+{
+
+template<typename T>
+using scalar_getter = T (*)(const metaffi_size* index, metaffi_size index_size, void* context);
+
+template<typename T>
+using scalar_visitor = void (*)(const metaffi_size* index, metaffi_size index_size, T val, void* context);
+
+template<typename T, T cdt_types::* member, metaffi_type type, scalar_getter<T> construct_cdts_callbacks::* getter>
+void construct_scalar(cdt& item, const construct_cdts_callbacks& callbacks, const metaffi_type_info& /*type_info*/, std::vector<metaffi_size>& index)
+{
+	if(!callbacks.is_null) // nullability unknown - get_type_info decides (as construct_cdt does)
+	{
+		construct_cdt(item, callbacks, index);
+		return;
+	}
+
+	if(callbacks.is_null(index.data(), index.size(), callbacks.context))
+	{
+		item.type = metaffi_null_type;
+		item.free_required = false;
+		return;
+	}
+
+	item.cdt_val.*member = (callbacks.*getter)(index.data(), index.size(), callbacks.context);
+	item.type = type;
+	item.free_required = false;
+}
+
+template<typename T, T cdt_types::* member, metaffi_type type, scalar_visitor<T> traverse_cdts_callbacks::* visitor>
+void traverse_scalar(const cdt& item, const traverse_cdts_callbacks& callbacks, std::vector<metaffi_size>& index)
+{
+	if(item.type != type) // e.g. null - fall back to the dynamic traversal
+	{
+		traverse_cdt(item, callbacks, index);
+		return;
+	}
+
+	(callbacks.*visitor)(index.data(), index.size(), item.cdt_val.*member, callbacks.context);
+}
+
+void construct_known(cdt& item, const construct_cdts_callbacks& callbacks, const metaffi_type_info& type_info, std::vector<metaffi_size>& index)
+{
+	construct_cdt(item, callbacks, index, type_info);
+}
+
+void construct_dynamic(cdt& item, const construct_cdts_callbacks& callbacks, const metaffi_type_info& /*type_info*/, std::vector<metaffi_size>& index)
+{
+	construct_cdt(item, callbacks, index);
+}
+
+void traverse_dynamic(const cdt& item, const traverse_cdts_callbacks& callbacks, std::vector<metaffi_size>& index)
+{
+	traverse_cdt(item, callbacks, index);
+}
+
+#define scalar_ops(name) \
+	case metaffi_##name##_type: \
+		construct = &construct_scalar<decltype(cdt_types::name##_val), &cdt_types::name##_val, metaffi_##name##_type, &construct_cdts_callbacks::get_##name>; \
+		traverse = &traverse_scalar<decltype(cdt_types::name##_val), &cdt_types::name##_val, metaffi_##name##_type, &traverse_cdts_callbacks::on_##name>; \
+		return true;
+
+// Selects the direct ops of a scalar type. Returns false if type is not a scalar type.
+template<typename construct_op, typename traverse_op>
+bool select_scalar_ops(metaffi_type type, construct_op& construct, traverse_op& traverse)
+{
+	switch(type)
+	{
+		scalar_ops(float64)
+		scalar_ops(float32)
+		scalar_ops(int8)
+		scalar_ops(uint8)
+		scalar_ops(int16)
+		scalar_ops(uint16)
+		scalar_ops(int32)
+		scalar_ops(uint32)
+		scalar_ops(int64)
+		scalar_ops(uint64)
+		scalar_ops(bool)
+		scalar_ops(char8)
+		scalar_ops(char16)
+		scalar_ops(char32)
+
+		default:
+			return false;
+	}
+}
+
+#undef scalar_ops
+
+}
+
+//--------------------------------------------------------------------
+cdts_marshal_plan::cdts_marshal_plan(const metaffi_type_info* types, metaffi_size types_length)
+{
+	ops.reserve(types_length);
+
+	for(metaffi_size i = 0 ; i < types_length ; i++)
+	{
+		op current{};
+
+		// the plan does not own (or need) the alias
+		current.type = metaffi_type_info(types[i].type, nullptr, false, types[i].fixed_dimensions);
+		current.is_static = false;
+
+		if(types[i].type == metaffi_any_type)
+		{
+			current.construct = &construct_dynamic;
+			current.traverse = &traverse_dynamic;
+		}
+		else if(types[i].fixed_dimensions <= 0 && select_scalar_ops(types[i].type, current.construct, current.traverse))
+		{
+			current.is_static = true;
+		}
+		else
+		{
+			current.construct = &construct_known;
+			current.traverse = &traverse_dynamic;
+		}
+
+		ops.emplace_back(std::move(current));
+	}
+}
+//--------------------------------------------------------------------
+cdts_marshal_plan::cdts_marshal_plan(const std::vector<metaffi_type_info>& types) : cdts_marshal_plan(types.data(), static_cast<metaffi_size>(types.size()))
+{
+}
+//--------------------------------------------------------------------
+void cdts_marshal_plan::construct(cdts& arr, const construct_cdts_callbacks& callbacks) const
+{
+	if(arr.length == 0)
+	{
+		if(ops.empty())
+		{
+			return;
+		}
+
+		arr.length = ops.size();
+		delete[] arr.arr;
+		
+		arr.arr = new cdt[arr.length]{};
+	}
+	else if(arr.length != ops.size())
+	{
+		std::stringstream ss;
+		ss << "CDTS length " << arr.length << " does not match the marshaling plan size " << ops.size();
+		throw std::invalid_argument(ss.str());
+	}
+
+	std::vector<metaffi_size> index(1);
+	for(metaffi_size i = 0 ; i < arr.length ; i++)
+	{
+		index[0] = i;
+		ops[i].construct(arr.arr[i], callbacks, ops[i].type, index);
+	}
+}
+//--------------------------------------------------------------------
+void cdts_marshal_plan::traverse(const cdts& arr, const traverse_cdts_callbacks& callbacks) const
+{
+	if(arr.length != ops.size())
+	{
+		std::stringstream ss;
+		ss << "CDTS length " << arr.length << " does not match the marshaling plan size " << ops.size();
+		throw std::invalid_argument(ss.str());
+	}
+
+	std::vector<metaffi_size> index(1);
+	for(metaffi_size i = 0 ; i < arr.length ; i++)
+	{
+		index[0] = i;
+		ops[i].traverse(arr.arr[i], callbacks, index);
+	}
+}
+//--------------------------------------------------------------------
+metaffi_size cdts_marshal_plan::static_ops_count() const
+{
+	metaffi_size count = 0;
+	for(const op& current : ops)
+	{
+		if(current.is_static)
+		{
+			count++;
+		}
+	}
+	return count;
+}
+//--------------------------------------------------------------------
+}
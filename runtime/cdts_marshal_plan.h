@@ -0,0 +1,70 @@
+#pragma once
+#include "cdt.h"
+#include "cdts_traverse_construct.h"
+#include <vector>
+
+namespace metaffi::runtime
+{
+
+/************************************************
+*   CDTS marshaling plan
+*************************************************/
+
+/**
+ * @brief Construct/traverse plan of the root elements of a CDTS, compiled from an entity's signature.
+ *
+ * Each root position is compiled once into an op:
+ * - statically typed scalars/chars call their construct/traverse callback directly,
+ *   without get_type_info and without switching on the type.
+ *   Construction checks the plugin's is_null callback first, so null values become metaffi_null_type CDTs.
+ *   If the plugin does not set is_null, these positions are constructed dynamically.
+ * - other concrete types (strings, arrays, handles, ...) are constructed with their known type,
+ *   so get_type_info is not called for the root element.
+ * - metaffi_any_type positions are constructed and traversed dynamically (as construct_cdt/traverse_cdt do).
+ *
+ * A plan is immutable once built, so a single plan can be shared by all the calls of an xcall
+ * (e.g. stored next to the xcall's context when the entity is loaded) and used concurrently.
+ */
+class cdts_marshal_plan
+{
+public:
+	cdts_marshal_plan() = default;
+	cdts_marshal_plan(const metaffi_type_info* types, metaffi_size types_length);
+	explicit cdts_marshal_plan(const std::vector<metaffi_type_info>& types);
+
+	/**
+	 * @brief Fill arr using callbacks. If arr is empty, it is allocated with size() elements.
+	 * @throws std::invalid_argument if arr is not empty and its length is not size().
+	 */
+	void construct(cdts& arr, const construct_cdts_callbacks& callbacks) const;
+
+	/**
+	 * @brief Traverse arr using callbacks.
+	 * Elements whose type differs from the plan's type (e.g. metaffi_null_type) are traversed dynamically.
+	 * @throws std::invalid_argument if the length of arr is not size().
+	 */
+	void traverse(const cdts& arr, const traverse_cdts_callbacks& callbacks) const;
+
+	[[nodiscard]] metaffi_size size() const { return static_cast<metaffi_size>(ops.size()); }
+
+	/**
+	 * @brief Count of root positions compiled into direct scalar ops.
+	 */
+	[[nodiscard]] metaffi_size static_ops_count() const;
+
+private:
+	typedef void (*construct_op)(cdt& item, const construct_cdts_callbacks& callbacks, const metaffi_type_info& type, std::vector<metaffi_size>& index);
+	typedef void (*traverse_op)(const cdt& item, const traverse_cdts_callbacks& callbacks, std::vector<metaffi_size>& index);
+
+	struct op
+	{
+		metaffi_type_info type;
+		construct_op construct;
+		traverse_op traverse;
+		bool is_static;
+	};
+
+	std::vector<op> ops;
+};
+
+}
@@ -1,8 +1,19 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 
 #include "../utils/scope_guard.hpp"
+#include "cdts_arena.h"
+#include "cdts_cache.h"
+#include "cdts_marshal_plan.h"
+#include "memory_pool.h"
 #include "cdts_traverse_construct.h"
+#include "packed_string_blob.h"
+#include "packed_tensor.h"
 #include <doctest/doctest.h>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -16,6 +27,85 @@
 
 using namespace metaffi::runtime;
 
+// Counts global operator new calls made by the current thread while counting is enabled
+// (used to verify allocation-free code paths).
+static thread_local bool count_allocations = false;
+static thread_local size_t allocations_count = 0;
+
+void* operator new(std::size_t size)
+{
+	if(count_allocations)
+	{
+		allocations_count++;
+	}
+	
+	void* p = std::malloc(size ? size : 1);
+	if(!p)
+	{
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+struct traverse_benchmark_context
+{
+	metaffi_size leaves = 0;
+	metaffi_size max_depth = 0;
+	metaffi_int64 sum = 0;
+};
+
+// Traverses a rows x cols int32 matrix (nested CDTS arrays), returns the allocations made by the traversal
+static size_t traverse_matrix_allocations(metaffi_size rows, metaffi_size cols)
+{
+	cdts root(1);
+	root[0].set_new_array(rows, 2, metaffi_int32_type);
+	cdts& matrix = static_cast<cdts&>(root[0]);
+	for(metaffi_size r = 0; r < rows; r++)
+	{
+		matrix[r].set_new_array(cols, 1, metaffi_int32_type);
+		cdts& row = static_cast<cdts&>(matrix[r]);
+		for(metaffi_size c = 0; c < cols; c++)
+		{
+			row[c] = (metaffi_int32)(r + c);
+		}
+	}
+	
+	traverse_benchmark_context ctx;
+	traverse_cdts_callbacks tcb(&ctx);
+	tcb.on_array = [](const metaffi_size* index, metaffi_size index_size, const cdts& val, metaffi_int64 fixed_dimensions, metaffi_type common_type, void* context) -> metaffi_bool {
+		return true;
+	};
+	tcb.on_int32 = [](const metaffi_size* index, metaffi_size index_size, metaffi_int32 val, void* context) {
+		auto* ctx = static_cast<traverse_benchmark_context*>(context);
+		ctx->leaves++;
+		ctx->sum += val;
+		ctx->max_depth = index_size > ctx->max_depth ? index_size : ctx->max_depth;
+	};
+	
+	traverse_cdts(root, tcb); // warm up
+	
+	ctx = traverse_benchmark_context();
+	
+	allocations_count = 0;
+	count_allocations = true;
+	auto start = std::chrono::steady_clock::now();
+	traverse_cdts(root, tcb);
+	auto end = std::chrono::steady_clock::now();
+	count_allocations = false;
+	
+	REQUIRE(ctx.leaves == rows * cols);
+	REQUIRE(ctx.max_depth == 3);
+	
+	auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+	MESSAGE("traverse " << rows << "x" << cols << ": " << allocations_count << " allocations, "
+	        << (double)ns / (double)(rows * cols) << " ns/element");
+	
+	return allocations_count;
+}
+
 TEST_SUITE("CDTS Tests")
 {
 	TEST_CASE("MetaFFI primitives")
@@ -467,6 +557,98 @@ TEST_SUITE("CDTS Tests")
 		traverse_cdts(arr, tcb);
 	}
 	//--------------------------------------------------------------------
+	TEST_CASE("1D array range getters")
+	{
+		struct range_context
+		{
+			std::vector<metaffi_int32> ints;
+			std::vector<std::u8string> strings;
+			int range_calls = 0;
+			int type_info_calls = 0;
+			metaffi_size next_start = 0;
+		};
+		
+		// large enough to be requested in several ranges
+		range_context ctx;
+		for(metaffi_int32 i = 0; i < 3000; i++)
+		{
+			ctx.ints.push_back(i * 3);
+		}
+		ctx.strings = {u8"one", u8"two", u8"three"};
+		
+		cdts arr;
+		
+		construct_cdts_callbacks ccb = {};
+		ccb.context = &ctx;
+		ccb.get_root_elements_count = [](void* context) -> metaffi_size {
+			return 2;
+		};
+		
+		ccb.get_type_info = [](const metaffi_size* index, metaffi_size index_length, void* context) -> metaffi_type_info {
+			static_cast<range_context*>(context)->type_info_calls++;
+			REQUIRE(index_length == 1);
+			return {index[0] == 0 ? (metaffi_int32_type | metaffi_array_type) : (metaffi_string8_type | metaffi_array_type), nullptr};
+		};
+		
+		ccb.get_array_metadata = [](const metaffi_size* index, metaffi_size index_length, metaffi_bool* is_fixed_dimension,
+		                            metaffi_bool* is_1d_array, metaffi_type* common_type, metaffi_bool* is_manually_construct_array, void* context) -> metaffi_size {
+			auto* ctx = static_cast<range_context*>(context);
+			*is_fixed_dimension = 1;
+			*is_1d_array = 1;
+			return index[0] == 0 ? ctx->ints.size() : ctx->strings.size();
+		};
+		
+		// per-element getters are not set - construct_cdt must use the range getters
+		ccb.get_int32_range = [](const metaffi_size* index, metaffi_size index_size, metaffi_size start, metaffi_size count, metaffi_int32* out, void* context) {
+			auto* ctx = static_cast<range_context*>(context);
+			ctx->range_calls++;
+			REQUIRE(index_size == 1);
+			REQUIRE(index[0] == 0);
+			REQUIRE(start == ctx->next_start);
+			REQUIRE(count > 0);
+			REQUIRE(start + count <= ctx->ints.size());
+			std::copy(ctx->ints.begin() + start, ctx->ints.begin() + start + count, out);
+			ctx->next_start = start + count;
+		};
+		
+		ccb.get_string8_range = [](const metaffi_size* index, metaffi_size index_size, metaffi_size start, metaffi_size count, metaffi_string8* out, metaffi_bool* is_free_required, void* context) {
+			auto* ctx = static_cast<range_context*>(context);
+			ctx->range_calls++;
+			REQUIRE(index_size == 1);
+			REQUIRE(index[0] == 1);
+			REQUIRE(count == ctx->strings.size());
+			for(metaffi_size i = 0; i < count; i++)
+			{
+				out[i] = (metaffi_string8)ctx->strings[start + i].c_str();
+			}
+			*is_free_required = false;
+		};
+		
+		construct_cdts(arr, ccb);
+		
+		REQUIRE(ctx.range_calls > 2);
+		REQUIRE(ctx.next_start == ctx.ints.size());
+		REQUIRE(ctx.type_info_calls == 2);
+		
+		REQUIRE(arr[0].type == (metaffi_int32_type | metaffi_array_type));
+		cdts& ints = static_cast<cdts&>(arr[0]);
+		REQUIRE(ints.fixed_dimensions == 1);
+		REQUIRE(ints.length == 3000);
+		for(metaffi_size i = 0; i < ints.length; i++)
+		{
+			REQUIRE(ints[i].type == metaffi_int32_type);
+			REQUIRE(ints[i].cdt_val.int32_val == (metaffi_int32)(i * 3));
+		}
+		
+		REQUIRE(arr[1].type == (metaffi_string8_type | metaffi_array_type));
+		cdts& strings = static_cast<cdts&>(arr[1]);
+		REQUIRE(strings.fixed_dimensions == 1);
+		REQUIRE(strings.length == 3);
+		REQUIRE(strings[2].type == metaffi_string8_type);
+		REQUIRE(!strings[2].free_required);
+		REQUIRE(std::u8string(strings[2].cdt_val.string8_val) == u8"three");
+	}
+	//--------------------------------------------------------------------
 	TEST_CASE("ragged array")
 	{
 		auto init_4d_ragged_c_array = []() -> metaffi_int32**** {
@@ -946,6 +1128,225 @@ TEST_SUITE("CDTS Tests")
 		// Destructor exercises free_packed_array() with string cleanup
 	}
 	
+	TEST_CASE("borrowed packed array")
+	{
+		std::vector<metaffi_int32> values = {1, 2, 3, 4};
+		{
+			cdt item;
+			item.set_borrowed_packed_array(values.data(), values.size(), metaffi_int32_type);
+
+			REQUIRE(item.type == metaffi_int32_packed_array_type);
+			REQUIRE(item.free_required);
+
+			cdt_packed_array* packed = item.get_packed_array();
+			REQUIRE(packed->data == values.data());
+			REQUIRE(packed->length == 4);
+			REQUIRE(packed->is_borrowed);
+
+			// destructor frees only the packed array header
+		}
+
+		REQUIRE(values == std::vector<metaffi_int32>{1, 2, 3, 4});
+	}
+	
+	TEST_CASE("packed tensor")
+	{
+		metaffi_size shape[] = {2, 3};
+		cdts arr(1);
+		{
+			cdt_packed_array* packed = alloc_packed_tensor(2, shape, sizeof(metaffi_int32));
+			arr[0].set_packed_array(packed, metaffi_int32_type);
+			
+			REQUIRE(metaffi_packed_is_tensor(packed));
+			REQUIRE(packed->length == 6);
+			REQUIRE(packed->shape != shape);
+			REQUIRE(packed->strides == nullptr);
+			REQUIRE(packed_rank(packed) == 2);
+			REQUIRE(packed_extent(packed, 1) == 3);
+			
+			auto* values = static_cast<metaffi_int32*>(packed->data);
+			for(metaffi_int32 i = 0; i < 6; i++)
+			{
+				values[i] = i;
+			}
+			
+			metaffi_size index[] = {1, 2};
+			REQUIRE(packed_element_offset(packed, index) == 5);
+		}
+		
+		// traversal hands the tensor to on_packed_array
+		traverse_cdts_callbacks tcb;
+		tcb.on_packed_array = [](const metaffi_size* index, metaffi_size index_size, const cdt_packed_array* val, metaffi_type element_type, void* context) {
+			REQUIRE(element_type == metaffi_int32_type);
+			REQUIRE(val->rank == 2);
+			REQUIRE(val->shape[0] == 2);
+		};
+		traverse_cdts(arr, tcb);
+		
+		// a 1D packed array is rank 1
+		cdt_packed_array flat(nullptr, 4);
+		REQUIRE(packed_rank(&flat) == 1);
+		REQUIRE(packed_extent(&flat, 0) == 4);
+		REQUIRE(packed_element_size(metaffi_float64_type) == 8);
+		REQUIRE(packed_element_size(metaffi_string8_type) == 0);
+	}
+	
+	TEST_CASE("strided packed tensor")
+	{
+		// 3x2 transposed view of a row-major 2x3 matrix
+		std::vector<metaffi_float64> matrix = {1, 2, 3, 4, 5, 6};
+		metaffi_size shape[] = {3, 2};
+		metaffi_int64 strides[] = {1, 3};
+		
+		cdt_packed_array view(matrix.data(), 0, true);
+		std::vector<unsigned char> shape_buffer(metaffi_packed_shape_size(2, true));
+		set_packed_shape(&view, shape_buffer.data(), 2, shape, strides);
+		
+		REQUIRE(view.length == 6);
+		REQUIRE(view.strides[1] == 3);
+		REQUIRE_FALSE(packed_is_contiguous(&view));
+		
+		metaffi_size index[] = {2, 1};
+		REQUIRE(packed_element_offset(&view, index) == 5);
+		
+		std::vector<metaffi_float64> transposed(6);
+		copy_packed_elements(&view, sizeof(metaffi_float64), transposed.data());
+		REQUIRE(transposed == std::vector<metaffi_float64>{1, 4, 2, 5, 3, 6});
+		
+		// row-major strides are contiguous
+		metaffi_int64 row_major[] = {2, 1};
+		set_packed_shape(&view, shape_buffer.data(), 2, shape, row_major);
+		REQUIRE(packed_is_contiguous(&view));
+		
+		// the shape allocation is freed with the packed array, even if data is borrowed
+		cdt item;
+		item.set_borrowed_packed_array(matrix.data(), 0, metaffi_float64_type);
+		alloc_packed_shape(item.get_packed_array(), 2, shape, strides);
+		REQUIRE(item.get_packed_array()->length == 6);
+	}
+	
+	TEST_CASE("packed string blob")
+	{
+		const char16_t* sources[] = {u"hello", u"", nullptr, u"blob"};
+		metaffi_size total_length = 5 + 0 + 4;
+
+		cdt item;
+		cdt_packed_array* packed = alloc_packed_string_blob<char16_t>(4, total_length);
+		REQUIRE(packed->is_string_blob);
+
+		packed_string_blob_writer<char16_t> writer(packed->data, 4);
+		for(const char16_t* src : sources)
+		{
+			if(src)
+			{
+				writer.append(src, std::char_traits<char16_t>::length(src));
+			}
+			else
+			{
+				writer.append_null();
+			}
+		}
+		item.set_packed_array(packed, metaffi_string16_type);
+
+		auto* strings = static_cast<metaffi_string16*>(packed->data);
+		REQUIRE(std::u16string(strings[0]) == u"hello");
+		REQUIRE(std::u16string(strings[1]).empty());
+		REQUIRE(strings[2] == nullptr);
+		REQUIRE(std::u16string(strings[3]) == u"blob");
+
+		REQUIRE(packed_string_length<char16_t>(packed, 0) == 5);
+		REQUIRE(packed_string_length<char16_t>(packed, 1) == 0);
+		REQUIRE(packed_string_length<char16_t>(packed, 2) == 0);
+		REQUIRE(packed_string_length<char16_t>(packed, 3) == 4);
+		REQUIRE(metaffi_string_blob_offsets(packed)[4] == total_length + 3); // 3 NULL terminators
+
+		// strings are in the blob - the destructor frees the blob and the header only
+	}
+	
+	TEST_CASE("sized string")
+	{
+		const char8_t source[] = u8"a string with\0an embedded NULL";
+		const metaffi_size length = sizeof(source) - 1;
+
+		cdt item;
+		item.set_string(source, length, true);
+		REQUIRE(item.has_length);
+		REQUIRE(item.cdt_val.sized_string_val.length == length);
+		REQUIRE(item.cdt_val.string8_val != source);
+		REQUIRE(item.cdt_val.string8_val[length] == 0); // copies are NULL terminated
+
+		std::u8string_view view = item.get_string8_view();
+		REQUIRE(view.size() == length);
+		REQUIRE(view == std::u8string_view(source, length));
+
+		// NULL terminated strings fall back to their terminator
+		cdt unsized;
+		unsized.set_string(u"no length", false);
+		REQUIRE(!unsized.has_length);
+		REQUIRE(unsized.get_string16_view() == u"no length");
+
+		cdt empty;
+		empty.set_string(static_cast<const char32_t*>(nullptr), false);
+		REQUIRE(empty.get_string32_view().empty());
+
+		item.free();
+		REQUIRE(!item.has_length);
+	}
+
+	TEST_CASE("small string")
+	{
+		cdt item;
+		item.set_string(u8"key\0id", 6, true);
+		REQUIRE(item.type == metaffi_string8_type);
+		REQUIRE(item.is_small_string);
+		REQUIRE(!item.free_required);
+		REQUIRE(item.get_string8_view() == std::u8string_view(u8"key\0id", 6));
+		REQUIRE(metaffi_cdt_string8(&item) == item.cdt_val.small_string_val.string8);
+		REQUIRE(metaffi_cdt_string_length(&item) == 6);
+
+		// capacity: 15 (string8), 7 (string16) and 3 (string32) code units
+		cdt largest8(std::u8string_view(u8"0123456789abcde"), true);
+		cdt too_large8(std::u8string_view(u8"0123456789abcdef"), true);
+		REQUIRE(largest8.is_small_string);
+		REQUIRE(largest8.cdt_val.small_string_val.string8[15] == 0);
+		REQUIRE(!too_large8.is_small_string);
+		REQUIRE(too_large8.get_string8_view() == u8"0123456789abcdef");
+
+		cdt largest16(u"0123456", true);
+		cdt too_large16(u"01234567", true);
+		REQUIRE(largest16.is_small_string);
+		REQUIRE(!too_large16.is_small_string);
+		REQUIRE(std::u16string(static_cast<metaffi_string16>(largest16)) == u"0123456");
+
+		cdt largest32(U"012", true);
+		cdt too_large32(U"0123", true);
+		REQUIRE(largest32.is_small_string);
+		REQUIRE(!too_large32.is_small_string);
+		REQUIRE(largest32.get_string32_view() == U"012");
+
+		// moves keep the inline string
+		cdts arr(1);
+		arr.set(0, std::move(item));
+		REQUIRE(!item.is_small_string);
+		REQUIRE(arr[0].is_small_string);
+		REQUIRE(arr[0].get_string8_view() == std::u8string_view(u8"key\0id", 6));
+
+		// traversal passes the inline string
+		traverse_cdts_callbacks tcb{};
+		std::u8string visited;
+		tcb.context = &visited;
+		tcb.on_string8 = [](const metaffi_size*, metaffi_size, metaffi_string8 val, void* context) {
+			*static_cast<std::u8string*>(context) = val;
+		};
+		traverse_cdts(arr, tcb);
+		REQUIRE(visited == u8"key");
+
+		// re-setting as a non-inline string clears the flag
+		arr[0].set_string(u8"borrowed", false);
+		REQUIRE(!arr[0].is_small_string);
+		REQUIRE(arr[0].get_string8_view() == u8"borrowed");
+	}
+
 	TEST_CASE("packed type macros")
 	{
 		// Test the helper macros
@@ -982,4 +1383,358 @@ TEST_SUITE("CDTS Tests")
 		metaffi_type_to_str(metaffi_handle_packed_array_type, str);
 		REQUIRE(std::string(str) == "metaffi_handle_packed_array");
 	}
+	
+	TEST_CASE("arena frame")
+	{
+		cdts_arena arena;
+		
+		{
+			cdts_arena_scope scope(arena);
+			
+			cdts params(arena.alloc_cdt_array(3), 3, MIXED_OR_UNKNOWN_DIMENSIONS, 1);
+			params[0] = (metaffi_int32)7;
+			params[1].set_string(arena.copy_string(u8"arena string", 12), false);
+			
+			cdts* nested = arena.alloc_cdts(2, 1);
+			params[2].set_array(nested, metaffi_string8_type);
+			params[2].free_required = false;
+			
+			// element owned by the nested array (not by the arena) - destructed on rewind
+			(*nested)[0].set_string(u8"owned", true);
+			(*nested)[1].set_string(arena.copy_string(u8"borrowed", 8), false);
+			
+			REQUIRE(params[0].cdt_val.int32_val == 7);
+			REQUIRE(std::strcmp((const char*)params[1].cdt_val.string8_val, "arena string") == 0);
+			REQUIRE(std::strcmp((const char*)(*nested)[1].cdt_val.string8_val, "borrowed") == 0);
+		}
+		
+		REQUIRE(arena.mark().used == 0);
+		
+		// re-entrant scopes release only their own allocations
+		cdts_arena::marker outer = arena.mark();
+		void* outer_alloc = arena.alloc(64);
+		{
+			cdts_arena_scope inner(arena);
+			
+			// larger than the inline block - spills to a heap block
+			cdt_packed_array* packed = arena.alloc_packed_array(100000, sizeof(metaffi_float64), alignof(metaffi_float64));
+			REQUIRE(packed->length == 100000);
+			REQUIRE(packed->data != nullptr);
+			static_cast<metaffi_float64*>(packed->data)[99999] = 1.5;
+			REQUIRE(arena.heap_blocks_count() == 1);
+		}
+		REQUIRE(arena.mark().blk == outer.blk);
+		REQUIRE(arena.alloc(64) != outer_alloc);
+		
+		arena.rewind(outer);
+		
+		// heap blocks are kept for reuse
+		{
+			cdts_arena_scope scope(arena);
+			arena.alloc_packed_array(100000, sizeof(metaffi_float64), alignof(metaffi_float64));
+			REQUIRE(arena.heap_blocks_count() == 1);
+		}
+	}
+	
+	TEST_CASE("thread cache frame")
+	{
+		cdts_cache& cache = cdts_cache::thread_local_instance();
+		REQUIRE(cache.free_slots() == cdt_cache_size);
+		REQUIRE(cache.free_frames() == cdts_cache_size);
+		
+		{
+			cdts_frame frame(2, 1);
+			REQUIRE(cache.is_cached(frame.get()));
+			REQUIRE(cache.is_cached(frame.params().arr));
+			REQUIRE(cache.is_cached(frame.retvals().arr));
+			REQUIRE(frame.params().allocated_on_cache);
+			REQUIRE(cache.free_slots() == cdt_cache_size - 3);
+			
+			frame.params()[0] = (metaffi_int32)1;
+			frame.params()[1].set_string(u8"owned by the frame", true);
+			
+			{
+				// re-entrant call on the same thread
+				cdts_frame nested(1, 1);
+				REQUIRE(cache.free_slots() == cdt_cache_size - 5);
+				REQUIRE(cache.free_frames() == cdts_cache_size - 2);
+			}
+			
+			REQUIRE(cache.free_slots() == cdt_cache_size - 3);
+			REQUIRE(cache.free_frames() == cdts_cache_size - 1);
+		}
+		
+		REQUIRE(cache.free_slots() == cdt_cache_size);
+		REQUIRE(cache.free_frames() == cdts_cache_size);
+		
+		// arity larger than the cache falls back to the heap
+		{
+			cdts_frame frame(cdt_cache_size + 1, 0);
+			REQUIRE_FALSE(cache.is_cached(frame.params().arr));
+			REQUIRE_FALSE(frame.params().allocated_on_cache);
+			REQUIRE(frame.params().length == cdt_cache_size + 1);
+		}
+		
+		// return values that outlive the frame
+		cdts retvals;
+		{
+			cdts_frame frame(1, 1, false);
+			REQUIRE_FALSE(cache.is_cached(frame.retvals().arr));
+			frame.retvals()[0] = (metaffi_int64)42;
+			retvals = frame.detach_retvals();
+		}
+		REQUIRE(retvals[0].cdt_val.int64_val == 42);
+		
+		{
+			cdts_frame frame(1, 1);
+			REQUIRE_THROWS(frame.detach_retvals());
+		}
+		
+		REQUIRE(cache.free_slots() == cdt_cache_size);
+	}
+	
+	TEST_CASE("memory pool")
+	{
+		bool was_pooling = memory_pool::is_pooling();
+		metaffi::utils::scope_guard restore([was_pooling](){ memory_pool::set_pooling(was_pooling); });
+		
+		memory_pool::set_pooling(false);
+		memory_pool_stats before = memory_pool::stats();
+		void* unpooled = memory_pool::allocate(64);
+		REQUIRE(unpooled != nullptr);
+		REQUIRE(reinterpret_cast<uintptr_t>(unpooled) % 16 == 0);
+		REQUIRE(memory_pool::stats().pooled_allocations == before.pooled_allocations);
+		
+		memory_pool::set_pooling(true);
+		REQUIRE(memory_pool::is_pooling());
+		
+		// every size class, and a request too large to pool
+		std::vector<void*> blocks;
+		for(uint64_t size : {1, 16, 17, 100, 1000, 4096, 4097, 100000})
+		{
+			auto* p = static_cast<unsigned char*>(memory_pool::allocate(size));
+			REQUIRE(p != nullptr);
+			REQUIRE(reinterpret_cast<uintptr_t>(p) % 16 == 0);
+			std::memset(p, 0xAB, size);
+			blocks.push_back(p);
+		}
+		
+		memory_pool_stats after_alloc = memory_pool::stats();
+		REQUIRE(after_alloc.allocations - before.allocations == 9);
+		REQUIRE(after_alloc.pooled_allocations - before.pooled_allocations == 6);
+		REQUIRE(after_alloc.reserved_bytes > 0);
+		
+		// freed blocks are reused by the same thread
+		void* reused = blocks[4];
+		memory_pool::deallocate(reused);
+		REQUIRE(memory_pool::allocate(1000) == reused);
+		
+		// blocks allocated while not pooling are released to malloc after switching
+		memory_pool::deallocate(unpooled);
+		for(void* p : blocks)
+		{
+			memory_pool::deallocate(p);
+		}
+		memory_pool::deallocate(nullptr);
+		
+		// freed by another thread, reclaimed by the allocating thread
+		void* remote = memory_pool::allocate(256);
+		uint64_t remote_frees = memory_pool::stats().remote_frees;
+		std::thread([remote](){ memory_pool::deallocate(remote); }).join();
+		REQUIRE(memory_pool::stats().remote_frees == remote_frees + 1);
+		
+		void* drained = memory_pool::allocate(256);
+		REQUIRE(drained == remote);
+		memory_pool::deallocate(drained);
+		
+		// allocated by a thread that exited, freed here
+		void* orphaned = nullptr;
+		std::thread([&orphaned](){ orphaned = memory_pool::allocate(32); }).join();
+		REQUIRE(orphaned != nullptr);
+		memory_pool::deallocate(orphaned);
+		
+		memory_pool_stats after = memory_pool::stats();
+		REQUIRE(after.allocations - before.allocations == after.frees - before.frees);
+	}
+	
+	TEST_CASE("traverse allocations do not depend on array size")
+	{
+		size_t small = traverse_matrix_allocations(10, 10);
+		size_t large = traverse_matrix_allocations(1000, 1000);
+		
+		REQUIRE(small == 0);
+		REQUIRE(large == small);
+	}
+
+	TEST_CASE("re-entrant traverse keeps the outer index valid")
+	{
+		// outer: 2x2 int32 matrix. inner: 64 nested arrays deep, enough to grow any stack the outer shares
+		cdts outer(1);
+		outer[0].set_new_array(2, 2, metaffi_int32_type);
+		cdts& matrix = static_cast<cdts&>(outer[0]);
+		for(metaffi_size r = 0; r < 2; r++)
+		{
+			matrix[r].set_new_array(2, 1, metaffi_int32_type);
+			static_cast<cdts&>(matrix[r])[0] = (metaffi_int32)(r * 2);
+			static_cast<cdts&>(matrix[r])[1] = (metaffi_int32)(r * 2 + 1);
+		}
+
+		cdts inner(1);
+		cdt* deepest = &inner[0];
+		for(int depth = 0; depth < 64; depth++)
+		{
+			deepest->set_new_array(1, MIXED_OR_UNKNOWN_DIMENSIONS, metaffi_any_type);
+			deepest = &static_cast<cdts&>(*deepest)[0];
+		}
+		*deepest = (metaffi_int64)7;
+
+		struct reentry_context
+		{
+			cdts* inner;
+			traverse_cdts_callbacks* callbacks;
+			metaffi_size inner_leaves = 0;
+			bool index_intact = true;
+		} ctx{&inner};
+
+		traverse_cdts_callbacks tcb(&ctx);
+		ctx.callbacks = &tcb;
+		tcb.on_array = [](const metaffi_size* index, metaffi_size index_size, const cdts& val, metaffi_int64 fixed_dimensions, metaffi_type common_type, void* context) -> metaffi_bool {
+			return true;
+		};
+		tcb.on_int64 = [](const metaffi_size* index, metaffi_size index_size, metaffi_int64 val, void* context) {
+			static_cast<reentry_context*>(context)->inner_leaves++;
+		};
+		tcb.on_int32 = [](const metaffi_size* index, metaffi_size index_size, metaffi_int32 val, void* context) {
+			auto* ctx = static_cast<reentry_context*>(context);
+			std::vector<metaffi_size> before(index, index + index_size);
+			traverse_cdts(*ctx->inner, *ctx->callbacks);
+			ctx->index_intact = ctx->index_intact && std::equal(before.begin(), before.end(), index) && index[1] * 2 + index[2] == (metaffi_size)val;
+		};
+
+		traverse_cdts(outer, tcb);
+
+		REQUIRE(ctx.inner_leaves == 4);
+		REQUIRE(ctx.index_intact);
+
+		// the thread's stack is reused afterwards
+		REQUIRE(traverse_matrix_allocations(10, 10) == 0);
+	}
+	
+	TEST_CASE("marshaling plan")
+	{
+		struct plan_context
+		{
+			int type_info_calls = 0;
+			int is_null_calls = 0;
+			metaffi_size null_position = (metaffi_size)-1;
+			std::vector<metaffi_size> visited;
+		};
+		
+		std::vector<metaffi_type_info> signature = {metaffi_type_info(metaffi_int32_type),
+		                                            metaffi_type_info(metaffi_float64_type),
+		                                            metaffi_type_info(metaffi_string8_type),
+		                                            metaffi_type_info(metaffi_any_type)};
+		
+		cdts_marshal_plan plan(signature);
+		REQUIRE(plan.size() == 4);
+		REQUIRE(plan.static_ops_count() == 2);
+		
+		plan_context ctx;
+		construct_cdts_callbacks ccb = {};
+		ccb.context = &ctx;
+		ccb.get_type_info = [](const metaffi_size* index, metaffi_size index_size, void* context) -> metaffi_type_info {
+			static_cast<plan_context*>(context)->type_info_calls++;
+			REQUIRE(index_size == 1);
+			switch(index[0])
+			{
+				case 0: return {metaffi_int32_type};
+				case 1: return {metaffi_float64_type};
+				case 3: return {metaffi_uint8_type};
+				default: FAIL("get_type_info of a position with a known non-scalar type"); return {};
+			}
+		};
+		ccb.is_null = [](const metaffi_size* index, metaffi_size index_size, void* context) -> metaffi_bool {
+			auto* ctx = static_cast<plan_context*>(context);
+			ctx->is_null_calls++;
+			return index[0] == ctx->null_position;
+		};
+		ccb.get_int32 = [](const metaffi_size* index, metaffi_size index_size, void* context) -> metaffi_int32 {
+			REQUIRE(index[0] == 0);
+			return -7;
+		};
+		ccb.get_float64 = [](const metaffi_size* index, metaffi_size index_size, void* context) -> metaffi_float64 {
+			REQUIRE(index[0] == 1);
+			REQUIRE(static_cast<plan_context*>(context)->null_position != 1);
+			return 2.5;
+		};
+		ccb.get_string8 = [](const metaffi_size* index, metaffi_size index_size, metaffi_bool* is_free_required, void* context) -> metaffi_string8 {
+			REQUIRE(index[0] == 2);
+			*is_free_required = false;
+			return (metaffi_string8)u8"plan";
+		};
+		ccb.get_uint8 = [](const metaffi_size* index, metaffi_size index_size, void* context) -> metaffi_uint8 {
+			REQUIRE(index[0] == 3);
+			return 200;
+		};
+		
+		cdts arr;
+		plan.construct(arr, ccb);
+		
+		REQUIRE(ctx.type_info_calls == 1); // only the dynamic position
+		REQUIRE(ctx.is_null_calls == 2);
+		REQUIRE(arr.length == 4);
+		REQUIRE(arr[0].type == metaffi_int32_type);
+		REQUIRE(arr[0].cdt_val.int32_val == -7);
+		REQUIRE(arr[1].type == metaffi_float64_type);
+		REQUIRE(arr[1].cdt_val.float64_val == 2.5);
+		REQUIRE(arr[2].type == metaffi_string8_type);
+		REQUIRE(std::u8string(arr[2].cdt_val.string8_val) == u8"plan");
+		REQUIRE(arr[3].type == metaffi_uint8_type);
+		REQUIRE(arr[3].cdt_val.uint8_val == 200);
+		
+		// a null at a statically typed position falls back to the dynamic traversal
+		arr[1].type = metaffi_null_type;
+		
+		traverse_cdts_callbacks tcb(&ctx);
+		tcb.on_int32 = [](const metaffi_size* index, metaffi_size index_size, metaffi_int32 val, void* context) {
+			REQUIRE(val == -7);
+			static_cast<plan_context*>(context)->visited.push_back(index[0]);
+		};
+		tcb.on_null = [](const metaffi_size* index, metaffi_size index_size, void* context) {
+			static_cast<plan_context*>(context)->visited.push_back(index[0]);
+		};
+		tcb.on_string8 = [](const metaffi_size* index, metaffi_size index_size, metaffi_string8 val, void* context) {
+			REQUIRE(std::u8string(val) == u8"plan");
+			static_cast<plan_context*>(context)->visited.push_back(index[0]);
+		};
+		tcb.on_uint8 = [](const metaffi_size* index, metaffi_size index_size, metaffi_uint8 val, void* context) {
+			REQUIRE(val == 200);
+			static_cast<plan_context*>(context)->visited.push_back(index[0]);
+		};
+		
+		plan.traverse(arr, tcb);
+		REQUIRE(ctx.visited == std::vector<metaffi_size>{0, 1, 2, 3});
+		
+		cdts wrong_length(2);
+		REQUIRE_THROWS_AS(plan.traverse(wrong_length, tcb), std::invalid_argument);
+		REQUIRE_THROWS_AS(plan.construct(wrong_length, ccb), std::invalid_argument);
+		
+		// a null value at a statically typed position is not passed to get_<type>
+		ctx.null_position = 1;
+		cdts with_null;
+		plan.construct(with_null, ccb);
+		REQUIRE(with_null[0].type == metaffi_int32_type);
+		REQUIRE(with_null[1].type == metaffi_null_type);
+		REQUIRE(with_null[3].type == metaffi_uint8_type);
+		
+		// without is_null, scalar positions are constructed dynamically
+		ctx.null_position = (metaffi_size)-1;
+		ctx.type_info_calls = 0;
+		ccb.is_null = nullptr;
+		cdts without_is_null;
+		plan.construct(without_is_null, ccb);
+		REQUIRE(ctx.type_info_calls == 3);
+		REQUIRE(without_is_null[0].cdt_val.int32_val == -7);
+		REQUIRE(without_is_null[1].cdt_val.float64_val == 2.5);
+	}
 }
@@ -1,4 +1,5 @@
 #include "cdts_traverse_construct.h"
+#include <algorithm>
 #include <iostream>
 #include <queue>
 #include <sstream>
@@ -9,27 +10,40 @@ namespace metaffi::runtime
 
 //--------------------------------------------------------------------
 
-void traverse_cdt(const cdt& item, const metaffi::runtime::traverse_cdts_callbacks& callbacks)
+namespace
 {
-	traverse_cdt(item, callbacks, {});
-}
 
-void traverse_cdt(const cdt* item, const traverse_cdts_callbacks* callbacks, char** out_nul_term_err) noexcept
+// Reusable per-thread state of the depth-first traversal.
+// "index" holds the index of the current element, "arrays" holds the array iterated at each depth.
+// Once the vectors reached their high-water mark, traversal does not allocate.
+// A traversal started from within a callback uses its own stack, so it cannot reallocate
+// the vectors the outer callback's index points into.
+struct traverse_stack
 {
-	try
-	{
-		traverse_cdt(*item, *callbacks);
-	}
-	catch(const std::exception& e)
+	std::vector<metaffi_size> index;
+	std::vector<const cdts*> arrays;
+	bool in_use = false;
+};
+
+thread_local traverse_stack tls_traverse_stack;
+
+// empties the stack after the traversal, keeping its capacity (also if a callback throws)
+struct traverse_stack_restore
+{
+	traverse_stack& stack;
+	
+	~traverse_stack_restore()
 	{
-		std::string err = e.what();
-		*out_nul_term_err = new char[err.size()+1];
-		std::copy(err.begin(), err.end(), *out_nul_term_err);
-		(*out_nul_term_err)[err.size()] = '\0';
+		stack.index.clear();
+		stack.arrays.clear();
+		stack.in_use = false;
 	}
-}
+};
 
-void traverse_cdt(const cdt& item, const metaffi::runtime::traverse_cdts_callbacks& callbacks, const std::vector<metaffi_size>& current_index)
+// Calls the callback of a single item.
+// Returns the nested array to iterate into, or nullptr if there is nothing to iterate into.
+// index is only valid until the callback returns.
+const cdts* traverse_item(const cdt& item, const metaffi::runtime::traverse_cdts_callbacks& callbacks, const metaffi_size* index, metaffi_size index_size)
 {
 	if(item.type == metaffi_any_type)
 	{
@@ -49,9 +63,24 @@ void traverse_cdt(const cdt& item, const metaffi::runtime::traverse_cdts_callbac
 			throw std::runtime_error("on_packed_array callback is null but a packed array CDT was encountered");
 		}
 		
+		const cdt_packed_array* packed = item.cdt_val.packed_array_val;
+		if(metaffi_packed_is_tensor(packed))
+		{
+			metaffi_size length = 1;
+			for(metaffi_size dim = 0; dim < packed->rank; dim++)
+			{
+				length *= packed->shape[dim];
+			}
+			
+			if(length != packed->length)
+			{
+				throw std::runtime_error("Packed tensor shape does not match its length");
+			}
+		}
+		
 		metaffi_type element_type = metaffi_packed_element_type(item.type);
-		callbacks.on_packed_array(current_index.data(), current_index.size(), item.cdt_val.packed_array_val, element_type, callbacks.context);
-		return;
+		callbacks.on_packed_array(index, index_size, packed, element_type, callbacks.context);
+		return nullptr;
 	}
 	
 	metaffi_type common_type = metaffi_any_type;
@@ -66,87 +95,87 @@ void traverse_cdt(const cdt& item, const metaffi::runtime::traverse_cdts_callbac
 	{
 		case metaffi_float64_type:
 		{
-			callbacks.on_float64(current_index.data(), current_index.size(), item.cdt_val.float64_val, callbacks.context);
+			callbacks.on_float64(index, index_size, item.cdt_val.float64_val, callbacks.context);
 		}break;
 		
 		case metaffi_float32_type:
 		{
-			callbacks.on_float32(current_index.data(), current_index.size(), item.cdt_val.float32_val, callbacks.context);
+			callbacks.on_float32(index, index_size, item.cdt_val.float32_val, callbacks.context);
 		}break;
 		
 		case metaffi_int8_type:
 		{
-			callbacks.on_int8(current_index.data(), current_index.size(), item.cdt_val.int8_val, callbacks.context);
+			callbacks.on_int8(index, index_size, item.cdt_val.int8_val, callbacks.context);
 		}break;
 		
 		case metaffi_uint8_type:
 		{
-			callbacks.on_uint8(current_index.data(), current_index.size(), item.cdt_val.uint8_val, callbacks.context);
+			callbacks.on_uint8(index, index_size, item.cdt_val.uint8_val, callbacks.context);
 		}break;
 		
 		case metaffi_int16_type:
 		{
-			callbacks.on_int16(current_index.data(), current_index.size(), item.cdt_val.int16_val, callbacks.context);
+			callbacks.on_int16(index, index_size, item.cdt_val.int16_val, callbacks.context);
 		}break;
 		
 		case metaffi_uint16_type:
 		{
-			callbacks.on_uint16(current_index.data(), current_index.size(), item.cdt_val.uint16_val, callbacks.context);
+			callbacks.on_uint16(index, index_size, item.cdt_val.uint16_val, callbacks.context);
 		}break;
 		
 		case metaffi_int32_type:
 		{
-			callbacks.on_int32(current_index.data(), current_index.size(), item.cdt_val.int32_val, callbacks.context);
+			callbacks.on_int32(index, index_size, item.cdt_val.int32_val, callbacks.context);
 		}break;
 		
 		case metaffi_uint32_type:
 		{
-			callbacks.on_uint32(current_index.data(), current_index.size(), item.cdt_val.uint32_val, callbacks.context);
+			callbacks.on_uint32(index, index_size, item.cdt_val.uint32_val, callbacks.context);
 		}break;
 		
 		case metaffi_int64_type:
 		{
-			callbacks.on_int64(current_index.data(), current_index.size(), item.cdt_val.int64_val, callbacks.context);
+			callbacks.on_int64(index, index_size, item.cdt_val.int64_val, callbacks.context);
 		}break;
 		
 		case metaffi_uint64_type:
 		{
-			callbacks.on_uint64(current_index.data(), current_index.size(), item.cdt_val.uint64_val, callbacks.context);
+			callbacks.on_uint64(index, index_size, item.cdt_val.uint64_val, callbacks.context);
 		}break;
 		
 		case metaffi_bool_type:
 		{
-			callbacks.on_bool(current_index.data(), current_index.size(), item.cdt_val.bool_val, callbacks.context);
+			callbacks.on_bool(index, index_size, item.cdt_val.bool_val, callbacks.context);
 		}break;
 		
 		case metaffi_char8_type:
 		{
-			callbacks.on_char8(current_index.data(), current_index.size(), item.cdt_val.char8_val, callbacks.context);
+			callbacks.on_char8(index, index_size, item.cdt_val.char8_val, callbacks.context);
 		}break;
 		
 		case metaffi_string8_type:
 		{
-			callbacks.on_string8(current_index.data(), current_index.size(), item.cdt_val.string8_val, callbacks.context);
+			callbacks.on_string8(index, index_size, metaffi_cdt_string8(&item), callbacks.context);
 		}break;
 		
 		case metaffi_char16_type:
 		{
-			callbacks.on_char16(current_index.data(), current_index.size(), item.cdt_val.char16_val, callbacks.context);
+			callbacks.on_char16(index, index_size, item.cdt_val.char16_val, callbacks.context);
 		}break;
 		
 		case metaffi_string16_type:
 		{
-			callbacks.on_string16(current_index.data(), current_index.size(), item.cdt_val.string16_val, callbacks.context);
+			callbacks.on_string16(index, index_size, metaffi_cdt_string16(&item), callbacks.context);
 		}break;
 		
 		case metaffi_char32_type:
 		{
-			callbacks.on_char32(current_index.data(), current_index.size(), item.cdt_val.char32_val, callbacks.context);
+			callbacks.on_char32(index, index_size, item.cdt_val.char32_val, callbacks.context);
 		}break;
 		
 		case metaffi_string32_type:
 		{
-			callbacks.on_string32(current_index.data(), current_index.size(), item.cdt_val.string32_val, callbacks.context);
+			callbacks.on_string32(index, index_size, metaffi_cdt_string32(&item), callbacks.context);
 		}break;
 		
 		case metaffi_handle_type:
@@ -154,11 +183,11 @@ void traverse_cdt(const cdt& item, const metaffi::runtime::traverse_cdts_callbac
 			if(!item.cdt_val.handle_val)
 			{
 				cdt_metaffi_handle null_handle{};
-				callbacks.on_handle(current_index.data(), current_index.size(), null_handle, callbacks.context);
+				callbacks.on_handle(index, index_size, null_handle, callbacks.context);
 			}
 			else
 			{
-				callbacks.on_handle(current_index.data(), current_index.size(), *item.cdt_val.handle_val, callbacks.context);
+				callbacks.on_handle(index, index_size, *item.cdt_val.handle_val, callbacks.context);
 			}
 		}break;
 		
@@ -168,12 +197,12 @@ void traverse_cdt(const cdt& item, const metaffi::runtime::traverse_cdts_callbac
 				throw std::runtime_error("Callable value is null");
 			}
 			
-			callbacks.on_callable(current_index.data(), current_index.size(), *item.cdt_val.callable_val, callbacks.context);
+			callbacks.on_callable(index, index_size, *item.cdt_val.callable_val, callbacks.context);
 		}break;
 		
 		case metaffi_null_type:
 		{
-			callbacks.on_null(current_index.data(), current_index.size(), callbacks.context);
+			callbacks.on_null(index, index_size, callbacks.context);
 		}break;
 		
 		case metaffi_array_type:
@@ -182,10 +211,10 @@ void traverse_cdt(const cdt& item, const metaffi::runtime::traverse_cdts_callbac
 				throw std::runtime_error("Array value is null");
 			}
 			
-			metaffi_bool continue_traverse = callbacks.on_array(current_index.data(), current_index.size(), *item.cdt_val.array_val, item.cdt_val.array_val->fixed_dimensions, common_type, callbacks.context);
+			metaffi_bool continue_traverse = callbacks.on_array(index, index_size, *item.cdt_val.array_val, item.cdt_val.array_val->fixed_dimensions, common_type, callbacks.context);
 			
 			if(continue_traverse){
-				traverse_cdts(*item.cdt_val.array_val, callbacks, current_index);
+				return item.cdt_val.array_val; // caller iterates into the array
 			}
 		}break;
 		
@@ -196,11 +225,93 @@ void traverse_cdt(const cdt& item, const metaffi::runtime::traverse_cdts_callbac
 			throw std::runtime_error(ss.str());
 		}
 	}
+	
+	return nullptr;
+}
+
+void traverse_array(const cdts& arr, const metaffi::runtime::traverse_cdts_callbacks& callbacks, const metaffi_size* starting_index, metaffi_size starting_index_size)
+{
+	if(arr.length == 0){ // empty CDTS
+		return;
+	}
+	
+	traverse_stack nested_stack; // re-entrant traversals (rare) allocate, as they cannot share the thread's stack
+	traverse_stack& stack = tls_traverse_stack.in_use ? nested_stack : tls_traverse_stack;
+	stack.in_use = true;
+	traverse_stack_restore restore{stack};
+	
+	stack.index.insert(stack.index.end(), starting_index, starting_index + starting_index_size);
+	stack.arrays.push_back(&arr);
+	stack.index.push_back(0);
+	
+	while(!stack.arrays.empty())
+	{
+		const cdts& current = *stack.arrays.back();
+		metaffi_size pos = stack.index.back();
+		
+		if(pos >= current.length) // done with the array - continue with its next sibling
+		{
+			stack.arrays.pop_back();
+			stack.index.pop_back();
+			if(!stack.arrays.empty())
+			{
+				stack.index.back()++;
+			}
+			continue;
+		}
+		
+		const cdts* nested = traverse_item(current.arr[pos], callbacks, stack.index.data(), stack.index.size());
+		
+		if(nested)
+		{
+			stack.arrays.push_back(nested);
+			stack.index.push_back(0);
+		}
+		else
+		{
+			stack.index.back()++;
+		}
+	}
+}
+
+}
+
+void traverse_cdt(const cdt& item, const metaffi::runtime::traverse_cdts_callbacks& callbacks)
+{
+	const cdts* nested = traverse_item(item, callbacks, nullptr, 0);
+	if(nested)
+	{
+		traverse_array(*nested, callbacks, nullptr, 0);
+	}
+}
+
+void traverse_cdt(const cdt* item, const traverse_cdts_callbacks* callbacks, char** out_nul_term_err) noexcept
+{
+	try
+	{
+		traverse_cdt(*item, *callbacks);
+	}
+	catch(const std::exception& e)
+	{
+		std::string err = e.what();
+		*out_nul_term_err = new char[err.size()+1];
+		std::copy(err.begin(), err.end(), *out_nul_term_err);
+		(*out_nul_term_err)[err.size()] = '\0';
+	}
+}
+
+void traverse_cdt(const cdt& item, const metaffi::runtime::traverse_cdts_callbacks& callbacks, const std::vector<metaffi_size>& current_index)
+{
+	const cdts* nested = traverse_item(item, callbacks, current_index.data(), current_index.size());
+	if(nested)
+	{
+		traverse_array(*nested, callbacks, current_index.data(), current_index.size());
+	}
 }
 
 void traverse_cdts(const cdts& arr, const metaffi::runtime::traverse_cdts_callbacks& callbacks)
 {
-	traverse_cdts(arr, callbacks, {});
+	traverse_array(arr, callbacks, nullptr, 0);
 }
 
 void traverse_cdts(const cdts* arr, const traverse_cdts_callbacks* callbacks, char** out_nul_term_err) noexcept
@@ -220,26 +331,166 @@ void traverse_cdts(const cdts* arr, const traverse_cdts_callbacks* callbacks, ch
 
 void traverse_cdts(const cdts& arr, const metaffi::runtime::traverse_cdts_callbacks& callbacks, const std::vector<metaffi_size>& starting_index)
 {
-	if(arr.length == 0){ // empty CDTS
-		return;
-	}
+	traverse_array(arr, callbacks, starting_index.data(), starting_index.size());
+}
+//--------------------------------------------------------------------
+
+namespace
+{
+
+template<typename T>
+using construct_range_getter = void (*)(const metaffi_size* index, metaffi_size index_size, metaffi_size start, metaffi_size count, T* out, void* context);
+
+template<typename T>
+using construct_string_range_getter = void (*)(const metaffi_size* index, metaffi_size index_size, metaffi_size start, metaffi_size count, T* out, metaffi_bool* is_free_required, void* context);
+
+// Range getters fill this many bytes per call, so filling an array needs no allocation
+// and each chunk is copied into the CDTs while it is still in cache.
+constexpr size_t construct_range_chunk_bytes = 4096;
+
+template<typename T>
+void construct_range(cdts& arr, const std::vector<metaffi_size>& index, construct_range_getter<T> getter, T cdt_types::* member, metaffi_type type, void* context)
+{
+	constexpr metaffi_size chunk_length = construct_range_chunk_bytes / sizeof(T);
+	T values[chunk_length];
 	
-	std::queue<std::pair<std::vector<metaffi_size>, cdt&>> queue;
-	for(metaffi_size i=0 ; i<arr.length ; i++)
+	for(metaffi_size start = 0 ; start < arr.length ; start += chunk_length)
 	{
-		std::vector<metaffi_size> index = starting_index;
-		index.emplace_back(i);
-		queue.emplace(index, arr[i]);
+		metaffi_size count = (std::min)(chunk_length, arr.length - start);
+		getter(index.data(), index.size(), start, count, values, context);
+		
+		for(metaffi_size i = 0 ; i < count ; i++)
+		{
+			cdt& item = arr.arr[start + i];
+			item.type = type;
+			item.cdt_val.*member = values[i];
+			item.free_required = false;
+		}
 	}
+}
+
+template<typename T>
+void construct_string_range(cdts& arr, const std::vector<metaffi_size>& index, construct_string_range_getter<T> getter, T cdt_types::* member, metaffi_type type, void* context)
+{
+	constexpr metaffi_size chunk_length = construct_range_chunk_bytes / sizeof(T);
+	T values[chunk_length];
 	
-	while(!queue.empty())
+	for(metaffi_size start = 0 ; start < arr.length ; start += chunk_length)
 	{
-		auto [currentIndex, pcdt] = queue.front();
-		queue.pop();
-		
-		metaffi::runtime::traverse_cdt(pcdt, callbacks, currentIndex);
+		metaffi_size count = (std::min)(chunk_length, arr.length - start);
+		metaffi_bool is_free_required = true; // default
+		getter(index.data(), index.size(), start, count, values, &is_free_required, context);
+		
+		for(metaffi_size i = 0 ; i < count ; i++)
+		{
+			cdt& item = arr.arr[start + i];
+			item.type = type;
+			item.cdt_val.*member = values[i];
+			item.free_required = is_free_required;
+			item.has_length = 0;
+			item.is_small_string = 0;
+		}
 	}
 }
+
+// Fills a 1D array of common_type using the matching range getter.
+// Returns false if there is no range getter for common_type.
+bool try_construct_range(cdts& arr, const std::vector<metaffi_size>& index, metaffi_type common_type, const metaffi::runtime::construct_cdts_callbacks& callbacks)
+{
+	switch(common_type)
+	{
+		case metaffi_float64_type:
+			if(!callbacks.get_float64_range){ return false; }
+			construct_range(arr, index, callbacks.get_float64_range, &cdt_types::float64_val, common_type, callbacks.context);
+			return true;
+			
+		case metaffi_float32_type:
+			if(!callbacks.get_float32_range){ return false; }
+			construct_range(arr, index, callbacks.get_float32_range, &cdt_types::float32_val, common_type, callbacks.context);
+			return true;
+			
+		case metaffi_int8_type:
+			if(!callbacks.get_int8_range){ return false; }
+			construct_range(arr, index, callbacks.get_int8_range, &cdt_types::int8_val, common_type, callbacks.context);
+			return true;
+			
+		case metaffi_uint8_type:
+			if(!callbacks.get_uint8_range){ return false; }
+			construct_range(arr, index, callbacks.get_uint8_range, &cdt_types::uint8_val, common_type, callbacks.context);
+			return true;
+			
+		case metaffi_int16_type:
+			if(!callbacks.get_int16_range){ return false; }
+			construct_range(arr, index, callbacks.get_int16_range, &cdt_types::int16_val, common_type, callbacks.context);
+			return true;
+			
+		case metaffi_uint16_type:
+			if(!callbacks.get_uint16_range){ return false; }
+			construct_range(arr, index, callbacks.get_uint16_range, &cdt_types::uint16_val, common_type, callbacks.context);
+			return true;
+			
+		case metaffi_int32_type:
+			if(!callbacks.get_int32_range){ return false; }
+			construct_range(arr, index, callbacks.get_int32_range, &cdt_types::int32_val, common_type, callbacks.context);
+			return true;
+			
+		case metaffi_uint32_type:
+			if(!callbacks.get_uint32_range){ return false; }
+			construct_range(arr, index, callbacks.get_uint32_range, &cdt_types::uint32_val, common_type, callbacks.context);
+			return true;
+			
+		case metaffi_int64_type:
+			if(!callbacks.get_int64_range){ return false; }
+			construct_range(arr, index, callbacks.get_int64_range, &cdt_types::int64_val, common_type, callbacks.context);
+			return true;
+			
+		case metaffi_uint64_type:
+			if(!callbacks.get_uint64_range){ return false; }
+			construct_range(arr, index, callbacks.get_uint64_range, &cdt_types::uint64_val, common_type, callbacks.context);
+			return true;
+			
+		case metaffi_bool_type:
+			if(!callbacks.get_bool_range){ return false; }
+			construct_range(arr, index, callbacks.get_bool_range, &cdt_types::bool_val, common_type, callbacks.context);
+			return true;
+			
+		case metaffi_char8_type:
+			if(!callbacks.get_char8_range){ return false; }
+			construct_range(arr, index, callbacks.get_char8_range, &cdt_types::char8_val, common_type, callbacks.context);
+			return true;
+			
+		case metaffi_char16_type:
+			if(!callbacks.get_char16_range){ return false; }
+			construct_range(arr, index, callbacks.get_char16_range, &cdt_types::char16_val, common_type, callbacks.context);
+			return true;
+			
+		case metaffi_char32_type:
+			if(!callbacks.get_char32_range){ return false; }
+			construct_range(arr, index, callbacks.get_char32_range, &cdt_types::char32_val, common_type, callbacks.context);
+			return true;
+			
+		case metaffi_string8_type:
+			if(!callbacks.get_string8_range){ return false; }
+			construct_string_range(arr, index, callbacks.get_string8_range, &cdt_types::string8_val, common_type, callbacks.context);
+			return true;
+			
+		case metaffi_string16_type:
+			if(!callbacks.get_string16_range){ return false; }
+			construct_string_range(arr, index, callbacks.get_string16_range, &cdt_types::string16_val, common_type, callbacks.context);
+			return true;
+			
+		case metaffi_string32_type:
+			if(!callbacks.get_string32_range){ return false; }
+			construct_string_range(arr, index, callbacks.get_string32_range, &cdt_types::string32_val, common_type, callbacks.context);
+			return true;
+			
+		default:
+			return false;
+	}
+}
+
+}
+
 //--------------------------------------------------------------------
 void construct_cdt(cdt& item, const metaffi::runtime::construct_cdts_callbacks& callbacks)
 {
@@ -382,6 +633,8 @@ void construct_cdt(cdt& item, const metaffi::runtime::construct_cdts_callbacks&
 		case metaffi_string8_type:
 		{
 			item.cdt_val.string8_val = callbacks.get_string8(current_index.data(), current_index.size(), &item.free_required, callbacks.context);
+			item.has_length = 0;
+			item.is_small_string = 0;
 		}break;
 		
 		case metaffi_char16_type:
@@ -393,6 +646,8 @@ void construct_cdt(cdt& item, const metaffi::runtime::construct_cdts_callbacks&
 		case metaffi_string16_type:
 		{
 			item.cdt_val.string16_val = callbacks.get_string16(current_index.data(), current_index.size(), &item.free_required, callbacks.context);
+			item.has_length = 0;
+			item.is_small_string = 0;
 		}break;
 		
 		case metaffi_char32_type:
@@ -404,6 +659,8 @@ void construct_cdt(cdt& item, const metaffi::runtime::construct_cdts_callbacks&
 		case metaffi_string32_type:
 		{
 			item.cdt_val.string32_val = callbacks.get_string32(current_index.data(), current_index.size(), &item.free_required, callbacks.context);
+			item.has_length = 0;
+			item.is_small_string = 0;
 		}break;
 		
 		case metaffi_handle_type:
@@ -438,6 +695,11 @@ void construct_cdt(cdt& item, const metaffi::runtime::construct_cdts_callbacks&
 				// let callback construct the array
 				callbacks.construct_cdt_array(current_index.data(), current_index.size(), item.cdt_val.array_val, callbacks.context);
 			}
+			else if(is_1d_array && try_construct_range(*item.cdt_val.array_val, current_index, common_type, callbacks))
+			{
+				// filled by a single range getter call
+				item.cdt_val.array_val->fixed_dimensions = 1;
+			}
 			else // iterate into array
 			{
 				item.cdt_val.array_val->length = array_length;
@@ -445,10 +707,14 @@ void construct_cdt(cdt& item, const metaffi::runtime::construct_cdts_callbacks&
 				// initialize found_dims - if already detected mixed dimensions - skip the dimensions calculation
 				// else, set to INT_MIN to perform the calculation
 				metaffi_int64 found_dims = is_fixed_dimension ? INT_MIN : MIXED_OR_UNKNOWN_DIMENSIONS;
+				
+				// index of the current element (the last entry is updated in every iteration)
+				std::vector<metaffi_size> new_index = current_index;
+				new_index.emplace_back(0);
+				
 				for(int i=0 ; i<item.cdt_val.array_val->length ; i++)
 				{
-					std::vector<metaffi_size> new_index = current_index;
-					new_index.emplace_back(i);
+					new_index.back() = i;
 					cdt& new_item = item.cdt_val.array_val->arr[i];
 					construct_cdt(new_item, callbacks, new_index);
 					
@@ -50,6 +50,7 @@ struct traverse_cdts_callbacks
 	
 	// Packed array: a contiguous T* buffer + length.
 	// element_type is the scalar element type (e.g. metaffi_int32_type).
+	// N-D tensors have val->rank > 1 and val->shape (see cdt_packed_array and runtime/packed_tensor.h).
 	void (*on_packed_array)(const metaffi_size* index, metaffi_size index_size, const struct cdt_packed_array* val, metaffi_type element_type, void* context);
 
 #ifdef __cplusplus
@@ -189,7 +190,38 @@ struct construct_cdts_callbacks
 	// Packed array: return a heap-allocated cdt_packed_array* with data buffer.
 	// element_type is the scalar element type from the type_info (e.g. metaffi_int32_type).
 	// Caller takes ownership of the returned cdt_packed_array and its data buffer.
+	// Return an N-D tensor (rank and shape set) for multi-dimensional arrays.
 	struct cdt_packed_array* (*get_packed_array)(const metaffi_size* index, metaffi_size index_size, metaffi_type element_type, metaffi_bool* is_free_required, void* context);
+	
+	// Optional range getters of 1D arrays with a common type (may be null).
+	// Fill out[0..count) with the elements [start, start+count) of the array at index.
+	// If the getter of the array's common type is set, construct_cdt uses it instead of calling
+	// get_type_info and get_<type> for every element.
+	// Large arrays are requested in several consecutive ranges of a few KB each.
+	// For strings, is_free_required applies to all the strings returned by the call.
+	void (*get_float64_range)(const metaffi_size* index, metaffi_size index_size, metaffi_size start, metaffi_size count, metaffi_float64* out, void* context);
+	void (*get_float32_range)(const metaffi_size* index, metaffi_size index_size, metaffi_size start, metaffi_size count, metaffi_float32* out, void* context);
+	void (*get_int8_range)(const metaffi_size* index, metaffi_size index_size, metaffi_size start, metaffi_size count, metaffi_int8* out, void* context);
+	void (*get_uint8_range)(const metaffi_size* index, metaffi_size index_size, metaffi_size start, metaffi_size count, metaffi_uint8* out, void* context);
+	void (*get_int16_range)(const metaffi_size* index, metaffi_size index_size, metaffi_size start, metaffi_size count, metaffi_int16* out, void* context);
+	void (*get_uint16_range)(const metaffi_size* index, metaffi_size index_size, metaffi_size start, metaffi_size count, metaffi_uint16* out, void* context);
+	void (*get_int32_range)(const metaffi_size* index, metaffi_size index_size, metaffi_size start, metaffi_size count, metaffi_int32* out, void* context);
+	void (*get_uint32_range)(const metaffi_size* index, metaffi_size index_size, metaffi_size start, metaffi_size count, metaffi_uint32* out, void* context);
+	void (*get_int64_range)(const metaffi_size* index, metaffi_size index_size, metaffi_size start, metaffi_size count, metaffi_int64* out, void* context);
+	void (*get_uint64_range)(const metaffi_size* index, metaffi_size index_size, metaffi_size start, metaffi_size count, metaffi_uint64* out, void* context);
+	void (*get_bool_range)(const metaffi_size* index, metaffi_size index_size, metaffi_size start, metaffi_size count, metaffi_bool* out, void* context);
+	void (*get_char8_range)(const metaffi_size* index, metaffi_size index_size, metaffi_size start, metaffi_size count, struct metaffi_char8* out, void* context);
+	void (*get_string8_range)(const metaffi_size* index, metaffi_size index_size, metaffi_size start, metaffi_size count, metaffi_string8* out, metaffi_bool* is_free_required, void* context);
+	void (*get_char16_range)(const metaffi_size* index, metaffi_size index_size, metaffi_size start, metaffi_size count, struct metaffi_char16* out, void* context);
+	void (*get_string16_range)(const metaffi_size* index, metaffi_size index_size, metaffi_size start, metaffi_size count, metaffi_string16* out, metaffi_bool* is_free_required, void* context);
+	void (*get_char32_range)(const metaffi_size* index, metaffi_size index_size, metaffi_size start, metaffi_size count, struct metaffi_char32* out, void* context);
+	void (*get_string32_range)(const metaffi_size* index, metaffi_size index_size, metaffi_size start, metaffi_size count, metaffi_string32* out, metaffi_bool* is_free_required, void* context);
+	
+	// Optional (may be null). Returns true if the value at index is null (e.g. None, null jobject).
+	// Used by cdts_marshal_plan to construct statically typed scalar positions without get_type_info:
+	// a null value becomes a metaffi_null_type CDT instead of being passed to get_<type>.
+	// If not set, the plan constructs scalar positions dynamically.
+	metaffi_bool (*is_null)(const metaffi_size* index, metaffi_size index_size, void* context);
 
 #ifdef __cplusplus
 	
@@ -221,6 +253,24 @@ struct construct_cdts_callbacks
 		get_handle = nullptr;
 		get_callable = nullptr;
 		get_packed_array = nullptr;
+		get_float64_range = nullptr;
+		get_float32_range = nullptr;
+		get_int8_range = nullptr;
+		get_uint8_range = nullptr;
+		get_int16_range = nullptr;
+		get_uint16_range = nullptr;
+		get_int32_range = nullptr;
+		get_uint32_range = nullptr;
+		get_int64_range = nullptr;
+		get_uint64_range = nullptr;
+		get_bool_range = nullptr;
+		get_char8_range = nullptr;
+		get_string8_range = nullptr;
+		get_char16_range = nullptr;
+		get_string16_range = nullptr;
+		get_char32_range = nullptr;
+		get_string32_range = nullptr;
+		is_null = nullptr;
 	}
 	
 	construct_cdts_callbacks(
@@ -273,7 +323,25 @@ struct construct_cdts_callbacks
 	    get_string32(get_string32),
 	    get_handle(get_handle),
 	    get_callable(get_callable),
-	    get_packed_array(get_packed_array)
+	    get_packed_array(get_packed_array),
+	    get_float64_range(nullptr),
+	    get_float32_range(nullptr),
+	    get_int8_range(nullptr),
+	    get_uint8_range(nullptr),
+	    get_int16_range(nullptr),
+	    get_uint16_range(nullptr),
+	    get_int32_range(nullptr),
+	    get_uint32_range(nullptr),
+	    get_int64_range(nullptr),
+	    get_uint64_range(nullptr),
+	    get_bool_range(nullptr),
+	    get_char8_range(nullptr),
+	    get_string8_range(nullptr),
+	    get_char16_range(nullptr),
+	    get_string16_range(nullptr),
+	    get_char32_range(nullptr),
+	    get_string32_range(nullptr),
+	    is_null(nullptr)
 	{}
 	
 #endif // __cplusplus
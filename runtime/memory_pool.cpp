@@ -0,0 +1,349 @@
+#include "memory_pool.h"
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+
+namespace metaffi::runtime
+{
+
+//--------------------------------------------------------------------
+
+namespace
+{
+
+constexpr uint32_t size_classes_count = 9; // 16 bytes to 4KB
+constexpr uint32_t unpooled_class = size_classes_count;
+constexpr size_t chunk_size = 64 * 1024;
+
+struct thread_cache;
+
+// precedes every block (16 bytes - keeps the user memory 16 bytes aligned)
+struct alignas(16) block_header
+{
+	thread_cache* owner; // nullptr for malloc'ed blocks
+	uint32_t size_class;
+	uint32_t reserved;
+};
+
+static_assert(sizeof(block_header) == 16);
+
+// free blocks are linked through their (unused) user memory
+struct free_block
+{
+	free_block* next;
+};
+
+inline free_block* as_free_block(block_header* header) { return reinterpret_cast<free_block*>(header + 1); }
+inline block_header* header_of(free_block* block) { return reinterpret_cast<block_header*>(block) - 1; }
+
+inline size_t class_block_size(uint32_t size_class) { return sizeof(block_header) + (size_t(16) << size_class); }
+
+inline uint32_t size_class_of(uint64_t size)
+{
+	uint32_t size_class = 0;
+	while((uint64_t(16) << size_class) < size)
+	{
+		size_class++;
+	}
+	return size_class;
+}
+
+// counters are written by the owning thread only (except remote_frees), and read by stats()
+struct cache_counters
+{
+	std::atomic<uint64_t> allocations{0};
+	std::atomic<uint64_t> frees{0};
+	std::atomic<uint64_t> pooled_allocations{0};
+	std::atomic<uint64_t> reserved_bytes{0};
+
+	static void increment(std::atomic<uint64_t>& counter, uint64_t by = 1)
+	{
+		counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+	}
+};
+
+struct thread_cache
+{
+	free_block* free_lists[size_classes_count] = {};
+	std::atomic<free_block*> remote_frees{nullptr};
+	std::atomic<uint64_t> remote_frees_count{0};
+
+	unsigned char* chunk_cursor = nullptr;
+	unsigned char* chunk_end = nullptr;
+
+	cache_counters counters;
+
+	// reclaim the blocks other threads freed
+	void drain_remote_frees()
+	{
+		free_block* block = remote_frees.exchange(nullptr, std::memory_order_acquire);
+		while(block)
+		{
+			free_block* next = block->next;
+			uint32_t size_class = header_of(block)->size_class;
+			block->next = free_lists[size_class];
+			free_lists[size_class] = block;
+			block = next;
+		}
+	}
+
+	block_header* carve(uint32_t size_class)
+	{
+		size_t size = class_block_size(size_class);
+		if(chunk_cursor == nullptr || size_t(chunk_end - chunk_cursor) < size)
+		{
+			// the rest of the current chunk is dropped - blocks are never split
+			chunk_cursor = static_cast<unsigned char*>(std::malloc(chunk_size));
+			if(!chunk_cursor)
+			{
+				chunk_end = nullptr;
+				return nullptr;
+			}
+			chunk_end = chunk_cursor + chunk_size;
+			cache_counters::increment(counters.reserved_bytes, chunk_size);
+		}
+
+		auto* header = reinterpret_cast<block_header*>(chunk_cursor);
+		chunk_cursor += size;
+
+		header->owner = this;
+		header->size_class = size_class;
+		return header;
+	}
+
+	void* allocate(uint32_t size_class)
+	{
+		free_block* block = free_lists[size_class];
+		if(!block)
+		{
+			drain_remote_frees();
+			block = free_lists[size_class];
+		}
+
+		if(block)
+		{
+			free_lists[size_class] = block->next;
+			return block;
+		}
+
+		block_header* header = carve(size_class);
+		return header ? header + 1 : nullptr;
+	}
+
+	void free_local(block_header* header)
+	{
+		free_block* block = as_free_block(header);
+		block->next = free_lists[header->size_class];
+		free_lists[header->size_class] = block;
+	}
+
+	// lock-free push, from any thread
+	void free_remote(block_header* header)
+	{
+		free_block* block = as_free_block(header);
+		block->next = remote_frees.load(std::memory_order_relaxed);
+		while(!remote_frees.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed))
+		{
+		}
+		remote_frees_count.fetch_add(1, std::memory_order_relaxed);
+	}
+};
+
+// all the caches ever created, and the caches of exited threads waiting to be adopted.
+// Locked only when a thread creates/adopts/releases its cache and by stats().
+struct cache_registry
+{
+	std::mutex lock;
+	std::vector<thread_cache*> caches;
+	std::vector<thread_cache*> orphans;
+	cache_counters no_cache_counters; // threads whose cache is already released (thread exit)
+};
+
+cache_registry& registry()
+{
+	static auto* instance = new cache_registry(); // never destroyed - blocks may be freed during shutdown
+	return *instance;
+}
+
+std::atomic<bool> pooling{false};
+
+thread_local thread_cache* current_cache = nullptr;
+thread_local bool cache_released = false;
+
+// gives the thread's cache back to the registry on thread exit
+struct cache_releaser
+{
+	~cache_releaser()
+	{
+		if(!current_cache)
+		{
+			return;
+		}
+
+		cache_registry& reg = registry();
+		std::lock_guard<std::mutex> guard(reg.lock);
+		reg.orphans.push_back(current_cache);
+		current_cache = nullptr;
+		cache_released = true;
+	}
+};
+
+thread_local cache_releaser releaser;
+
+thread_cache* acquire_cache()
+{
+	if(cache_released) // thread is exiting
+	{
+		return nullptr;
+	}
+
+	cache_registry& reg = registry();
+	{
+		std::lock_guard<std::mutex> guard(reg.lock);
+		if(!reg.orphans.empty())
+		{
+			current_cache = reg.orphans.back();
+			reg.orphans.pop_back();
+		}
+		else
+		{
+			current_cache = new thread_cache();
+			reg.caches.push_back(current_cache);
+		}
+	}
+
+	(void)&releaser; // registers the thread_local destructor
+	return current_cache;
+}
+
+inline thread_cache* get_cache()
+{
+	return current_cache ? current_cache : acquire_cache();
+}
+
+inline cache_counters& counters_of(thread_cache* cache)
+{
+	return cache ? cache->counters : registry().no_cache_counters;
+}
+
+void* allocate_unpooled(uint64_t size)
+{
+	auto* header = static_cast<block_header*>(std::malloc(sizeof(block_header) + size));
+	if(!header)
+	{
+		return nullptr;
+	}
+
+	header->owner = nullptr;
+	header->size_class = unpooled_class;
+	return header + 1;
+}
+
+}
+
+//--------------------------------------------------------------------
+void* memory_pool::allocate(uint64_t size)
+{
+	if(size == 0)
+	{
+		size = 1;
+	}
+
+	thread_cache* cache = get_cache();
+	cache_counters& counters = counters_of(cache);
+
+	// no cache (thread exit) - counted with a shared counter, so use an atomic increment
+	if(cache)
+	{
+		cache_counters::increment(counters.allocations);
+	}
+	else
+	{
+		counters.allocations.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	if(!cache || size > max_pooled_size || !pooling.load(std::memory_order_relaxed))
+	{
+		return allocate_unpooled(size);
+	}
+
+	void* ptr = cache->allocate(size_class_of(size));
+	if(ptr)
+	{
+		cache_counters::increment(counters.pooled_allocations);
+	}
+
+	return ptr;
+}
+//--------------------------------------------------------------------
+void memory_pool::deallocate(void* ptr)
+{
+	if(!ptr)
+	{
+		return;
+	}
+
+	block_header* header = static_cast<block_header*>(ptr) - 1;
+	thread_cache* cache = get_cache();
+
+	if(cache)
+	{
+		cache_counters::increment(cache->counters.frees);
+	}
+	else
+	{
+		registry().no_cache_counters.frees.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	if(header->size_class == unpooled_class)
+	{
+		std::free(header);
+	}
+	else if(header->owner == cache)
+	{
+		cache->free_local(header);
+	}
+	else
+	{
+		header->owner->free_remote(header);
+	}
+}
+//--------------------------------------------------------------------
+void memory_pool::set_pooling(bool enabled)
+{
+	pooling.store(enabled, std::memory_order_relaxed);
+}
+//--------------------------------------------------------------------
+bool memory_pool::is_pooling()
+{
+	return pooling.load(std::memory_order_relaxed);
+}
+//--------------------------------------------------------------------
+memory_pool_stats memory_pool::stats()
+{
+	memory_pool_stats result;
+
+	cache_registry& reg = registry();
+	std::lock_guard<std::mutex> guard(reg.lock);
+
+	auto add = [&result](const cache_counters& counters)
+	{
+		result.allocations += counters.allocations.load(std::memory_order_relaxed);
+		result.frees += counters.frees.load(std::memory_order_relaxed);
+		result.pooled_allocations += counters.pooled_allocations.load(std::memory_order_relaxed);
+		result.reserved_bytes += counters.reserved_bytes.load(std::memory_order_relaxed);
+	};
+
+	for(thread_cache* cache : reg.caches)
+	{
+		add(cache->counters);
+		result.remote_frees += cache->remote_frees_count.load(std::memory_order_relaxed);
+	}
+	add(reg.no_cache_counters);
+
+	result.thread_caches = reg.caches.size();
+	return result;
+}
+//--------------------------------------------------------------------
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief XLLR runtime flag (set_runtime_flag) switching alloc_memory/free_memory to the memory_pool.
+ */
+#define METAFFI_POOLED_MEMORY_FLAG "pooled_memory"
+
+namespace metaffi::runtime
+{
+
+/************************************************
+*   Memory pool
+*************************************************/
+
+/**
+ * @brief Counters of the memory pool, summed over all threads.
+ */
+struct memory_pool_stats
+{
+	uint64_t allocations = 0;        // allocate() calls
+	uint64_t frees = 0;              // deallocate() calls
+	uint64_t pooled_allocations = 0; // allocations served by a size class (the rest use malloc)
+	uint64_t remote_frees = 0;       // pooled blocks freed by a thread other than the one that allocated them
+	uint64_t reserved_bytes = 0;     // memory reserved by the size classes (never returned to the system)
+	uint64_t thread_caches = 0;      // thread caches created so far
+};
+
+/**
+ * @brief Thread-caching, size-class pooled allocator backing XLLR's alloc_memory/free_memory.
+ *
+ * XLLR's alloc_memory/free_memory call allocate()/deallocate(), and set_runtime_flag(METAFFI_POOLED_MEMORY_FLAG)
+ * calls set_pooling(true). Plugins keep using xllr_alloc_memory/xllr_free_memory - only XLLR links the pool.
+ *
+ * - Requests of up to max_pooled_size bytes are served from power-of-two size classes (16 bytes to 4KB)
+ *   by a per-thread cache: a local free list per class, refilled from 64KB chunks.
+ *   The hot path touches only the calling thread's cache - no locks and no shared atomics.
+ * - Blocks freed by another thread (e.g. the guest frees what the host allocated) are pushed
+ *   lock-free to the owning cache's remote free list, which the owner reclaims when its local list runs out.
+ * - Larger requests, and all requests while pooling is off, use malloc.
+ *
+ * Every block starts with a 16 bytes header recording how it was allocated, so pooling can be switched
+ * at any time - blocks are always released the way they were allocated.
+ * The caches of exited threads are kept (their blocks may still be alive) and adopted by new threads.
+ */
+class memory_pool
+{
+public:
+	static constexpr size_t max_pooled_size = 4096;
+
+	/**
+	 * @return 16 bytes aligned memory, or nullptr if out of memory.
+	 */
+	static void* allocate(uint64_t size);
+
+	/**
+	 * @brief Free memory returned by allocate(), on any thread. nullptr is ignored.
+	 */
+	static void deallocate(void* ptr);
+
+	/**
+	 * @brief Switch between the pool and malloc. Default is malloc.
+	 */
+	static void set_pooling(bool enabled);
+	[[nodiscard]] static bool is_pooling();
+
+	[[nodiscard]] static memory_pool_stats stats();
+};
+
+}
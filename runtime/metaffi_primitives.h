@@ -252,18 +252,58 @@ enum metaffi_types
  * - Strings: data points to an array of string pointers (e.g. metaffi_string8[])
  * - Handles: data points to a cdt_metaffi_handle[] array
  * - Callables: data points to a cdt_metaffi_callable[] array
+ *
+ * Borrowed packed arrays (is_borrowed != 0) point to a buffer owned by someone else
+ * (e.g. the caller's buffer of an input parameter, which outlives the call).
+ * Freeing a borrowed packed array frees only the cdt_packed_array struct, never the data
+ * (nor the strings/handles/callables it points to).
+ *
+ * String blobs (is_string_blob != 0, string8/16/32 only) keep all the strings in data's single allocation:
+ *   metaffi_stringN strings[length]  - pointers to each string (same as the pointer array layout)
+ *   metaffi_size offsets[length + 1] - offset (in code units) of each string in chars, offsets[length] is the end
+ *   chars                            - the strings, each followed by a NULL terminator
+ * Length of string i is offsets[i+1] - offsets[i] - 1 (see metaffi_string_blob_string_length).
+ * Null strings have a null pointer and offsets[i+1] == offsets[i].
+ * Freeing a string blob frees data once, not each string.
+ *
+ * N-D tensors (rank > 1) hold all the elements in data, and length is the total number of elements:
+ *   shape[rank]   - extent of each dimension, outermost first (the product of the extents is length)
+ *   strides[rank] - optional stride (in elements) of each dimension. nullptr means row-major contiguous.
+ *                   Only numeric, bool, size and char tensors may have strides.
+ * shape and strides share a single allocation (metaffi_packed_shape_size bytes, strides follow shape)
+ * which is owned by the packed array, even if data is borrowed.
+ * A contiguous tensor read as a 1D packed array is its elements in row-major order.
+ *
+ * Code allocating cdt_packed_array without a constructor must set is_borrowed, is_string_blob, rank, shape and strides explicitly.
  */
 struct cdt_packed_array
 {
 	void* data;           // Raw typed data buffer
-	metaffi_size length;  // Number of elements
+	metaffi_size length;  // Number of elements (of all the dimensions)
+	metaffi_bool is_borrowed; // data is not owned by the packed array
+	metaffi_bool is_string_blob; // strings are stored in data as a single blob
+	metaffi_size rank;       // number of dimensions (0 or 1 for a 1D array)
+	metaffi_size* shape;     // rank > 1: extent of each dimension, nullptr otherwise
+	metaffi_int64* strides;  // rank > 1: stride of each dimension in elements, nullptr if row-major contiguous
 
 #ifdef __cplusplus
-	cdt_packed_array() : data(nullptr), length(0) {}
-	cdt_packed_array(void* data, metaffi_size length) : data(data), length(length) {}
+	cdt_packed_array() : data(nullptr), length(0), is_borrowed(0), is_string_blob(0), rank(0), shape(nullptr), strides(nullptr) {}
+	cdt_packed_array(void* data, metaffi_size length) : data(data), length(length), is_borrowed(0), is_string_blob(0), rank(0), shape(nullptr), strides(nullptr) {}
+	cdt_packed_array(void* data, metaffi_size length, bool is_borrowed) : data(data), length(length), is_borrowed(is_borrowed ? 1 : 0), is_string_blob(0), rank(0), shape(nullptr), strides(nullptr) {}
 #endif
 };
 
+// Helper macros for packed N-D tensors
+#define metaffi_packed_is_tensor(packed) ((packed)->rank > 1 && (packed)->shape)
+#define metaffi_packed_shape_size(rank, with_strides) (sizeof(metaffi_size) * (rank) * ((with_strides) ? 2 : 1))
+
+// Helper macros for packed string blobs
+#define metaffi_string_blob_size(length, code_units, code_unit_size) \
+	(sizeof(void*) * (length) + sizeof(metaffi_size) * ((length) + 1) + (code_unit_size) * ((code_units) + (length)))
+#define metaffi_string_blob_offsets(packed) ((metaffi_size*)((char*)(packed)->data + sizeof(void*) * (packed)->length))
+#define metaffi_string_blob_string_length(packed, i) \
+	(metaffi_string_blob_offsets(packed)[(i) + 1] - metaffi_string_blob_offsets(packed)[(i)] - 1)
+
 #define metaffi_type_to_str(t, str) \
     str = (t == metaffi_float64_type) ? "metaffi_float64" : \
           (t == metaffi_float32_type) ? "metaffi_float32" : \
@@ -0,0 +1,129 @@
+#pragma once
+#include "cdt.h"
+#include <cstring>
+#include <new>
+#include <string>
+
+namespace metaffi::runtime
+{
+
+/************************************************
+*   Packed string blobs
+*************************************************/
+
+/**
+ * @brief Writes the strings of a packed string blob (see cdt_packed_array) into a buffer of blob_size() bytes.
+ * The strings must be appended in order, exactly count times.
+ * @tparam char_t char8_t, char16_t or char32_t
+ */
+template<typename char_t>
+class packed_string_blob_writer
+{
+public:
+	/**
+	 * @brief Size in bytes of a blob of count strings with total_code_units code units (without NULL terminators)
+	 */
+	[[nodiscard]] static size_t blob_size(metaffi_size count, metaffi_size total_code_units)
+	{
+		return metaffi_string_blob_size(count, total_code_units, sizeof(char_t));
+	}
+
+	packed_string_blob_writer(void* blob, metaffi_size count)
+		: strings(static_cast<char_t**>(blob)),
+		  offsets(reinterpret_cast<metaffi_size*>(strings + count)),
+		  chars(reinterpret_cast<char_t*>(offsets + count + 1)),
+		  index(0)
+	{
+		offsets[0] = 0;
+	}
+
+	/**
+	 * @brief Append a string of code_units code units and NULL terminate it.
+	 * @return Where to write the string's code_units code units.
+	 */
+	char_t* append(metaffi_size code_units)
+	{
+		char_t* str = chars + offsets[index];
+		str[code_units] = 0;
+
+		strings[index] = str;
+		offsets[index + 1] = offsets[index] + code_units + 1;
+		index++;
+
+		return str;
+	}
+
+	/**
+	 * @brief Append a null string (no characters, offsets[i+1] == offsets[i]).
+	 */
+	void append_null()
+	{
+		strings[index] = nullptr;
+		offsets[index + 1] = offsets[index];
+		index++;
+	}
+
+	void append(const char_t* str, metaffi_size code_units)
+	{
+		char_t* dst = append(code_units);
+		if(code_units > 0)
+		{
+			std::memcpy(dst, str, code_units * sizeof(char_t));
+		}
+	}
+
+private:
+	char_t** strings;
+	metaffi_size* offsets;
+	char_t* chars;
+	metaffi_size index;
+};
+
+/**
+ * @brief Allocate (xllr_alloc_memory) a packed string blob of count strings and total_code_units code units.
+ * Fill it with a packed_string_blob_writer over packed->data.
+ * @throws std::bad_alloc
+ */
+template<typename char_t>
+cdt_packed_array* alloc_packed_string_blob(metaffi_size count, metaffi_size total_code_units)
+{
+	auto* packed = static_cast<cdt_packed_array*>(xllr_alloc_memory(sizeof(cdt_packed_array)));
+	if(!packed)
+	{
+		throw std::bad_alloc();
+	}
+
+	new (packed) cdt_packed_array(nullptr, count);
+	if(count == 0)
+	{
+		return packed;
+	}
+
+	packed->data = xllr_alloc_memory(packed_string_blob_writer<char_t>::blob_size(count, total_code_units));
+	if(!packed->data)
+	{
+		xllr_free_memory(packed);
+		throw std::bad_alloc();
+	}
+
+	packed->is_string_blob = 1;
+	return packed;
+}
+
+/**
+ * @brief Length (in code units) of string i of a packed string array (0 for null strings).
+ * O(1) for string blobs, scans for the NULL terminator otherwise.
+ */
+template<typename char_t>
+metaffi_size packed_string_length(const cdt_packed_array* packed, metaffi_size i)
+{
+	const char_t* str = static_cast<char_t* const*>(packed->data)[i];
+	if(!str)
+	{
+		return 0;
+	}
+
+	return packed->is_string_blob ? metaffi_string_blob_string_length(packed, i) : std::char_traits<char_t>::length(str);
+}
+
+}
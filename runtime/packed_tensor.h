@@ -0,0 +1,270 @@
+#pragma once
+#include "cdt.h"
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+namespace metaffi::runtime
+{
+
+/************************************************
+*   Packed N-D tensors
+*************************************************/
+
+/**
+ * @brief Number of dimensions of a packed array (1 for 1D packed arrays)
+ */
+inline metaffi_size packed_rank(const cdt_packed_array* packed)
+{
+	return metaffi_packed_is_tensor(packed) ? packed->rank : 1;
+}
+
+/**
+ * @brief Extent of dimension dim (length for 1D packed arrays)
+ */
+inline metaffi_size packed_extent(const cdt_packed_array* packed, metaffi_size dim)
+{
+	return metaffi_packed_is_tensor(packed) ? packed->shape[dim] : packed->length;
+}
+
+/**
+ * @brief Whether the elements are in data in row-major order without gaps
+ */
+inline bool packed_is_contiguous(const cdt_packed_array* packed)
+{
+	if(!metaffi_packed_is_tensor(packed) || !packed->strides)
+	{
+		return true;
+	}
+
+	metaffi_int64 expected = 1;
+	for(metaffi_size dim = packed->rank; dim-- > 0;)
+	{
+		if(packed->shape[dim] > 1 && packed->strides[dim] != expected)
+		{
+			return false;
+		}
+		expected *= static_cast<metaffi_int64>(packed->shape[dim]);
+	}
+
+	return true;
+}
+
+/**
+ * @brief Set the shape (and optionally strides) of packed into a shape buffer of metaffi_packed_shape_size(rank, strides) bytes.
+ * Sets length to the product of the extents. rank <= 1 makes packed a 1D array of shape[0] elements.
+ * @param shape_buffer Allocated with the packed array's allocator (xllr_alloc_memory, or the arena). Unused if rank <= 1.
+ */
+inline void set_packed_shape(cdt_packed_array* packed, void* shape_buffer, metaffi_size rank, const metaffi_size* shape, const metaffi_int64* strides = nullptr)
+{
+	metaffi_size length = 1;
+	for(metaffi_size dim = 0; dim < rank; dim++)
+	{
+		length *= shape[dim];
+	}
+	packed->length = rank == 0 ? 0 : length;
+
+	if(rank <= 1)
+	{
+		packed->rank = rank;
+		packed->shape = nullptr;
+		packed->strides = nullptr;
+		return;
+	}
+
+	packed->rank = rank;
+	packed->shape = static_cast<metaffi_size*>(shape_buffer);
+	std::memcpy(packed->shape, shape, sizeof(metaffi_size) * rank);
+
+	if(strides)
+	{
+		packed->strides = reinterpret_cast<metaffi_int64*>(packed->shape + rank);
+		std::memcpy(packed->strides, strides, sizeof(metaffi_int64) * rank);
+	}
+	else
+	{
+		packed->strides = nullptr;
+	}
+}
+
+/**
+ * @brief Allocate (xllr_alloc_memory) and set the shape of packed. See set_packed_shape.
+ * @throws std::bad_alloc
+ */
+inline void alloc_packed_shape(cdt_packed_array* packed, metaffi_size rank, const metaffi_size* shape, const metaffi_int64* strides = nullptr)
+{
+	void* shape_buffer = nullptr;
+	if(rank > 1)
+	{
+		shape_buffer = xllr_alloc_memory(metaffi_packed_shape_size(rank, strides != nullptr));
+		if(!shape_buffer)
+		{
+			throw std::bad_alloc();
+		}
+	}
+
+	set_packed_shape(packed, shape_buffer, rank, shape, strides);
+}
+
+/**
+ * @brief Size in bytes of a numeric/bool/size/char element, 0 for other element types
+ */
+inline size_t packed_element_size(metaffi_type element_type)
+{
+	switch(element_type)
+	{
+		case metaffi_int8_type:
+		case metaffi_uint8_type:
+		case metaffi_char8_type:
+			return 1;
+		case metaffi_int16_type:
+		case metaffi_uint16_type:
+		case metaffi_char16_type:
+			return 2;
+		case metaffi_int32_type:
+		case metaffi_uint32_type:
+		case metaffi_float32_type:
+		case metaffi_char32_type:
+			return 4;
+		case metaffi_int64_type:
+		case metaffi_uint64_type:
+		case metaffi_float64_type:
+		case metaffi_size_type:
+			return 8;
+		case metaffi_bool_type:
+			return sizeof(metaffi_bool);
+		default:
+			return 0;
+	}
+}
+
+/**
+ * @brief Allocate (xllr_alloc_memory) a contiguous packed tensor of shape[rank] with an uninitialized buffer.
+ * Set it in a CDT (set_packed_array) before filling it, so it is freed if filling fails.
+ * @throws std::bad_alloc
+ */
+inline cdt_packed_array* alloc_packed_tensor(metaffi_size rank, const metaffi_size* shape, size_t element_size)
+{
+	auto* packed = static_cast<cdt_packed_array*>(xllr_alloc_memory(sizeof(cdt_packed_array)));
+	if(!packed)
+	{
+		throw std::bad_alloc();
+	}
+	new (packed) cdt_packed_array();
+
+	try
+	{
+		alloc_packed_shape(packed, rank, shape);
+		if(packed->length > 0)
+		{
+			packed->data = xllr_alloc_memory(packed->length * element_size);
+			if(!packed->data)
+			{
+				throw std::bad_alloc();
+			}
+		}
+	}
+	catch(...)
+	{
+		if(packed->shape)
+		{
+			xllr_free_memory(packed->shape);
+		}
+		xllr_free_memory(packed);
+		throw;
+	}
+
+	return packed;
+}
+
+/**
+ * @brief Offset (in elements) of the element at index[rank] from data
+ */
+inline metaffi_int64 packed_element_offset(const cdt_packed_array* packed, const metaffi_size* index)
+{
+	if(!metaffi_packed_is_tensor(packed))
+	{
+		return static_cast<metaffi_int64>(index[0]);
+	}
+
+	metaffi_int64 offset = 0;
+	if(packed->strides)
+	{
+		for(metaffi_size dim = 0; dim < packed->rank; dim++)
+		{
+			offset += static_cast<metaffi_int64>(index[dim]) * packed->strides[dim];
+		}
+	}
+	else
+	{
+		for(metaffi_size dim = 0; dim < packed->rank; dim++)
+		{
+			offset = offset * static_cast<metaffi_int64>(packed->shape[dim]) + static_cast<metaffi_int64>(index[dim]);
+		}
+	}
+
+	return offset;
+}
+
+/**
+ * @brief Copy the elements of a numeric/bool/size/char packed array to dst in row-major order.
+ * @param dst Buffer of packed->length elements of element_size bytes
+ */
+inline void copy_packed_elements(const cdt_packed_array* packed, size_t element_size, void* dst)
+{
+	if(packed->length == 0)
+	{
+		return;
+	}
+
+	if(packed_is_contiguous(packed))
+	{
+		std::memcpy(dst, packed->data, packed->length * element_size);
+		return;
+	}
+
+	// strided - copy row by row of the innermost dimension
+	metaffi_size rank = packed->rank;
+	metaffi_size inner_extent = packed->shape[rank - 1];
+	metaffi_int64 inner_stride = packed->strides[rank - 1];
+	metaffi_size rows = packed->length / inner_extent;
+
+	const auto* src = static_cast<const unsigned char*>(packed->data);
+	auto* out = static_cast<unsigned char*>(dst);
+
+	if(rank > 64)
+	{
+		throw std::invalid_argument("packed tensor rank is larger than 64");
+	}
+	metaffi_size index[64] = {};
+
+	for(metaffi_size row = 0; row < rows; row++)
+	{
+		const unsigned char* row_start = src + packed_element_offset(packed, index) * static_cast<metaffi_int64>(element_size);
+		if(inner_stride == 1)
+		{
+			std::memcpy(out, row_start, inner_extent * element_size);
+			out += inner_extent * element_size;
+		}
+		else
+		{
+			for(metaffi_size i = 0; i < inner_extent; i++)
+			{
+				std::memcpy(out, row_start + static_cast<metaffi_int64>(i) * inner_stride * static_cast<metaffi_int64>(element_size), element_size);
+				out += element_size;
+			}
+		}
+
+		// next row: increment the index of the outer dimensions
+		for(metaffi_size dim = rank - 1; dim-- > 0;)
+		{
+			if(++index[dim] < packed->shape[dim])
+			{
+				break;
+			}
+			index[dim] = 0;
+		}
+	}
+}
+
+}
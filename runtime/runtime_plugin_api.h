@@ -43,4 +43,10 @@ void xcall_params_no_ret(void* context, cdts params_ret[2], char** out_err);
 void xcall_no_params_ret(void* context, cdts params_ret[2], char** out_err);
 void xcall_no_params_no_ret(void* context, char** out_err);
 
+/**
+ * Call pxcall count times in one crossing into the plugin (see xcall_batch in xllr_api.h).
+ * Optional - if the plugin does not export it, XLLR calls pxcall count times.
+ */
+void xcall_batch(struct xcall* pxcall, struct cdts* frames, metaffi_size count, char** out_err);
+
 }
@@ -35,5 +35,33 @@ struct runtime_plugin_interface
 	 * Free loaded entity
 	 */ 
 	virtual void free_xcall(xcall* pff, char** err) = 0;
+
+	/**
+	 * Call pxcall count times. frames holds count parameters/return values pairs,
+	 * or is null if the entity has no parameters and no return values.
+	 * Stops at the first failing call.
+	 *
+	 * The default calls pxcall one by one - override to pay the per-call setup
+	 * (GIL, JNI environment, ...) once for the whole batch.
+	 */
+	virtual void xcall_batch(xcall* pxcall, cdts* frames, metaffi_size count, char** err)
+	{
+		for(metaffi_size i = 0; i < count; i++)
+		{
+			if(frames)
+			{
+				(*pxcall)(&frames[2 * i], err);
+			}
+			else
+			{
+				(*pxcall)(err);
+			}
+
+			if(*err)
+			{
+				return;
+			}
+		}
+	}
 	
 };
@@ -88,6 +88,20 @@ void xcall_no_params_no_ret(
         char** out_err                                           // [out] error
 );
 
+/***
+ * Call foreign entity count times, crossing into the runtime plugin once for all the calls
+ * (e.g. the plugin takes the GIL or attaches the JNI environment once).
+ * Forwards to the plugin's xcall_batch, or calls pxcall count times if the plugin does not export it.
+ * Stops at the first failing call.
+ */
+void xcall_batch(
+        struct xcall* pplugin_xcall_and_context, // [in] pointer to plugin's xcall + context
+        struct cdts* frames,                     // [in/out] count parameters/return values pairs (frames[2*i], frames[2*i+1]).
+                                                 //          NULL if the entity has no parameters and no return values.
+        metaffi_size count,                      // [in] number of calls
+        char** out_err                           // [out] error of the failing call
+);
+
 /**
  * @brief Sets a flag in XLLR
  */
@@ -153,6 +153,39 @@ void xllr_xcall_no_params_no_ret(struct xcall* pxcall,
 	pxllr_xcall_no_params_no_ret(pxcall, out_err);
 }
 
+void (*pxllr_xcall_batch)(struct xcall*, struct cdts*, metaffi_size, char**); // optional - NULL in XLLR versions without xcall_batch
+void xllr_xcall_batch(struct xcall* pxcall,
+                      struct cdts* frames,
+                      metaffi_size count,
+                      char** out_err
+)
+{
+	check_function_pointer(pxllr_xcall_params_ret,); // loads XLLR
+
+	if(pxllr_xcall_batch)
+	{
+		pxllr_xcall_batch(pxcall, frames, count, out_err);
+		return;
+	}
+
+	for(metaffi_size i = 0; i < count; i++)
+	{
+		if(frames)
+		{
+			call_xcall_with_params_and_or_retvals(pxcall, &frames[2 * i], out_err);
+		}
+		else
+		{
+			call_xcall_no_params_no_retvals(pxcall, out_err);
+		}
+
+		if(*out_err)
+		{
+			return;
+		}
+	}
+}
+
 struct xcall* (*pxllr_load_entity)(const char*, const char*, const char*, struct metaffi_type_info*, int8_t, struct metaffi_type_info*, int8_t, char**);
 struct xcall* xllr_load_entity(const char* runtime_plugin,
                           const char* module_path,
@@ -431,6 +464,16 @@ void* load_symbol(void* handle, const char* name, char** out_err)
 
 #endif //_WIN32 ------- END POSIX else block -----
 
+// returns NULL without logging an error if the symbol does not exist
+static void* load_optional_symbol(void* handle, const char* name)
+{
+#ifdef _WIN32
+	return (void*)GetProcAddress(handle, name);
+#else
+	return dlsym(handle, name);
+#endif
+}
+
 const char* load_xllr_capi()
 {
 	char* out_err = NULL;
@@ -610,6 +653,9 @@ const char* load_xllr_capi()
 		return out_err;
 	}
 
+	// optional - xllr_xcall_batch loops over the xcall if missing
+	pxllr_xcall_batch = (void (*)(struct xcall*, struct cdts*, metaffi_size, char**))load_optional_symbol(cdt_helper_xllr_handle, "xcall_batch");
+
 	return NULL;
 }
 
@@ -40,6 +40,18 @@ void xllr_xcall_no_params_no_ret(struct xcall* pxcall,
                 char** out_err
 );
 
+/**
+ * Call pxcall count times with a single crossing into the runtime plugin.
+ * frames holds count parameters/return values pairs (frames[2*i], frames[2*i+1]),
+ * or is NULL if the entity has no parameters and no return values.
+ * Stops at the first failing call. Loops locally if XLLR does not export xcall_batch.
+ */
+void xllr_xcall_batch(struct xcall* pxcall,
+                struct cdts* frames,
+                metaffi_size count,
+                char** out_err
+);
+
 struct xcall* xllr_load_entity(const char* runtime_plugin,
                           const char* module_path,
                           const char* entity_path,
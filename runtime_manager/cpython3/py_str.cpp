@@ -5,6 +5,7 @@
 #include "py_str.h"
 #include "py_utils.h"
 #include "runtime_manager.h"
+#include <algorithm>
 #include <cstring>
 
 py_str::py_str(cpython3_runtime_manager& rt) : py_object(rt)
@@ -99,16 +100,13 @@ py_str::py_str(cpython3_runtime_manager& rt, const char16_t* s) : py_object(rt)
 metaffi_string8 py_str::to_utf8() const
 {
 	auto gil = m_runtime.acquire_gil();
-	PyObject* utf8 = pPyUnicode_AsUTF8String(instance);
-	if(!utf8)
+	Py_ssize_t len;
+	const char* s = utf8_data(instance, len);
+	if(!s)
 	{
 		throw std::runtime_error(check_python_error());
 	}
 
-	char* s;
-	Py_ssize_t len;
-	pPyBytes_AsStringAndSize(utf8, &s, &len);
-
 	// Allocate memory for the metaffi_string8
 	metaffi_string8 result = new char8_t[len + 1];
 
@@ -116,53 +114,43 @@ metaffi_string8 py_str::to_utf8() const
 	std::memcpy(result, s, len);
 	result[len] = '\0'; // Null-terminate the string
 
-	Py_DECREF(utf8);
 	return result;
 }
 
 metaffi_string16 py_str::to_utf16() const
 {
 	auto gil = m_runtime.acquire_gil();
-	PyObject* bytes = pPyUnicode_AsUTF16String(instance);
-	if(!bytes)
+	PyUnicode_Kind kind;
+	const void* data;
+	Py_ssize_t length;
+	if(!canonical_data(instance, kind, data, length) || !check_no_surrogates(kind, data, length))
 	{
 		throw std::runtime_error(check_python_error());
 	}
 
-	char* s = pPyBytes_AsString(bytes);
-	Py_ssize_t size = pPyBytes_Size(bytes);
-
-	// Allocate memory for the metaffi_string16
-	metaffi_string16 result = new char16_t[(size / 2) + 1];
-
-	// Copy the string to the allocated memory (skip BOM)
-	std::memcpy(result, s + 2, size - 2);  // Skip 2-byte BOM
-	result[(size - 2) / 2] = '\0'; // Null-terminate the string
+	Py_ssize_t units = utf16_length(kind, data, length);
+	metaffi_string16 result = new char16_t[units + 1];
+	copy_utf16(kind, data, length, result);
+	result[units] = u'\0';
 
-	Py_DECREF(bytes);
 	return result;
 }
 
 metaffi_string32 py_str::to_utf32() const
 {
 	auto gil = m_runtime.acquire_gil();
-	PyObject* bytes = pPyUnicode_AsUTF32String(instance);
-	if(!bytes)
+	PyUnicode_Kind kind;
+	const void* data;
+	Py_ssize_t length;
+	if(!canonical_data(instance, kind, data, length) || !check_no_surrogates(kind, data, length))
 	{
 		throw std::runtime_error(check_python_error());
 	}
 
-	char* s = pPyBytes_AsString(bytes);
-	Py_ssize_t size = pPyBytes_Size(bytes);
+	metaffi_string32 result = new char32_t[length + 1];
+	copy_utf32(kind, data, length, result);
+	result[length] = U'\0';
 
-	// Allocate memory for the metaffi_string32
-	metaffi_string32 result = new char32_t[(size / 4) + 1];
-
-	// Copy the string to the allocated memory (skip BOM)
-	std::memcpy(result, s + 4, size - 4);  // Skip 4-byte BOM
-	result[(size - 4) / 4] = '\0'; // Null-terminate the string
-
-	Py_DECREF(bytes);
 	return result;
 }
 
@@ -206,6 +194,140 @@ bool py_str::check(PyObject* obj)
 	return pPyUnicode_Check(obj);
 }
 
+const char* py_str::utf8_data(PyObject* obj, Py_ssize_t& out_size)
+{
+	// compact ASCII strings are their own UTF-8 form
+	if(pPyUnicode_Check(obj) && pPyUnicode_IS_COMPACT_ASCII(obj))
+	{
+		out_size = pPyUnicode_GET_LENGTH(obj);
+		return static_cast<const char*>(pPyUnicode_DATA(obj));
+	}
+
+	return pPyUnicode_AsUTF8AndSize(obj, &out_size);
+}
+
+bool py_str::canonical_data(PyObject* obj, PyUnicode_Kind& out_kind, const void*& out_data, Py_ssize_t& out_length)
+{
+	// before Python 3.12, a non-compact str might not be "ready" - PyUnicode_GetLength() readies it
+	if(!pPyUnicode_IS_COMPACT(obj) && pPyUnicode_GetLength(obj) < 0)
+	{
+		return false;
+	}
+
+	out_kind = pPyUnicode_KIND(obj);
+	out_data = pPyUnicode_DATA(obj);
+	out_length = pPyUnicode_GET_LENGTH(obj);
+	return true;
+}
+
+Py_ssize_t py_str::utf16_length(PyUnicode_Kind kind, const void* data, Py_ssize_t length)
+{
+	if(kind != PyUnicode_4BYTE_KIND)
+	{
+		return length;
+	}
+
+	const char32_t* ucs4 = static_cast<const char32_t*>(data);
+	Py_ssize_t units = length;
+	for(Py_ssize_t i = 0; i < length; i++)
+	{
+		units += ucs4[i] > 0xFFFF ? 1 : 0;
+	}
+	return units;
+}
+
+bool py_str::check_no_surrogates(PyUnicode_Kind kind, const void* data, Py_ssize_t length)
+{
+	Py_ssize_t position = -1;
+	switch(kind)
+	{
+		case PyUnicode_1BYTE_KIND: // Latin-1 has no surrogates
+			return true;
+
+		case PyUnicode_2BYTE_KIND:
+		{
+			const char16_t* ucs2 = static_cast<const char16_t*>(data);
+			const char16_t* found = std::find_if(ucs2, ucs2 + length, [](char16_t c) { return c >= 0xD800 && c <= 0xDFFF; });
+			position = found == ucs2 + length ? -1 : found - ucs2;
+		}break;
+
+		default: // PyUnicode_4BYTE_KIND
+		{
+			const char32_t* ucs4 = static_cast<const char32_t*>(data);
+			const char32_t* found = std::find_if(ucs4, ucs4 + length, [](char32_t c) { return c >= 0xD800 && c <= 0xDFFF; });
+			position = found == ucs4 + length ? -1 : found - ucs4;
+		}break;
+	}
+
+	if(position < 0)
+	{
+		return true;
+	}
+
+	std::string error = "surrogates not allowed (lone surrogate in position " + std::to_string(position) + ")";
+	pPyErr_SetString(pPyExc_ValueError, error.c_str());
+	return false;
+}
+
+void py_str::copy_utf16(PyUnicode_Kind kind, const void* data, Py_ssize_t length, char16_t* dst)
+{
+	switch(kind)
+	{
+		case PyUnicode_1BYTE_KIND:
+		{
+			const uint8_t* latin1 = static_cast<const uint8_t*>(data);
+			std::copy(latin1, latin1 + length, dst);
+		}break;
+
+		case PyUnicode_2BYTE_KIND:
+		{
+			std::memcpy(dst, data, length * sizeof(char16_t));
+		}break;
+
+		default: // PyUnicode_4BYTE_KIND
+		{
+			const char32_t* ucs4 = static_cast<const char32_t*>(data);
+			for(Py_ssize_t i = 0; i < length; i++)
+			{
+				char32_t cp = ucs4[i];
+				if(cp > 0xFFFF)
+				{
+					cp -= 0x10000;
+					*dst++ = static_cast<char16_t>(0xD800 + (cp >> 10));
+					*dst++ = static_cast<char16_t>(0xDC00 + (cp & 0x3FF));
+				}
+				else
+				{
+					*dst++ = static_cast<char16_t>(cp);
+				}
+			}
+		}break;
+	}
+}
+
+void py_str::copy_utf32(PyUnicode_Kind kind, const void* data, Py_ssize_t length, char32_t* dst)
+{
+	switch(kind)
+	{
+		case PyUnicode_1BYTE_KIND:
+		{
+			const uint8_t* latin1 = static_cast<const uint8_t*>(data);
+			std::copy(latin1, latin1 + length, dst);
+		}break;
+
+		case PyUnicode_2BYTE_KIND:
+		{
+			const char16_t* ucs2 = static_cast<const char16_t*>(data);
+			std::copy(ucs2, ucs2 + length, dst);
+		}break;
+
+		default: // PyUnicode_4BYTE_KIND
+		{
+			std::memcpy(dst, data, length * sizeof(char32_t));
+		}break;
+	}
+}
+
 py_str::py_str(cpython3_runtime_manager& rt, const metaffi_char8 c) : py_object(rt)
 {
 	auto gil = m_runtime.acquire_gil();
@@ -21,6 +21,49 @@ public:
 	 */
 	static bool check(PyObject* obj);
 
+	/**
+	 * @brief UTF-8 contents of a str, without creating a bytes object
+	 * Compact ASCII strings are read in place, others use the UTF-8 buffer cached on the str.
+	 * @param out_size Size in bytes
+	 * @return Buffer owned by obj, or nullptr with a Python error set
+	 * @note Assumes GIL is held by caller
+	 */
+	static const char* utf8_data(PyObject* obj, Py_ssize_t& out_size);
+
+	/**
+	 * @brief In-place access to the canonical (Latin-1, UCS-2 or UCS-4) code units of a str
+	 * @param out_kind Size of a code unit in bytes (PyUnicode_1BYTE_KIND, 2BYTE or 4BYTE)
+	 * @param out_data Code units, owned by obj
+	 * @param out_length Length in code points
+	 * @return false with a Python error set on failure
+	 * @note Assumes GIL is held by caller
+	 */
+	static bool canonical_data(PyObject* obj, PyUnicode_Kind& out_kind, const void*& out_data, Py_ssize_t& out_length);
+
+	/**
+	 * @brief Number of UTF-16 code units of canonical code units (code points above the BMP take two)
+	 */
+	static Py_ssize_t utf16_length(PyUnicode_Kind kind, const void* data, Py_ssize_t length);
+
+	/**
+	 * @brief Check canonical code units hold no lone surrogates (U+D800-U+DFFF), which UTF-16/UTF-32 cannot encode
+	 * @return false with a Python ValueError set if a surrogate is found
+	 * @note Assumes GIL is held by caller
+	 */
+	static bool check_no_surrogates(PyUnicode_Kind kind, const void* data, Py_ssize_t length);
+
+	/**
+	 * @brief Convert canonical code units to UTF-16 into dst (utf16_length() units, no NULL terminator)
+	 * @note Surrogates are copied as-is - call check_no_surrogates() first
+	 */
+	static void copy_utf16(PyUnicode_Kind kind, const void* data, Py_ssize_t length, char16_t* dst);
+
+	/**
+	 * @brief Convert canonical code units to UTF-32 into dst (length units, no NULL terminator)
+	 * @note Surrogates are copied as-is - call check_no_surrogates() first
+	 */
+	static void copy_utf32(PyUnicode_Kind kind, const void* data, Py_ssize_t length, char32_t* dst);
+
 public:
 	/**
 	 * @brief Construct empty string
@@ -48,6 +48,7 @@ Py_InitializeEx_t pPy_InitializeEx = nullptr;
 Py_Finalize_t pPy_Finalize = nullptr;
 Py_FinalizeEx_t pPy_FinalizeEx = nullptr;
 Py_IsInitialized_t pPy_IsInitialized = nullptr;
+Py_GetVersion_t pPy_GetVersion = nullptr;
 
 PyUnicode_FromString_t pPyUnicode_FromString = nullptr;
 PyUnicode_FromStringAndSize_t pPyUnicode_FromStringAndSize = nullptr;
@@ -128,6 +129,13 @@ PyObject_DelItem_t pPyObject_DelItem = nullptr;
 PyObject_DelItemString_t pPyObject_DelItemString = nullptr;
 PyObject_AsCharBuffer_t pPyObject_AsCharBuffer = nullptr;
 PyObject_CheckReadBuffer_t pPyObject_CheckReadBuffer = nullptr;
+PyObject_GetBuffer_t pPyObject_GetBuffer = nullptr;
+PyBuffer_Release_t pPyBuffer_Release = nullptr;
+PyMemoryView_FromObject_t pPyMemoryView_FromObject = nullptr;
+PyMemoryView_FromMemory_t pPyMemoryView_FromMemory = nullptr;
+PyType_FromSpec_t pPyType_FromSpec = nullptr;
+PyType_GenericAlloc_t pPyType_GenericAlloc = nullptr;
+PyObject_Free_t pPyObject_Free = nullptr;
 PyObject_Format_t pPyObject_Format = nullptr;
 PyObject_GetIter_t pPyObject_GetIter = nullptr;
 PyObject_IsTrue_t pPyObject_IsTrue = nullptr;
@@ -217,6 +225,10 @@ PyObject* pPy_None = nullptr;
 PyObject* pPy_True = nullptr;
 PyObject* pPy_False = nullptr;
 
+// Header sizes of compact str objects, set for the loaded version by set_unicode_object_sizes()
+Py_ssize_t python3_ascii_object_size = sizeof(PyASCIIObject);
+Py_ssize_t python3_compact_unicode_object_size = sizeof(PyASCIIObject) + sizeof(Py_ssize_t) + sizeof(char*);
+
 PyObject_Str_t pPyObject_Str = nullptr;
 PyCapsule_New_t pPyCapsule_New = nullptr;
 PyCapsule_GetPointer_t pPyCapsule_GetPointer = nullptr;
@@ -688,6 +700,23 @@ std::vector<std::string> detect_installed_python3()
 	return detected_versions;
 }
 
+// Python 3.12 removed PyASCIIObject.wstr and PyCompactUnicodeObject.wstr_length,
+// which moves the code units of compact str objects (see pPyUnicode_DATA)
+static void set_unicode_object_sizes()
+{
+	long minor = 12;
+	const char* version = pPy_GetVersion ? pPy_GetVersion() : nullptr; // "3.11.7 (main, ...)"
+	const char* dot = version ? strchr(version, '.') : nullptr;
+	if(dot)
+	{
+		minor = strtol(dot + 1, nullptr, 10);
+	}
+
+	bool has_wstr = minor < 12;
+	python3_ascii_object_size = sizeof(PyASCIIObject) + (has_wstr ? sizeof(wchar_t*) : 0);
+	python3_compact_unicode_object_size = python3_ascii_object_size + sizeof(Py_ssize_t) + sizeof(char*) + (has_wstr ? sizeof(Py_ssize_t) : 0);
+}
+
 // Helper function to load all Python API symbols from the library handle
 // Assumes python_lib_handle is already set
 static void load_all_python_symbols()
@@ -729,6 +758,7 @@ static void load_all_python_symbols()
 	LOAD_SYMBOL(python_lib_handle, Py_Finalize, Py_Finalize_t);
 	LOAD_SYMBOL(python_lib_handle, Py_FinalizeEx, Py_FinalizeEx_t);
 	LOAD_SYMBOL(python_lib_handle, Py_IsInitialized, Py_IsInitialized_t);
+	LOAD_SYMBOL(python_lib_handle, Py_GetVersion, Py_GetVersion_t);
 
 	LOAD_SYMBOL(python_lib_handle, PyUnicode_FromString, PyUnicode_FromString_t);
 	LOAD_SYMBOL(python_lib_handle, PyUnicode_FromStringAndSize, PyUnicode_FromStringAndSize_t);
@@ -809,6 +839,13 @@ static void load_all_python_symbols()
 	LOAD_SYMBOL(python_lib_handle, PyObject_DelItemString, PyObject_DelItemString_t);
 	LOAD_SYMBOL(python_lib_handle, PyObject_AsCharBuffer, PyObject_AsCharBuffer_t);
 	LOAD_SYMBOL(python_lib_handle, PyObject_CheckReadBuffer, PyObject_CheckReadBuffer_t);
+	LOAD_SYMBOL(python_lib_handle, PyObject_GetBuffer, PyObject_GetBuffer_t);
+	LOAD_SYMBOL(python_lib_handle, PyBuffer_Release, PyBuffer_Release_t);
+	LOAD_SYMBOL(python_lib_handle, PyMemoryView_FromObject, PyMemoryView_FromObject_t);
+	LOAD_SYMBOL(python_lib_handle, PyMemoryView_FromMemory, PyMemoryView_FromMemory_t);
+	LOAD_SYMBOL(python_lib_handle, PyType_FromSpec, PyType_FromSpec_t);
+	LOAD_SYMBOL(python_lib_handle, PyType_GenericAlloc, PyType_GenericAlloc_t);
+	LOAD_SYMBOL(python_lib_handle, PyObject_Free, PyObject_Free_t);
 	LOAD_SYMBOL(python_lib_handle, PyObject_Format, PyObject_Format_t);
 	LOAD_SYMBOL(python_lib_handle, PyObject_GetIter, PyObject_GetIter_t);
 	LOAD_SYMBOL(python_lib_handle, PyObject_IsTrue, PyObject_IsTrue_t);
@@ -956,6 +993,8 @@ static void load_all_python_symbols()
 	}
 #endif
 
+	set_unicode_object_sizes();
+
 #undef LOAD_SYMBOL
 }
 
@@ -1084,8 +1123,6 @@ bool load_python3_api_from_loaded_library(std::string& out_detected_version)
 #ifndef _WIN32
 	// On non-Windows, we need to detect the version from the running Python
 	// Since Python is already initialized, we can query it via Py_GetVersion
-	typedef const char* (*Py_GetVersion_t)(void);
-	Py_GetVersion_t pPy_GetVersion = (Py_GetVersion_t)dlsym(python_lib_handle, "Py_GetVersion");
 	if(pPy_GetVersion)
 	{
 		const char* version_str = pPy_GetVersion();
@@ -22,6 +22,7 @@ typedef void (*Py_InitializeEx_t)(int initsigs);
 typedef void (*Py_Finalize_t)(void);
 typedef int (*Py_FinalizeEx_t)(void);
 typedef int (*Py_IsInitialized_t)(void);
+typedef const char* (*Py_GetVersion_t)(void);
 
 typedef PyObject* (*PyUnicode_FromString_t)(const char *u);
 typedef PyObject* (*PyUnicode_FromStringAndSize_t)(const char *u, Py_ssize_t size);
@@ -102,6 +103,13 @@ typedef int (*PyObject_DelItem_t)(PyObject *o, PyObject *key);
 typedef int (*PyObject_DelItemString_t)(PyObject *o, const char *key);
 typedef int (*PyObject_AsCharBuffer_t)(PyObject *obj, const char **buffer, Py_ssize_t *buffer_len);
 typedef int (*PyObject_CheckReadBuffer_t)(PyObject *obj);
+typedef int (*PyObject_GetBuffer_t)(PyObject *obj, Py_buffer *view, int flags);
+typedef void (*PyBuffer_Release_t)(Py_buffer *view);
+typedef PyObject* (*PyMemoryView_FromObject_t)(PyObject *obj);
+typedef PyObject* (*PyMemoryView_FromMemory_t)(char *mem, Py_ssize_t size, int flags);
+typedef PyObject* (*PyType_FromSpec_t)(PyType_Spec *spec);
+typedef PyObject* (*PyType_GenericAlloc_t)(PyTypeObject *type, Py_ssize_t nitems);
+typedef void (*PyObject_Free_t)(void *ptr);
 typedef PyObject* (*PyObject_Format_t)(PyObject* obj, PyObject* format_spec);
 typedef PyObject* (*PyObject_GetIter_t)(PyObject *o);
 typedef int (*PyObject_IsTrue_t)(PyObject *o);
@@ -202,6 +210,7 @@ extern Py_InitializeEx_t pPy_InitializeEx;
 extern Py_Finalize_t pPy_Finalize;
 extern Py_FinalizeEx_t pPy_FinalizeEx;
 extern Py_IsInitialized_t pPy_IsInitialized;
+extern Py_GetVersion_t pPy_GetVersion;
 
 extern PyUnicode_FromString_t pPyUnicode_FromString;
 extern PyUnicode_FromStringAndSize_t pPyUnicode_FromStringAndSize;
@@ -282,6 +291,13 @@ extern PyObject_DelItem_t pPyObject_DelItem;
 extern PyObject_DelItemString_t pPyObject_DelItemString;
 extern PyObject_AsCharBuffer_t pPyObject_AsCharBuffer;
 extern PyObject_CheckReadBuffer_t pPyObject_CheckReadBuffer;
+extern PyObject_GetBuffer_t pPyObject_GetBuffer;
+extern PyBuffer_Release_t pPyBuffer_Release;
+extern PyMemoryView_FromObject_t pPyMemoryView_FromObject;
+extern PyMemoryView_FromMemory_t pPyMemoryView_FromMemory;
+extern PyType_FromSpec_t pPyType_FromSpec;
+extern PyType_GenericAlloc_t pPyType_GenericAlloc;
+extern PyObject_Free_t pPyObject_Free;
 extern PyObject_Format_t pPyObject_Format;
 extern PyObject_GetIter_t pPyObject_GetIter;
 extern PyObject_IsTrue_t pPyObject_IsTrue;
@@ -185,15 +185,60 @@ typedef struct {
     binaryfunc nb_inplace_matrix_multiply;
 } PyNumberMethods;
 
+// Buffer protocol view (Py_buffer)
+typedef struct bufferinfo {
+    void *buf;
+    PyObject *obj;
+    Py_ssize_t len;
+    Py_ssize_t itemsize;
+    int readonly;
+    int ndim;
+    char *format;
+    Py_ssize_t *shape;
+    Py_ssize_t *strides;
+    Py_ssize_t *suboffsets;
+    void *internal;
+} Py_buffer;
+
+// Buffer request flags
+#define PyBUF_SIMPLE 0
+#define PyBUF_WRITABLE 0x0001
+#define PyBUF_FORMAT 0x0004
+#define PyBUF_ND 0x0008
+#define PyBUF_STRIDES (0x0010 | PyBUF_ND)
+#define PyBUF_C_CONTIGUOUS (0x0020 | PyBUF_STRIDES)
+#define PyBUF_RECORDS_RO (PyBUF_STRIDES | PyBUF_FORMAT)
+#define PyBUF_READ 0x100
+#define PyBUF_WRITE 0x200
+
 // Buffer protocol struct
 typedef struct {
     getbufferproc bf_getbuffer;
     releasebufferproc bf_releasebuffer;
 } PyBufferProcs;
 
+// Heap type specification (PyType_FromSpec)
+typedef struct {
+    int slot;
+    void *pfunc;
+} PyType_Slot;
+
+typedef struct {
+    const char *name;
+    int basicsize;
+    int itemsize;
+    unsigned int flags;
+    PyType_Slot *slots;
+} PyType_Spec;
+
+// Type slot IDs (typeslots.h)
+#define Py_bf_getbuffer 1
+#define Py_bf_releasebuffer 2
+#define Py_tp_dealloc 52
+
 // Type object struct
 struct _typeobject : public PyObject {
-    PyObject_VAR_HEAD
+    Py_ssize_t ob_size; // PyObject_VAR_HEAD - the PyObject part is the base class
     const char *tp_name;
     Py_ssize_t tp_basicsize;
     Py_ssize_t tp_itemsize;
@@ -392,3 +437,42 @@ static inline void Py_SET_SIZE(PyVarObject *ob, Py_ssize_t size) {
 // Cast macros
 #define _PyObject_CAST(op) ((PyObject*)(op))
 #define _PyVarObject_CAST(op) ((PyVarObject*)(op))
+
+// Concrete object layouts (unchanged across supported Python versions) for direct access
+// in hot loops, after an exact type check.
+typedef struct {
+    PyObject ob_base;
+    double ob_fval;
+} PyFloatObject;
+
+typedef struct {
+    PyVarObject ob_base;
+    PyObject **ob_item;
+    Py_ssize_t allocated;
+} PyListObject;
+
+// str objects (PEP 393) - only the fields common to all supported versions.
+// Compact strings store their code units right after the header, whose size depends on the
+// loaded version (3.12 removed the wstr fields). Other strings point to them (data.any).
+typedef struct {
+    PyObject ob_base;
+    Py_ssize_t length; // in code points
+    Py_hash_t hash;
+    unsigned int state; // bit fields: interned:2, kind:3, compact:1, ascii:1, ...
+} PyASCIIObject;
+
+extern Py_ssize_t python3_ascii_object_size;
+extern Py_ssize_t python3_compact_unicode_object_size;
+
+#define pPyUnicode_GET_LENGTH(op) (((PyASCIIObject*)(op))->length)
+#define pPyUnicode_KIND(op) ((PyUnicode_Kind)((((PyASCIIObject*)(op))->state >> 2) & 0x7))
+#define pPyUnicode_IS_COMPACT(op) ((((PyASCIIObject*)(op))->state >> 5) & 0x1)
+#define pPyUnicode_IS_ASCII(op) ((((PyASCIIObject*)(op))->state >> 6) & 0x1)
+#define pPyUnicode_IS_COMPACT_ASCII(op) (pPyUnicode_IS_COMPACT(op) && pPyUnicode_IS_ASCII(op))
+#define pPyUnicode_DATA(op) (pPyUnicode_IS_COMPACT(op) ? \
+    (void*)((char*)(op) + (pPyUnicode_IS_ASCII(op) ? python3_ascii_object_size : python3_compact_unicode_object_size)) : \
+    *(void**)((char*)(op) + python3_compact_unicode_object_size))
+
+#define pPyFloat_AS_DOUBLE(op) (((PyFloatObject*)(op))->ob_fval)
+#define pPyList_GET_SIZE(op) (((PyVarObject*)(op))->ob_size)
+#define pPyList_ITEMS(op) (((PyListObject*)(op))->ob_item)
@@ -22,6 +22,7 @@
 #include <cstring>
 #include <mutex>
 #include <runtime/cdts_traverse_construct.h>
+#include <runtime/packed_string_blob.h>
 #include <runtime/xllr_capi_loader.h>
 #include <utility>
 #include <utils/defines.h>
@@ -3300,6 +3301,11 @@ DLL_PRIVATE cdt_packed_array* on_construct_get_packed_array(const metaffi_size*
 	if (!packed) { throw std::runtime_error("on_construct_get_packed_array: xllr_alloc_memory failed"); }
 	packed->data = nullptr;
 	packed->length = static_cast<metaffi_size>(length);
+	packed->is_borrowed = 0;
+	packed->is_string_blob = 0;
+	packed->rank = 0;
+	packed->shape = nullptr;
+	packed->strides = nullptr;
 
 	if(length == 0)
 	{
@@ -3362,25 +3368,38 @@ DLL_PRIVATE cdt_packed_array* on_construct_get_packed_array(const metaffi_size*
 			break;
 		}
 		case metaffi_string8_type: {
+			// single blob of all the strings (see cdt_packed_array) - sum the lengths, then write in place
 			jobjectArray objArr = (jobjectArray)arr;
-			metaffi_string8* str_buf = static_cast<metaffi_string8*>(xllr_alloc_memory(static_cast<size_t>(length) * sizeof(metaffi_string8)));
+			metaffi_size total_length = 0;
 			for(jsize i = 0; i < length; i++)
 			{
 				jstring jstr = (jstring)env->GetObjectArrayElement(objArr, i);
 				if(jstr)
 				{
-					const char* utf8 = env->GetStringUTFChars(jstr, nullptr);
-					jsize utf8_len = env->GetStringUTFLength(jstr);
-					str_buf[i] = xllr_alloc_string8(reinterpret_cast<const char8_t*>(utf8), static_cast<uint64_t>(utf8_len));
-					env->ReleaseStringUTFChars(jstr, utf8);
+					total_length += static_cast<metaffi_size>(env->GetStringUTFLength(jstr));
+					env->DeleteLocalRef(jstr);
+				}
+			}
+
+			packed->data = xllr_alloc_memory(metaffi::runtime::packed_string_blob_writer<char8_t>::blob_size(packed->length, total_length));
+			if(!packed->data) { xllr_free_memory(packed); throw std::runtime_error("on_construct_get_packed_array: xllr_alloc_memory failed"); }
+			packed->is_string_blob = 1;
+
+			metaffi::runtime::packed_string_blob_writer<char8_t> writer(packed->data, packed->length);
+			for(jsize i = 0; i < length; i++)
+			{
+				jstring jstr = (jstring)env->GetObjectArrayElement(objArr, i);
+				if(jstr)
+				{
+					char8_t* dst = writer.append(static_cast<metaffi_size>(env->GetStringUTFLength(jstr)));
+					env->GetStringUTFRegion(jstr, 0, env->GetStringLength(jstr), reinterpret_cast<char*>(dst));
 					env->DeleteLocalRef(jstr);
 				}
 				else
 				{
-					str_buf[i] = nullptr;
+					writer.append_null();
 				}
 			}
-			packed->data = str_buf;
 			break;
 		}
 		default:
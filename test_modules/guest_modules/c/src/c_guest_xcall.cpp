@@ -261,7 +261,7 @@ void xcall_c_accept_bool(void* /*ctx*/, cdts* params_ret, char** /*err*/)
 extern "C" C_GUEST_API
 void xcall_c_accept_string(void* /*ctx*/, cdts* params_ret, char** /*err*/)
 {
-	const char* s = reinterpret_cast<const char*>(params_ret[0].arr[0].cdt_val.string8_val);
+	const char* s = reinterpret_cast<const char*>(metaffi_cdt_string8(&params_ret[0].arr[0]));
 	c_guest_accept_string(s ? s : "");
 }
 
@@ -300,7 +300,7 @@ void xcall_c_echo_bool(void* /*ctx*/, cdts* params_ret, char** /*err*/)
 extern "C" C_GUEST_API
 void xcall_c_echo_string(void* /*ctx*/, cdts* params_ret, char** /*err*/)
 {
-	const char* s = reinterpret_cast<const char*>(params_ret[0].arr[0].cdt_val.string8_val);
+	const char* s = reinterpret_cast<const char*>(metaffi_cdt_string8(&params_ret[0].arr[0]));
 
 	// c_guest_echo_string heap-allocates the result — copy to thread_local buf then free
 	const char* result = c_guest_echo_string(s ? s : "");
@@ -330,6 +330,11 @@ void xcall_c_make_1d_int64_array(void* /*ctx*/, cdts* params_ret, char** /*err*/
 
 	pa->data = data;
 	pa->length = static_cast<metaffi_size>(out_len);
+	pa->is_borrowed = 0;
+	pa->is_string_blob = 0;
+	pa->rank = 0;
+	pa->shape = nullptr;
+	pa->strides = nullptr;
 
 	params_ret[1].arr[0].set_packed_array(pa, metaffi_int64_type);
 	params_ret[1].arr[0].free_required = 0; // caller manages lifetime
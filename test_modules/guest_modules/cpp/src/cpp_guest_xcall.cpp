@@ -268,7 +268,7 @@ void xcall_accept_bool(void* /*ctx*/, cdts* params_ret, char** /*err*/)
 extern "C" CPP_GUEST_MODULE_API
 void xcall_accept_string(void* /*ctx*/, cdts* params_ret, char** /*err*/)
 {
-	const char* s = reinterpret_cast<const char*>(params_ret[0].arr[0].cdt_val.string8_val);
+	const char* s = reinterpret_cast<const char*>(metaffi_cdt_string8(&params_ret[0].arr[0]));
 	guest::accept_string(std::string(s ? s : ""));
 }
 
@@ -310,7 +310,7 @@ void xcall_echo_bool(void* /*ctx*/, cdts* params_ret, char** /*err*/)
 extern "C" CPP_GUEST_MODULE_API
 void xcall_echo_string(void* /*ctx*/, cdts* params_ret, char** /*err*/)
 {
-	const char* s = reinterpret_cast<const char*>(params_ret[0].arr[0].cdt_val.string8_val);
+	const char* s = reinterpret_cast<const char*>(metaffi_cdt_string8(&params_ret[0].arr[0]));
 	std::string result = guest::echo_string(std::string(s ? s : ""));
 
 	static thread_local char buf[4096];
@@ -338,6 +338,11 @@ void xcall_make_1d_int64_array(void* /*ctx*/, cdts* params_ret, char** /*err*/)
 	}
 	pa->data = data;
 	pa->length = static_cast<metaffi_size>(result.size());
+	pa->is_borrowed = 0;
+	pa->is_string_blob = 0;
+	pa->rank = 0;
+	pa->shape = nullptr;
+	pa->strides = nullptr;
 
 	params_ret[1].arr[0].set_packed_array(pa, metaffi_int64_type);
 	params_ret[1].arr[0].free_required = 0; // caller manages lifetime
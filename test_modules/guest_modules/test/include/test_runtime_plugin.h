@@ -92,4 +92,10 @@ TEST_PLUGIN_API void xcall_params_no_ret(void* context, cdts params_ret[2], char
 TEST_PLUGIN_API void xcall_no_params_ret(void* context, cdts params_ret[2], char** out_err);
 TEST_PLUGIN_API void xcall_no_params_no_ret(void* context, char** out_err);
 
+/**
+ * Batched xcall - invokes the entity handler count times, logging the batch once.
+ * frames holds count params/returns pairs, or is null for no params/no returns entities.
+ */
+TEST_PLUGIN_API void xcall_batch(xcall* pxcall, cdts* frames, metaffi_size count, char** out_err);
+
 } // extern "C"
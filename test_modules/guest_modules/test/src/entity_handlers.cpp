@@ -255,7 +255,7 @@ void handler_accept_string8(cdts* data, char** out_err)
 		set_error(out_err, error_msg);
 		return;
 	}
-	const char* val = reinterpret_cast<const char*>(param.cdt_val.string8_val);
+	const char* val = reinterpret_cast<const char*>(metaffi_cdt_string8(&param));
 	log_entity("test::accept_string8", "received \"" + std::string(val ? val : "null") + "\"");
 }
 
@@ -280,7 +280,7 @@ void handler_echo_float64(cdts* data, char** out_err)
 
 void handler_echo_string8(cdts* data, char** out_err)
 {
-	const char* val = reinterpret_cast<const char*>(data[0].arr[0].cdt_val.string8_val);
+	const char* val = reinterpret_cast<const char*>(metaffi_cdt_string8(&data[0].arr[0]));
 	if(val)
 	{
 		data[1].arr[0].set_string(reinterpret_cast<const char8_t*>(val), true);
@@ -324,8 +324,8 @@ void handler_add_float64(cdts* data, char** out_err)
 
 void handler_concat_strings(cdts* data, char** out_err)
 {
-	const char* a = reinterpret_cast<const char*>(data[0].arr[0].cdt_val.string8_val);
-	const char* b = reinterpret_cast<const char*>(data[0].arr[1].cdt_val.string8_val);
+	const char* a = reinterpret_cast<const char*>(metaffi_cdt_string8(&data[0].arr[0]));
+	const char* b = reinterpret_cast<const char*>(metaffi_cdt_string8(&data[0].arr[1]));
 
 	std::string result;
 	if(a) result += a;
@@ -346,6 +346,11 @@ void handler_return_int64_array_1d(cdts* data, char** out_err)
 	cdt_packed_array* packed = static_cast<cdt_packed_array*>(xllr_alloc_memory(sizeof(cdt_packed_array)));
 	packed->data = nullptr;
 	packed->length = 3;
+	packed->is_borrowed = 0;
+	packed->is_string_blob = 0;
+	packed->rank = 0;
+	packed->shape = nullptr;
+	packed->strides = nullptr;
 
 	auto* buf = static_cast<metaffi_int64*>(xllr_alloc_memory(3 * sizeof(metaffi_int64)));
 	buf[0] = 1;
@@ -435,6 +440,11 @@ void handler_return_string_array(cdts* data, char** out_err)
 	cdt_packed_array* packed = static_cast<cdt_packed_array*>(xllr_alloc_memory(sizeof(cdt_packed_array)));
 	packed->data = nullptr;
 	packed->length = 3;
+	packed->is_borrowed = 0;
+	packed->is_string_blob = 0;
+	packed->rank = 0;
+	packed->shape = nullptr;
+	packed->strides = nullptr;
 
 	auto* buf = static_cast<metaffi_string8*>(xllr_alloc_memory(3 * sizeof(metaffi_string8)));
 	buf[0] = xllr_alloc_string8(reinterpret_cast<const char8_t*>("one"), 3);
@@ -505,6 +515,11 @@ void handler_echo_int64_array(cdts* data, char** out_err)
 		cdt_packed_array* output = static_cast<cdt_packed_array*>(xllr_alloc_memory(sizeof(cdt_packed_array)));
 		output->data = nullptr;
 		output->length = input->length;
+		output->is_borrowed = 0;
+		output->is_string_blob = 0;
+		output->rank = 0;
+		output->shape = nullptr;
+		output->strides = nullptr;
 		auto* out_vals = static_cast<metaffi_int64*>(xllr_alloc_memory(input->length * sizeof(metaffi_int64)));
 		for(metaffi_size i = 0; i < input->length; ++i)
 		{
@@ -565,7 +580,7 @@ void handler_join_strings(cdts* data, char** out_err)
 			for(metaffi_size i = 0; i < arr->length; ++i)
 			{
 				if(i > 0) result += ", ";
-				const char* s = reinterpret_cast<const char*>(arr->arr[i].cdt_val.string8_val);
+				const char* s = reinterpret_cast<const char*>(metaffi_cdt_string8(&arr->arr[i]));
 				if(s) result += s;
 			}
 		}
@@ -640,7 +655,7 @@ void handler_set_handle_data(cdts* data, char** out_err)
 {
 	// data[0] = params (handle, string)
 	cdt_metaffi_handle* h = data[0].arr[0].cdt_val.handle_val;
-	const char* new_data = reinterpret_cast<const char*>(data[0].arr[1].cdt_val.string8_val);
+	const char* new_data = reinterpret_cast<const char*>(metaffi_cdt_string8(&data[0].arr[1]));
 
 	if(!h || !h->handle)
 	{
@@ -744,7 +759,7 @@ void handler_call_callback_string(cdts* data, char** out_err)
 	}
 
 	// Get result from callback
-	const char* result = reinterpret_cast<const char*>(call_data[1].arr[0].cdt_val.string8_val);
+	const char* result = reinterpret_cast<const char*>(metaffi_cdt_string8(&call_data[1].arr[0]));
 	data[1].arr[0].set_string(reinterpret_cast<const char8_t*>(result ? result : ""), true);
 	log_entity("test::call_callback_string", "callback returned \"" + std::string(result ? result : "") + "\"");
 }
@@ -830,7 +845,7 @@ void handler_throw_error(cdts* data, char** out_err)
 
 void handler_throw_with_message(cdts* data, char** out_err)
 {
-	const char* msg = reinterpret_cast<const char*>(data[0].arr[0].cdt_val.string8_val);
+	const char* msg = reinterpret_cast<const char*>(metaffi_cdt_string8(&data[0].arr[0]));
 	std::string error_msg = msg ? msg : "No message provided";
 	log_error("test::throw_with_message", error_msg);
 	set_error(out_err, error_msg);
@@ -884,7 +899,7 @@ void handler_accept_any(cdts* data, char** out_err)
 
 		case metaffi_string8_type:
 		{
-			const char* input_str = reinterpret_cast<const char*>(param.cdt_val.string8_val);
+			const char* input_str = reinterpret_cast<const char*>(metaffi_cdt_string8(&param));
 			std::string return_str = input_str ? std::string("echoed: ") + input_str : "echoed: null";
 			ret.set_string(reinterpret_cast<const char8_t*>(return_str.c_str()), true);
 			log_entity("test::accept_any", "received string8: \"" + std::string(input_str ? input_str : "null") + "\", returning string8: \"" + return_str + "\"");
@@ -951,7 +966,7 @@ void handler_swap_values(cdts* data, char** out_err)
 {
 	// data[0] = params (int64, string8), data[1] = returns (string8, int64)
 	metaffi_int64 int_val = data[0].arr[0].cdt_val.int64_val;
-	const char* str_val = reinterpret_cast<const char*>(data[0].arr[1].cdt_val.string8_val);
+	const char* str_val = reinterpret_cast<const char*>(metaffi_cdt_string8(&data[0].arr[1]));
 
 	data[1].arr[0].set_string(reinterpret_cast<const char8_t*>(str_val ? str_val : ""), true);
 	data[1].arr[1] = int_val;
@@ -986,7 +1001,7 @@ void handler_append_to_data(cdts* data, char** out_err)
 {
 	// data[0] = params (handle, string8)
 	cdt_metaffi_handle* h = data[0].arr[0].cdt_val.handle_val;
-	const char* append_str = reinterpret_cast<const char*>(data[0].arr[1].cdt_val.string8_val);
+	const char* append_str = reinterpret_cast<const char*>(metaffi_cdt_string8(&data[0].arr[1]));
 
 	if(!h || !h->handle)
 	{
@@ -1018,7 +1033,7 @@ void handler_get_g_name(cdts* data, char** out_err)
 void handler_set_g_name(cdts* data, char** out_err)
 {
 	// data[0] = params (string8)
-	const char* new_name = reinterpret_cast<const char*>(data[0].arr[0].cdt_val.string8_val);
+	const char* new_name = reinterpret_cast<const char*>(metaffi_cdt_string8(&data[0].arr[0]));
 	std::string old_name = g_name;
 	g_name = new_name ? new_name : "";
 	log_entity("test::set_g_name", "set g_name: \"" + old_name + "\" -> \"" + g_name + "\"");
@@ -114,9 +114,9 @@ inline void log_cdt_value(std::ostream& os, const cdt& c, int indent_level = 0)
 			os << " value='" << static_cast<char>(c.cdt_val.char8_val.c[0]) << "'";
 			break;
 		case metaffi_string8_type:
-			if(c.cdt_val.string8_val)
+			if(metaffi_cdt_string8(&c))
 			{
-				os << " value=\"" << reinterpret_cast<const char*>(c.cdt_val.string8_val) << "\"";
+				os << " value=\"" << reinterpret_cast<const char*>(metaffi_cdt_string8(&c)) << "\"";
 			}
 			else
 			{
@@ -258,9 +258,9 @@ inline std::string format_string_array(const cdts* arr)
 	for(metaffi_size i = 0; i < arr->length; ++i)
 	{
 		if(i > 0) oss << ", ";
-		if(arr->arr[i].cdt_val.string8_val)
+		if(metaffi_cdt_string8(&arr->arr[i]))
 		{
-			oss << "\"" << reinterpret_cast<const char*>(arr->arr[i].cdt_val.string8_val) << "\"";
+			oss << "\"" << reinterpret_cast<const char*>(metaffi_cdt_string8(&arr->arr[i])) << "\"";
 		}
 		else
 		{
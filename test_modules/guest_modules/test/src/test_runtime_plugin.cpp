@@ -423,4 +423,27 @@ void xcall_no_params_no_ret(void* context, char** out_err)
 	dispatch_no_params_no_ret(context, out_err);
 }
 
+void xcall_batch(xcall* pxcall, cdts* frames, metaffi_size count, char** out_err)
+{
+	if(!pxcall || !pxcall->is_valid())
+	{
+		log_error("xcall_batch", "invalid xcall");
+		set_error(out_err, "xcall_batch: invalid xcall");
+		return;
+	}
+
+	auto* ctx = static_cast<EntityContext*>(pxcall->pxcall_and_context[1]);
+	METAFFI_INFO(LOG, "xcall_batch - {} x{}", ctx->entity_name, count);
+
+	// the batch is logged once - the handlers are called directly
+	for(metaffi_size i = 0; i < count; i++)
+	{
+		ctx->handler(frames ? &frames[2 * i] : nullptr, out_err);
+		if(out_err && *out_err)
+		{
+			return;
+		}
+	}
+}
+
 } // extern "C"